@@ -16,6 +16,7 @@ from argparse import ArgumentTypeError
 import os
 from typing import Any
 from typing import Dict
+from typing import Iterable
 from typing import Optional
 
 from rclpy.duration import Duration
@@ -24,6 +25,7 @@ from rclpy.qos import QoSHistoryPolicy
 from rclpy.qos import QoSLivelinessPolicy
 from rclpy.qos import QoSProfile
 from rclpy.qos import QoSReliabilityPolicy
+from rosbag2_py import ThreadOptions
 
 # This map needs to be updated when new policies are introduced
 _QOS_POLICY_FROM_SHORT_NAME = {
@@ -80,6 +82,40 @@ def convert_yaml_to_qos_profile(qos_profile_dict: Dict) -> Dict[str, QoSProfile]
     return topic_profile_dict
 
 
+def interpret_dict_as_thread_options(thread_options_dict: Dict) -> ThreadOptions:
+    """Sanitize a user provided dict of thread options and verify all keys are valid."""
+    thread_options = ThreadOptions()
+    for key, value in thread_options_dict.items():
+        if key == 'cpu_affinity':
+            if any(not isinstance(cpu, int) or cpu < 0 for cpu in value):
+                raise ValueError('`cpu_affinity` must be a list of CPU indices.')
+            thread_options.cpu_affinity = value
+        elif key == 'nice':
+            if not -20 <= value <= 19:
+                raise ValueError('`nice` must be between -20 and 19.')
+            thread_options.nice = value
+        elif key == 'fifo_priority':
+            if not 0 <= value <= 99:
+                raise ValueError('`fifo_priority` must be between 0 and 99.')
+            thread_options.fifo_priority = value
+        else:
+            raise ValueError('Unexpected key `{}` for thread options.'.format(key))
+    return thread_options
+
+
+def convert_yaml_to_thread_options(
+    thread_options_dict: Dict, thread_classes: Iterable[str]
+) -> Dict[str, ThreadOptions]:
+    """Convert a YAML file of thread options by thread class to rosbag2_py's ThreadOptions."""
+    class_options_dict = {}
+    for thread_class, options in thread_options_dict.items():
+        if thread_class not in thread_classes:
+            raise ValueError('Unknown thread class `{}`, expected one of: {}.'.format(
+                thread_class, ', '.join(thread_classes)))
+        class_options_dict[thread_class] = interpret_dict_as_thread_options(options)
+    return class_options_dict
+
+
 def create_bag_directory(uri: str) -> Optional[str]:
     """Create a directory."""
     try:
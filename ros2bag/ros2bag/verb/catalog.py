@@ -0,0 +1,74 @@
+# Copyright 2022 Open Source Robotics Foundation, Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import os
+
+from ros2bag.api import print_error
+from ros2bag.verb import VerbExtension
+
+
+def seconds_to_nanoseconds(seconds):
+    return int(round(float(seconds) * 1e9))
+
+
+class CatalogVerb(VerbExtension):
+    """Index bag directories into a catalog and find bags by topic and time."""
+
+    def add_arguments(self, parser, cli_name):  # noqa: D102
+        parser.add_argument(
+            'catalog', help='catalog database file, created if it does not exist')
+        parser.add_argument(
+            '-i', '--index', nargs='+', default=[], metavar='DIRECTORY',
+            help='directories to search for bags and add to the catalog. '
+                 'Bags which are already indexed are only read again if their metadata changed')
+        parser.add_argument(
+            '-t', '--topics', nargs='+', default=[],
+            help='only list bags with messages on any of these topics')
+        parser.add_argument(
+            '--start', type=seconds_to_nanoseconds, default=None,
+            help='only list bags with messages from this time on, in seconds since epoch')
+        parser.add_argument(
+            '--end', type=seconds_to_nanoseconds, default=None,
+            help='only list bags with messages up to this time, in seconds since epoch')
+
+    def main(self, *, args):  # noqa: D102
+        # Import on demand, see the note in the info verb
+        from rosbag2_py._catalog import BagCatalog, BagCatalogQuery
+
+        try:
+            catalog = BagCatalog(args.catalog)
+            for directory in args.index:
+                if not os.path.isdir(directory):
+                    return print_error("'{}' is not a directory".format(directory))
+                indexed = catalog.index(directory)
+                print('Indexed {} new or changed bags in {}'.format(indexed, directory))
+        except RuntimeError as e:
+            return print_error(str(e))
+
+        if args.index and not (args.topics or args.start is not None or args.end is not None):
+            return
+
+        query = BagCatalogQuery(topics=args.topics)
+        if args.start is not None:
+            query.start_time = args.start
+        if args.end is not None:
+            query.end_time = args.end
+        for entry in catalog.query(query):
+            print('{} ({:.3f} - {:.3f}) | Size: {} B'.format(
+                entry.uri, entry.start_time / 1e9, entry.end_time / 1e9, entry.size))
+            for topic in entry.topics:
+                print('  Topic: {} | Type: {} | Count: {}'.format(
+                    topic.topic_metadata.name, topic.topic_metadata.type, topic.message_count))
+            for file, size in zip(entry.files, entry.file_sizes):
+                print('  File: {} | Size: {} B'.format(file.path, size))
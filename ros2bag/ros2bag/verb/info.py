@@ -27,6 +27,20 @@ class InfoVerb(VerbExtension):
             '-s', '--storage', default='sqlite3',
             help='storage identifier to be used to open storage, if no yaml file exists.'
                  ' Defaults to "sqlite3"')
+        parser.add_argument(
+            '--deep', action='store_true',
+            help='also scan all messages of the bag for per topic message sizes, periods and gaps')
+        parser.add_argument(
+            '--gap-factor', type=float, default=5.0,
+            help='with --deep, report periods longer than this factor times the mean period of '
+                 'a topic as gaps. Defaults to 5.0')
+        parser.add_argument(
+            '--max-gaps', type=int, default=10,
+            help='with --deep, number of gaps listed per topic. Defaults to 10')
+        parser.add_argument(
+            '--threads', type=int, default=0,
+            help='with --deep, number of bag files scanned concurrently. '
+                 'Defaults to 0, the number of CPU cores')
 
     def main(self, *, args):  # noqa: D102
         bag_file = args.bag_file
@@ -37,12 +51,22 @@ class InfoVerb(VerbExtension):
         #               may result in DLL loading failures when attempting to import a C
         #               extension. Therefore, do not import rosbag2_transport at the module
         #               level but on demand, right before first use.
-        from rosbag2_py._info import Info
+        from rosbag2_py._info import BagStatisticsOptions, Info
+        info = Info()
         try:
-            m = Info().read_metadata(bag_file, args.storage)
+            m = info.read_metadata(bag_file, args.storage)
             print(m)
         except RuntimeError:
             return ('Could not read metadata for {}.'
                     'Please specify the path to the folder containing '
                     "an existing 'metadata.yaml' file or provide correct storage id "
                     "if metadata file doesn't exist (see help).".format(bag_file))
+        if args.deep:
+            options = BagStatisticsOptions(
+                gap_factor=args.gap_factor,
+                max_gaps_per_topic=args.max_gaps,
+                num_threads=args.threads)
+            try:
+                print(info.read_statistics(bag_file, args.storage, options))
+            except RuntimeError as e:
+                return 'Could not read statistics for {}: {}'.format(bag_file, e)
@@ -19,6 +19,7 @@ from ros2bag.api import check_not_negative_int
 from ros2bag.api import check_path_exists
 from ros2bag.api import check_positive_float
 from ros2bag.api import convert_yaml_to_qos_profile
+from ros2bag.api import convert_yaml_to_thread_options
 from ros2bag.api import print_error
 from ros2bag.verb import VerbExtension
 from ros2cli.node import NODE_NAME_PREFIX
@@ -62,6 +63,10 @@ class PlayVerb(VerbExtension):
         parser.add_argument(
             '--qos-profile-overrides-path', type=FileType('r'),
             help='Path to a yaml file defining overrides of the QoS profile for specific topics.')
+        parser.add_argument(
+            '--thread-options-path', type=FileType('r'),
+            help='Path to a yaml file defining CPU affinity, nice level or SCHED_FIFO priority '
+                 'of the player threads, by thread class: player_loader and playback.')
         parser.add_argument(
             '-l', '--loop', action='store_true',
             help='enables loop playback when playing a bagfile: it starts back at the beginning '
@@ -138,6 +143,17 @@ class PlayVerb(VerbExtension):
                  'By default, if loaned message can be used, messages are published as loaned '
                  'message. It can help to reduce the number of data copies, so there is a greater '
                  'benefit for sending big data.')
+        parser.add_argument(
+            '--flow-control-window', type=check_not_negative_int, default=0,
+            help='Enable flow-controlled playback: publish messages as fast as consumers '
+                 'acknowledge them on the "~/ack" topic, ignoring recorded timing, and keep at '
+                 'most this many messages in flight. Default is 0, which disables flow control.',
+            metavar='NUM_MESSAGES')
+        parser.add_argument(
+            '--flow-control-consumers', type=str, default=[], nargs='+',
+            help='Identifiers of the consumers which must acknowledge every message when flow '
+                 'control is enabled. If none specified, acknowledgements from all consumers are '
+                 'counted together.')
         parser.add_argument(
             '-f', '--duration', type=float, default=None,
             help='Play for SEC seconds. Default is None, meaning that playback will continue '
@@ -161,6 +177,14 @@ class PlayVerb(VerbExtension):
             except (InvalidQoSProfileException, ValueError) as e:
                 return print_error(str(e))
 
+        thread_options = {}
+        if args.thread_options_path:
+            try:
+                thread_options = convert_yaml_to_thread_options(
+                    yaml.safe_load(args.thread_options_path), ['player_loader', 'playback'])
+            except ValueError as e:
+                return print_error(str(e))
+
         storage_config_file = ''
         if args.storage_config_file:
             storage_config_file = args.storage_config_file.name
@@ -193,6 +217,9 @@ class PlayVerb(VerbExtension):
         play_options.start_offset = args.start_offset
         play_options.wait_acked_timeout = args.wait_for_all_acked
         play_options.disable_loan_message = args.disable_loan_message
+        play_options.flow_control_window = args.flow_control_window
+        play_options.flow_control_consumers = args.flow_control_consumers
+        play_options.thread_options = thread_options
 
         player = Player()
         player.play(storage_options, play_options)
@@ -17,7 +17,9 @@ import datetime
 import os
 
 from rclpy.qos import InvalidQoSProfileException
+from ros2bag.api import check_not_negative_int
 from ros2bag.api import convert_yaml_to_qos_profile
+from ros2bag.api import convert_yaml_to_thread_options
 from ros2bag.api import print_error
 from ros2bag.verb import VerbExtension
 from ros2cli.node import NODE_NAME_PREFIX
@@ -27,9 +29,24 @@ from rosbag2_py import get_registered_writers
 from rosbag2_py import Recorder
 from rosbag2_py import RecordOptions
 from rosbag2_py import StorageOptions
+from rosbag2_py import TopicThrottleOptions
 import yaml
 
 
+def _split_topic_values(topic_values, value_type):
+    for topic_value in topic_values:
+        topic, separator, value = topic_value.rpartition(':')
+        if not separator or not topic:
+            raise ValueError("Invalid argument '{}', expected TOPIC:VALUE".format(topic_value))
+        try:
+            parsed_value = value_type(value)
+        except ValueError:
+            raise ValueError("Invalid value in '{}'".format(topic_value))
+        if parsed_value < 0:
+            raise ValueError("Negative value in '{}'".format(topic_value))
+        yield topic, parsed_value
+
+
 class RecordVerb(VerbExtension):
     """Record ROS data to a bag."""
 
@@ -87,7 +104,9 @@ class RecordVerb(VerbExtension):
                  'startup will be recorded')
         parser.add_argument(
             '-p', '--polling-interval', type=int, default=100,
-            help='time in ms to wait between querying available topics for recording. '
+            help='minimum time in ms between queries of the available topics for recording. '
+                  'Topics are queried when the ROS graph changes, and every 50 intervals '
+                  'otherwise. '
                   'It has no effect if --no-discovery is enabled.'
         )
         parser.add_argument(
@@ -136,6 +155,17 @@ class RecordVerb(VerbExtension):
             help='Enable snapshot mode. Messages will not be written to the bagfile until '
                  'the "/rosbag2_recorder/snapshot" service is called.'
         )
+        parser.add_argument(
+            '--index-header-stamps', action='store_true',
+            help='Index the header stamp of messages whose type starts with a std_msgs/Header, '
+                 'so that they can be read back filtered by header stamp.'
+        )
+        parser.add_argument(
+            '--rate-overview-bucket-duration', type=check_not_negative_int, default=1000,
+            help='Duration in milliseconds of the buckets of the per topic message rate overview '
+                 'stored in the bag metadata. Buckets are coarsened for long recordings. '
+                 'Default: %(default)d, 0 disables the overview.'
+        )
         parser.add_argument(
             '--ignore-leaf-topics', action='store_true',
             help='Ignore topics without a publisher.'
@@ -144,6 +174,12 @@ class RecordVerb(VerbExtension):
             '--qos-profile-overrides-path', type=FileType('r'),
             help='Path to a yaml file defining overrides of the QoS profile for specific topics.'
         )
+        parser.add_argument(
+            '--thread-options-path', type=FileType('r'),
+            help='Path to a yaml file defining CPU affinity, nice level or SCHED_FIFO priority '
+                 'of the recorder threads, by thread class: cache_consumer, compression, '
+                 'discovery and event_publisher.'
+        )
         parser.add_argument(
             '--storage-preset-profile', type=str, default='none', choices=['none', 'resilient'],
             help='Select a configuration preset for storage.'
@@ -160,6 +196,57 @@ class RecordVerb(VerbExtension):
                  'write:'
                  '  pragmas: [\"<setting_name>\" = <setting_value>]'
                  'For a list of sqlite3 settings, refer to sqlite3 documentation')
+        parser.add_argument(
+            '--callback-group-policy', type=str, default='default',
+            choices=['default', 'per_topic', 'reentrant'],
+            help="Callback groups of the subscriptions. 'default' serializes all topics through "
+                 "the node's default group, 'per_topic' gives every topic its own mutually "
+                 "exclusive group and 'reentrant' lets all callbacks run in parallel, which may "
+                 "write messages of one topic out of order. Only has an effect together with "
+                 "--executor-threads. Callbacks still write to the bag one at a time. "
+                 "Default is 'default'.")
+        parser.add_argument(
+            '--topic-callback-groups', type=str, default=[], nargs='+', metavar='TOPIC:GROUP',
+            help='Assign topics to named callback groups. Topics in the same group are handled '
+                 'one at a time, topics in different groups in parallel. Takes precedence over '
+                 '--callback-group-policy.')
+        parser.add_argument(
+            '--executor-threads', type=check_not_negative_int, default=1,
+            help='Number of threads handling subscription callbacks. '
+                 'Default is 1, 0 is interpreted as the number of CPU cores.')
+        parser.add_argument(
+            '--max-rate', type=str, default=[], nargs='+', metavar='TOPIC:HZ',
+            help='Record at most this average rate of messages from the topic. Messages above '
+                 'the rate are dropped before they are written.')
+        parser.add_argument(
+            '--keep-every-nth', type=str, default=[], nargs='+', metavar='TOPIC:N',
+            help='Record only every N-th message received on the topic.')
+        parser.add_argument(
+            '--min-interval', type=str, default=[], nargs='+', metavar='TOPIC:SECONDS',
+            help='Minimum time between two recorded messages of the topic.')
+        parser.add_argument(
+            '--content-filter', type=str, default=[], nargs='+', metavar='TOPIC:CONDITION',
+            help='Record only messages of the topic whose field satisfies the condition, '
+                 'e.g. "/diagnostics_agg:status[0].level >= 1". A condition compares a numeric '
+                 'or boolean field with a number using ==, !=, <, <=, > or >=. Messages must '
+                 'satisfy all conditions given for their topic.')
+        parser.add_argument(
+            '--statistics-period', type=check_not_negative_int, default=0,
+            help='Period in ms of the recording statistics published on '
+                 '~/statistics as rosbag2_interfaces/msg/RecorderStatistics. '
+                 'Default is 0, which disables the statistics.')
+        parser.add_argument(
+            '--history-budget', type=check_not_negative_int, default=0,
+            help='Time span in ms of messages the subscription of each topic should be able to '
+                 'hold while the recorder is busy. The history depth is sized from the observed '
+                 'rate of the topic, subscriptions are replaced when the rate changes. '
+                 'Topics with QoS overrides and transient local topics keep their depth. '
+                 'Has no effect with --no-discovery. '
+                 'Default is 0, which keeps the default history depth.')
+        parser.add_argument(
+            '--max-history-depth', type=check_not_negative_int, default=10000,
+            help='Upper bound of the history depth sized from --history-budget. '
+                 'Default is 10000.')
         parser.add_argument(
             '--start-paused', action='store_true', default=False,
             help='Start the recorder in a paused state.')
@@ -198,6 +285,35 @@ class RecordVerb(VerbExtension):
 
         args.compression_mode = args.compression_mode.upper()
 
+        topic_callback_groups = {}
+        for topic_and_group in args.topic_callback_groups:
+            topic, separator, group = topic_and_group.rpartition(':')
+            if not separator or not topic or not group:
+                return print_error(
+                    "Invalid topic callback group '{}', expected TOPIC:GROUP".format(
+                        topic_and_group))
+            topic_callback_groups[topic] = group
+
+        topic_throttles = {}
+        try:
+            for topic, value in _split_topic_values(args.max_rate, float):
+                topic_throttles.setdefault(topic, TopicThrottleOptions()).max_rate = value
+            for topic, value in _split_topic_values(args.keep_every_nth, int):
+                topic_throttles.setdefault(topic, TopicThrottleOptions()).keep_every_nth = value
+            for topic, value in _split_topic_values(args.min_interval, float):
+                topic_throttles.setdefault(topic, TopicThrottleOptions()).min_interval = \
+                    datetime.timedelta(seconds=value)
+        except ValueError as e:
+            return print_error(str(e))
+
+        topic_content_filters = {}
+        for topic_and_condition in args.content_filter:
+            topic, separator, condition = topic_and_condition.partition(':')
+            if not separator or not topic or not condition.strip():
+                return print_error(
+                    "Invalid argument '{}', expected TOPIC:CONDITION".format(topic_and_condition))
+            topic_content_filters.setdefault(topic, []).append(condition)
+
         qos_profile_overrides = {}  # Specify a valid default
         if args.qos_profile_overrides_path:
             qos_profile_dict = yaml.safe_load(args.qos_profile_overrides_path)
@@ -207,6 +323,15 @@ class RecordVerb(VerbExtension):
             except (InvalidQoSProfileException, ValueError) as e:
                 return print_error(str(e))
 
+        thread_options = {}
+        if args.thread_options_path:
+            try:
+                thread_options = convert_yaml_to_thread_options(
+                    yaml.safe_load(args.thread_options_path),
+                    ['cache_consumer', 'compression', 'discovery', 'event_publisher'])
+            except ValueError as e:
+                return print_error(str(e))
+
         storage_config_file = ''
         if args.storage_config_file:
             storage_config_file = args.storage_config_file.name
@@ -219,7 +344,9 @@ class RecordVerb(VerbExtension):
             max_cache_size=args.max_cache_size,
             storage_preset_profile=args.storage_preset_profile,
             storage_config_uri=storage_config_file,
-            snapshot_mode=args.snapshot_mode
+            snapshot_mode=args.snapshot_mode,
+            index_header_stamps=args.index_header_stamps,
+            rate_overview_bucket_duration=args.rate_overview_bucket_duration
         )
         record_options = RecordOptions()
         record_options.all = args.all
@@ -241,6 +368,17 @@ class RecordVerb(VerbExtension):
         record_options.start_paused = args.start_paused
         record_options.ignore_leaf_topics = args.ignore_leaf_topics
         record_options.use_sim_time = args.use_sim_time
+        record_options.callback_group_policy = args.callback_group_policy
+        record_options.topic_callback_groups = topic_callback_groups
+        record_options.num_executor_threads = args.executor_threads
+        record_options.topic_throttles = topic_throttles
+        record_options.topic_content_filters = topic_content_filters
+        record_options.statistics_publish_period = datetime.timedelta(
+            milliseconds=args.statistics_period)
+        record_options.subscription_history_budget = datetime.timedelta(
+            milliseconds=args.history_budget)
+        record_options.max_subscription_history_depth = args.max_history_depth
+        record_options.thread_options = thread_options
 
         recorder = Recorder()
 
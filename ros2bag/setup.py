@@ -39,6 +39,7 @@ The package provides the rosbag command for the ROS 2 command line tools.""",
         ],
         'ros2bag.verb': [
             'burst = ros2bag.verb.burst:BurstVerb',
+            'catalog = ros2bag.verb.catalog:CatalogVerb',
             'convert = ros2bag.verb.convert:ConvertVerb',
             'info = ros2bag.verb.info:InfoVerb',
             'list = ros2bag.verb.list:ListVerb',
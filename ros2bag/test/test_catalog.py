@@ -0,0 +1,84 @@
+# Copyright 2022 Open Source Robotics Foundation, Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import contextlib
+from pathlib import Path
+import tempfile
+import unittest
+
+from launch import LaunchDescription
+from launch.actions import ExecuteProcess
+import launch_testing
+import launch_testing.actions
+import launch_testing.asserts
+import launch_testing.markers
+import launch_testing.tools
+
+import pytest
+
+
+RESOURCES_PATH = Path(__file__).parent / 'resources'
+
+
+@pytest.mark.rostest
+@launch_testing.markers.keep_alive
+def generate_test_description():
+    return LaunchDescription([launch_testing.actions.ReadyToTest()])
+
+
+class TestRos2BagCatalog(unittest.TestCase):
+
+    @classmethod
+    def setUpClass(cls, launch_service, proc_info, proc_output):
+        @contextlib.contextmanager
+        def launch_bag_command(self, arguments, **kwargs):
+            pkg_command_action = ExecuteProcess(
+                cmd=['ros2', 'bag', *arguments],
+                additional_env={'PYTHONUNBUFFERED': '1'},
+                name='ros2bag-cli',
+                output='screen',
+                **kwargs
+            )
+            with launch_testing.tools.launch_process(
+                    launch_service, pkg_command_action, proc_info, proc_output
+            ) as pkg_command:
+                yield pkg_command
+        cls.launch_bag_command = launch_bag_command
+
+    def test_index_and_query(self):
+        """Test indexing a directory of bags and listing them."""
+        with tempfile.TemporaryDirectory() as temp_dir:
+            catalog_path = (Path(temp_dir) / 'catalog.db3').as_posix()
+
+            arguments = ['catalog', catalog_path, '--index', RESOURCES_PATH.as_posix()]
+            with self.launch_bag_command(arguments=arguments) as bag_command:
+                bag_command.wait_for_shutdown(timeout=5)
+            assert bag_command.exit_code == launch_testing.asserts.EXIT_OK
+            assert 'Indexed 1 new or changed bags' in bag_command.output, \
+                'ros2bag CLI did not index the bag'
+
+            arguments = ['catalog', catalog_path]
+            with self.launch_bag_command(arguments=arguments) as bag_command:
+                bag_command.wait_for_shutdown(timeout=5)
+            assert bag_command.exit_code == launch_testing.asserts.EXIT_OK
+            assert (RESOURCES_PATH / 'empty_bag').as_posix() in bag_command.output, \
+                'ros2bag CLI did not list the bag'
+            assert 'Topic: /rosout' in bag_command.output
+
+            # The bag has no messages on any topic
+            arguments = ['catalog', catalog_path, '--topics', '/rosout']
+            with self.launch_bag_command(arguments=arguments) as bag_command:
+                bag_command.wait_for_shutdown(timeout=5)
+            assert bag_command.exit_code == launch_testing.asserts.EXIT_OK
+            assert 'empty_bag' not in bag_command.output
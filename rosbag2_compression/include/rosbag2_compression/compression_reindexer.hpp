@@ -0,0 +1,97 @@
+// Copyright 2022 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROSBAG2_COMPRESSION__COMPRESSION_REINDEXER_HPP_
+#define ROSBAG2_COMPRESSION__COMPRESSION_REINDEXER_HPP_
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "rcpputils/filesystem_helper.hpp"
+
+#include "rosbag2_cpp/reindexer.hpp"
+
+#include "rosbag2_storage/bag_metadata.hpp"
+#include "rosbag2_storage/metadata_io.hpp"
+#include "rosbag2_storage/storage_factory.hpp"
+#include "rosbag2_storage/storage_factory_interface.hpp"
+#include "rosbag2_storage/storage_interfaces/read_only_interface.hpp"
+#include "rosbag2_storage/storage_options.hpp"
+
+#include "base_decompressor_interface.hpp"
+#include "compression_factory.hpp"
+#include "visibility_control.hpp"
+
+#ifdef _WIN32
+# pragma warning(push)
+# pragma warning(disable:4251)
+#endif
+
+namespace rosbag2_compression
+{
+
+/**
+ * Reindexer which also reconstructs the metadata of compressed bags.
+ *
+ * Files whose last extension is a known compression format are FILE compressed. They are
+ * decompressed next to the compressed file to read their metadata, and the decompressed file is
+ * removed afterwards unless it was already there.
+ *
+ * MESSAGE compression leaves no trace in the storage, so it is detected from the first message of
+ * each file: if a CDR message doesn't start with a CDR encapsulation header, the compression
+ * format is the first one, in alphabetical order, which decompresses it into one.
+ */
+class ROSBAG2_COMPRESSION_PUBLIC CompressionReindexer : public rosbag2_cpp::Reindexer
+{
+public:
+  explicit CompressionReindexer(
+    std::unique_ptr<rosbag2_compression::CompressionFactory> compression_factory =
+    std::make_unique<rosbag2_compression::CompressionFactory>(),
+    std::unique_ptr<rosbag2_storage::StorageFactoryInterface> storage_factory =
+    std::make_unique<rosbag2_storage::StorageFactory>(),
+    std::unique_ptr<rosbag2_storage::MetadataIo> metadata_io =
+    std::make_unique<rosbag2_storage::MetadataIo>());
+
+  virtual ~CompressionReindexer() = default;
+
+protected:
+  rosbag2_storage::BagMetadata get_file_metadata(
+    const rcpputils::fs::path & file,
+    const rosbag2_storage::StorageOptions & storage_options) override;
+
+private:
+  // Thread safe wrapper of compression_factory_->create_decompressor
+  std::shared_ptr<BaseDecompressorInterface> create_decompressor(const std::string & format);
+
+  // Compression format of a FILE compressed bag file, empty if the file is not compressed
+  std::string get_file_compression_format(const rcpputils::fs::path & file);
+
+  // Sets the MESSAGE compression of metadata if the first message of storage is compressed
+  void detect_message_compression(
+    const rcpputils::fs::path & file,
+    rosbag2_storage::storage_interfaces::ReadOnlyInterface & storage,
+    rosbag2_storage::BagMetadata & metadata);
+
+  std::unique_ptr<rosbag2_compression::CompressionFactory> compression_factory_{};
+  std::mutex compression_factory_mutex_;
+};
+
+}  // namespace rosbag2_compression
+
+#ifdef _WIN32
+# pragma warning(pop)
+#endif
+
+#endif  // ROSBAG2_COMPRESSION__COMPRESSION_REINDEXER_HPP_
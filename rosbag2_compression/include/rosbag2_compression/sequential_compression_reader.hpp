@@ -67,6 +67,16 @@ public:
 
   std::shared_ptr<rosbag2_storage::SerializedBagMessage> read_next() override;
 
+  /**
+   * Return messages of a MESSAGE compressed bag as they are stored, without decompressing them.
+   * Meant to copy compressed messages into a bag with the same compression settings.
+   * Has no effect on FILE compressed bags.
+   *
+   * \param passthrough true to skip decompression of messages
+   * \throws std::runtime_error if passthrough is requested while messages are converted
+   */
+  void set_compressed_message_passthrough(bool passthrough);
+
 protected:
   /**
    * Decompress the current bagfile so that it can be opened by the storage implementation.
@@ -90,6 +100,8 @@ private:
   std::unique_ptr<rosbag2_compression::CompressionFactory> compression_factory_{};
 
   rosbag2_storage::StorageOptions storage_options_;
+
+  bool compressed_message_passthrough_{false};
 };
 
 }  // namespace rosbag2_compression
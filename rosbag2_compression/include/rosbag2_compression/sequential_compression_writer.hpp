@@ -119,6 +119,21 @@ public:
    */
   void close() override;
 
+  /**
+   * Adds the messages dropped from the compression queue to the statistics of SequentialWriter.
+   */
+  rosbag2_cpp::WriterStatistics get_statistics() override;
+
+  /**
+   * Write messages as they are given, because they are already compressed with the compression
+   * format of this writer. Meant to copy messages of a MESSAGE compressed bag with the same
+   * compression format. Has no effect in FILE compression mode.
+   *
+   * \param passthrough true to skip compression of messages
+   * \throws std::runtime_error if passthrough is requested while messages are converted
+   */
+  void set_compressed_message_passthrough(bool passthrough);
+
 protected:
   /**
    * Compress a file and update the metadata file path.
@@ -167,6 +182,11 @@ protected:
    */
   virtual void stop_compressor_threads();
 
+  /**
+   * In MESSAGE mode, header stamps are indexed by write() before the message is compressed.
+   */
+  void index_header_stamp(rosbag2_storage::SerializedBagMessage & message) const override;
+
 private:
   std::shared_ptr<rosbag2_compression::BaseCompressorInterface> compressor_{};
   std::unique_ptr<rosbag2_compression::CompressionFactory> compression_factory_{};
@@ -174,6 +194,8 @@ private:
   std::queue<std::shared_ptr<rosbag2_storage::SerializedBagMessage>>
   compressor_message_queue_ RCPPUTILS_TSA_GUARDED_BY(compressor_queue_mutex_);
   std::queue<std::string> compressor_file_queue_ RCPPUTILS_TSA_GUARDED_BY(compressor_queue_mutex_);
+  std::unordered_map<std::string, uint64_t> compressor_messages_dropped_
+  RCPPUTILS_TSA_GUARDED_BY(compressor_queue_mutex_);
   std::vector<std::thread> compression_threads_;
   /* *INDENT-OFF* */  // uncrustify doesn't understand the macro + brace initializer
   std::atomic_bool compression_is_running_
@@ -181,11 +203,15 @@ private:
   /* *INDENT-ON* */
   std::recursive_mutex storage_mutex_;
   std::condition_variable compressor_condition_;
+  // Signals free space in compressor_message_queue_ to writers blocking on a full queue
+  std::condition_variable compressor_queue_space_condition_;
 
   rosbag2_compression::CompressionOptions compression_options_{};
 
   bool should_compress_last_file_{true};
 
+  bool compressed_message_passthrough_{false};
+
   // Runs a while loop that pulls data from the compression queue until
   // compression_is_running_ is false; should be run in a separate thread
   void compression_thread_fn();
@@ -0,0 +1,164 @@
+// Copyright 2022 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "rcpputils/scope_exit.hpp"
+
+#include "rosbag2_compression/compression_options.hpp"
+#include "rosbag2_compression/compression_reindexer.hpp"
+
+#include "rosbag2_storage/ros_helper.hpp"
+#include "rosbag2_storage/serialized_bag_message.hpp"
+
+#include "logging.hpp"
+
+namespace
+{
+// A CDR encapsulation header starts with the zero high byte of the representation identifier,
+// followed by two option bytes, the first of which is always zero.
+// Compressed data starts with the magic number of its format instead.
+bool looks_like_cdr(const rcutils_uint8_array_t & data)
+{
+  return data.buffer_length >= 4 && data.buffer[0] == 0 && data.buffer[2] == 0;
+}
+}  // namespace
+
+namespace rosbag2_compression
+{
+
+CompressionReindexer::CompressionReindexer(
+  std::unique_ptr<rosbag2_compression::CompressionFactory> compression_factory,
+  std::unique_ptr<rosbag2_storage::StorageFactoryInterface> storage_factory,
+  std::unique_ptr<rosbag2_storage::MetadataIo> metadata_io)
+: Reindexer(std::move(storage_factory), std::move(metadata_io)),
+  compression_factory_(std::move(compression_factory))
+{}
+
+std::shared_ptr<BaseDecompressorInterface> CompressionReindexer::create_decompressor(
+  const std::string & format)
+{
+  std::lock_guard<std::mutex> lock(compression_factory_mutex_);
+  return compression_factory_->create_decompressor(format);
+}
+
+std::string CompressionReindexer::get_file_compression_format(const rcpputils::fs::path & file)
+{
+  auto extension = file.extension().string();
+  if (extension.empty()) {
+    return "";
+  }
+  extension = extension.substr(1);
+
+  std::lock_guard<std::mutex> lock(compression_factory_mutex_);
+  const auto formats = compression_factory_->get_declared_compressor_plugins();
+  if (std::find(formats.begin(), formats.end(), extension) == formats.end()) {
+    return "";
+  }
+  return extension;
+}
+
+void CompressionReindexer::detect_message_compression(
+  const rcpputils::fs::path & file,
+  rosbag2_storage::storage_interfaces::ReadOnlyInterface & storage,
+  rosbag2_storage::BagMetadata & metadata)
+{
+  if (!storage.has_next()) {
+    return;
+  }
+  const auto message = storage.read_next();
+  const auto topic = std::find_if(
+    metadata.topics_with_message_count.begin(), metadata.topics_with_message_count.end(),
+    [&message](const rosbag2_storage::TopicInformation & topic_information) {
+      return topic_information.topic_metadata.name == message->topic_name;
+    });
+  // Only the CDR encapsulation tells compressed from uncompressed messages
+  if (topic == metadata.topics_with_message_count.end() ||
+    topic->topic_metadata.serialization_format != "cdr" ||
+    looks_like_cdr(*message->serialized_data))
+  {
+    return;
+  }
+
+  std::vector<std::string> formats;
+  {
+    std::lock_guard<std::mutex> lock(compression_factory_mutex_);
+    formats = compression_factory_->get_declared_compressor_plugins();
+  }
+  std::sort(formats.begin(), formats.end());
+  for (const auto & format : formats) {
+    auto decompressor = create_decompressor(format);
+    if (!decompressor) {
+      continue;
+    }
+    // Messages are decompressed in place, try each format on a copy
+    rosbag2_storage::SerializedBagMessage candidate = *message;
+    candidate.serialized_data = rosbag2_storage::make_serialized_message(
+      message->serialized_data->buffer, message->serialized_data->buffer_length);
+    try {
+      decompressor->decompress_serialized_bag_message(&candidate);
+    } catch (const std::exception &) {
+      continue;
+    }
+    if (looks_like_cdr(*candidate.serialized_data)) {
+      metadata.compression_format = format;
+      metadata.compression_mode = compression_mode_to_string(CompressionMode::MESSAGE);
+      return;
+    }
+  }
+  ROSBAG2_COMPRESSION_LOG_WARN_STREAM(
+    "The first message of " << file.string() << " is not CDR, but none of the compression " <<
+      "formats decompresses it. Reindexing it as uncompressed.");
+}
+
+rosbag2_storage::BagMetadata CompressionReindexer::get_file_metadata(
+  const rcpputils::fs::path & file,
+  const rosbag2_storage::StorageOptions & storage_options)
+{
+  const auto format = get_file_compression_format(file);
+  if (format.empty()) {
+    auto storage = open_storage(file, storage_options);
+    auto metadata = storage->get_metadata();
+    detect_message_compression(file, *storage, metadata);
+    return metadata;
+  }
+
+  auto decompressor = create_decompressor(format);
+  if (!decompressor) {
+    throw std::runtime_error("Couldn't initialize decompressor for " + file.string());
+  }
+  // A reader of the bag may have left the decompressed file behind, which is not ours to remove
+  const bool decompressed_file_existed = rcpputils::fs::remove_extension(file).exists();
+  ROSBAG2_COMPRESSION_LOG_DEBUG_STREAM("Decompressing " << file.string());
+  const rcpputils::fs::path decompressed_file{decompressor->decompress_uri(file.string())};
+  auto remove_decompressed_file = rcpputils::make_scope_exit(
+    [&decompressed_file, decompressed_file_existed]() {
+      if (!decompressed_file_existed) {
+        rcpputils::fs::remove(decompressed_file);
+      }
+    });
+
+  auto metadata = Reindexer::get_file_metadata(decompressed_file, storage_options);
+  metadata.compression_format = format;
+  metadata.compression_mode = compression_mode_to_string(CompressionMode::FILE);
+  return metadata;
+}
+
+}  // namespace rosbag2_compression
@@ -108,7 +108,9 @@ std::shared_ptr<rosbag2_storage::SerializedBagMessage> SequentialCompressionRead
     // roll over if necessary
     has_next();
     auto message = storage_->read_next();
-    if (compression_mode_ == rosbag2_compression::CompressionMode::MESSAGE) {
+    if (compression_mode_ == rosbag2_compression::CompressionMode::MESSAGE &&
+      !compressed_message_passthrough_)
+    {
       decompressor_->decompress_serialized_bag_message(message.get());
     }
     return converter_ ? converter_->convert(message) : message;
@@ -116,4 +118,12 @@ std::shared_ptr<rosbag2_storage::SerializedBagMessage> SequentialCompressionRead
   throw std::runtime_error{"Bag is not open. Call open() before reading."};
 }
 
+void SequentialCompressionReader::set_compressed_message_passthrough(bool passthrough)
+{
+  if (passthrough && converter_) {
+    throw std::runtime_error{"Compressed messages can't be passed through a converter."};
+  }
+  compressed_message_passthrough_ = passthrough;
+}
+
 }  // namespace rosbag2_compression
@@ -28,6 +28,7 @@
 #include "rcutils/filesystem.h"
 
 #include "rosbag2_cpp/info.hpp"
+#include "rosbag2_cpp/thread_options.hpp"
 
 #include "rosbag2_storage/storage_options.hpp"
 #include "rosbag2_storage/storage_interfaces/read_write_interface.hpp"
@@ -62,6 +63,7 @@ SequentialCompressionWriter::~SequentialCompressionWriter()
 
 void SequentialCompressionWriter::compression_thread_fn()
 {
+  rosbag2_cpp::configure_current_thread(rosbag2_cpp::thread_class::kCompression, thread_options_);
   // Every thread needs to have its own compression context for thread safety.
   auto compressor = compression_factory_->create_compressor(
     compression_options_.compression_format);
@@ -83,6 +85,7 @@ void SequentialCompressionWriter::compression_thread_fn()
       if (!compressor_message_queue_.empty()) {
         message = compressor_message_queue_.front();
         compressor_message_queue_.pop();
+        compressor_queue_space_condition_.notify_one();
       } else if (!compressor_file_queue_.empty()) {
         file = compressor_file_queue_.front();
         compressor_file_queue_.pop();
@@ -164,6 +167,7 @@ void SequentialCompressionWriter::stop_compressor_threads()
       compression_is_running_ = false;
     }
     compressor_condition_.notify_all();
+    compressor_queue_space_condition_.notify_all();
     for (auto & thread : compression_threads_) {
       thread.join();
     }
@@ -312,9 +316,23 @@ void SequentialCompressionWriter::write(
   // by the compression threads.
   if (compression_options_.compression_mode == CompressionMode::FILE) {
     SequentialWriter::write(message);
+  } else if (compressed_message_passthrough_) {
+    std::lock_guard<std::recursive_mutex> storage_lock(storage_mutex_);
+    SequentialWriter::write(message);
   } else {
-    std::lock_guard<std::mutex> lock(compressor_queue_mutex_);
+    // The stamp can't be read from the compressed message later on
+    SequentialWriter::index_header_stamp(*message);
+    std::unique_lock<std::mutex> lock(compressor_queue_mutex_);
+    if (storage_options_.block_on_full_cache) {
+      compressor_queue_space_condition_.wait(
+        lock,
+        [&] {
+          return !compression_is_running_ ||
+          compressor_message_queue_.size() <= compression_options_.compression_queue_size;
+        });
+    }
     while (compressor_message_queue_.size() > compression_options_.compression_queue_size) {
+      compressor_messages_dropped_[compressor_message_queue_.front()->topic_name]++;
       compressor_message_queue_.pop();
     }
     compressor_message_queue_.push(message);
@@ -322,6 +340,30 @@ void SequentialCompressionWriter::write(
   }
 }
 
+void SequentialCompressionWriter::set_compressed_message_passthrough(bool passthrough)
+{
+  if (passthrough && converter_) {
+    throw std::runtime_error{"Compressed messages can't be passed through a converter."};
+  }
+  compressed_message_passthrough_ = passthrough;
+}
+
+void SequentialCompressionWriter::index_header_stamp(
+  rosbag2_storage::SerializedBagMessage & message) const
+{
+  if (compression_options_.compression_mode != CompressionMode::MESSAGE) {
+    SequentialWriter::index_header_stamp(message);
+  }
+}
+
+rosbag2_cpp::WriterStatistics SequentialCompressionWriter::get_statistics()
+{
+  auto statistics = SequentialWriter::get_statistics();
+  std::lock_guard<std::mutex> lock(compressor_queue_mutex_);
+  statistics.messages_dropped_compression_queue = compressor_messages_dropped_;
+  return statistics;
+}
+
 bool SequentialCompressionWriter::should_split_bagfile(
   const std::chrono::time_point<std::chrono::high_resolution_clock> & current_time)
 {
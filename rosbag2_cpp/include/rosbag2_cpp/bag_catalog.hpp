@@ -0,0 +1,155 @@
+// Copyright 2022 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROSBAG2_CPP__BAG_CATALOG_HPP_
+#define ROSBAG2_CPP__BAG_CATALOG_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "rcutils/time.h"
+
+#include "rosbag2_cpp/visibility_control.hpp"
+
+#include "rosbag2_storage/bag_metadata.hpp"
+
+// This is necessary because of using stl types here. It is completely safe, because
+// a) the member is not accessible from the outside
+// b) there are no inline functions.
+#ifdef _WIN32
+# pragma warning(push)
+# pragma warning(disable:4251)
+#endif
+
+struct sqlite3;
+
+namespace rosbag2_cpp
+{
+
+struct BagCatalogQuery
+{
+  // Topic names of interest. Bags match if they contain messages of any of them.
+  // If the list is empty, bags match regardless of their topics.
+  std::vector<std::string> topics;
+
+  // Range of receive timestamps of interest, both bounds included.
+  rcutils_time_point_value_t start_time = INT64_MIN;
+  rcutils_time_point_value_t end_time = INT64_MAX;
+};
+
+/// A bag matching a BagCatalogQuery, restricted to the part of it which matches.
+struct BagCatalogEntry
+{
+  std::string uri;
+  std::string storage_identifier;
+  // Topics of the query contained in the bag, or all topics of the bag if the query has none.
+  std::vector<rosbag2_storage::TopicInformation> topics;
+  // Files of the bag whose time range overlaps the one of the query.
+  std::vector<rosbag2_storage::FileInformation> files;
+  // Sizes in bytes of the files on disk when the bag was indexed, in the order of files.
+  // 0 for files which didn't exist.
+  std::vector<uint64_t> file_sizes;
+  // Size in bytes of the whole bag directory when it was indexed.
+  uint64_t size = 0;
+  // Overlap of the time ranges of the bag and the query.
+  rcutils_time_point_value_t start_time = 0;
+  rcutils_time_point_value_t end_time = 0;
+};
+
+/**
+ * Index of the metadata of many bags in a local database, for fast topic and time lookups.
+ *
+ * Bags are found by their metadata.yaml file, bags without one have to be reindexed first.
+ * Indexing is incremental: a bag is only parsed again when its metadata file changed, and bags
+ * which disappeared from an indexed directory are dropped from the catalog. Sizes are therefore
+ * those of the bag files when its metadata last changed.
+ *
+ * The catalog is a sqlite3 database, queries are answered from its indices without touching
+ * the bags.
+ */
+class ROSBAG2_CPP_PUBLIC BagCatalog
+{
+public:
+  /**
+   * Open the catalog database, creating it if it doesn't exist.
+   *
+   * \param catalog_path Path of the catalog database file.
+   * \throws std::runtime_error if the database can't be opened.
+   */
+  explicit BagCatalog(const std::string & catalog_path);
+
+  ~BagCatalog();
+
+  BagCatalog(const BagCatalog &) = delete;
+  BagCatalog & operator=(const BagCatalog &) = delete;
+
+  /**
+   * Recursively index all bags below a directory.
+   * Symbolic links to directories are not followed, since they may form cycles.
+   *
+   * \param directory Directory to search for bags, which may itself be a bag.
+   * \return Number of bags added or updated in the catalog.
+   * \throws std::runtime_error if the catalog can't be written.
+   */
+  size_t index(const std::string & directory);
+
+  /**
+   * Add a single bag to the catalog, or update it if its metadata changed.
+   *
+   * \param uri Bag directory containing a metadata.yaml file.
+   * \return Whether the bag was added or updated.
+   * \throws std::runtime_error if the bag has no metadata file or the catalog can't be written.
+   */
+  bool index_bag(const std::string & uri);
+
+  /**
+   * Remove a bag from the catalog.
+   *
+   * \param uri Bag directory as it was indexed.
+   */
+  void remove_bag(const std::string & uri);
+
+  /// Bags matching the query, ordered by start time.
+  std::vector<BagCatalogEntry> query(const BagCatalogQuery & query) const;
+
+  /// Number of bags in the catalog.
+  size_t size() const;
+
+private:
+  // Add or update the bag, within the transaction of the caller. Nothing is changed if it
+  // throws.
+  bool update_bag(const std::string & uri);
+
+  // Insert or replace the bag without checking whether it changed
+  void insert_bag(
+    const std::string & uri,
+    const rosbag2_storage::BagMetadata & metadata,
+    int64_t metadata_modification_time,
+    int64_t metadata_file_size);
+
+  // Add the bags below directory to the catalog, and collect the uris of all found bags
+  size_t index_directory(const std::string & directory, std::vector<std::string> & found_bags);
+
+  sqlite3 * database_ = nullptr;
+};
+
+}  // namespace rosbag2_cpp
+
+#ifdef _WIN32
+# pragma warning(pop)
+#endif
+
+#endif  // ROSBAG2_CPP__BAG_CATALOG_HPP_
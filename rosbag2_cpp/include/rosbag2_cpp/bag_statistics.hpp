@@ -0,0 +1,81 @@
+// Copyright 2022 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROSBAG2_CPP__BAG_STATISTICS_HPP_
+#define ROSBAG2_CPP__BAG_STATISTICS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "rcutils/time.h"
+
+namespace rosbag2_cpp
+{
+
+/// A span of time in which a topic received no message, between two messages of the topic.
+struct TopicGap
+{
+  rcutils_time_point_value_t start = 0;
+  rcutils_time_point_value_t end = 0;
+};
+
+/// Statistics of the messages of one topic, as computed by Info::read_statistics.
+struct TopicStatistics
+{
+  std::string topic_name;
+  uint64_t message_count = 0;
+  /// Sizes of the messages as stored, i.e. compressed for MESSAGE compressed bags.
+  uint64_t total_bytes = 0;
+  uint64_t min_message_size = 0;
+  uint64_t max_message_size = 0;
+  /// Bucket i counts messages of [2^i, 2^(i+1)) bytes, bucket 0 also counts empty messages.
+  std::vector<uint64_t> message_size_histogram;
+  /// Receive timestamps of the first and last message.
+  rcutils_time_point_value_t first_timestamp = 0;
+  rcutils_time_point_value_t last_timestamp = 0;
+  /// Bucket i counts periods between consecutive messages of [2^i, 2^(i+1)) microseconds,
+  /// bucket 0 also counts shorter periods.
+  std::vector<uint64_t> period_histogram;
+  rcutils_duration_value_t min_period = 0;
+  rcutils_duration_value_t max_period = 0;
+  /// Number of periods longer than the gap threshold of the topic, and the first of them.
+  uint64_t gap_count = 0;
+  std::vector<TopicGap> gaps;
+};
+
+/// Per topic statistics of all messages of a bag, topics are ordered by name.
+struct BagStatistics
+{
+  std::vector<TopicStatistics> topics;
+  uint64_t message_count = 0;
+  uint64_t total_bytes = 0;
+};
+
+struct BagStatisticsOptions
+{
+  /// A period is a gap when it is longer than gap_factor times the mean period of the topic,
+  /// which is estimated from the message count of the topic over the time between its first and
+  /// last message.
+  double gap_factor = 5.0;
+  /// Number of gaps kept per topic, further gaps are only counted.
+  size_t max_gaps_per_topic = 10;
+  /// Number of files scanned concurrently, 0 for the number of CPU cores.
+  size_t num_threads = 0;
+};
+
+}  // namespace rosbag2_cpp
+
+#endif  // ROSBAG2_CPP__BAG_STATISTICS_HPP_
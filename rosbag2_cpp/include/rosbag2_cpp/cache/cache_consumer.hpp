@@ -25,6 +25,7 @@
 #include "rosbag2_cpp/cache/cache_buffer_interface.hpp"
 #include "rosbag2_cpp/cache/message_cache.hpp"
 #include "rosbag2_cpp/cache/message_cache_interface.hpp"
+#include "rosbag2_cpp/thread_options.hpp"
 
 // This is necessary because of using stl types here. It is completely safe, because
 // a) the member is not accessible from the outside
@@ -65,9 +66,11 @@ public:
   using consume_callback_function_t = std::function<void (const
       std::vector<CacheBufferInterface::buffer_element_t> &)>;
 
+  /// \param thread_options applied to the consumer thread, see thread_class::kCacheConsumer
   CacheConsumer(
     std::shared_ptr<MessageCacheInterface> message_cache,
-    consume_callback_function_t consume_callback);
+    consume_callback_function_t consume_callback,
+    const ThreadOptionsMap & thread_options = {});
 
   ~CacheConsumer();
 
@@ -80,6 +83,7 @@ public:
 private:
   std::shared_ptr<MessageCacheInterface> message_cache_;
   consume_callback_function_t consume_callback_;
+  ThreadOptionsMap thread_options_;
 
   /// Write buffer data to a storage
   void exec_consuming();
@@ -66,16 +66,20 @@ namespace cache
 * The cache holds infomation about dropped messages (per topic). These are
 * messages that were pushed to the cache when it was full. Such situation signals
 * performance issues, most likely with the CacheConsumer consumer callback.
+*
+* With block_on_full, the producer instead waits for the consumer to swap buffers when
+* the producer buffer is full. Messages are then only dropped while flushing.
 */
 class ROSBAG2_CPP_PUBLIC MessageCache
   : public MessageCacheInterface
 {
 public:
-  explicit MessageCache(size_t max_buffer_size);
+  explicit MessageCache(size_t max_buffer_size, bool block_on_full = false);
 
   ~MessageCache() override;
 
-  /// Puts msg into primary buffer. With full cache, msg is ignored and counted as lost
+  /// Puts msg into primary buffer. With full cache, msg is ignored and counted as lost,
+  /// or the call blocks until the buffers were swapped if the cache blocks on full.
   void push(std::shared_ptr<const rosbag2_storage::SerializedBagMessage> msg) override;
 
   /// Gets a consumer buffer.
@@ -108,11 +112,16 @@ public:
   /// Summarize dropped/remaining messages
   void log_dropped() override;
 
+  std::unordered_map<std::string, uint64_t> get_dropped_messages_per_topic() override;
+
+  size_t get_producer_buffer_bytes() override;
+
   /// Producer API: notify consumer to wake-up (primary buffer has data)
   void notify_data_ready() override;
 
 protected:
-  /// Dropped messages per topic. Used for printing in alphabetic order
+  /// Dropped messages per topic. Used for printing in alphabetic order.
+  /// Guarded by producer_buffer_mutex_ while the cache is in use.
   std::unordered_map<std::string, uint32_t> messages_dropped_per_topic_;
 
 private:
@@ -126,6 +135,10 @@ private:
   bool data_ready_ {false};
   std::condition_variable cache_condition_var_;
 
+  /// Producers blocked on a full cache wait for the next swap
+  const bool block_on_full_;
+  std::condition_variable buffers_swapped_condition_var_;
+
   /// Cache is no longer accepting messages and is in the process of flushing
   std::atomic_bool flushing_ {false};
 };
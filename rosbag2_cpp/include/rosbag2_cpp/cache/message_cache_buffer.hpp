@@ -64,6 +64,9 @@ public:
   /// Get number of elements in the buffer
   size_t size() override;
 
+  /// Get the total size of the serialized messages in the buffer
+  size_t bytes_size() const;
+
   /// Get buffer data
   const std::vector<CacheBufferInterface::buffer_element_t> & data() override;
 
@@ -15,7 +15,10 @@
 #ifndef ROSBAG2_CPP__CACHE__MESSAGE_CACHE_INTERFACE_HPP_
 #define ROSBAG2_CPP__CACHE__MESSAGE_CACHE_INTERFACE_HPP_
 
+#include <cstdint>
 #include <memory>
+#include <string>
+#include <unordered_map>
 
 #include "rosbag2_cpp/visibility_control.hpp"
 #include "rosbag2_cpp/cache/cache_buffer_interface.hpp"
@@ -70,6 +73,18 @@ public:
   /// Print a log message with details of any dropped messages.
   virtual void log_dropped() {}
 
+  /// Get the number of messages per topic which were dropped because the cache was full.
+  virtual std::unordered_map<std::string, uint64_t> get_dropped_messages_per_topic()
+  {
+    return {};
+  }
+
+  /// Get the number of bytes held in the producer buffer, waiting to be consumed.
+  virtual size_t get_producer_buffer_bytes()
+  {
+    return 0;
+  }
+
   /// \brief Producer API: notify wait_for_data() to wake up and unblock consumer thread.
   virtual void notify_data_ready() {}
 };
@@ -26,6 +26,9 @@ namespace rosbag2_cpp
 /**
  * Version of the PlayerClock interface that has control over time.
  * It does not listen to any ROS time source, instead using an internal steady time.
+ *
+ * Queries (`now`, `get_rate`, `is_paused`) are lock-free and never contend with each other or
+ * with `sleep_until`; only state changes (pause, resume, set_rate, jump) take the internal lock.
  */
 class TimeControllerClockImpl;
 class TimeControllerClock : public PlayerClock
@@ -0,0 +1,142 @@
+// Copyright 2022 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROSBAG2_CPP__FIELD_PROJECTION_HPP_
+#define ROSBAG2_CPP__FIELD_PROJECTION_HPP_
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "rcpputils/shared_library.hpp"
+
+#include "rcutils/time.h"
+#include "rcutils/types/uint8_array.h"
+
+#include "rosidl_runtime_cpp/message_type_support_decl.hpp"
+
+#include "rosbag2_cpp/visibility_control.hpp"
+
+// This is necessary because of using stl types here. It is completely safe, because
+// a) the member is not accessible from the outside
+// b) there are no inline functions.
+#ifdef _WIN32
+# pragma warning(push)
+# pragma warning(disable:4251)
+#endif
+
+namespace rosbag2_cpp
+{
+
+class Reader;
+
+/**
+ * \brief Extracts selected scalar fields from CDR serialized messages without deserializing them.
+ *
+ * Field paths are compiled once against the introspection typesupport of the message type.
+ * Extraction then walks the serialized buffer, skipping everything which isn't selected, and
+ * stops after the last selected field.
+ *
+ * A field path is a dot separated list of member names, where array and sequence members are
+ * indexed with brackets, e.g. "pose.pose.position.x" or "transforms[0].transform.translation".
+ * Paths ending in a nested message select all numeric and boolean fields below it, leaving out
+ * strings and sequences. Every selected field is a column, holding its value as a double.
+ */
+class ROSBAG2_CPP_PUBLIC FieldProjection
+{
+public:
+  /**
+   * \param type Full type name of the messages, e.g. nav_msgs/msg/Odometry
+   * \param field_paths Fields to extract
+   * \throws std::runtime_error if the type can't be introspected, or a path doesn't select a
+   *   numeric or boolean field of it.
+   */
+  FieldProjection(const std::string & type, const std::vector<std::string> & field_paths);
+
+  /**
+   * \param introspection_ts Introspection typesupport of the messages, which must outlive the
+   *   projection
+   * \param field_paths Fields to extract
+   * \throws std::runtime_error if a path doesn't select a numeric or boolean field of the type.
+   */
+  FieldProjection(
+    const rosidl_message_type_support_t * introspection_ts,
+    const std::vector<std::string> & field_paths);
+
+  ~FieldProjection();
+
+  FieldProjection(FieldProjection &&);
+  FieldProjection & operator=(FieldProjection &&);
+
+  /// Names of the columns, i.e. the paths of the selected fields.
+  const std::vector<std::string> & names() const;
+
+  /// Number of columns.
+  size_t size() const;
+
+  /**
+   * \brief Extract the selected fields of a message.
+   *
+   * Elements past the end of a sequence are set to NaN.
+   * \param serialized_data Plain CDR serialized message, including the encapsulation header
+   * \param values Set to the value of each column, must hold size() values
+   * \returns false if the message is not plain CDR or is too short for its type
+   */
+  bool extract(const rcutils_uint8_array_t & serialized_data, double * values) const;
+
+private:
+  struct MessagePlan;
+
+  void compile(
+    const rosidl_message_type_support_t * introspection_ts,
+    const std::vector<std::string> & field_paths);
+
+  std::shared_ptr<rcpputils::SharedLibrary> library_;
+  std::vector<std::string> names_;
+  std::unique_ptr<MessagePlan> plan_;
+};
+
+/// Values of projected fields of messages of one topic, stored by column.
+struct ProjectedFields
+{
+  /// Names of the columns, see FieldProjection::names.
+  std::vector<std::string> names;
+  /// Receive timestamps of the messages.
+  std::vector<rcutils_time_point_value_t> time_stamps;
+  /// columns[i][j] is the value of field names[i] in message j.
+  std::vector<std::vector<double>> columns;
+};
+
+/**
+ * \brief Read fields of all remaining messages of a topic into columns.
+ *
+ * Replaces the filter of the reader with one for the topic.
+ * \param reader Open reader of a bag, whose messages of the topic are CDR serialized
+ * \param topic_name Topic to read
+ * \param field_paths Fields to extract, see FieldProjection
+ * \throws std::runtime_error if the topic isn't in the bag or not CDR serialized, the paths don't
+ *   match its type or a message can't be walked.
+ */
+ROSBAG2_CPP_PUBLIC
+ProjectedFields project_fields(
+  Reader & reader, const std::string & topic_name, const std::vector<std::string> & field_paths);
+
+}  // namespace rosbag2_cpp
+
+#ifdef _WIN32
+# pragma warning(pop)
+#endif
+
+#endif  // ROSBAG2_CPP__FIELD_PROJECTION_HPP_
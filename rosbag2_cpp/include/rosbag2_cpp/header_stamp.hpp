@@ -0,0 +1,53 @@
+// Copyright 2022 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROSBAG2_CPP__HEADER_STAMP_HPP_
+#define ROSBAG2_CPP__HEADER_STAMP_HPP_
+
+#include <string>
+
+#include "rcutils/time.h"
+#include "rcutils/types/uint8_array.h"
+
+#include "rosbag2_cpp/visibility_control.hpp"
+
+namespace rosbag2_cpp
+{
+
+/**
+ * \brief Check whether messages of a type start with a std_msgs/msg/Header.
+ *
+ * Uses the introspection typesupport of the type. Types which can't be introspected are
+ * reported as not having a header.
+ * \param type Full type name, e.g. sensor_msgs/msg/Image
+ */
+ROSBAG2_CPP_PUBLIC
+bool type_starts_with_header(const std::string & type);
+
+/**
+ * \brief Read the header stamp of a CDR serialized message without deserializing it.
+ *
+ * Only valid for messages of a type for which type_starts_with_header is true.
+ * \param serialized_data CDR serialized message, including the encapsulation header
+ * \param stamp Set to the header stamp in nanoseconds on success
+ * \returns false if the message is too short to contain a stamp
+ */
+ROSBAG2_CPP_PUBLIC
+bool read_cdr_header_stamp(
+  const rcutils_uint8_array_t & serialized_data, rcutils_time_point_value_t & stamp);
+
+}  // namespace rosbag2_cpp
+
+#endif  // ROSBAG2_CPP__HEADER_STAMP_HPP_
@@ -17,6 +17,7 @@
 
 #include <string>
 
+#include "rosbag2_cpp/bag_statistics.hpp"
 #include "rosbag2_cpp/visibility_control.hpp"
 
 #include "rosbag2_storage/bag_metadata.hpp"
@@ -31,6 +32,21 @@ public:
 
   virtual rosbag2_storage::BagMetadata read_metadata(
     const std::string & uri, const std::string & storage_id);
+
+  /**
+   * Scan all messages of a bag for per topic sizes, periods and gaps.
+   *
+   * Only timestamps and sizes are read, the storage skips the serialized data if it can.
+   * The files of the bag are scanned concurrently.
+   *
+   * \param uri Bag directory, or storage file if the bag has no metadata file.
+   * \param storage_id Storage used when the bag has no metadata file.
+   * \param options Gap detection and concurrency settings.
+   * \throws std::runtime_error if the bag can't be opened or is FILE compressed.
+   */
+  virtual BagStatistics read_statistics(
+    const std::string & uri, const std::string & storage_id,
+    const BagStatisticsOptions & options = BagStatisticsOptions());
 };
 
 }  // namespace rosbag2_cpp
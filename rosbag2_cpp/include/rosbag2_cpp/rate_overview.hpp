@@ -0,0 +1,92 @@
+// Copyright 2022 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROSBAG2_CPP__RATE_OVERVIEW_HPP_
+#define ROSBAG2_CPP__RATE_OVERVIEW_HPP_
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "rcutils/time.h"
+
+#include "rosbag2_cpp/visibility_control.hpp"
+
+#include "rosbag2_storage/bag_metadata.hpp"
+
+// This is necessary because of using stl types here. It is completely safe, because
+// a) the member is not accessible from the outside
+// b) there are no inline functions.
+#ifdef _WIN32
+# pragma warning(push)
+# pragma warning(disable:4251)
+#endif
+
+namespace rosbag2_cpp
+{
+
+/**
+ * \brief Thread safe accumulator of the rate overview of a bag while it is written.
+ *
+ * Buckets are aligned to multiples of the bucket duration since the epoch, so overviews of
+ * different bags line up. To bound the size of the overview of long recordings, pairs of
+ * buckets are merged whenever more than max_buckets would be needed, doubling the bucket
+ * duration.
+ */
+class ROSBAG2_CPP_PUBLIC RateOverviewCollector
+{
+public:
+  /// A bucket duration of 0 disables the collector.
+  explicit RateOverviewCollector(
+    std::chrono::nanoseconds bucket_duration = std::chrono::nanoseconds(0),
+    size_t max_buckets = 1024);
+
+  /// Discard all counts and start over with bucket_duration.
+  void reset(std::chrono::nanoseconds bucket_duration);
+
+  /// Count a message of size bytes received at time_stamp on topic_name.
+  void add(const std::string & topic_name, rcutils_time_point_value_t time_stamp, uint64_t size);
+
+  /// Overview of the messages counted so far, topics ordered by name.
+  rosbag2_storage::RateOverview get_overview() const;
+
+private:
+  // Start of the bucket containing time_stamp
+  rcutils_time_point_value_t bucket_start(rcutils_time_point_value_t time_stamp) const;
+
+  // Grow the buckets to cover time_stamp, coarsening them as needed, and return its bucket
+  size_t bucket_index(rcutils_time_point_value_t time_stamp);
+
+  // Merge pairs of buckets, doubling the bucket duration
+  void coarsen();
+
+  mutable std::mutex mutex_;
+  const size_t max_buckets_;
+  int64_t bucket_duration_;
+  rcutils_time_point_value_t starting_time_ = 0;
+  size_t num_buckets_ = 0;
+  std::unordered_map<std::string, size_t> topic_indices_;
+  std::vector<rosbag2_storage::TopicRateOverview> topics_;
+};
+
+}  // namespace rosbag2_cpp
+
+#ifdef _WIN32
+# pragma warning(pop)
+#endif
+
+#endif  // ROSBAG2_CPP__RATE_OVERVIEW_HPP_
@@ -23,6 +23,7 @@
 #include "rclcpp/serialization.hpp"
 #include "rclcpp/serialized_message.hpp"
 
+#include "rosbag2_cpp/bag_catalog.hpp"
 #include "rosbag2_cpp/bag_events.hpp"
 #include "rosbag2_cpp/converter_options.hpp"
 #include "rosbag2_cpp/readers/sequential_reader.hpp"
@@ -94,6 +95,18 @@ public:
     const rosbag2_storage::StorageOptions & storage_options,
     const ConverterOptions & converter_options = ConverterOptions());
 
+  /**
+   * Opens the bag of a BagCatalog query result, reading only the topics of the entry from its
+   * start time on.
+   * Messages after the end time of the entry are not filtered out.
+   *
+   * \param entry Bag as returned by BagCatalog::query.
+   * \param converter_options Options for specifying the output data format
+   */
+  void open(
+    const BagCatalogEntry & entry,
+    const ConverterOptions & converter_options = ConverterOptions());
+
   /**
    * Closing the reader instance.
    */
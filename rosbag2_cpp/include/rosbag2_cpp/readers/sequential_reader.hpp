@@ -45,6 +45,12 @@ namespace rosbag2_cpp
 {
 namespace readers
 {
+namespace details
+{
+/// Resolve the relative file paths of a bag of the given version against the bag directory.
+ROSBAG2_CPP_PUBLIC std::vector<std::string> resolve_relative_paths(
+  const std::string & base_folder, std::vector<std::string> relative_files, const int version = 4);
+}  // namespace details
 
 class ROSBAG2_CPP_PUBLIC SequentialReader
   : public ::rosbag2_cpp::reader_interfaces::BaseReaderInterface
@@ -130,6 +136,21 @@ protected:
   */
   virtual void load_next_file();
 
+  /**
+  * Checks whether the metadata of a file shows that none of its messages pass the topic filter
+  * and seek time. Only bags with per-file topic message counts (version 7) can skip files.
+  *
+  * \param file_index Index of the file in the list of relative file paths
+  * \return true if the file can be skipped without opening it
+  */
+  virtual bool can_skip_file(size_t file_index) const;
+
+  /**
+  * Return the first file after the current one which can't be skipped, or the end of the file
+  * paths if there is none.
+  */
+  std::vector<std::string>::iterator find_next_file() const;
+
   /**
    * Checks if all topics in the bagfile have the same RMW serialization format.
    * Currently a bag file can only be played if all topics have the same serialization format.
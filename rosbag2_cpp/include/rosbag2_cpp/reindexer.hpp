@@ -24,6 +24,7 @@
 #define ROSBAG2_CPP__REINDEXER_HPP_
 
 #include <memory>
+#include <mutex>
 #include <regex>
 #include <string>
 #include <vector>
@@ -69,6 +70,11 @@ namespace rosbag2_cpp
  *   within the metadata. But it should at least repair a bag to the point it can be read
  *   again.
  *
+ * The files of the bag are processed concurrently, one thread per file up to the number of CPU
+ *   cores. The results are merged in file order, so the generated metadata does not depend on
+ *   which thread finished first.
+ *
+ * Compressed bags are not supported by this class, see rosbag2_compression::CompressionReindexer.
  */
 class ROSBAG2_CPP_PUBLIC Reindexer
 {
@@ -88,6 +94,22 @@ public:
   void reindex(const rosbag2_storage::StorageOptions & storage_options);
 
 protected:
+  /// Extract the metadata of a single bag file.
+  /*
+  * Called concurrently for different files. The returned metadata only needs the topics, message
+  * counts, starting time and duration, and the compression of the file if any.
+  * \param file Path of the bag file.
+  * \param storage_options Storage options of the bag, with the URI of the bag directory.
+  */
+  virtual rosbag2_storage::BagMetadata get_file_metadata(
+    const rcpputils::fs::path & file,
+    const rosbag2_storage::StorageOptions & storage_options);
+
+  /// Open a bag file read only, safe to call concurrently.
+  std::shared_ptr<rosbag2_storage::storage_interfaces::ReadOnlyInterface> open_storage(
+    const rcpputils::fs::path & file,
+    const rosbag2_storage::StorageOptions & storage_options);
+
   std::unique_ptr<rosbag2_storage::StorageFactoryInterface> storage_factory_{};
   std::unique_ptr<rosbag2_storage::MetadataIo> metadata_io_{};
   rosbag2_storage::BagMetadata metadata_{};
@@ -96,7 +118,7 @@ protected:
 private:
   std::string regex_bag_pattern_;
   rcpputils::fs::path base_folder_;   // The folder that the bag files are in
-  std::shared_ptr<SerializationFormatConverterFactoryInterface> converter_factory_{};
+  std::mutex storage_factory_mutex_;
   void get_bag_files(
     const rcpputils::fs::path & base_folder,
     std::vector<rcpputils::fs::path> & output);
@@ -106,12 +128,16 @@ private:
     const std::vector<rcpputils::fs::path> & files,
     const rosbag2_storage::StorageOptions & storage_options);
 
-  // Attempts to harvest metadata from all bag files, and aggregates the result
-  void aggregate_metadata(
+  // Harvests metadata from all bag files concurrently
+  std::vector<rosbag2_storage::BagMetadata> collect_file_metadata(
     const std::vector<rcpputils::fs::path> & files,
-    const std::unique_ptr<rosbag2_cpp::readers::SequentialReader> & bag_reader,
     const rosbag2_storage::StorageOptions & storage_options);
 
+  // Aggregates the metadata harvested from the bag files, in file order
+  void aggregate_metadata(
+    const std::vector<rcpputils::fs::path> & files,
+    const std::vector<rosbag2_storage::BagMetadata> & file_metadata);
+
   // Comparison function for std::sort with our filepath convention
   bool compare_relative_file(
     const rcpputils::fs::path & first_path,
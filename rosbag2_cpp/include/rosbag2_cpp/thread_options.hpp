@@ -0,0 +1,91 @@
+// Copyright 2022 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROSBAG2_CPP__THREAD_OPTIONS_HPP_
+#define ROSBAG2_CPP__THREAD_OPTIONS_HPP_
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "rosbag2_cpp/visibility_control.hpp"
+#include "rosbag2_storage/yaml.hpp"
+
+namespace rosbag2_cpp
+{
+
+/// Scheduling of a class of threads started by rosbag2.
+struct ThreadOptions
+{
+  /// CPUs the threads may run on, empty to not restrict them.
+  std::vector<int> cpu_affinity;
+  /// Nice level of the threads, 0 keeps the nice level of the process.
+  /// Only applies to threads without realtime priority.
+  int nice = 0;
+  /// SCHED_FIFO priority from 1 to 99, 0 keeps the default scheduling policy.
+  int fifo_priority = 0;
+};
+
+/// Thread options by thread class. Each thread started by rosbag2 is named after its class.
+using ThreadOptionsMap = std::unordered_map<std::string, ThreadOptions>;
+
+/// Classes of the threads started by rosbag2.
+namespace thread_class
+{
+/// Thread writing the message cache to storage.
+constexpr const char kCacheConsumer[] = "cache_consumer";
+/// Threads compressing messages or files.
+constexpr const char kCompression[] = "compression";
+/// Thread of the Recorder looking for new topics.
+constexpr const char kDiscovery[] = "discovery";
+/// Thread of the Recorder publishing split events.
+constexpr const char kEventPublisher[] = "event_publisher";
+/// Thread of the Player reading messages ahead from storage.
+constexpr const char kPlayerLoader[] = "player_loader";
+/// Thread of the Player publishing messages, when the Player owns it.
+constexpr const char kPlayback[] = "playback";
+/// Threads of bag_rewrite reading an input bag ahead.
+constexpr const char kRewriteReader[] = "rewrite_reader";
+/// Threads of bag_rewrite writing an output bag.
+constexpr const char kRewriteWriter[] = "rewrite_writer";
+}  // namespace thread_class
+
+/**
+ * \brief Name the calling thread after its class and apply the options of that class to it.
+ *
+ * Failures, usually caused by missing privileges for realtime priorities, are logged rather
+ * than thrown, so that a misconfiguration doesn't stop recording or playback.
+ * Only names the thread on platforms other than Linux.
+ *
+ * \param thread_class Class of the calling thread, one of the names in rosbag2_cpp::thread_class.
+ * \param thread_options Options by thread class, classes without entry are only named.
+ */
+ROSBAG2_CPP_PUBLIC
+void configure_current_thread(
+  const std::string & thread_class,
+  const ThreadOptionsMap & thread_options);
+
+}  // namespace rosbag2_cpp
+
+namespace YAML
+{
+template<>
+struct ROSBAG2_CPP_PUBLIC convert<rosbag2_cpp::ThreadOptions>
+{
+  static Node encode(const rosbag2_cpp::ThreadOptions & thread_options);
+  static bool decode(const Node & node, rosbag2_cpp::ThreadOptions & thread_options);
+};
+}  // namespace YAML
+
+#endif  // ROSBAG2_CPP__THREAD_OPTIONS_HPP_
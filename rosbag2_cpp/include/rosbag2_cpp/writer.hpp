@@ -28,6 +28,8 @@
 #include "rosbag2_cpp/bag_events.hpp"
 #include "rosbag2_cpp/converter_options.hpp"
 #include "rosbag2_cpp/visibility_control.hpp"
+#include "rosbag2_cpp/thread_options.hpp"
+#include "rosbag2_cpp/writer_statistics.hpp"
 #include "rosbag2_cpp/writers/sequential_writer.hpp"
 
 #include "rosbag2_storage/serialized_bag_message.hpp"
@@ -211,6 +213,20 @@ public:
    */
   void add_event_callbacks(bag_events::WriterEventCallbacks & callbacks);
 
+  /**
+   * \brief Get statistics about the health of the writer.
+   * Doesn't wait for ongoing writes, so it can be polled while recording.
+   * \returns statistics of the underlying writer implementation
+   */
+  WriterStatistics get_statistics();
+
+  /**
+   * \brief Set scheduling options of the threads started by the writer, by thread class.
+   * Must be called before open to take effect.
+   * \param thread_options options by class, see rosbag2_cpp::thread_class
+   */
+  void set_thread_options(const ThreadOptionsMap & thread_options);
+
 private:
   std::mutex writer_mutex_;
   std::unique_ptr<rosbag2_cpp::writer_interfaces::BaseWriterInterface> writer_impl_;
@@ -20,6 +20,8 @@
 #include "rosbag2_cpp/bag_events.hpp"
 #include "rosbag2_cpp/converter_options.hpp"
 #include "rosbag2_cpp/visibility_control.hpp"
+#include "rosbag2_cpp/thread_options.hpp"
+#include "rosbag2_cpp/writer_statistics.hpp"
 
 #include "rosbag2_storage/serialized_bag_message.hpp"
 #include "rosbag2_storage/storage_options.hpp"
@@ -54,6 +56,21 @@ public:
   virtual bool take_snapshot() = 0;
 
   virtual void add_event_callbacks(const bag_events::WriterEventCallbacks & callbacks) = 0;
+
+  /**
+   * Get statistics about the health of the writer. Must be safe to call concurrently with write.
+   * \returns empty statistics for writers which don't collect them
+   */
+  virtual WriterStatistics get_statistics()
+  {
+    return WriterStatistics{};
+  }
+
+  /**
+   * Set the options of the threads started by the writer. Must be called before open.
+   * Writers which don't start threads ignore them.
+   */
+  virtual void set_thread_options(const ThreadOptionsMap & /* thread_options */) {}
 };
 
 }  // namespace writer_interfaces
@@ -0,0 +1,115 @@
+// Copyright 2022 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROSBAG2_CPP__WRITER_STATISTICS_HPP_
+#define ROSBAG2_CPP__WRITER_STATISTICS_HPP_
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "rosbag2_cpp/visibility_control.hpp"
+
+// This is necessary because of using stl types here. It is completely safe, because
+// a) the member is not accessible from the outside
+// b) there are no inline functions.
+#ifdef _WIN32
+# pragma warning(push)
+# pragma warning(disable:4251)
+#endif
+
+namespace rosbag2_cpp
+{
+
+/**
+ * \brief Health of a writer, as returned by Writer::get_statistics.
+ *
+ * Drop counters are totals since the writer was opened. Batch sizes and write latencies only
+ * cover the period since the previous call to get_statistics.
+ */
+struct WriterStatistics
+{
+  /// Messages dropped per topic because the cache buffer was full.
+  std::unordered_map<std::string, uint64_t> messages_dropped_cache_full;
+  /// Messages dropped per topic because the compression queue was full.
+  std::unordered_map<std::string, uint64_t> messages_dropped_compression_queue;
+  /// Messages the storage refused to write, e.g. because they exceed its size limit.
+  uint64_t messages_dropped_storage = 0;
+  /// Bytes waiting in the cache to be written, and the cache capacity. Both 0 without cache.
+  uint64_t cache_bytes = 0;
+  uint64_t cache_capacity_bytes = 0;
+  /// Number of storage writes and messages written in them during the period.
+  /// Without cache every message is a write of its own.
+  uint64_t write_batches = 0;
+  uint64_t max_batch_size = 0;
+  uint64_t messages_written = 0;
+  /// Percentiles of the duration of a single storage write during the period.
+  std::chrono::nanoseconds write_latency_p50{0};
+  std::chrono::nanoseconds write_latency_p90{0};
+  std::chrono::nanoseconds write_latency_p99{0};
+  std::chrono::nanoseconds write_latency_max{0};
+  /// Number of splits since the writer was opened and the duration of the last one.
+  uint64_t splits = 0;
+  std::chrono::nanoseconds last_split_duration{0};
+};
+
+/**
+ * \brief Thread safe accumulator for the parts of WriterStatistics measured by the writer.
+ *
+ * Write latencies are kept as samples until they are reported. At most max_latency_samples
+ * are kept per period, further writes still count towards batches but not the percentiles.
+ */
+class ROSBAG2_CPP_PUBLIC WriterStatisticsCollector
+{
+public:
+  explicit WriterStatisticsCollector(size_t max_latency_samples = 10000);
+
+  /// Record a storage write of num_messages which took duration.
+  void on_write(size_t num_messages, std::chrono::nanoseconds duration);
+
+  /// Record a split of the bag which took duration.
+  void on_split(std::chrono::nanoseconds duration);
+
+  /// Set the number of messages the current storage refused to write.
+  void set_storage_dropped(uint64_t dropped_by_current_storage);
+
+  /// Keep the storage drop count of the current storage before it is replaced on split.
+  void on_storage_closed();
+
+  /// Fill the fields measured by this collector into statistics and start a new period.
+  void report(WriterStatistics & statistics);
+
+private:
+  std::mutex mutex_;
+  const size_t max_latency_samples_;
+  std::vector<std::chrono::nanoseconds> latencies_;
+  uint64_t write_batches_ = 0;
+  uint64_t max_batch_size_ = 0;
+  uint64_t messages_written_ = 0;
+  uint64_t splits_ = 0;
+  std::chrono::nanoseconds last_split_duration_{0};
+  uint64_t storage_dropped_closed_ = 0;
+  uint64_t storage_dropped_current_ = 0;
+};
+
+}  // namespace rosbag2_cpp
+
+#ifdef _WIN32
+# pragma warning(pop)
+#endif
+
+#endif  // ROSBAG2_CPP__WRITER_STATISTICS_HPP_
@@ -19,6 +19,7 @@
 #include <mutex>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "rosbag2_cpp/bag_events.hpp"
@@ -27,9 +28,12 @@
 #include "rosbag2_cpp/cache/message_cache.hpp"
 #include "rosbag2_cpp/cache/message_cache_interface.hpp"
 #include "rosbag2_cpp/converter.hpp"
+#include "rosbag2_cpp/rate_overview.hpp"
 #include "rosbag2_cpp/serialization_format_converter_factory.hpp"
 #include "rosbag2_cpp/writer_interfaces/base_writer_interface.hpp"
+#include "rosbag2_cpp/thread_options.hpp"
 #include "rosbag2_cpp/visibility_control.hpp"
+#include "rosbag2_cpp/writer_statistics.hpp"
 
 #include "rosbag2_storage/metadata_io.hpp"
 #include "rosbag2_storage/storage_factory.hpp"
@@ -121,6 +125,14 @@ public:
    */
   void add_event_callbacks(const bag_events::WriterEventCallbacks & callbacks) override;
 
+  /**
+   * \brief Get statistics about drops, cache fill, storage write latencies and splits.
+   * Safe to call concurrently with write and close.
+   */
+  WriterStatistics get_statistics() override;
+
+  void set_thread_options(const ThreadOptionsMap & thread_options) override;
+
 protected:
   std::string base_folder_;
   std::unique_ptr<rosbag2_storage::StorageFactoryInterface> storage_factory_;
@@ -130,6 +142,7 @@ protected:
   std::unique_ptr<Converter> converter_;
 
   bool use_cache_ {false};
+  // Set and reset with std::atomic_store, since get_statistics() reads it from other threads
   std::shared_ptr<rosbag2_cpp::cache::MessageCacheInterface> message_cache_;
   std::unique_ptr<rosbag2_cpp::cache::CacheConsumer> cache_consumer_;
 
@@ -146,6 +159,24 @@ protected:
 
   rosbag2_storage::BagMetadata metadata_;
 
+  WriterStatisticsCollector statistics_collector_;
+
+  // Per topic message counts and bytes over time, stored with the metadata
+  RateOverviewCollector rate_overview_collector_;
+
+  // Options of the threads started by the writer, by thread class
+  ThreadOptionsMap thread_options_;
+
+  // CDR topics whose type starts with a header, only filled if header stamps are indexed
+  std::unordered_set<std::string> topics_with_header_stamp_;
+
+  // Sets the header stamp of messages on topics_with_header_stamp_ from their serialized data.
+  // Must be called before the serialized data is converted or compressed.
+  virtual void index_header_stamp(rosbag2_storage::SerializedBagMessage & message) const;
+
+  // Counts a message which was written to storage in the rate overview.
+  void add_to_rate_overview(const rosbag2_storage::SerializedBagMessage & message);
+
   // Closes the current backed storage and opens the next bagfile.
   virtual void split_bagfile();
 
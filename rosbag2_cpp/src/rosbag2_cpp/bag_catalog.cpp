@@ -0,0 +1,583 @@
+// Copyright 2022 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rosbag2_cpp/bag_catalog.hpp"
+
+#include <sqlite3.h>
+#include <sys/stat.h>
+#ifdef _WIN32
+# include <windows.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "rcpputils/filesystem_helper.hpp"
+#include "rcutils/filesystem.h"
+
+#include "rosbag2_cpp/logging.hpp"
+
+#include "rosbag2_storage/metadata_io.hpp"
+
+namespace
+{
+// Stored as the user_version of the database. The catalog only holds copies of bag metadata, so
+// catalogs with another schema version are emptied and indexed again.
+const int kSchemaVersion = 2;
+
+const char * const kSchema =
+  "PRAGMA foreign_keys = ON;"
+  "CREATE TABLE IF NOT EXISTS bags("
+  "  id INTEGER PRIMARY KEY,"
+  "  uri TEXT NOT NULL UNIQUE,"
+  "  storage_identifier TEXT NOT NULL,"
+  "  start_time INTEGER NOT NULL,"
+  "  end_time INTEGER NOT NULL,"
+  "  size INTEGER NOT NULL,"
+  "  metadata_modification_time INTEGER NOT NULL,"
+  "  metadata_file_size INTEGER NOT NULL);"
+  "CREATE INDEX IF NOT EXISTS bags_time_idx ON bags(start_time, end_time);"
+  "CREATE TABLE IF NOT EXISTS topics("
+  "  bag_id INTEGER NOT NULL REFERENCES bags(id) ON DELETE CASCADE,"
+  "  name TEXT NOT NULL,"
+  "  type TEXT NOT NULL,"
+  "  serialization_format TEXT NOT NULL,"
+  "  offered_qos_profiles TEXT NOT NULL,"
+  "  message_count INTEGER NOT NULL);"
+  "CREATE INDEX IF NOT EXISTS topics_name_idx ON topics(name, bag_id);"
+  "CREATE INDEX IF NOT EXISTS topics_bag_idx ON topics(bag_id);"
+  "CREATE TABLE IF NOT EXISTS files("
+  "  bag_id INTEGER NOT NULL REFERENCES bags(id) ON DELETE CASCADE,"
+  "  path TEXT NOT NULL,"
+  "  start_time INTEGER NOT NULL,"
+  "  end_time INTEGER NOT NULL,"
+  "  message_count INTEGER NOT NULL,"
+  "  size INTEGER NOT NULL);"
+  "CREATE INDEX IF NOT EXISTS files_bag_idx ON files(bag_id, start_time);";
+
+const char * const kDropSchema =
+  "DROP TABLE IF EXISTS files;"
+  "DROP TABLE IF EXISTS topics;"
+  "DROP TABLE IF EXISTS bags;";
+
+void execute(sqlite3 * database, const std::string & statements)
+{
+  char * error_message = nullptr;
+  if (sqlite3_exec(database, statements.c_str(), nullptr, nullptr, &error_message) != SQLITE_OK) {
+    std::string error = error_message ? error_message : "unknown error";
+    sqlite3_free(error_message);
+    throw std::runtime_error("Bag catalog statement failed: " + error);
+  }
+}
+
+// Prepared statement, finalized when going out of scope
+class Statement
+{
+public:
+  Statement(sqlite3 * database, const std::string & query)
+  : database_(database)
+  {
+    if (sqlite3_prepare_v2(database, query.c_str(), -1, &statement_, nullptr) != SQLITE_OK) {
+      throw std::runtime_error(
+              "Error preparing bag catalog query '" + query + "': " + sqlite3_errmsg(database));
+    }
+  }
+
+  ~Statement()
+  {
+    sqlite3_finalize(statement_);
+  }
+
+  Statement(const Statement &) = delete;
+  Statement & operator=(const Statement &) = delete;
+
+  Statement & bind(int index, int64_t value)
+  {
+    check(sqlite3_bind_int64(statement_, index, value));
+    return *this;
+  }
+
+  Statement & bind(int index, const std::string & value)
+  {
+    check(sqlite3_bind_text(statement_, index, value.c_str(), -1, SQLITE_TRANSIENT));
+    return *this;
+  }
+
+  // Advance to the next row, false once there are no more rows
+  bool step()
+  {
+    const int return_code = sqlite3_step(statement_);
+    if (return_code == SQLITE_ROW) {
+      return true;
+    }
+    if (return_code != SQLITE_DONE) {
+      check(return_code);
+    }
+    return false;
+  }
+
+  void reset()
+  {
+    sqlite3_reset(statement_);
+  }
+
+  int64_t get_int(int column) const
+  {
+    return sqlite3_column_int64(statement_, column);
+  }
+
+  std::string get_text(int column) const
+  {
+    const auto text = sqlite3_column_text(statement_, column);
+    return text ? reinterpret_cast<const char *>(text) : "";
+  }
+
+private:
+  void check(int return_code) const
+  {
+    if (return_code != SQLITE_OK) {
+      throw std::runtime_error(
+              std::string("Bag catalog query failed: ") + sqlite3_errmsg(database_));
+    }
+  }
+
+  sqlite3 * database_;
+  sqlite3_stmt * statement_ = nullptr;
+};
+
+// Rolls back unless committed
+class Transaction
+{
+public:
+  explicit Transaction(sqlite3 * database)
+  : database_(database)
+  {
+    execute(database_, "BEGIN TRANSACTION;");
+  }
+
+  ~Transaction()
+  {
+    if (!committed_) {
+      sqlite3_exec(database_, "ROLLBACK;", nullptr, nullptr, nullptr);
+    }
+  }
+
+  void commit()
+  {
+    execute(database_, "COMMIT;");
+    committed_ = true;
+  }
+
+private:
+  sqlite3 * database_;
+  bool committed_ = false;
+};
+
+// Rolls back to the state at construction unless released, within a transaction
+class Savepoint
+{
+public:
+  explicit Savepoint(sqlite3 * database)
+  : database_(database)
+  {
+    execute(database_, "SAVEPOINT catalog_savepoint;");
+  }
+
+  ~Savepoint()
+  {
+    if (!released_) {
+      sqlite3_exec(
+        database_, "ROLLBACK TO catalog_savepoint; RELEASE catalog_savepoint;",
+        nullptr, nullptr, nullptr);
+    }
+  }
+
+  void release()
+  {
+    execute(database_, "RELEASE catalog_savepoint;");
+    released_ = true;
+  }
+
+private:
+  sqlite3 * database_;
+  bool released_ = false;
+};
+
+bool get_file_status(const std::string & path, int64_t & modification_time, int64_t & size)
+{
+#ifdef _WIN32
+  struct _stat64 status;
+  if (_stat64(path.c_str(), &status) != 0) {
+    return false;
+  }
+#else
+  struct stat status;
+  if (stat(path.c_str(), &status) != 0) {
+    return false;
+  }
+#endif
+  modification_time = static_cast<int64_t>(status.st_mtime);
+  size = static_cast<int64_t>(status.st_size);
+  return true;
+}
+
+// True for symbolic links, and for junctions on Windows
+bool is_link(const std::string & path)
+{
+#ifdef _WIN32
+  const DWORD attributes = GetFileAttributesA(path.c_str());
+  return attributes != INVALID_FILE_ATTRIBUTES && (attributes & FILE_ATTRIBUTE_REPARSE_POINT);
+#else
+  struct stat status;
+  return lstat(path.c_str(), &status) == 0 && S_ISLNK(status.st_mode);
+#endif
+}
+
+// Size of a file of a bag, 0 if it doesn't exist
+int64_t bag_file_size(const std::string & uri, const std::string & path)
+{
+  rcpputils::fs::path file_path(path);
+  if (!file_path.is_absolute()) {
+    file_path = rcpputils::fs::path(uri) / file_path;
+  }
+  int64_t modification_time = 0;
+  int64_t size = 0;
+  return get_file_status(file_path.string(), modification_time, size) ? size : 0;
+}
+
+std::string absolute_path(const std::string & path)
+{
+  rcpputils::fs::path result(path);
+  if (!result.is_absolute()) {
+    result = rcpputils::fs::current_path() / result;
+  }
+  auto absolute = result.string();
+  while (absolute.size() > 1 && absolute.back() == rcpputils::fs::kPreferredSeparator) {
+    absolute.pop_back();
+  }
+  return absolute;
+}
+
+rcutils_time_point_value_t to_nanoseconds(
+  const std::chrono::time_point<std::chrono::high_resolution_clock> & time_point)
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(time_point.time_since_epoch())
+         .count();
+}
+
+// Comma separated list of count parameters, for IN clauses
+std::string placeholders(size_t count)
+{
+  std::string result = "?";
+  for (size_t i = 1; i < count; ++i) {
+    result += ", ?";
+  }
+  return result;
+}
+}  // namespace
+
+namespace rosbag2_cpp
+{
+
+BagCatalog::BagCatalog(const std::string & catalog_path)
+{
+  if (sqlite3_open(catalog_path.c_str(), &database_) != SQLITE_OK) {
+    std::string error = database_ ? sqlite3_errmsg(database_) : "out of memory";
+    sqlite3_close(database_);
+    throw std::runtime_error("Could not open bag catalog " + catalog_path + ": " + error);
+  }
+  try {
+    Statement select_version(database_, "PRAGMA user_version;");
+    select_version.step();
+    if (select_version.get_int(0) != kSchemaVersion) {
+      execute(
+        database_, std::string(kDropSchema) + kSchema +
+        "PRAGMA user_version = " + std::to_string(kSchemaVersion) + ";");
+    } else {
+      execute(database_, kSchema);
+    }
+  } catch (...) {
+    sqlite3_close(database_);
+    throw;
+  }
+}
+
+BagCatalog::~BagCatalog()
+{
+  sqlite3_close(database_);
+}
+
+size_t BagCatalog::index(const std::string & directory)
+{
+  const auto root = absolute_path(directory);
+  if (!rcpputils::fs::path(root).is_directory()) {
+    throw std::runtime_error("Bag catalog can't index " + root + ", it is not a directory.");
+  }
+
+  Transaction transaction(database_);
+  std::vector<std::string> found_bags;
+  const size_t indexed_bags = index_directory(root, found_bags);
+
+  // Drop the bags which were below the directory when it was indexed before, but not anymore
+  const std::unordered_set<std::string> found(found_bags.begin(), found_bags.end());
+  const std::string prefix = root + rcpputils::fs::kPreferredSeparator;
+  std::vector<std::string> removed_bags;
+  Statement select_uris(database_, "SELECT uri FROM bags;");
+  while (select_uris.step()) {
+    const auto uri = select_uris.get_text(0);
+    if ((uri == root || uri.compare(0, prefix.size(), prefix) == 0) && found.count(uri) == 0) {
+      removed_bags.push_back(uri);
+    }
+  }
+  for (const auto & uri : removed_bags) {
+    ROSBAG2_CPP_LOG_DEBUG_STREAM("Removing " << uri << " from the bag catalog.");
+    remove_bag(uri);
+  }
+
+  transaction.commit();
+  return indexed_bags;
+}
+
+size_t BagCatalog::index_directory(
+  const std::string & directory, std::vector<std::string> & found_bags)
+{
+  const rcpputils::fs::path directory_path(directory);
+  if ((directory_path / rosbag2_storage::MetadataIo::metadata_filename).exists()) {
+    found_bags.push_back(directory);
+    try {
+      // Keeps the previous entry of the bag if it fails halfway
+      Savepoint savepoint(database_);
+      const bool updated = update_bag(directory);
+      savepoint.release();
+      return updated ? 1 : 0;
+    } catch (const std::exception & e) {
+      // One broken bag shouldn't keep the rest of a collection out of the catalog
+      ROSBAG2_CPP_LOG_WARN_STREAM("Could not index bag " << directory << ": " << e.what());
+      return 0;
+    }
+  }
+
+  std::vector<std::string> subdirectories;
+  auto dir_iter = rcutils_dir_iter_start(directory.c_str(), rcutils_get_default_allocator());
+  if (dir_iter == nullptr) {
+    return 0;
+  }
+  do {
+    const std::string entry_name = dir_iter->entry_name;
+    if (entry_name == "." || entry_name == "..") {
+      continue;
+    }
+    const auto entry = directory_path / entry_name;
+    if (entry.is_directory() && !is_link(entry.string())) {
+      subdirectories.push_back(entry.string());
+    }
+  } while (rcutils_dir_iter_next(dir_iter));
+  rcutils_dir_iter_end(dir_iter);
+
+  // Index in a stable order, the directory listing isn't sorted
+  std::sort(subdirectories.begin(), subdirectories.end());
+  size_t indexed_bags = 0;
+  for (const auto & subdirectory : subdirectories) {
+    indexed_bags += index_directory(subdirectory, found_bags);
+  }
+  return indexed_bags;
+}
+
+bool BagCatalog::index_bag(const std::string & uri)
+{
+  Transaction transaction(database_);
+  const bool updated = update_bag(absolute_path(uri));
+  transaction.commit();
+  return updated;
+}
+
+bool BagCatalog::update_bag(const std::string & uri)
+{
+  const auto metadata_file =
+    (rcpputils::fs::path(uri) / rosbag2_storage::MetadataIo::metadata_filename).string();
+  int64_t modification_time = 0;
+  int64_t file_size = 0;
+  if (!get_file_status(metadata_file, modification_time, file_size)) {
+    throw std::runtime_error("The bag " + uri + " has no metadata file.");
+  }
+
+  Statement select_bag(
+    database_,
+    "SELECT metadata_modification_time, metadata_file_size FROM bags WHERE uri = ?;");
+  select_bag.bind(1, uri);
+  if (select_bag.step() && select_bag.get_int(0) == modification_time &&
+    select_bag.get_int(1) == file_size)
+  {
+    return false;
+  }
+
+  rosbag2_storage::MetadataIo metadata_io;
+  const auto metadata = metadata_io.read_metadata(uri);
+  ROSBAG2_CPP_LOG_DEBUG_STREAM("Adding " << uri << " to the bag catalog.");
+  insert_bag(uri, metadata, modification_time, file_size);
+  return true;
+}
+
+void BagCatalog::insert_bag(
+  const std::string & uri,
+  const rosbag2_storage::BagMetadata & metadata,
+  int64_t metadata_modification_time,
+  int64_t metadata_file_size)
+{
+  remove_bag(uri);
+
+  const auto start_time = to_nanoseconds(metadata.starting_time);
+  const auto end_time = start_time + metadata.duration.count();
+  Statement insert_bag(
+    database_,
+    "INSERT INTO bags (uri, storage_identifier, start_time, end_time, size, "
+    "metadata_modification_time, metadata_file_size) VALUES (?, ?, ?, ?, ?, ?, ?);");
+  insert_bag.bind(1, uri).bind(2, metadata.storage_identifier).bind(3, start_time)
+  .bind(4, end_time).bind(5, static_cast<int64_t>(metadata.bag_size))
+  .bind(6, metadata_modification_time).bind(7, metadata_file_size);
+  insert_bag.step();
+  const int64_t bag_id = sqlite3_last_insert_rowid(database_);
+
+  Statement insert_topic(
+    database_,
+    "INSERT INTO topics (bag_id, name, type, serialization_format, offered_qos_profiles, "
+    "message_count) VALUES (?, ?, ?, ?, ?, ?);");
+  for (const auto & topic : metadata.topics_with_message_count) {
+    insert_topic.bind(1, bag_id).bind(2, topic.topic_metadata.name)
+    .bind(3, topic.topic_metadata.type).bind(4, topic.topic_metadata.serialization_format)
+    .bind(5, topic.topic_metadata.offered_qos_profiles)
+    .bind(6, static_cast<int64_t>(topic.message_count));
+    insert_topic.step();
+    insert_topic.reset();
+  }
+
+  Statement insert_file(
+    database_,
+    "INSERT INTO files (bag_id, path, start_time, end_time, message_count, size) "
+    "VALUES (?, ?, ?, ?, ?, ?);");
+  if (!metadata.files.empty()) {
+    for (const auto & file : metadata.files) {
+      const auto file_start_time = to_nanoseconds(file.starting_time);
+      insert_file.bind(1, bag_id).bind(2, file.path).bind(3, file_start_time)
+      .bind(4, file_start_time + file.duration.count())
+      .bind(5, static_cast<int64_t>(file.message_count)).bind(6, bag_file_size(uri, file.path));
+      insert_file.step();
+      insert_file.reset();
+    }
+  } else {
+    // Metadata before version 5 has no per file information, each file spans the whole bag
+    for (const auto & path : metadata.relative_file_paths) {
+      insert_file.bind(1, bag_id).bind(2, path).bind(3, start_time).bind(4, end_time)
+      .bind(5, int64_t{0}).bind(6, bag_file_size(uri, path));
+      insert_file.step();
+      insert_file.reset();
+    }
+  }
+}
+
+void BagCatalog::remove_bag(const std::string & uri)
+{
+  Statement delete_bag(database_, "DELETE FROM bags WHERE uri = ?;");
+  delete_bag.bind(1, absolute_path(uri));
+  delete_bag.step();
+}
+
+std::vector<BagCatalogEntry> BagCatalog::query(const BagCatalogQuery & query) const
+{
+  std::string topic_condition;
+  if (!query.topics.empty()) {
+    topic_condition = " AND name IN (" + placeholders(query.topics.size()) + ")";
+  }
+  auto bind_topics = [&query](Statement & statement, int first_index) {
+      for (const auto & topic : query.topics) {
+        statement.bind(first_index++, topic);
+      }
+    };
+
+  Statement select_bags(
+    database_,
+    "SELECT id, uri, storage_identifier, start_time, end_time, size FROM bags "
+    "WHERE end_time >= ? AND start_time <= ?" +
+    (query.topics.empty() ? std::string() :
+    " AND id IN (SELECT bag_id FROM topics WHERE message_count > 0" + topic_condition + ")") +
+    " ORDER BY start_time, uri;");
+  select_bags.bind(1, query.start_time).bind(2, query.end_time);
+  bind_topics(select_bags, 3);
+
+  Statement select_topics(
+    database_,
+    "SELECT name, type, serialization_format, offered_qos_profiles, message_count FROM topics "
+    "WHERE bag_id = ?" +
+    (query.topics.empty() ? std::string() : " AND message_count > 0" + topic_condition) +
+    " ORDER BY name;");
+  Statement select_files(
+    database_,
+    "SELECT path, start_time, end_time, message_count, size FROM files "
+    "WHERE bag_id = ? AND end_time >= ? AND start_time <= ? ORDER BY rowid;");
+
+  std::vector<BagCatalogEntry> entries;
+  while (select_bags.step()) {
+    const int64_t bag_id = select_bags.get_int(0);
+    BagCatalogEntry entry;
+    entry.uri = select_bags.get_text(1);
+    entry.storage_identifier = select_bags.get_text(2);
+    entry.start_time = std::max(select_bags.get_int(3), query.start_time);
+    entry.end_time = std::min(select_bags.get_int(4), query.end_time);
+    entry.size = static_cast<uint64_t>(select_bags.get_int(5));
+
+    select_topics.bind(1, bag_id);
+    bind_topics(select_topics, 2);
+    while (select_topics.step()) {
+      rosbag2_storage::TopicInformation topic;
+      topic.topic_metadata.name = select_topics.get_text(0);
+      topic.topic_metadata.type = select_topics.get_text(1);
+      topic.topic_metadata.serialization_format = select_topics.get_text(2);
+      topic.topic_metadata.offered_qos_profiles = select_topics.get_text(3);
+      topic.message_count = static_cast<size_t>(select_topics.get_int(4));
+      entry.topics.push_back(topic);
+    }
+    select_topics.reset();
+
+    select_files.bind(1, bag_id).bind(2, query.start_time).bind(3, query.end_time);
+    while (select_files.step()) {
+      rosbag2_storage::FileInformation file;
+      file.path = select_files.get_text(0);
+      file.starting_time = std::chrono::time_point<std::chrono::high_resolution_clock>(
+        std::chrono::nanoseconds(select_files.get_int(1)));
+      file.duration = std::chrono::nanoseconds(select_files.get_int(2) - select_files.get_int(1));
+      file.message_count = static_cast<size_t>(select_files.get_int(3));
+      entry.files.push_back(file);
+      entry.file_sizes.push_back(static_cast<uint64_t>(select_files.get_int(4)));
+    }
+    select_files.reset();
+
+    entries.push_back(std::move(entry));
+  }
+  return entries;
+}
+
+size_t BagCatalog::size() const
+{
+  Statement count_bags(database_, "SELECT COUNT(*) FROM bags;");
+  count_bags.step();
+  return static_cast<size_t>(count_bags.get_int(0));
+}
+
+}  // namespace rosbag2_cpp
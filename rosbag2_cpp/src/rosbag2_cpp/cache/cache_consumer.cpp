@@ -24,9 +24,11 @@ namespace cache
 
 CacheConsumer::CacheConsumer(
   std::shared_ptr<MessageCacheInterface> message_cache,
-  consume_callback_function_t consume_callback)
+  consume_callback_function_t consume_callback,
+  const ThreadOptionsMap & thread_options)
 : message_cache_(message_cache),
-  consume_callback_(consume_callback)
+  consume_callback_(consume_callback),
+  thread_options_(thread_options)
 {
   consumer_thread_ = std::thread(&CacheConsumer::exec_consuming, this);
 }
@@ -60,6 +62,7 @@ void CacheConsumer::start()
 
 void CacheConsumer::exec_consuming()
 {
+  configure_current_thread(thread_class::kCacheConsumer, thread_options_);
   bool exit_flag = false;
   bool flushing = false;
   while (!exit_flag) {
@@ -28,7 +28,8 @@ namespace rosbag2_cpp
 namespace cache
 {
 
-MessageCache::MessageCache(size_t max_buffer_size)
+MessageCache::MessageCache(size_t max_buffer_size, bool block_on_full)
+: block_on_full_(block_on_full)
 {
   producer_buffer_ = std::make_shared<MessageCacheBuffer>(max_buffer_size);
   consumer_buffer_ = std::make_shared<MessageCacheBuffer>(max_buffer_size);
@@ -41,20 +42,25 @@ MessageCache::~MessageCache()
   // exceptional situations.
   flushing_ = true;
   cache_condition_var_.notify_one();
+  buffers_swapped_condition_var_.notify_all();
   log_dropped();
 }
 
 void MessageCache::push(std::shared_ptr<const rosbag2_storage::SerializedBagMessage> msg)
 {
   // While pushing, we keep track of inserted and dropped messages as well
-  bool pushed = false;
   {
-    std::lock_guard<std::mutex> lock(producer_buffer_mutex_);
-    pushed = producer_buffer_->push(msg);
-  }
-
-  if (!pushed) {
-    messages_dropped_per_topic_[msg->topic_name]++;
+    std::unique_lock<std::mutex> lock(producer_buffer_mutex_);
+    while (!producer_buffer_->push(msg)) {
+      if (!block_on_full_ || flushing_) {
+        messages_dropped_per_topic_[msg->topic_name]++;
+        break;
+      }
+      // Wake up the consumer, it can't be waiting for more data than a full buffer
+      data_ready_ = true;
+      cache_condition_var_.notify_one();
+      buffers_swapped_condition_var_.wait(lock);
+    }
   }
 
   notify_data_ready();
@@ -95,9 +101,12 @@ void MessageCache::wait_for_data()
 
 void MessageCache::swap_buffers()
 {
-  std::lock_guard<std::mutex> producer_lock(producer_buffer_mutex_);
-  std::lock_guard<std::mutex> consumer_lock(consumer_buffer_mutex_);
-  std::swap(producer_buffer_, consumer_buffer_);
+  {
+    std::lock_guard<std::mutex> producer_lock(producer_buffer_mutex_);
+    std::lock_guard<std::mutex> consumer_lock(consumer_buffer_mutex_);
+    std::swap(producer_buffer_, consumer_buffer_);
+  }
+  buffers_swapped_condition_var_.notify_all();
 }
 
 void MessageCache::begin_flushing()
@@ -107,6 +116,7 @@ void MessageCache::begin_flushing()
     flushing_ = true;
   }
   cache_condition_var_.notify_one();
+  buffers_swapped_condition_var_.notify_all();
 }
 
 void MessageCache::done_flushing()
@@ -114,6 +124,18 @@ void MessageCache::done_flushing()
   flushing_ = false;
 }
 
+std::unordered_map<std::string, uint64_t> MessageCache::get_dropped_messages_per_topic()
+{
+  std::lock_guard<std::mutex> lock(producer_buffer_mutex_);
+  return {messages_dropped_per_topic_.begin(), messages_dropped_per_topic_.end()};
+}
+
+size_t MessageCache::get_producer_buffer_bytes()
+{
+  std::lock_guard<std::mutex> lock(producer_buffer_mutex_);
+  return producer_buffer_->bytes_size();
+}
+
 void MessageCache::log_dropped()
 {
   uint64_t total_lost = 0;
@@ -55,6 +55,11 @@ size_t MessageCacheBuffer::size()
   return buffer_.size();
 }
 
+size_t MessageCacheBuffer::bytes_size() const
+{
+  return buffer_bytes_size_;
+}
+
 const std::vector<CacheBufferInterface::buffer_element_t> & MessageCacheBuffer::data()
 {
   return buffer_;
@@ -0,0 +1,131 @@
+// Copyright 2022 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROSBAG2_CPP__CDR_READER_HPP_
+#define ROSBAG2_CPP__CDR_READER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+namespace rosbag2_cpp
+{
+namespace cdr
+{
+
+// CDR encapsulation header: two bytes representation identifier, two bytes options
+constexpr size_t kEncapsulationSize = 4;
+
+template<typename T>
+T read_cdr(const uint8_t * data, bool little_endian)
+{
+  uint8_t bytes[sizeof(T)];
+  std::memcpy(bytes, data, sizeof(T));
+  const uint16_t probe = 1;
+  const bool host_little_endian = *reinterpret_cast<const uint8_t *>(&probe) == 1;
+  if (host_little_endian != little_endian) {
+    for (size_t i = 0; i < sizeof(T) / 2; ++i) {
+      std::swap(bytes[i], bytes[sizeof(T) - 1 - i]);
+    }
+  }
+  T value;
+  std::memcpy(&value, bytes, sizeof(T));
+  return value;
+}
+
+/**
+ * Bounds checked cursor over a plain (XCDR1) CDR serialized message.
+ *
+ * Alignment is relative to the end of the encapsulation header. All operations return false
+ * instead of reading past the end of the buffer, in which case the cursor is left unchanged.
+ */
+class CdrReader
+{
+public:
+  /// Returns false if the buffer doesn't start with a plain CDR encapsulation header.
+  bool reset(const uint8_t * buffer, size_t length)
+  {
+    if (buffer == nullptr || length < kEncapsulationSize || buffer[0] != 0 || buffer[1] > 1) {
+      return false;
+    }
+    buffer_ = buffer;
+    length_ = length;
+    position_ = kEncapsulationSize;
+    // The second byte of the representation identifier is 1 for little endian CDR.
+    little_endian_ = buffer[1] == 1;
+    return true;
+  }
+
+  bool align(size_t alignment)
+  {
+    const size_t misalignment = (position_ - kEncapsulationSize) % alignment;
+    return misalignment == 0 || advance(alignment - misalignment);
+  }
+
+  bool advance(size_t size)
+  {
+    if (size > length_ - position_) {
+      return false;
+    }
+    position_ += size;
+    return true;
+  }
+
+  /// Skip count elements of the given size, aligned to their size capped at 8 bytes.
+  bool skip_elements(size_t element_size, size_t count)
+  {
+    if (count == 0) {
+      return true;
+    }
+    const size_t saved_position = position_;
+    if (!align(element_size < 8 ? element_size : 8) ||
+      count > (length_ - position_) / element_size)
+    {
+      position_ = saved_position;
+      return false;
+    }
+    position_ += count * element_size;
+    return true;
+  }
+
+  template<typename T>
+  bool read(T & value)
+  {
+    const size_t saved_position = position_;
+    if (!align(sizeof(T)) || sizeof(T) > length_ - position_) {
+      position_ = saved_position;
+      return false;
+    }
+    value = read_cdr<T>(buffer_ + position_, little_endian_);
+    position_ += sizeof(T);
+    return true;
+  }
+
+  size_t remaining() const
+  {
+    return length_ - position_;
+  }
+
+private:
+  const uint8_t * buffer_ = nullptr;
+  size_t length_ = 0;
+  size_t position_ = 0;
+  bool little_endian_ = true;
+};
+
+}  // namespace cdr
+}  // namespace rosbag2_cpp
+
+#endif  // ROSBAG2_CPP__CDR_READER_HPP_
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <atomic>
 #include <condition_variable>
 #include <memory>
 #include <mutex>
@@ -56,56 +57,70 @@ public:
     std::chrono::steady_clock::time_point steady;
   };
 
+  /// Everything needed to compute the current ROS time.
+  struct State
+  {
+    TimeReference reference;
+    double rate = 1.0;
+    bool paused = false;
+  };
+
   explicit TimeControllerClockImpl(
     PlayerClock::NowFunction now_fn,
     std::chrono::milliseconds sleep_time_while_paused,
     bool start_paused)
   : now_fn(now_fn),
     sleep_time_while_paused(sleep_time_while_paused),
-    paused(start_paused)
+    state{{0, std::chrono::steady_clock::time_point{}}, 1.0, start_paused}
   {}
   virtual ~TimeControllerClockImpl() = default;
 
   /// Return the total nanoseconds of an arbitrary duration type.
   template<typename T>
-  rcutils_duration_value_t duration_nanos(const T & duration) const
+  static rcutils_duration_value_t duration_nanos(const T & duration)
   {
     return std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
   }
 
-  /// Convert an arbitrary SteadyTime to a ROSTime, based on the current reference snapshot.
-  rcutils_time_point_value_t steady_to_ros(std::chrono::steady_clock::time_point steady_time) const
-  RCPPUTILS_TSA_REQUIRES(state_mutex)
+  /// Convert an arbitrary SteadyTime to a ROSTime, based on the given reference snapshot.
+  static rcutils_time_point_value_t steady_to_ros(
+    const State & from_state, std::chrono::steady_clock::time_point steady_time)
   {
-    return reference.ros + static_cast<rcutils_duration_value_t>(
-      rate * duration_nanos(steady_time - reference.steady));
+    return from_state.reference.ros + static_cast<rcutils_duration_value_t>(
+      from_state.rate * duration_nanos(steady_time - from_state.reference.steady));
   }
 
-  /// Convert an arbitrary ROSTime to a SteadyTime, based on the current reference snapshot.
-  std::chrono::steady_clock::time_point ros_to_steady(rcutils_time_point_value_t ros_time) const
-  RCPPUTILS_TSA_REQUIRES(state_mutex)
+  /// Convert an arbitrary ROSTime to a SteadyTime, based on the given reference snapshot.
+  static std::chrono::steady_clock::time_point ros_to_steady(
+    const State & from_state, rcutils_time_point_value_t ros_time)
   {
     const auto diff_nanos = static_cast<rcutils_duration_value_t>(
-      (ros_time - reference.ros) / rate);
-    return reference.steady + std::chrono::nanoseconds(diff_nanos);
+      (ros_time - from_state.reference.ros) / from_state.rate);
+    return from_state.reference.steady + std::chrono::nanoseconds(diff_nanos);
+  }
+
+  /// Return the current ROS time right now, based on the given settings.
+  rcutils_time_point_value_t ros_now(const State & from_state) const
+  {
+    if (from_state.paused) {
+      return from_state.reference.ros;
+    }
+    return steady_to_ros(from_state, now_fn());
   }
 
   /// Return the current ROS time right now, based on current settings.
   rcutils_time_point_value_t ros_now() const
   RCPPUTILS_TSA_REQUIRES(state_mutex)
   {
-    if (paused) {
-      return reference.ros;
-    }
-    return steady_to_ros(now_fn());
+    return ros_now(state);
   }
 
   /// Take a new reference snapshot, matching `ros_time` to the current steady time
   void snapshot(rcutils_time_point_value_t ros_time)
   RCPPUTILS_TSA_REQUIRES(state_mutex)
   {
-    reference.ros = ros_time;
-    reference.steady = now_fn();
+    state.reference.ros = ros_time;
+    state.reference.steady = now_fn();
   }
 
   /**
@@ -118,6 +133,61 @@ public:
     snapshot(ros_now());
   }
 
+  /**
+   * Mark the start of a state modification for lock-free readers.
+   * Must be called before taking any snapshot for the update, so that no reader can combine a
+   * steady time sampled after the snapshot with the state from before the update.
+   * Writers are serialized by state_mutex; the sequence counter only protects readers.
+   */
+  void begin_state_update()
+  RCPPUTILS_TSA_REQUIRES(state_mutex)
+  {
+    sequence.fetch_add(1, std::memory_order_relaxed);  // odd: update in progress
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+  }
+
+  /// Publish the modified state to lock-free readers and mark the update as finished.
+  void end_state_update()
+  RCPPUTILS_TSA_REQUIRES(state_mutex)
+  {
+    published_ros.store(state.reference.ros, std::memory_order_relaxed);
+    published_steady.store(
+      state.reference.steady.time_since_epoch().count(), std::memory_order_relaxed);
+    published_rate.store(state.rate, std::memory_order_relaxed);
+    published_paused.store(state.paused, std::memory_order_relaxed);
+    sequence.fetch_add(1, std::memory_order_release);  // even: update complete
+  }
+
+  /**
+   * Evaluate `fn` on a consistent copy of the published state without taking state_mutex.
+   * `fn` is retried if the state was modified while it was running, so it must not have
+   * side effects.
+   */
+  template<typename FunctionT>
+  auto read_state(FunctionT fn) const
+  {
+    State snapshot_copy;
+    uint32_t seq_begin = 0;
+    uint32_t seq_end = 0;
+    while (true) {
+      seq_begin = sequence.load(std::memory_order_acquire);
+      if (seq_begin & 1u) {
+        continue;
+      }
+      snapshot_copy.reference.ros = published_ros.load(std::memory_order_relaxed);
+      snapshot_copy.reference.steady = std::chrono::steady_clock::time_point(
+        std::chrono::steady_clock::duration(published_steady.load(std::memory_order_relaxed)));
+      snapshot_copy.rate = published_rate.load(std::memory_order_relaxed);
+      snapshot_copy.paused = published_paused.load(std::memory_order_relaxed);
+      auto result = fn(snapshot_copy);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      seq_end = sequence.load(std::memory_order_relaxed);
+      if (seq_begin == seq_end) {
+        return result;
+      }
+    }
+  }
+
   /**
    * \brief Adjust internal clock to the specified timestamp.
    * \details It will change the current internally maintained offset so that next published time
@@ -128,7 +198,9 @@ public:
   void jump(rcutils_time_point_value_t ros_time)
   {
     std::lock_guard<std::mutex> lock(state_mutex);
+    begin_state_update();
     snapshot(ros_time);
+    end_state_update();
     cv.notify_all();
   }
 
@@ -137,9 +209,14 @@ public:
 
   std::mutex state_mutex;
   std::condition_variable cv RCPPUTILS_TSA_GUARDED_BY(state_mutex);
-  double rate RCPPUTILS_TSA_GUARDED_BY(state_mutex) = 1.0;
-  bool paused RCPPUTILS_TSA_GUARDED_BY(state_mutex) = false;
-  TimeReference reference RCPPUTILS_TSA_GUARDED_BY(state_mutex);
+  State state RCPPUTILS_TSA_GUARDED_BY(state_mutex);
+
+  // Seqlock-protected copy of `state` for lock-free readers, written only under state_mutex
+  std::atomic<uint32_t> sequence{0};
+  std::atomic<rcutils_time_point_value_t> published_ros{0};
+  std::atomic<std::chrono::steady_clock::rep> published_steady{0};
+  std::atomic<double> published_rate{1.0};
+  std::atomic<bool> published_paused{false};
 };
 
 TimeControllerClock::TimeControllerClock(
@@ -153,8 +230,9 @@ TimeControllerClock::TimeControllerClock(
     throw std::invalid_argument("TimeControllerClock now_fn must be non-empty.");
   }
   std::lock_guard<std::mutex> lock(impl_->state_mutex);
-  impl_->reference.ros = starting_time;
-  impl_->reference.steady = impl_->now_fn();
+  impl_->begin_state_update();
+  impl_->snapshot(starting_time);
+  impl_->end_state_update();
 }
 
 TimeControllerClock::~TimeControllerClock()
@@ -162,21 +240,22 @@ TimeControllerClock::~TimeControllerClock()
 
 rcutils_time_point_value_t TimeControllerClock::now() const
 {
-  std::lock_guard<std::mutex> lock(impl_->state_mutex);
-  return impl_->ros_now();
+  // Steady time is sampled inside the read so that it is consistent with the reference
+  return impl_->read_state(
+    [this](const TimeControllerClockImpl::State & state) {return impl_->ros_now(state);});
 }
 
 bool TimeControllerClock::sleep_until(rcutils_time_point_value_t until)
 {
   {
     TSAUniqueLock lock(impl_->state_mutex);
-    if (impl_->paused) {
+    if (impl_->state.paused) {
       impl_->cv.wait_for(lock, impl_->sleep_time_while_paused);
     } else {
-      const auto steady_until = impl_->ros_to_steady(until);
+      const auto steady_until = impl_->ros_to_steady(impl_->state, until);
       impl_->cv.wait_until(lock, steady_until);
     }
-    if (impl_->paused) {
+    if (impl_->state.paused) {
       // Don't allow publishing any messages while paused
       // even if the time was technically reached by the time of wakeup
       return false;
@@ -196,49 +275,55 @@ bool TimeControllerClock::set_rate(double rate)
     return false;
   }
   std::lock_guard<std::mutex> lock(impl_->state_mutex);
-  if (impl_->rate == rate) {
+  if (impl_->state.rate == rate) {
     return true;
   }
+  impl_->begin_state_update();
   impl_->snapshot();
-  impl_->rate = rate;
+  impl_->state.rate = rate;
+  impl_->end_state_update();
   impl_->cv.notify_all();
   return true;
 }
 
 double TimeControllerClock::get_rate() const
 {
-  std::lock_guard<std::mutex> lock(impl_->state_mutex);
-  return impl_->rate;
+  return impl_->read_state(
+    [](const TimeControllerClockImpl::State & state) {return state.rate;});
 }
 
 void TimeControllerClock::pause()
 {
   std::lock_guard<std::mutex> lock(impl_->state_mutex);
-  if (impl_->paused) {
+  if (impl_->state.paused) {
     return;
   }
   // Take snapshot before changing state
+  impl_->begin_state_update();
   impl_->snapshot();
-  impl_->paused = true;
+  impl_->state.paused = true;
+  impl_->end_state_update();
   impl_->cv.notify_all();
 }
 
 void TimeControllerClock::resume()
 {
   std::lock_guard<std::mutex> lock(impl_->state_mutex);
-  if (!impl_->paused) {
+  if (!impl_->state.paused) {
     return;
   }
   // Take snapshot before changing state
+  impl_->begin_state_update();
   impl_->snapshot();
-  impl_->paused = false;
+  impl_->state.paused = false;
+  impl_->end_state_update();
   impl_->cv.notify_all();
 }
 
 bool TimeControllerClock::is_paused() const
 {
-  std::lock_guard<std::mutex> lock(impl_->state_mutex);
-  return impl_->paused;
+  return impl_->read_state(
+    [](const TimeControllerClockImpl::State & state) {return state.paused;});
 }
 
 void TimeControllerClock::jump(rcutils_time_point_value_t ros_time)
@@ -0,0 +1,571 @@
+// Copyright 2022 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rosbag2_cpp/field_projection.hpp"
+
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "rosidl_typesupport_introspection_cpp/field_types.hpp"
+#include "rosidl_typesupport_introspection_cpp/identifier.hpp"
+#include "rosidl_typesupport_introspection_cpp/message_introspection.hpp"
+
+#include "rosbag2_cpp/reader.hpp"
+#include "rosbag2_cpp/typesupport_helpers.hpp"
+
+#include "rosbag2_storage/storage_filter.hpp"
+
+#include "./cdr_reader.hpp"
+
+namespace
+{
+using rosidl_typesupport_introspection_cpp::MessageMember;
+using rosidl_typesupport_introspection_cpp::MessageMembers;
+
+constexpr size_t kNoColumn = std::numeric_limits<size_t>::max();
+
+// Size of a primitive type in CDR, 0 for strings and messages
+size_t primitive_size(uint8_t type_id)
+{
+  namespace ti = rosidl_typesupport_introspection_cpp;
+  switch (type_id) {
+    case ti::ROS_TYPE_BOOLEAN:
+    case ti::ROS_TYPE_OCTET:
+    case ti::ROS_TYPE_UINT8:
+    case ti::ROS_TYPE_INT8:
+    case ti::ROS_TYPE_CHAR:
+      return 1;
+    case ti::ROS_TYPE_UINT16:
+    case ti::ROS_TYPE_INT16:
+      return 2;
+    case ti::ROS_TYPE_FLOAT:
+    case ti::ROS_TYPE_UINT32:
+    case ti::ROS_TYPE_INT32:
+    case ti::ROS_TYPE_WCHAR:
+      return 4;
+    case ti::ROS_TYPE_DOUBLE:
+    case ti::ROS_TYPE_UINT64:
+    case ti::ROS_TYPE_INT64:
+      return 8;
+    case ti::ROS_TYPE_LONG_DOUBLE:
+      return 16;
+    default:
+      return 0;
+  }
+}
+
+// Whether values of the type can be a column
+bool is_numeric(uint8_t type_id)
+{
+  return primitive_size(type_id) > 0 &&
+         type_id != rosidl_typesupport_introspection_cpp::ROS_TYPE_LONG_DOUBLE;
+}
+
+const MessageMembers * nested_members(const MessageMember & member)
+{
+  return static_cast<const MessageMembers *>(member.members_->data);
+}
+
+bool is_fixed_array(const MessageMember & member)
+{
+  return member.is_array_ && member.array_size_ > 0 && !member.is_upper_bound_;
+}
+
+std::string type_name(const MessageMembers * members)
+{
+  return std::string(members->message_namespace_) + "::" + members->message_name_;
+}
+
+template<typename T>
+bool read_as_double(rosbag2_cpp::cdr::CdrReader & reader, double & value)
+{
+  T raw;
+  if (!reader.read(raw)) {
+    return false;
+  }
+  value = static_cast<double>(raw);
+  return true;
+}
+
+bool read_value(rosbag2_cpp::cdr::CdrReader & reader, uint8_t type_id, double & value)
+{
+  namespace ti = rosidl_typesupport_introspection_cpp;
+  switch (type_id) {
+    case ti::ROS_TYPE_BOOLEAN:
+      {
+        uint8_t raw;
+        if (!reader.read(raw)) {
+          return false;
+        }
+        value = raw != 0 ? 1.0 : 0.0;
+        return true;
+      }
+    case ti::ROS_TYPE_OCTET:
+    case ti::ROS_TYPE_UINT8:
+    case ti::ROS_TYPE_CHAR:
+      return read_as_double<uint8_t>(reader, value);
+    case ti::ROS_TYPE_INT8:
+      return read_as_double<int8_t>(reader, value);
+    case ti::ROS_TYPE_UINT16:
+      return read_as_double<uint16_t>(reader, value);
+    case ti::ROS_TYPE_INT16:
+      return read_as_double<int16_t>(reader, value);
+    case ti::ROS_TYPE_UINT32:
+    case ti::ROS_TYPE_WCHAR:
+      return read_as_double<uint32_t>(reader, value);
+    case ti::ROS_TYPE_INT32:
+      return read_as_double<int32_t>(reader, value);
+    case ti::ROS_TYPE_UINT64:
+      return read_as_double<uint64_t>(reader, value);
+    case ti::ROS_TYPE_INT64:
+      return read_as_double<int64_t>(reader, value);
+    case ti::ROS_TYPE_FLOAT:
+      return read_as_double<float>(reader, value);
+    case ti::ROS_TYPE_DOUBLE:
+      return read_as_double<double>(reader, value);
+    default:
+      return false;
+  }
+}
+
+bool read_count(rosbag2_cpp::cdr::CdrReader & reader, const MessageMember & member, size_t & count)
+{
+  if (is_fixed_array(member)) {
+    count = member.array_size_;
+    return true;
+  }
+  uint32_t length;
+  if (!reader.read(length)) {
+    return false;
+  }
+  count = length;
+  return true;
+}
+
+bool skip_message(rosbag2_cpp::cdr::CdrReader & reader, const MessageMembers * members);
+
+// Skip a single value of the type of the member, i.e. an element if it is an array
+bool skip_value(rosbag2_cpp::cdr::CdrReader & reader, const MessageMember & member)
+{
+  namespace ti = rosidl_typesupport_introspection_cpp;
+  switch (member.type_id_) {
+    case ti::ROS_TYPE_STRING:
+      {
+        // The length includes the null terminator
+        uint32_t length;
+        return reader.read(length) && reader.advance(length);
+      }
+    case ti::ROS_TYPE_WSTRING:
+      {
+        // Wide characters are serialized with four bytes each
+        uint32_t length;
+        return reader.read(length) && reader.skip_elements(4, length);
+      }
+    case ti::ROS_TYPE_MESSAGE:
+      return skip_message(reader, nested_members(member));
+    default:
+      return reader.skip_elements(primitive_size(member.type_id_), 1);
+  }
+}
+
+bool skip_values(
+  rosbag2_cpp::cdr::CdrReader & reader, const MessageMember & member, size_t count)
+{
+  const size_t size = primitive_size(member.type_id_);
+  if (size > 0) {
+    return reader.skip_elements(size, count);
+  }
+  for (size_t i = 0; i < count; ++i) {
+    if (!skip_value(reader, member)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool skip_member(rosbag2_cpp::cdr::CdrReader & reader, const MessageMember & member)
+{
+  if (!member.is_array_) {
+    return skip_value(reader, member);
+  }
+  size_t count;
+  return read_count(reader, member, count) && skip_values(reader, member, count);
+}
+
+bool skip_message(rosbag2_cpp::cdr::CdrReader & reader, const MessageMembers * members)
+{
+  for (uint32_t i = 0; i < members->member_count_; ++i) {
+    if (!skip_member(reader, members->members_[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+}  // namespace
+
+namespace rosbag2_cpp
+{
+
+// Members of a message to walk, up to the last one containing a selected field
+struct FieldProjection::MessagePlan
+{
+  struct PathElement
+  {
+    std::string name;
+    bool has_index = false;
+    size_t index = 0;
+  };
+
+  // What to extract from a member, or from one of its elements if it is an array
+  struct Selection
+  {
+    size_t column = kNoColumn;
+    std::unique_ptr<MessagePlan> message;
+    // Selected elements of an array member, by index
+    std::map<size_t, Selection> elements;
+
+    bool empty() const
+    {
+      return column == kNoColumn && !message && elements.empty();
+    }
+
+    void set_missing(double * values) const
+    {
+      if (column != kNoColumn) {
+        values[column] = std::numeric_limits<double>::quiet_NaN();
+      }
+      if (message) {
+        message->set_missing(values);
+      }
+      for (const auto & element : elements) {
+        element.second.set_missing(values);
+      }
+    }
+  };
+
+  explicit MessagePlan(const MessageMembers * members)
+  : members(members)
+  {}
+
+  static std::vector<PathElement> parse(const std::string & path)
+  {
+    std::vector<PathElement> elements;
+    std::istringstream stream(path);
+    std::string token;
+    while (std::getline(stream, token, '.')) {
+      PathElement element;
+      const auto bracket = token.find('[');
+      element.name = token.substr(0, bracket);
+      if (bracket != std::string::npos) {
+        const auto index = token.substr(bracket + 1);
+        if (index.size() < 2 || index.back() != ']' ||
+          index.find_first_not_of("0123456789") != index.size() - 1)
+        {
+          throw std::runtime_error("Invalid index in field path '" + path + "'");
+        }
+        element.has_index = true;
+        element.index = std::stoul(index.substr(0, index.size() - 1));
+      }
+      if (element.name.empty()) {
+        throw std::runtime_error("Invalid field path '" + path + "'");
+      }
+      elements.push_back(element);
+    }
+    if (elements.empty()) {
+      throw std::runtime_error("Empty field path");
+    }
+    return elements;
+  }
+
+  // Select the field at path[depth:] below this message, naming its columns after name
+  void add_path(
+    const std::vector<PathElement> & path, size_t depth, const std::string & name,
+    std::vector<std::string> & names)
+  {
+    const auto & element = path[depth];
+    uint32_t index = 0;
+    while (index < members->member_count_ && element.name != members->members_[index].name_) {
+      ++index;
+    }
+    if (index == members->member_count_) {
+      throw std::runtime_error(
+              "Field '" + element.name + "' of '" + name + "' not found in " + type_name(members));
+    }
+    const auto & member = members->members_[index];
+    if (selections.size() <= index) {
+      selections.resize(index + 1);
+    }
+    auto & selection = selections[index];
+
+    if (element.has_index) {
+      if (!member.is_array_) {
+        throw std::runtime_error("Field '" + element.name + "' of '" + name + "' is no array");
+      }
+      if (is_fixed_array(member) && element.index >= member.array_size_) {
+        throw std::runtime_error("Index of '" + name + "' is out of bounds");
+      }
+      add_element(member, selection.elements[element.index], path, depth, name, names);
+    } else if (member.is_array_) {
+      if (depth + 1 < path.size() || !is_fixed_array(member)) {
+        throw std::runtime_error("Field '" + name + "' needs an index");
+      }
+      for (size_t i = 0; i < member.array_size_; ++i) {
+        add_element(
+          member, selection.elements[i], path, depth,
+          name + "[" + std::to_string(i) + "]", names);
+      }
+    } else {
+      add_element(member, selection, path, depth, name, names);
+    }
+  }
+
+  // Select path[depth + 1:] below a value of the type of member, which is the end of name
+  void add_element(
+    const MessageMember & member, Selection & selection,
+    const std::vector<PathElement> & path, size_t depth, const std::string & name,
+    std::vector<std::string> & names)
+  {
+    if (member.type_id_ == rosidl_typesupport_introspection_cpp::ROS_TYPE_MESSAGE) {
+      if (!selection.message) {
+        if (selection.column != kNoColumn) {
+          throw std::runtime_error("Field '" + name + "' is selected more than once");
+        }
+        selection.message = std::make_unique<MessagePlan>(nested_members(member));
+      }
+      if (depth + 1 < path.size()) {
+        selection.message->add_path(path, depth + 1, name, names);
+      } else {
+        selection.message->add_all(name, names);
+      }
+      return;
+    }
+    if (depth + 1 < path.size()) {
+      throw std::runtime_error("Field '" + path[depth].name + "' of '" + name + "' is no message");
+    }
+    if (!is_numeric(member.type_id_)) {
+      throw std::runtime_error("Field '" + name + "' is not numeric");
+    }
+    if (!selection.empty()) {
+      throw std::runtime_error("Field '" + name + "' is selected more than once");
+    }
+    selection.column = names.size();
+    names.push_back(name);
+  }
+
+  // Select all numeric fields of this message, except those in sequences
+  void add_all(const std::string & name, std::vector<std::string> & names)
+  {
+    for (uint32_t i = 0; i < members->member_count_; ++i) {
+      const auto & member = members->members_[i];
+      const bool is_message =
+        member.type_id_ == rosidl_typesupport_introspection_cpp::ROS_TYPE_MESSAGE;
+      if ((member.is_array_ && !is_fixed_array(member)) ||
+        (!is_message && !is_numeric(member.type_id_)))
+      {
+        continue;
+      }
+      std::vector<PathElement> path{{member.name_, false, 0}};
+      add_path(path, 0, name + "." + member.name_, names);
+    }
+  }
+
+  void set_missing(double * values) const
+  {
+    for (const auto & selection : selections) {
+      selection.set_missing(values);
+    }
+  }
+
+  // Walk a message of this type. If is_tail, nothing after this message has to be read, and
+  // the walk stops after the last selected field.
+  bool read(cdr::CdrReader & reader, double * values, bool is_tail) const
+  {
+    for (size_t i = 0; i < selections.size(); ++i) {
+      const auto & member = members->members_[i];
+      const auto & selection = selections[i];
+      const bool member_is_tail = is_tail && i + 1 == selections.size();
+      if (selection.empty()) {
+        if (!skip_member(reader, member)) {
+          return false;
+        }
+      } else if (!member.is_array_) {
+        if (!read_element(reader, member, selection, values, member_is_tail)) {
+          return false;
+        }
+      } else if (!read_elements(reader, member, selection, values, member_is_tail)) {
+        return false;
+      }
+    }
+    if (!is_tail) {
+      for (size_t i = selections.size(); i < members->member_count_; ++i) {
+        if (!skip_member(reader, members->members_[i])) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  static bool read_element(
+    cdr::CdrReader & reader, const MessageMember & member, const Selection & selection,
+    double * values, bool is_tail)
+  {
+    if (selection.column != kNoColumn) {
+      return read_value(reader, member.type_id_, values[selection.column]);
+    }
+    return selection.message->read(reader, values, is_tail);
+  }
+
+  static bool read_elements(
+    cdr::CdrReader & reader, const MessageMember & member, const Selection & selection,
+    double * values, bool is_tail)
+  {
+    size_t count;
+    if (!read_count(reader, member, count)) {
+      return false;
+    }
+    size_t next = 0;
+    for (auto it = selection.elements.begin(); it != selection.elements.end(); ++it) {
+      if (it->first >= count) {
+        it->second.set_missing(values);
+        continue;
+      }
+      const bool element_is_tail = is_tail && std::next(it) == selection.elements.end();
+      if (!skip_values(reader, member, it->first - next) ||
+        !read_element(reader, member, it->second, values, element_is_tail))
+      {
+        return false;
+      }
+      next = it->first + 1;
+    }
+    return is_tail || next >= count || skip_values(reader, member, count - next);
+  }
+
+  const MessageMembers * members;
+  std::vector<Selection> selections;
+};
+
+FieldProjection::FieldProjection(
+  const std::string & type, const std::vector<std::string> & field_paths)
+: library_(
+    get_typesupport_library(type, rosidl_typesupport_introspection_cpp::typesupport_identifier))
+{
+  compile(
+    get_typesupport_handle(
+      type, rosidl_typesupport_introspection_cpp::typesupport_identifier, library_),
+    field_paths);
+}
+
+FieldProjection::FieldProjection(
+  const rosidl_message_type_support_t * introspection_ts,
+  const std::vector<std::string> & field_paths)
+{
+  compile(introspection_ts, field_paths);
+}
+
+FieldProjection::~FieldProjection() = default;
+
+FieldProjection::FieldProjection(FieldProjection &&) = default;
+
+FieldProjection & FieldProjection::operator=(FieldProjection &&) = default;
+
+const std::vector<std::string> & FieldProjection::names() const
+{
+  return names_;
+}
+
+size_t FieldProjection::size() const
+{
+  return names_.size();
+}
+
+void FieldProjection::compile(
+  const rosidl_message_type_support_t * introspection_ts,
+  const std::vector<std::string> & field_paths)
+{
+  plan_ = std::make_unique<MessagePlan>(
+    static_cast<const MessageMembers *>(introspection_ts->data));
+  for (const auto & path : field_paths) {
+    plan_->add_path(MessagePlan::parse(path), 0, path, names_);
+  }
+}
+
+bool FieldProjection::extract(const rcutils_uint8_array_t & serialized_data, double * values) const
+{
+  cdr::CdrReader reader;
+  return reader.reset(serialized_data.buffer, serialized_data.buffer_length) &&
+         plan_->read(reader, values, true);
+}
+
+ProjectedFields project_fields(
+  Reader & reader, const std::string & topic_name, const std::vector<std::string> & field_paths)
+{
+  std::string type;
+  for (const auto & topic : reader.get_all_topics_and_types()) {
+    if (topic.name == topic_name) {
+      if (topic.serialization_format != "cdr") {
+        throw std::runtime_error(
+                "Fields can only be projected from CDR serialized messages, topic '" +
+                topic_name + "' is serialized as " + topic.serialization_format);
+      }
+      type = topic.type;
+    }
+  }
+  if (type.empty()) {
+    throw std::runtime_error("Topic '" + topic_name + "' not found in bag");
+  }
+
+  FieldProjection projection(type, field_paths);
+  ProjectedFields fields;
+  fields.names = projection.names();
+  fields.columns.resize(projection.size());
+  for (const auto & topic : reader.get_metadata().topics_with_message_count) {
+    if (topic.topic_metadata.name == topic_name) {
+      fields.time_stamps.reserve(topic.message_count);
+      for (auto & column : fields.columns) {
+        column.reserve(topic.message_count);
+      }
+    }
+  }
+
+  rosbag2_storage::StorageFilter filter;
+  filter.topics = {topic_name};
+  reader.set_filter(filter);
+
+  std::vector<double> values(projection.size());
+  while (reader.has_next()) {
+    const auto message = reader.read_next();
+    if (!projection.extract(*message->serialized_data, values.data())) {
+      std::stringstream error;
+      error << "Failed to project fields of message on topic '" << topic_name << "' at " <<
+        message->time_stamp << ", it is not valid CDR for " << type;
+      throw std::runtime_error(error.str());
+    }
+    fields.time_stamps.push_back(message->time_stamp);
+    for (size_t i = 0; i < values.size(); ++i) {
+      fields.columns[i].push_back(values[i]);
+    }
+  }
+  return fields;
+}
+
+}  // namespace rosbag2_cpp
@@ -0,0 +1,85 @@
+// Copyright 2022 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "rosbag2_cpp/header_stamp.hpp"
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#include "rosidl_typesupport_introspection_cpp/field_types.hpp"
+#include "rosidl_typesupport_introspection_cpp/identifier.hpp"
+#include "rosidl_typesupport_introspection_cpp/message_introspection.hpp"
+
+#include "rosbag2_cpp/typesupport_helpers.hpp"
+
+#include "./cdr_reader.hpp"
+
+namespace
+{
+// builtin_interfaces/msg/Time is int32 sec followed by uint32 nanosec
+constexpr size_t kStampSize = 8;
+}  // namespace
+
+namespace rosbag2_cpp
+{
+
+bool type_starts_with_header(const std::string & type)
+{
+  using rosidl_typesupport_introspection_cpp::MessageMembers;
+  try {
+    auto library = get_typesupport_library(
+      type, rosidl_typesupport_introspection_cpp::typesupport_identifier);
+    auto type_support = get_typesupport_handle(
+      type, rosidl_typesupport_introspection_cpp::typesupport_identifier, library);
+    auto members = static_cast<const MessageMembers *>(type_support->data);
+    if (members->member_count_ == 0) {
+      return false;
+    }
+    const auto & first = members->members_[0];
+    if (first.type_id_ != rosidl_typesupport_introspection_cpp::ROS_TYPE_MESSAGE ||
+      first.is_array_ || first.members_ == nullptr)
+    {
+      return false;
+    }
+    auto nested = static_cast<const MessageMembers *>(first.members_->data);
+    return std::string(nested->message_namespace_) == "std_msgs::msg" &&
+           std::string(nested->message_name_) == "Header";
+  } catch (const std::runtime_error &) {
+    return false;
+  }
+}
+
+bool read_cdr_header_stamp(
+  const rcutils_uint8_array_t & serialized_data, rcutils_time_point_value_t & stamp)
+{
+  if (serialized_data.buffer == nullptr ||
+    serialized_data.buffer_length < cdr::kEncapsulationSize + kStampSize)
+  {
+    return false;
+  }
+  // The second byte of the representation identifier is 1 for little endian CDR.
+  // The stamp is the first member and already aligned, offsets are relative to the
+  // end of the encapsulation header.
+  const bool little_endian = serialized_data.buffer[1] == 1;
+  const uint8_t * data = serialized_data.buffer + cdr::kEncapsulationSize;
+  auto sec = cdr::read_cdr<int32_t>(data, little_endian);
+  auto nanosec = cdr::read_cdr<uint32_t>(data + sizeof(int32_t), little_endian);
+  stamp = RCUTILS_S_TO_NS(static_cast<rcutils_time_point_value_t>(sec)) +
+    static_cast<rcutils_time_point_value_t>(nanosec);
+  return true;
+}
+
+}  // namespace rosbag2_cpp
@@ -14,14 +14,226 @@
 
 #include "rosbag2_cpp/info.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "rosbag2_cpp/readers/sequential_reader.hpp"
 
 #include "rosbag2_storage/metadata_io.hpp"
+#include "rosbag2_storage/storage_filter.hpp"
 #include "rosbag2_storage/storage_interfaces/read_only_interface.hpp"
 #include "rosbag2_storage/storage_factory.hpp"
 
+namespace
+{
+using TopicStatistics = rosbag2_cpp::TopicStatistics;
+
+// Gap threshold and gap limit of each topic
+struct GapDetection
+{
+  std::unordered_map<std::string, rcutils_duration_value_t> thresholds;
+  size_t max_gaps_per_topic;
+};
+
+size_t log2_bucket(uint64_t value)
+{
+  size_t bucket = 0;
+  while (value >>= 1) {
+    ++bucket;
+  }
+  return bucket;
+}
+
+void add_to_histogram(std::vector<uint64_t> & histogram, size_t bucket, uint64_t count = 1)
+{
+  if (histogram.size() <= bucket) {
+    histogram.resize(bucket + 1, 0);
+  }
+  histogram[bucket] += count;
+}
+
+void add_period(
+  TopicStatistics & topic,
+  rcutils_time_point_value_t from,
+  rcutils_time_point_value_t to,
+  const GapDetection & gap_detection)
+{
+  const rcutils_duration_value_t period = to - from;
+  if (period < 0) {
+    // Consecutive files may overlap by a few messages
+    return;
+  }
+  if (topic.period_histogram.empty()) {
+    topic.min_period = topic.max_period = period;
+  } else {
+    topic.min_period = std::min(topic.min_period, period);
+    topic.max_period = std::max(topic.max_period, period);
+  }
+  add_to_histogram(topic.period_histogram, log2_bucket(static_cast<uint64_t>(period / 1000)));
+
+  auto threshold = gap_detection.thresholds.find(topic.topic_name);
+  if (threshold != gap_detection.thresholds.end() && period > threshold->second) {
+    ++topic.gap_count;
+    if (topic.gaps.size() < gap_detection.max_gaps_per_topic) {
+      topic.gaps.push_back({from, to});
+    }
+  }
+}
+
+void add_message(
+  TopicStatistics & topic,
+  const rosbag2_storage::SerializedBagMessage & message,
+  const GapDetection & gap_detection)
+{
+  const uint64_t size = message.serialized_data->buffer_length;
+  if (topic.message_count == 0) {
+    topic.first_timestamp = message.time_stamp;
+    topic.min_message_size = topic.max_message_size = size;
+  } else {
+    add_period(topic, topic.last_timestamp, message.time_stamp, gap_detection);
+    topic.min_message_size = std::min(topic.min_message_size, size);
+    topic.max_message_size = std::max(topic.max_message_size, size);
+  }
+  topic.last_timestamp = message.time_stamp;
+  ++topic.message_count;
+  topic.total_bytes += size;
+  add_to_histogram(topic.message_size_histogram, log2_bucket(size));
+}
+
+// Append the statistics of a topic in a later file to those of the earlier files
+void append_statistics(
+  TopicStatistics & topic,
+  const TopicStatistics & later,
+  const GapDetection & gap_detection)
+{
+  if (later.message_count == 0) {
+    return;
+  }
+  if (topic.message_count == 0) {
+    topic = later;
+    return;
+  }
+
+  // The period between the files is a period of the topic like any other
+  add_period(topic, topic.last_timestamp, later.first_timestamp, gap_detection);
+  if (!later.period_histogram.empty()) {
+    if (topic.period_histogram.empty()) {
+      topic.min_period = later.min_period;
+      topic.max_period = later.max_period;
+    } else {
+      topic.min_period = std::min(topic.min_period, later.min_period);
+      topic.max_period = std::max(topic.max_period, later.max_period);
+    }
+    for (size_t i = 0; i < later.period_histogram.size(); ++i) {
+      add_to_histogram(topic.period_histogram, i, later.period_histogram[i]);
+    }
+  }
+  topic.gap_count += later.gap_count;
+  for (const auto & gap : later.gaps) {
+    if (topic.gaps.size() >= gap_detection.max_gaps_per_topic) {
+      break;
+    }
+    topic.gaps.push_back(gap);
+  }
+
+  topic.min_message_size = std::min(topic.min_message_size, later.min_message_size);
+  topic.max_message_size = std::max(topic.max_message_size, later.max_message_size);
+  for (size_t i = 0; i < later.message_size_histogram.size(); ++i) {
+    add_to_histogram(topic.message_size_histogram, i, later.message_size_histogram[i]);
+  }
+  topic.last_timestamp = std::max(topic.last_timestamp, later.last_timestamp);
+  topic.message_count += later.message_count;
+  topic.total_bytes += later.total_bytes;
+}
+
+std::map<std::string, TopicStatistics> scan_file(
+  rosbag2_storage::storage_interfaces::ReadOnlyInterface & storage,
+  const GapDetection & gap_detection)
+{
+  rosbag2_storage::StorageFilter storage_filter;
+  storage_filter.skip_serialized_data = true;
+  storage.set_filter(storage_filter);
+
+  std::map<std::string, TopicStatistics> topics;
+  while (storage.has_next()) {
+    auto message = storage.read_next();
+    auto & topic = topics[message->topic_name];
+    if (topic.message_count == 0) {
+      topic.topic_name = message->topic_name;
+    }
+    add_message(topic, *message, gap_detection);
+  }
+  return topics;
+}
+
+// Scan the files concurrently and merge their statistics in file order
+std::map<std::string, TopicStatistics> scan_files(
+  const std::vector<std::string> & files,
+  const std::string & storage_id,
+  size_t num_threads,
+  const GapDetection & gap_detection)
+{
+  rosbag2_storage::StorageFactory factory;
+  std::mutex factory_mutex;
+  std::vector<std::map<std::string, TopicStatistics>> file_statistics(files.size());
+  std::vector<std::exception_ptr> errors(files.size());
+  std::atomic<size_t> next_file{0};
+  std::atomic<bool> failed{false};
+
+  auto scan_next_files = [&]() {
+      for (size_t i = next_file++; i < files.size() && !failed; i = next_file++) {
+        try {
+          std::shared_ptr<rosbag2_storage::storage_interfaces::ReadOnlyInterface> storage;
+          {
+            // Plugin loading is not thread safe, only opening is serialized, not reading
+            std::lock_guard<std::mutex> lock(factory_mutex);
+            storage = factory.open_read_only({files[i], storage_id});
+          }
+          if (!storage) {
+            throw std::runtime_error("The bag file " + files[i] + " could not be opened.");
+          }
+          file_statistics[i] = scan_file(*storage, gap_detection);
+        } catch (...) {
+          errors[i] = std::current_exception();
+          failed = true;
+        }
+      }
+    };
+
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < num_threads; ++i) {
+    threads.emplace_back(scan_next_files);
+  }
+  scan_next_files();
+  for (auto & thread : threads) {
+    thread.join();
+  }
+  for (const auto & error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+  // Merge in file order, periods and gaps across file boundaries depend on it
+  std::map<std::string, TopicStatistics> topics;
+  for (const auto & statistics : file_statistics) {
+    for (const auto & topic : statistics) {
+      append_statistics(topics[topic.first], topic.second, gap_detection);
+    }
+  }
+  return topics;
+}
+}  // namespace
+
 namespace rosbag2_cpp
 {
 
@@ -49,4 +261,59 @@ rosbag2_storage::BagMetadata Info::read_metadata(
           "storage id of the bagfile to query it directly");
 }
 
+BagStatistics Info::read_statistics(
+  const std::string & uri, const std::string & storage_id,
+  const BagStatisticsOptions & options)
+{
+  const auto metadata = read_metadata(uri, storage_id);
+  if (metadata.compression_mode == "FILE") {
+    throw std::runtime_error("Statistics of FILE compressed bags are not supported.");
+  }
+
+  rosbag2_storage::MetadataIo metadata_io;
+  std::vector<std::string> files{uri};
+  if (metadata_io.metadata_file_exists(uri)) {
+    files = readers::details::resolve_relative_paths(
+      uri, metadata.relative_file_paths, metadata.version);
+  }
+  const auto file_storage_id =
+    metadata.storage_identifier.empty() ? storage_id : metadata.storage_identifier;
+
+  const size_t max_threads = options.num_threads > 0 ?
+    options.num_threads : std::max(1u, std::thread::hardware_concurrency());
+  const size_t num_threads = std::min(files.size(), max_threads);
+
+  // A gap is judged by the mean period of its topic, which is only known once all messages of the
+  // topic are scanned. The duration of the whole bag would hide the gaps of topics which were only
+  // published for part of it. So a second scan finds the gaps, if the longest periods show that
+  // there are any.
+  GapDetection gap_detection;
+  gap_detection.max_gaps_per_topic = options.max_gaps_per_topic;
+  auto topics = scan_files(files, file_storage_id, num_threads, gap_detection);
+  for (const auto & topic : topics) {
+    const auto & statistics = topic.second;
+    const rcutils_duration_value_t span = statistics.last_timestamp - statistics.first_timestamp;
+    if (statistics.message_count < 2 || span <= 0) {
+      continue;
+    }
+    const double mean_period =
+      static_cast<double>(span) / static_cast<double>(statistics.message_count - 1);
+    const auto threshold = static_cast<rcutils_duration_value_t>(options.gap_factor * mean_period);
+    if (statistics.max_period > threshold) {
+      gap_detection.thresholds[topic.first] = threshold;
+    }
+  }
+  if (!gap_detection.thresholds.empty()) {
+    topics = scan_files(files, file_storage_id, num_threads, gap_detection);
+  }
+
+  BagStatistics bag_statistics;
+  for (auto & topic : topics) {
+    bag_statistics.message_count += topic.second.message_count;
+    bag_statistics.total_bytes += topic.second.total_bytes;
+    bag_statistics.topics.push_back(std::move(topic.second));
+  }
+  return bag_statistics;
+}
+
 }  // namespace rosbag2_cpp
@@ -0,0 +1,149 @@
+// Copyright 2022 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rosbag2_cpp/rate_overview.hpp"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace rosbag2_cpp
+{
+
+RateOverviewCollector::RateOverviewCollector(
+  std::chrono::nanoseconds bucket_duration, size_t max_buckets)
+: max_buckets_(std::max<size_t>(max_buckets, 1)),
+  bucket_duration_(bucket_duration.count())
+{}
+
+void RateOverviewCollector::reset(std::chrono::nanoseconds bucket_duration)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  bucket_duration_ = bucket_duration.count();
+  starting_time_ = 0;
+  num_buckets_ = 0;
+  topic_indices_.clear();
+  topics_.clear();
+}
+
+void RateOverviewCollector::add(
+  const std::string & topic_name, rcutils_time_point_value_t time_stamp, uint64_t size)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (bucket_duration_ <= 0) {
+    return;
+  }
+  const size_t bucket = bucket_index(time_stamp);
+
+  auto topic_index = topic_indices_.find(topic_name);
+  if (topic_index == topic_indices_.end()) {
+    topic_index = topic_indices_.emplace(topic_name, topics_.size()).first;
+    rosbag2_storage::TopicRateOverview topic;
+    topic.topic_name = topic_name;
+    topic.message_counts.resize(num_buckets_, 0);
+    topic.message_bytes.resize(num_buckets_, 0);
+    topics_.push_back(std::move(topic));
+  }
+  auto & topic = topics_[topic_index->second];
+  ++topic.message_counts[bucket];
+  topic.message_bytes[bucket] += size;
+}
+
+rosbag2_storage::RateOverview RateOverviewCollector::get_overview() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  rosbag2_storage::RateOverview overview;
+  if (bucket_duration_ <= 0 || num_buckets_ == 0) {
+    return overview;
+  }
+  overview.starting_time = std::chrono::time_point<std::chrono::high_resolution_clock>(
+    std::chrono::nanoseconds(starting_time_));
+  overview.bucket_duration = std::chrono::nanoseconds(bucket_duration_);
+  overview.topics = topics_;
+  std::sort(
+    overview.topics.begin(), overview.topics.end(),
+    [](const rosbag2_storage::TopicRateOverview & a, const rosbag2_storage::TopicRateOverview & b)
+    {
+      return a.topic_name < b.topic_name;
+    });
+  return overview;
+}
+
+rcutils_time_point_value_t RateOverviewCollector::bucket_start(
+  rcutils_time_point_value_t time_stamp) const
+{
+  auto remainder = time_stamp % bucket_duration_;
+  if (remainder < 0) {
+    remainder += bucket_duration_;
+  }
+  return time_stamp - remainder;
+}
+
+size_t RateOverviewCollector::bucket_index(rcutils_time_point_value_t time_stamp)
+{
+  if (num_buckets_ == 0) {
+    starting_time_ = bucket_start(time_stamp);
+  }
+
+  rcutils_time_point_value_t first_start;
+  size_t needed_buckets;
+  while (true) {
+    first_start = std::min(starting_time_, bucket_start(time_stamp));
+    const auto end = std::max(
+      starting_time_ + static_cast<int64_t>(num_buckets_) * bucket_duration_,
+      bucket_start(time_stamp) + bucket_duration_);
+    needed_buckets = static_cast<size_t>((end - first_start) / bucket_duration_);
+    if (needed_buckets <= max_buckets_) {
+      break;
+    }
+    coarsen();
+  }
+
+  // Messages may arrive slightly out of order, earlier buckets are prepended
+  const auto prepended_buckets = static_cast<size_t>((starting_time_ - first_start) /
+    bucket_duration_);
+  for (auto & topic : topics_) {
+    topic.message_counts.insert(topic.message_counts.begin(), prepended_buckets, 0);
+    topic.message_bytes.insert(topic.message_bytes.begin(), prepended_buckets, 0);
+    topic.message_counts.resize(needed_buckets, 0);
+    topic.message_bytes.resize(needed_buckets, 0);
+  }
+  starting_time_ = first_start;
+  num_buckets_ = needed_buckets;
+  return static_cast<size_t>((time_stamp - starting_time_) / bucket_duration_);
+}
+
+void RateOverviewCollector::coarsen()
+{
+  const int64_t coarse_duration = bucket_duration_ * 2;
+  // Keep the coarse buckets aligned, the first fine bucket may be the second half of one
+  const size_t offset = starting_time_ % coarse_duration == 0 ? 0 : 1;
+  const size_t coarse_buckets = (num_buckets_ + offset + 1) / 2;
+  for (auto & topic : topics_) {
+    std::vector<uint64_t> counts(coarse_buckets, 0);
+    std::vector<uint64_t> bytes(coarse_buckets, 0);
+    for (size_t i = 0; i < num_buckets_; ++i) {
+      counts[(i + offset) / 2] += topic.message_counts[i];
+      bytes[(i + offset) / 2] += topic.message_bytes[i];
+    }
+    topic.message_counts = std::move(counts);
+    topic.message_bytes = std::move(bytes);
+  }
+  starting_time_ -= static_cast<int64_t>(offset) * bucket_duration_;
+  bucket_duration_ = coarse_duration;
+  num_buckets_ = coarse_buckets;
+}
+
+}  // namespace rosbag2_cpp
@@ -52,6 +52,21 @@ void Reader::open(
   reader_impl_->open(storage_options, converter_options);
 }
 
+void Reader::open(const BagCatalogEntry & entry, const ConverterOptions & converter_options)
+{
+  rosbag2_storage::StorageOptions storage_options;
+  storage_options.uri = entry.uri;
+  storage_options.storage_id = entry.storage_identifier;
+  reader_impl_->open(storage_options, converter_options);
+
+  rosbag2_storage::StorageFilter storage_filter;
+  for (const auto & topic : entry.topics) {
+    storage_filter.topics.push_back(topic.topic_metadata.name);
+  }
+  reader_impl_->set_filter(storage_filter);
+  reader_impl_->seek(entry.start_time);
+}
+
 void Reader::close()
 {
   reader_impl_->close();
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <chrono>
 #include <memory>
 #include <stdexcept>
 #include <string>
@@ -32,7 +33,7 @@ namespace readers
 namespace details
 {
 std::vector<std::string> resolve_relative_paths(
-  const std::string & base_folder, std::vector<std::string> relative_files, const int version = 4)
+  const std::string & base_folder, std::vector<std::string> relative_files, const int version)
 {
   auto base_path = rcpputils::fs::path(base_folder);
   if (version < 4) {
@@ -199,8 +200,13 @@ void SequentialReader::seek(const rcutils_time_point_value_t & timestamp)
 {
   seek_time_ = timestamp;
   if (storage_) {
-    // reset to the first file
+    // reset to the first file which has messages at or after the timestamp
     current_file_iterator_ = file_paths_.begin();
+    while (current_file_iterator_ + 1 != file_paths_.end() &&
+      can_skip_file(current_file_iterator_ - file_paths_.begin()))
+    {
+      current_file_iterator_++;
+    }
     load_current_file();
     return;
   }
@@ -210,7 +216,43 @@ void SequentialReader::seek(const rcutils_time_point_value_t & timestamp)
 
 bool SequentialReader::has_next_file() const
 {
-  return current_file_iterator_ + 1 != file_paths_.end();
+  return find_next_file() != file_paths_.end();
+}
+
+bool SequentialReader::can_skip_file(size_t file_index) const
+{
+  // Older bags don't record which topics a file holds
+  if (metadata_.version < 7 || metadata_.files.size() != file_paths_.size()) {
+    return false;
+  }
+  const auto & file = metadata_.files[file_index];
+  if (file.message_count == 0) {
+    return true;
+  }
+  const auto file_end = std::chrono::duration_cast<std::chrono::nanoseconds>(
+    (file.starting_time + file.duration).time_since_epoch()).count();
+  if (file_end < seek_time_) {
+    return true;
+  }
+  if (topics_filter_.topics.empty()) {
+    return false;
+  }
+  for (const auto & topic : topics_filter_.topics) {
+    const auto count = file.topic_message_counts.find(topic);
+    if (count != file.topic_message_counts.end() && count->second > 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::vector<std::string>::iterator SequentialReader::find_next_file() const
+{
+  auto file = current_file_iterator_ + 1;
+  while (file != file_paths_.end() && can_skip_file(file - file_paths_.begin())) {
+    file++;
+  }
+  return file;
 }
 
 void SequentialReader::load_current_file()
@@ -237,7 +279,7 @@ void SequentialReader::load_next_file()
   assert(current_file_iterator_ != file_paths_.end());
   auto info = std::make_shared<bag_events::BagSplitInfo>();
   info->closed_file = get_current_file();
-  current_file_iterator_++;
+  current_file_iterator_ = find_next_file();
   info->opened_file = get_current_file();
   load_current_file();
   callback_manager_.execute_callbacks(bag_events::BagEvent::READ_SPLIT, info);
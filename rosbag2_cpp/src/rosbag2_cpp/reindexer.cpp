@@ -21,12 +21,15 @@
 // This notice must appear in all copies of this file and its derivatives.
 
 #include <algorithm>
+#include <atomic>
+#include <exception>
 #include <iostream>
 #include <map>
 #include <memory>
 #include <regex>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -49,7 +52,8 @@ Reindexer::Reindexer(
 : storage_factory_(std::move(storage_factory)),
   metadata_io_(std::move(metadata_io))
 {
-  regex_bag_pattern_ = R"(.+_(\d+)\.([a-zA-Z0-9])+)";
+  // The optional second extension is the one a compressor appends to the files it compressed
+  regex_bag_pattern_ = R"(.+_(\d+)\.([a-zA-Z0-9])+(\.[a-zA-Z0-9]+)?)";
 }
 
 /// Determine which path should be placed first in a vector ordered by file number.
@@ -122,12 +126,31 @@ void Reindexer::get_bag_files(
     }
   } while (rcutils_dir_iter_next(dir_iter));
 
-  // Sort relative file path by database number
+  // Sort relative file path by database number.
+  // Reading a file compressed bag leaves the decompressed files next to the compressed ones.
+  // Both have the same number, sort the compressed file first since it is the one recorded.
   std::sort(
     output.begin(), output.end(),
     [&, this](rcpputils::fs::path a, rcpputils::fs::path b) {
-      return compare_relative_file(a, b);
+      if (compare_relative_file(a, b)) {
+        return true;
+      }
+      if (compare_relative_file(b, a)) {
+        return false;
+      }
+      return a.string().size() > b.string().size();
+    });
+
+  // Drop the decompressed duplicates
+  auto duplicate = std::unique(
+    output.begin(), output.end(),
+    [this](const rcpputils::fs::path & a, const rcpputils::fs::path & b) {
+      return !compare_relative_file(a, b) && !compare_relative_file(b, a);
     });
+  for (auto it = duplicate; it != output.end(); ++it) {
+    ROSBAG2_CPP_LOG_DEBUG_STREAM("Ignoring file with duplicate number: " << it->string());
+  }
+  output.erase(duplicate, output.end());
 }
 
 /// Prepare a fresh BagMetadata object for reindexing.
@@ -152,53 +175,134 @@ void Reindexer::init_metadata(
   }
 }
 
-/// Iterate through the bag files to collect various metadata parameters
+std::shared_ptr<rosbag2_storage::storage_interfaces::ReadOnlyInterface> Reindexer::open_storage(
+  const rcpputils::fs::path & file,
+  const rosbag2_storage::StorageOptions & storage_options)
+{
+  rosbag2_storage::StorageOptions file_storage_options = storage_options;
+  file_storage_options.uri = file.string();
+
+  std::shared_ptr<rosbag2_storage::storage_interfaces::ReadOnlyInterface> storage;
+  {
+    // Plugin loading is not thread safe, only opening is serialized, not reading
+    std::lock_guard<std::mutex> lock(storage_factory_mutex_);
+    storage = storage_factory_->open_read_only(file_storage_options);
+  }
+  if (!storage) {
+    throw std::runtime_error("No storage could be initialized for " + file.string());
+  }
+  return storage;
+}
+
+rosbag2_storage::BagMetadata Reindexer::get_file_metadata(
+  const rcpputils::fs::path & file,
+  const rosbag2_storage::StorageOptions & storage_options)
+{
+  // The storage already keeps the statistics we need, there is no need to read any message
+  return open_storage(file, storage_options)->get_metadata();
+}
+
+/// Collect the metadata of each bag file, using one thread per file up to the number of cores
 /**
- * Collects the topic metadata, `starting_time`, and `duration` portions of the `BagMetadata`
- * being constructed
  * @param: files The list of bag files to reindex
- * @param: storage_options Used to construct the `Reader` needed to parse the bag files
+ * @param: storage_options Used to open the bag files
+ * @return The metadata of each file, in the order of files
  */
-void Reindexer::aggregate_metadata(
+std::vector<rosbag2_storage::BagMetadata> Reindexer::collect_file_metadata(
   const std::vector<rcpputils::fs::path> & files,
-  const std::unique_ptr<rosbag2_cpp::readers::SequentialReader> & bag_reader,
   const rosbag2_storage::StorageOptions & storage_options)
 {
-  std::map<std::string, rosbag2_storage::TopicInformation> temp_topic_info;
-
-  // In order to most accurately reconstruct the metadata, we need to
-  // visit each of the contained relative files files in the bag,
-  // open them, read the info, and write it into an aggregated metadata object.
-  ROSBAG2_CPP_LOG_DEBUG_STREAM("Extracting metadata from database(s)");
-  for (const auto & f_ : files) {
-    ROSBAG2_CPP_LOG_DEBUG_STREAM("Extracting from file: " + f_.string());
-
-    metadata_.bag_size += f_.file_size();
-
-    // Set up reader
-    rosbag2_storage::StorageOptions temp_so = {
-      f_.string(),
-      storage_options.storage_id,
-      storage_options.max_bagfile_size,
-      storage_options.max_bagfile_duration,
-      storage_options.max_cache_size,
-      storage_options.storage_config_uri
+  std::vector<rosbag2_storage::BagMetadata> file_metadata(files.size());
+  std::vector<std::exception_ptr> errors(files.size());
+  std::atomic<size_t> next_file{0};
+  std::atomic<bool> failed{false};
+
+  auto extract_files = [&]() {
+      for (size_t i = next_file++; i < files.size() && !failed; i = next_file++) {
+        ROSBAG2_CPP_LOG_DEBUG_STREAM("Extracting from file: " << files[i].string());
+        try {
+          file_metadata[i] = get_file_metadata(files[i], storage_options);
+        } catch (...) {
+          errors[i] = std::current_exception();
+          failed = true;
+        }
+      }
     };
 
-    // We aren't actually interested in reading messages, so use a blank converter option
-    rosbag2_cpp::ConverterOptions blank_converter_options {};
-    bag_reader->open(temp_so, blank_converter_options);
-    auto temp_metadata = bag_reader->get_metadata();
+  const size_t num_threads = std::min<size_t>(
+    files.size(), std::max(1u, std::thread::hardware_concurrency()));
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < num_threads; ++i) {
+    threads.emplace_back(extract_files);
+  }
+  extract_files();
+  for (auto & thread : threads) {
+    thread.join();
+  }
+
+  // Report the error of the first failing file, whichever thread hit it first
+  for (const auto & error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+  return file_metadata;
+}
 
-    if (temp_metadata.starting_time < metadata_.starting_time) {
-      metadata_.starting_time = temp_metadata.starting_time;
+/// Aggregate the metadata collected from the bag files
+/**
+ * Collects the topic metadata, `starting_time`, `duration`, `files` and compression portions
+ * of the `BagMetadata` being constructed. Files are merged in order, so when files disagree on
+ * the metadata of a topic the last file wins.
+ * @param: files The list of bag files to reindex
+ * @param: file_metadata The metadata of each of the files
+ */
+void Reindexer::aggregate_metadata(
+  const std::vector<rcpputils::fs::path> & files,
+  const std::vector<rosbag2_storage::BagMetadata> & file_metadata)
+{
+  std::map<std::string, rosbag2_storage::TopicInformation> temp_topic_info;
+  auto ending_time = std::chrono::time_point<std::chrono::high_resolution_clock>::min();
+
+  ROSBAG2_CPP_LOG_DEBUG_STREAM("Aggregating metadata from database(s)");
+  for (size_t i = 0; i < files.size(); ++i) {
+    const auto & temp_metadata = file_metadata[i];
+
+    metadata_.bag_size += files[i].file_size();
+    metadata_.files.push_back(
+      {
+        metadata_.relative_file_paths[i],
+        temp_metadata.starting_time,
+        temp_metadata.duration,
+        temp_metadata.message_count,
+        {}
+      });
+
+    // Empty files report a starting time of 0, which must not count as the start of the bag
+    if (temp_metadata.message_count > 0) {
+      metadata_.starting_time = std::min(metadata_.starting_time, temp_metadata.starting_time);
+      ending_time = std::max(ending_time, temp_metadata.starting_time + temp_metadata.duration);
     }
-    metadata_.duration += temp_metadata.duration;
-    ROSBAG2_CPP_LOG_DEBUG_STREAM("New duration: " + std::to_string(metadata_.duration.count()));
     metadata_.message_count += temp_metadata.message_count;
 
+    if (i == 0) {
+      metadata_.compression_format = temp_metadata.compression_format;
+      metadata_.compression_mode = temp_metadata.compression_mode;
+    } else if (
+      temp_metadata.compression_format != metadata_.compression_format ||
+      temp_metadata.compression_mode != metadata_.compression_mode)
+    {
+      throw std::runtime_error(
+              "Bag file " + files[i].string() + " is compressed differently than " +
+              files[0].string() + ". Abort");
+    }
+
     // Add the topic metadata
     for (const auto & topic : temp_metadata.topics_with_message_count) {
+      if (topic.message_count > 0) {
+        metadata_.files.back().topic_message_counts[topic.topic_metadata.name] =
+          topic.message_count;
+      }
       auto found_topic = temp_topic_info.find(topic.topic_metadata.name);
       if (found_topic == temp_topic_info.end()) {
         // It's a new topic. Add it.
@@ -220,9 +324,15 @@ void Reindexer::aggregate_metadata(
         }
       }
     }
+  }
 
-    bag_reader->close();
+  if (metadata_.message_count == 0) {
+    metadata_.starting_time = std::chrono::time_point<std::chrono::high_resolution_clock>();
+    metadata_.duration = std::chrono::nanoseconds(0);
+  } else {
+    metadata_.duration = ending_time - metadata_.starting_time;
   }
+  ROSBAG2_CPP_LOG_DEBUG_STREAM("Duration: " + std::to_string(metadata_.duration.count()));
 
   // Convert the topic map into topic metadata
   for (auto & topic : temp_topic_info) {
@@ -233,7 +343,8 @@ void Reindexer::aggregate_metadata(
 /// Reconstruct a bag's `metadata.yaml` file from the enclosed bag files.
 /**
  * The reindexer opens the files within the bag directory and uses the metadata of the files to
- * reconstruct the metadata file. Currently does not support compressed bags.
+ * reconstruct the metadata file. The files are opened concurrently. Compressed bags are
+ * supported by rosbag2_compression::CompressionReindexer.
  * @param: storage_options The best-guess original storage options for the bag
  */
 void Reindexer::reindex(const rosbag2_storage::StorageOptions & storage_options)
@@ -241,10 +352,6 @@ void Reindexer::reindex(const rosbag2_storage::StorageOptions & storage_options)
   base_folder_ = storage_options.uri;
   ROSBAG2_CPP_LOG_INFO_STREAM("Beginning reindexing bag in directory: " << base_folder_);
 
-  auto metadata_io_default = std::make_unique<rosbag2_storage::MetadataIo>();
-  auto bag_reader = std::make_unique<rosbag2_cpp::readers::SequentialReader>(
-    std::move(storage_factory_), converter_factory_, std::move(metadata_io_default));
-
   // Identify all bag files
   std::vector<rcpputils::fs::path> files;
   get_bag_files(base_folder_, files);
@@ -256,7 +363,10 @@ void Reindexer::reindex(const rosbag2_storage::StorageOptions & storage_options)
   ROSBAG2_CPP_LOG_DEBUG_STREAM("Completed init_metadata");
 
   // Collect all metadata from database files
-  aggregate_metadata(files, bag_reader, storage_options);
+  auto file_metadata = collect_file_metadata(files, storage_options);
+  ROSBAG2_CPP_LOG_DEBUG_STREAM("Completed collect_file_metadata");
+
+  aggregate_metadata(files, file_metadata);
   ROSBAG2_CPP_LOG_DEBUG_STREAM("Completed aggregate_metadata");
 
   metadata_io_->write_metadata(base_folder_.string(), metadata_);
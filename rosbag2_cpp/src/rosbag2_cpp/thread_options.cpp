@@ -0,0 +1,138 @@
+// Copyright 2022 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <pthread.h>
+#endif
+#ifdef __linux__
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "rosbag2_cpp/logging.hpp"
+#include "rosbag2_cpp/thread_options.hpp"
+
+namespace
+{
+// Thread names are limited to 16 characters including the terminating null on Linux
+constexpr size_t kMaxThreadNameLength = 15;
+
+void set_current_thread_name(const std::string & name)
+{
+  const auto truncated_name = name.substr(0, kMaxThreadNameLength);
+#if defined(__linux__)
+  pthread_setname_np(pthread_self(), truncated_name.c_str());
+#elif defined(__APPLE__)
+  pthread_setname_np(truncated_name.c_str());
+#else
+  (void)truncated_name;
+#endif
+}
+
+#ifdef __linux__
+void apply_thread_options(
+  const std::string & thread_class, const rosbag2_cpp::ThreadOptions & options)
+{
+  if (!options.cpu_affinity.empty()) {
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (int cpu : options.cpu_affinity) {
+      if (cpu < 0 || cpu >= CPU_SETSIZE) {
+        ROSBAG2_CPP_LOG_WARN_STREAM(
+          "Ignoring invalid CPU " << cpu << " in affinity of " << thread_class << " thread");
+        continue;
+      }
+      CPU_SET(cpu, &cpu_set);
+    }
+    int ret = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+    if (ret != 0) {
+      ROSBAG2_CPP_LOG_WARN_STREAM(
+        "Failed to set CPU affinity of " << thread_class << " thread: " << std::strerror(ret));
+    }
+  }
+
+  if (options.fifo_priority > 0) {
+    sched_param param{};
+    param.sched_priority = options.fifo_priority;
+    int ret = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+    if (ret != 0) {
+      ROSBAG2_CPP_LOG_WARN_STREAM(
+        "Failed to set SCHED_FIFO priority " << options.fifo_priority << " of " <<
+          thread_class << " thread: " << std::strerror(ret));
+    }
+  } else if (options.nice != 0) {
+    // On Linux the nice level is a per thread attribute, addressed by the thread id
+    auto tid = static_cast<id_t>(syscall(SYS_gettid));
+    if (setpriority(PRIO_PROCESS, tid, options.nice) != 0) {
+      ROSBAG2_CPP_LOG_WARN_STREAM(
+        "Failed to set nice level " << options.nice << " of " << thread_class << " thread: " <<
+          std::strerror(errno));
+    }
+  }
+}
+#else
+void apply_thread_options(
+  const std::string & thread_class, const rosbag2_cpp::ThreadOptions & options)
+{
+  if (!options.cpu_affinity.empty() || options.nice != 0 || options.fifo_priority != 0) {
+    ROSBAG2_CPP_LOG_WARN_STREAM(
+      "Thread options of " << thread_class << " thread are only supported on Linux");
+  }
+}
+#endif
+}  // namespace
+
+namespace rosbag2_cpp
+{
+
+void configure_current_thread(
+  const std::string & thread_class,
+  const ThreadOptionsMap & thread_options)
+{
+  set_current_thread_name(thread_class);
+  auto options = thread_options.find(thread_class);
+  if (options != thread_options.end()) {
+    apply_thread_options(thread_class, options->second);
+  }
+}
+
+}  // namespace rosbag2_cpp
+
+namespace YAML
+{
+Node convert<rosbag2_cpp::ThreadOptions>::encode(const rosbag2_cpp::ThreadOptions & thread_options)
+{
+  Node node;
+  node["cpu_affinity"] = thread_options.cpu_affinity;
+  node["nice"] = thread_options.nice;
+  node["fifo_priority"] = thread_options.fifo_priority;
+  return node;
+}
+
+bool convert<rosbag2_cpp::ThreadOptions>::decode(
+  const Node & node, rosbag2_cpp::ThreadOptions & thread_options)
+{
+  optional_assign<std::vector<int>>(node, "cpu_affinity", thread_options.cpu_affinity);
+  optional_assign<int>(node, "nice", thread_options.nice);
+  optional_assign<int>(node, "fifo_priority", thread_options.fifo_priority);
+  return true;
+}
+}  // namespace YAML
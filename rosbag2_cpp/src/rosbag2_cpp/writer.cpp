@@ -191,4 +191,15 @@ void Writer::add_event_callbacks(bag_events::WriterEventCallbacks & callbacks)
   writer_impl_->add_event_callbacks(callbacks);
 }
 
+WriterStatistics Writer::get_statistics()
+{
+  return writer_impl_->get_statistics();
+}
+
+void Writer::set_thread_options(const ThreadOptionsMap & thread_options)
+{
+  std::lock_guard<std::mutex> writer_lock(writer_mutex_);
+  writer_impl_->set_thread_options(thread_options);
+}
+
 }  // namespace rosbag2_cpp
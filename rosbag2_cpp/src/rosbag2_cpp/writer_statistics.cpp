@@ -0,0 +1,97 @@
+// Copyright 2022 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <vector>
+
+#include "rosbag2_cpp/writer_statistics.hpp"
+
+namespace
+{
+std::chrono::nanoseconds percentile(std::vector<std::chrono::nanoseconds> & samples, double p)
+{
+  // nearest-rank percentile
+  auto rank = static_cast<size_t>(p * static_cast<double>(samples.size() - 1) + 0.5);
+  std::nth_element(samples.begin(), samples.begin() + rank, samples.end());
+  return samples[rank];
+}
+}  // namespace
+
+namespace rosbag2_cpp
+{
+
+WriterStatisticsCollector::WriterStatisticsCollector(size_t max_latency_samples)
+: max_latency_samples_(max_latency_samples)
+{}
+
+void WriterStatisticsCollector::on_write(size_t num_messages, std::chrono::nanoseconds duration)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  write_batches_++;
+  max_batch_size_ = std::max<uint64_t>(max_batch_size_, num_messages);
+  messages_written_ += num_messages;
+  if (latencies_.size() < max_latency_samples_) {
+    latencies_.push_back(duration);
+  }
+}
+
+void WriterStatisticsCollector::on_split(std::chrono::nanoseconds duration)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  splits_++;
+  last_split_duration_ = duration;
+}
+
+void WriterStatisticsCollector::set_storage_dropped(uint64_t dropped_by_current_storage)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  storage_dropped_current_ = dropped_by_current_storage;
+}
+
+void WriterStatisticsCollector::on_storage_closed()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  storage_dropped_closed_ += storage_dropped_current_;
+  storage_dropped_current_ = 0;
+}
+
+void WriterStatisticsCollector::report(WriterStatistics & statistics)
+{
+  std::vector<std::chrono::nanoseconds> latencies;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    statistics.messages_dropped_storage = storage_dropped_closed_ + storage_dropped_current_;
+    statistics.write_batches = write_batches_;
+    statistics.max_batch_size = max_batch_size_;
+    statistics.messages_written = messages_written_;
+    statistics.splits = splits_;
+    statistics.last_split_duration = last_split_duration_;
+    write_batches_ = 0;
+    max_batch_size_ = 0;
+    messages_written_ = 0;
+    latencies.swap(latencies_);
+  }
+  // Sort outside of the lock, the writer must not wait for the statistics
+  if (latencies.empty()) {
+    statistics.write_latency_p50 = statistics.write_latency_p90 =
+      statistics.write_latency_p99 = statistics.write_latency_max = std::chrono::nanoseconds{0};
+    return;
+  }
+  statistics.write_latency_max = *std::max_element(latencies.begin(), latencies.end());
+  statistics.write_latency_p99 = percentile(latencies, 0.99);
+  statistics.write_latency_p90 = percentile(latencies, 0.90);
+  statistics.write_latency_p50 = percentile(latencies, 0.50);
+}
+
+}  // namespace rosbag2_cpp
@@ -26,6 +26,7 @@
 
 #include "rcpputils/filesystem_helper.hpp"
 
+#include "rosbag2_cpp/header_stamp.hpp"
 #include "rosbag2_cpp/info.hpp"
 #include "rosbag2_cpp/logging.hpp"
 
@@ -83,6 +84,8 @@ void SequentialWriter::open(
 {
   base_folder_ = storage_options.uri;
   storage_options_ = storage_options;
+  rate_overview_collector_.reset(
+    std::chrono::milliseconds(storage_options.rate_overview_bucket_duration));
 
   if (converter_options.output_serialization_format !=
     converter_options.input_serialization_format)
@@ -128,16 +131,19 @@ void SequentialWriter::open(
   }
 
   if (use_cache_) {
+    std::shared_ptr<rosbag2_cpp::cache::MessageCacheInterface> message_cache;
     if (storage_options.snapshot_mode) {
-      message_cache_ = std::make_shared<rosbag2_cpp::cache::CircularMessageCache>(
+      message_cache = std::make_shared<rosbag2_cpp::cache::CircularMessageCache>(
         storage_options.max_cache_size);
     } else {
-      message_cache_ = std::make_shared<rosbag2_cpp::cache::MessageCache>(
-        storage_options.max_cache_size);
+      message_cache = std::make_shared<rosbag2_cpp::cache::MessageCache>(
+        storage_options.max_cache_size, storage_options.block_on_full_cache);
     }
+    std::atomic_store(&message_cache_, message_cache);
     cache_consumer_ = std::make_unique<rosbag2_cpp::cache::CacheConsumer>(
-      message_cache_,
-      std::bind(&SequentialWriter::write_messages, this, std::placeholders::_1));
+      message_cache,
+      std::bind(&SequentialWriter::write_messages, this, std::placeholders::_1),
+      thread_options_);
   }
 
   init_metadata();
@@ -148,7 +154,7 @@ void SequentialWriter::close()
   if (use_cache_) {
     // destructor will flush message cache
     cache_consumer_.reset();
-    message_cache_.reset();
+    std::atomic_store(&message_cache_, {});
   }
 
   if (!base_folder_.empty()) {
@@ -196,6 +202,14 @@ void SequentialWriter::create_topic(const rosbag2_storage::TopicMetadata & topic
   if (converter_) {
     converter_->add_topic(topic_with_type.name, topic_with_type.type);
   }
+
+  if (storage_options_.index_header_stamps &&
+    topic_with_type.serialization_format == "cdr" &&
+    type_starts_with_header(topic_with_type.type))
+  {
+    std::lock_guard<std::mutex> lock(topics_info_mutex_);
+    topics_with_header_stamp_.insert(topic_with_type.name);
+  }
 }
 
 void SequentialWriter::remove_topic(const rosbag2_storage::TopicMetadata & topic_with_type)
@@ -208,6 +222,7 @@ void SequentialWriter::remove_topic(const rosbag2_storage::TopicMetadata & topic
   {
     std::lock_guard<std::mutex> lock(topics_info_mutex_);
     erased = topics_names_to_info_.erase(topic_with_type.name) > 0;
+    topics_with_header_stamp_.erase(topic_with_type.name);
   }
 
   if (erased) {
@@ -240,6 +255,8 @@ void SequentialWriter::switch_to_next_storage()
     cache_consumer_->stop();
     message_cache_->log_dropped();
   }
+  statistics_collector_.set_storage_dropped(storage_->get_number_of_dropped_messages());
+  statistics_collector_.on_storage_closed();
 
   storage_options_.uri = format_storage_uri(
     base_folder_,
@@ -266,6 +283,7 @@ void SequentialWriter::switch_to_next_storage()
 
 void SequentialWriter::split_bagfile()
 {
+  const auto split_start = std::chrono::steady_clock::now();
   auto info = std::make_shared<bag_events::BagSplitInfo>();
   info->closed_file = storage_->get_relative_file_path();
   switch_to_next_storage();
@@ -279,6 +297,7 @@ void SequentialWriter::split_bagfile()
   file_info.path = strip_parent_path(storage_->get_relative_file_path());
   metadata_.files.push_back(file_info);
 
+  statistics_collector_.on_split(std::chrono::steady_clock::now() - split_start);
   callback_manager_.execute_callbacks(bag_events::BagEvent::WRITE_SPLIT, info);
 }
 
@@ -315,28 +334,50 @@ void SequentialWriter::write(std::shared_ptr<rosbag2_storage::SerializedBagMessa
 
   metadata_.starting_time = std::min(metadata_.starting_time, message_timestamp);
 
-  metadata_.files.back().starting_time =
-    std::min(metadata_.files.back().starting_time, message_timestamp);
-  const auto duration = message_timestamp - metadata_.files.back().starting_time;
-  metadata_.duration = std::max(metadata_.duration, duration);
+  auto & file_info = metadata_.files.back();
+  // Readers skip files by their time range, so keep the end of the file when an earlier message
+  // moves its start
+  const auto file_end = file_info.message_count == 0 ? message_timestamp :
+    std::max(file_info.starting_time + file_info.duration, message_timestamp);
+  file_info.starting_time = std::min(file_info.starting_time, message_timestamp);
+  file_info.duration = file_end - file_info.starting_time;
 
-  const auto file_duration = message_timestamp - metadata_.files.back().starting_time;
-  metadata_.files.back().duration =
-    std::max(metadata_.files.back().duration, file_duration);
+  const auto duration = message_timestamp - file_info.starting_time;
+  metadata_.duration = std::max(metadata_.duration, duration);
 
+  index_header_stamp(*message);
   auto converted_msg = get_writeable_message(message);
+  converted_msg->has_header_stamp = message->has_header_stamp;
+  converted_msg->header_stamp = message->header_stamp;
 
-  metadata_.files.back().message_count++;
+  file_info.message_count++;
+  file_info.topic_message_counts[message->topic_name]++;
   if (storage_options_.max_cache_size == 0u) {
     // If cache size is set to zero, we write to storage directly
+    const auto write_start = std::chrono::steady_clock::now();
     storage_->write(converted_msg);
+    statistics_collector_.on_write(1, std::chrono::steady_clock::now() - write_start);
+    statistics_collector_.set_storage_dropped(storage_->get_number_of_dropped_messages());
     ++topic_information->message_count;
+    add_to_rate_overview(*converted_msg);
   } else {
     // Otherwise, use cache buffer
     message_cache_->push(converted_msg);
   }
 }
 
+void SequentialWriter::index_header_stamp(rosbag2_storage::SerializedBagMessage & message) const
+{
+  // Messages read from another bag may already carry their stamp
+  if (message.has_header_stamp || topics_with_header_stamp_.empty() ||
+    topics_with_header_stamp_.count(message.topic_name) == 0)
+  {
+    return;
+  }
+  message.has_header_stamp = message.serialized_data &&
+    read_cdr_header_stamp(*message.serialized_data, message.header_stamp);
+}
+
 bool SequentialWriter::take_snapshot()
 {
   if (!storage_options_.snapshot_mode) {
@@ -400,6 +441,8 @@ void SequentialWriter::finalize_metadata()
     metadata_.topics_with_message_count.push_back(topic.second);
     metadata_.message_count += topic.second.message_count;
   }
+
+  metadata_.rate_overview = rate_overview_collector_.get_overview();
 }
 
 void SequentialWriter::write_messages(
@@ -408,15 +451,45 @@ void SequentialWriter::write_messages(
   if (messages.empty()) {
     return;
   }
+  const auto write_start = std::chrono::steady_clock::now();
   storage_->write(messages);
+  statistics_collector_.on_write(messages.size(), std::chrono::steady_clock::now() - write_start);
+  statistics_collector_.set_storage_dropped(storage_->get_number_of_dropped_messages());
   std::lock_guard<std::mutex> lock(topics_info_mutex_);
   for (const auto & msg : messages) {
     if (topics_names_to_info_.find(msg->topic_name) != topics_names_to_info_.end()) {
       topics_names_to_info_[msg->topic_name].message_count++;
     }
+    add_to_rate_overview(*msg);
   }
 }
 
+void SequentialWriter::add_to_rate_overview(const rosbag2_storage::SerializedBagMessage & message)
+{
+  rate_overview_collector_.add(
+    message.topic_name, message.time_stamp,
+    message.serialized_data ? message.serialized_data->buffer_length : 0);
+}
+
+WriterStatistics SequentialWriter::get_statistics()
+{
+  WriterStatistics statistics;
+  statistics_collector_.report(statistics);
+  // close() may reset message_cache_ concurrently
+  auto message_cache = std::atomic_load(&message_cache_);
+  if (message_cache) {
+    statistics.messages_dropped_cache_full = message_cache->get_dropped_messages_per_topic();
+    statistics.cache_bytes = message_cache->get_producer_buffer_bytes();
+    statistics.cache_capacity_bytes = storage_options_.max_cache_size;
+  }
+  return statistics;
+}
+
+void SequentialWriter::set_thread_options(const ThreadOptionsMap & thread_options)
+{
+  thread_options_ = thread_options;
+}
+
 void SequentialWriter::add_event_callbacks(const bag_events::WriterEventCallbacks & callbacks)
 {
   if (callbacks.write_split_callback) {
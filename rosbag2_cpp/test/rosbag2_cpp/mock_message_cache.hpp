@@ -27,8 +27,8 @@
 class MockMessageCache : public rosbag2_cpp::cache::MessageCache
 {
 public:
-  explicit MockMessageCache(uint64_t max_buffer_size)
-  : rosbag2_cpp::cache::MessageCache(max_buffer_size) {}
+  explicit MockMessageCache(uint64_t max_buffer_size, bool block_on_full = false)
+  : rosbag2_cpp::cache::MessageCache(max_buffer_size, block_on_full) {}
 
   std::unordered_map<std::string, uint32_t> messages_dropped() const
   {
@@ -0,0 +1,241 @@
+// Copyright 2022 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+#include <sqlite3.h>
+
+#ifndef _WIN32
+# include <unistd.h>
+#endif
+
+#include <chrono>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "rcpputils/filesystem_helper.hpp"
+#include "rcutils/allocator.h"
+#include "rcutils/filesystem.h"
+
+#include "rosbag2_cpp/bag_catalog.hpp"
+
+#include "rosbag2_storage/bag_metadata.hpp"
+#include "rosbag2_storage/metadata_io.hpp"
+
+#include "rosbag2_test_common/temporary_directory_fixture.hpp"
+
+using namespace ::testing;  // NOLINT
+using namespace rosbag2_test_common;  // NOLINT
+
+class BagCatalogTest : public TemporaryDirectoryFixture
+{
+public:
+  BagCatalogTest()
+  : bags_path_(rcpputils::fs::path(temporary_dir_path_) / "bags"),
+    catalog_path_((rcpputils::fs::path(temporary_dir_path_) / "catalog.db3").string())
+  {}
+
+  // Writes the metadata of a bag with one file per second, starting at start_s
+  std::string write_bag(
+    const std::string & relative_uri,
+    int64_t start_s,
+    size_t number_of_files,
+    const std::vector<std::string> & topics)
+  {
+    const auto uri = bags_path_ / relative_uri;
+    rcpputils::fs::create_directories(uri);
+
+    rosbag2_storage::BagMetadata metadata;
+    metadata.storage_identifier = "sqlite3";
+    metadata.starting_time = std::chrono::time_point<std::chrono::high_resolution_clock>(
+      std::chrono::seconds(start_s));
+    metadata.duration = std::chrono::seconds(number_of_files);
+    metadata.message_count = 0;
+    for (size_t i = 0; i < number_of_files; ++i) {
+      const auto path = relative_uri + "_" + std::to_string(i) + ".db3";
+      metadata.relative_file_paths.push_back(path);
+      metadata.files.push_back(
+        {path, metadata.starting_time + std::chrono::seconds(i), std::chrono::seconds(1), 10, {}});
+    }
+    for (const auto & topic : topics) {
+      metadata.topics_with_message_count.push_back(
+        {{topic, "test_msgs/msg/BasicTypes", "cdr", ""}, 10});
+      metadata.message_count += 10;
+    }
+    rosbag2_storage::MetadataIo().write_metadata(uri.string(), metadata);
+    return uri.string();
+  }
+
+  static rcutils_time_point_value_t seconds(int64_t s)
+  {
+    return s * 1000000000;
+  }
+
+  rcpputils::fs::path bags_path_;
+  std::string catalog_path_;
+};
+
+TEST_F(BagCatalogTest, queries_bags_and_files_by_topic_and_time) {
+  const auto early = write_bag("early", 100, 3, {"/lidar", "/camera"});
+  const auto late = write_bag("site/late", 200, 2, {"/lidar"});
+  const auto camera = write_bag("site/camera", 150, 4, {"/camera"});
+
+  rosbag2_cpp::BagCatalog catalog(catalog_path_);
+  EXPECT_EQ(catalog.index(bags_path_.string()), 3u);
+  EXPECT_EQ(catalog.size(), 3u);
+
+  rosbag2_cpp::BagCatalogQuery query;
+  query.topics = {"/lidar"};
+  auto entries = catalog.query(query);
+  ASSERT_THAT(entries, SizeIs(2));
+  EXPECT_EQ(entries[0].uri, early);
+  EXPECT_EQ(entries[0].storage_identifier, "sqlite3");
+  ASSERT_THAT(entries[0].topics, SizeIs(1));
+  EXPECT_EQ(entries[0].topics[0].topic_metadata.name, "/lidar");
+  EXPECT_EQ(entries[0].topics[0].message_count, 10u);
+  EXPECT_THAT(entries[0].files, SizeIs(3));
+  EXPECT_EQ(entries[1].uri, late);
+
+  // Only the second file of the early bag overlaps
+  query.start_time = seconds(101) + 500;
+  query.end_time = seconds(102) - 500;
+  entries = catalog.query(query);
+  ASSERT_THAT(entries, SizeIs(1));
+  EXPECT_EQ(entries[0].uri, early);
+  EXPECT_EQ(entries[0].start_time, query.start_time);
+  EXPECT_EQ(entries[0].end_time, query.end_time);
+  ASSERT_THAT(entries[0].files, SizeIs(1));
+  EXPECT_EQ(entries[0].files[0].path, "early_1.db3");
+  EXPECT_EQ(entries[0].files[0].duration, std::chrono::seconds(1));
+
+  // Without topics, bags match by time only and report all their topics
+  query.topics.clear();
+  query.start_time = seconds(150);
+  query.end_time = seconds(160);
+  entries = catalog.query(query);
+  ASSERT_THAT(entries, SizeIs(1));
+  EXPECT_EQ(entries[0].uri, camera);
+  EXPECT_EQ(entries[0].start_time, seconds(150));
+  EXPECT_EQ(entries[0].end_time, seconds(154));
+  EXPECT_THAT(entries[0].topics, SizeIs(1));
+  EXPECT_THAT(entries[0].files, SizeIs(4));
+
+  query.topics = {"/radar"};
+  query.start_time = INT64_MIN;
+  query.end_time = INT64_MAX;
+  EXPECT_THAT(catalog.query(query), IsEmpty());
+}
+
+TEST_F(BagCatalogTest, indexing_is_incremental) {
+  write_bag("first", 100, 1, {"/lidar"});
+  const auto second = write_bag("second", 200, 1, {"/lidar"});
+
+  {
+    rosbag2_cpp::BagCatalog catalog(catalog_path_);
+    EXPECT_EQ(catalog.index(bags_path_.string()), 2u);
+  }
+
+  // The catalog persists, unchanged bags are not indexed again
+  rosbag2_cpp::BagCatalog catalog(catalog_path_);
+  EXPECT_EQ(catalog.size(), 2u);
+  EXPECT_EQ(catalog.index(bags_path_.string()), 0u);
+
+  write_bag("second", 200, 1, {"/lidar", "/camera"});
+  rcpputils::fs::remove_all(bags_path_ / "first");
+  EXPECT_EQ(catalog.index(bags_path_.string()), 1u);
+  EXPECT_EQ(catalog.size(), 1u);
+
+  rosbag2_cpp::BagCatalogQuery query;
+  query.topics = {"/camera"};
+  const auto entries = catalog.query(query);
+  ASSERT_THAT(entries, SizeIs(1));
+  EXPECT_EQ(entries[0].uri, second);
+}
+
+TEST_F(BagCatalogTest, stores_sizes_of_bags_and_files) {
+  const auto bag = write_bag("bag", 100, 2, {"/lidar"});
+  {
+    std::ofstream file((rcpputils::fs::path(bag) / "bag_0.db3").string(), std::ios::binary);
+    file << std::string(100, 'x');
+  }
+
+  rosbag2_cpp::BagCatalog catalog(catalog_path_);
+  EXPECT_EQ(catalog.index(bags_path_.string()), 1u);
+  const auto entries = catalog.query({});
+  ASSERT_THAT(entries, SizeIs(1));
+  EXPECT_EQ(
+    entries[0].size,
+    rcutils_calculate_directory_size(bag.c_str(), rcutils_get_default_allocator()));
+  EXPECT_GT(entries[0].size, 100u);
+  // The second file doesn't exist
+  EXPECT_THAT(entries[0].file_sizes, ElementsAre(100u, 0u));
+}
+
+TEST_F(BagCatalogTest, failed_update_keeps_previous_entry) {
+  const auto bag = write_bag("bag", 100, 1, {"/lidar"});
+  rosbag2_cpp::BagCatalog catalog(catalog_path_);
+  EXPECT_EQ(catalog.index(bags_path_.string()), 1u);
+
+  // Fail indexing once the bag and its first file were written to the catalog
+  sqlite3 * database = nullptr;
+  ASSERT_EQ(sqlite3_open(catalog_path_.c_str(), &database), SQLITE_OK);
+  EXPECT_EQ(
+    sqlite3_exec(
+      database,
+      "CREATE TRIGGER fail_second_file BEFORE INSERT ON files WHEN NEW.path LIKE '%_1.db3' "
+      "BEGIN SELECT RAISE(ABORT, 'broken'); END;", nullptr, nullptr, nullptr),
+    SQLITE_OK);
+  sqlite3_close(database);
+
+  write_bag("bag", 100, 2, {"/lidar", "/camera"});
+  write_bag("new", 200, 2, {"/lidar"});
+  EXPECT_EQ(catalog.index(bags_path_.string()), 0u);
+
+  const auto entries = catalog.query({});
+  ASSERT_THAT(entries, SizeIs(1));
+  EXPECT_EQ(entries[0].uri, bag);
+  ASSERT_THAT(entries[0].topics, SizeIs(1));
+  EXPECT_EQ(entries[0].topics[0].topic_metadata.name, "/lidar");
+  ASSERT_THAT(entries[0].files, SizeIs(1));
+  EXPECT_EQ(entries[0].files[0].path, "bag_0.db3");
+}
+
+TEST_F(BagCatalogTest, index_bag_requires_metadata) {
+  rosbag2_cpp::BagCatalog catalog(catalog_path_);
+  rcpputils::fs::create_directories(bags_path_);
+  EXPECT_THROW(catalog.index_bag(bags_path_.string()), std::runtime_error);
+
+  const auto bag = write_bag("bag", 100, 1, {"/lidar"});
+  EXPECT_TRUE(catalog.index_bag(bag));
+  EXPECT_FALSE(catalog.index_bag(bag));
+  catalog.remove_bag(bag);
+  EXPECT_EQ(catalog.size(), 0u);
+}
+
+#ifndef _WIN32
+TEST_F(BagCatalogTest, index_does_not_follow_directory_links) {
+  const auto bag = write_bag("site/bag", 100, 1, {"/lidar"});
+  // A link back up the tree would make indexing recurse forever
+  const auto loop = bags_path_ / "site" / "loop";
+  ASSERT_EQ(symlink(bags_path_.string().c_str(), loop.string().c_str()), 0);
+
+  rosbag2_cpp::BagCatalog catalog(catalog_path_);
+  EXPECT_EQ(catalog.index(bags_path_.string()), 1u);
+  EXPECT_EQ(catalog.size(), 1u);
+  const auto entries = catalog.query({});
+  ASSERT_THAT(entries, SizeIs(1));
+  EXPECT_EQ(entries[0].uri, bag);
+}
+#endif
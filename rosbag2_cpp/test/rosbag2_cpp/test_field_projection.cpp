@@ -0,0 +1,224 @@
+// Copyright 2022 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "rosidl_typesupport_introspection_cpp/field_types.hpp"
+#include "rosidl_typesupport_introspection_cpp/identifier.hpp"
+#include "rosidl_typesupport_introspection_cpp/message_introspection.hpp"
+
+#include "rosbag2_cpp/field_projection.hpp"
+
+using namespace testing;  // NOLINT
+using rosidl_typesupport_introspection_cpp::MessageMember;
+using rosidl_typesupport_introspection_cpp::MessageMembers;
+
+namespace
+{
+namespace ti = rosidl_typesupport_introspection_cpp;
+
+MessageMember make_member(
+  const char * name, uint8_t type_id, bool is_array = false, size_t array_size = 0,
+  const rosidl_message_type_support_t * nested = nullptr)
+{
+  MessageMember member{};
+  member.name_ = name;
+  member.type_id_ = type_id;
+  member.is_array_ = is_array;
+  member.array_size_ = array_size;
+  member.members_ = nested;
+  return member;
+}
+
+// Little endian CDR serialization of the test types below
+class CdrWriter
+{
+public:
+  template<typename T>
+  CdrWriter & write(T value)
+  {
+    while ((data.size() - 4) % sizeof(T) != 0) {
+      data.push_back(0);
+    }
+    uint8_t bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    data.insert(data.end(), bytes, bytes + sizeof(T));
+    return *this;
+  }
+
+  CdrWriter & write_string(const std::string & value)
+  {
+    write<uint32_t>(static_cast<uint32_t>(value.size() + 1));
+    data.insert(data.end(), value.begin(), value.end());
+    data.push_back(0);
+    return *this;
+  }
+
+  CdrWriter & write_point(double x, double y, double z)
+  {
+    return write(x).write(y).write(z);
+  }
+
+  rcutils_uint8_array_t array()
+  {
+    rcutils_uint8_array_t array = rcutils_get_zero_initialized_uint8_array();
+    array.buffer = data.data();
+    array.buffer_length = data.size();
+    array.buffer_capacity = data.size();
+    return array;
+  }
+
+  std::vector<uint8_t> data = {0x00, 0x01, 0x00, 0x00};
+};
+}  // namespace
+
+class FieldProjectionTest : public Test
+{
+public:
+  FieldProjectionTest()
+  {
+    // Point: float64 x, y, z
+    point_members_ = {
+      make_member("x", ti::ROS_TYPE_DOUBLE),
+      make_member("y", ti::ROS_TYPE_DOUBLE),
+      make_member("z", ti::ROS_TYPE_DOUBLE)};
+    point_ = {"test_msgs::msg", "Point", 3, 0, point_members_.data(), nullptr, nullptr};
+    point_ts_ = {ti::typesupport_identifier, &point_, nullptr};
+
+    // Sample: uint8 flag, string label, Point point, float32[3] fixed, int16[] values,
+    // Point[] points, bool ok
+    sample_members_ = {
+      make_member("flag", ti::ROS_TYPE_UINT8),
+      make_member("label", ti::ROS_TYPE_STRING),
+      make_member("point", ti::ROS_TYPE_MESSAGE, false, 0, &point_ts_),
+      make_member("fixed", ti::ROS_TYPE_FLOAT, true, 3),
+      make_member("values", ti::ROS_TYPE_INT16, true, 0),
+      make_member("points", ti::ROS_TYPE_MESSAGE, true, 0, &point_ts_),
+      make_member("ok", ti::ROS_TYPE_BOOLEAN)};
+    sample_ = {"test_msgs::msg", "Sample", 7, 0, sample_members_.data(), nullptr, nullptr};
+    sample_ts_ = {ti::typesupport_identifier, &sample_, nullptr};
+  }
+
+  // A Sample with two values and two points
+  CdrWriter make_sample(const std::string & label = "odom")
+  {
+    CdrWriter writer;
+    writer.write<uint8_t>(7).write_string(label).write_point(1.0, 2.0, 3.0);
+    writer.write(0.5f).write(1.5f).write(2.5f);
+    writer.write<uint32_t>(2).write<int16_t>(-3).write<int16_t>(4);
+    writer.write<uint32_t>(2).write_point(10.0, 20.0, 30.0).write_point(40.0, 50.0, 60.0);
+    writer.write<uint8_t>(1);
+    return writer;
+  }
+
+  std::vector<double> extract(
+    const std::vector<std::string> & paths, CdrWriter writer, bool expect_success = true)
+  {
+    rosbag2_cpp::FieldProjection projection(&sample_ts_, paths);
+    std::vector<double> values(projection.size(), -1.0);
+    EXPECT_EQ(projection.extract(writer.array(), values.data()), expect_success);
+    return values;
+  }
+
+  std::vector<MessageMember> point_members_;
+  MessageMembers point_;
+  rosidl_message_type_support_t point_ts_;
+  std::vector<MessageMember> sample_members_;
+  MessageMembers sample_;
+  rosidl_message_type_support_t sample_ts_;
+};
+
+TEST_F(FieldProjectionTest, extracts_selected_fields_in_order_of_paths) {
+  rosbag2_cpp::FieldProjection projection(
+    &sample_ts_, {"ok", "point.y", "values[1]", "flag", "points[1].z"});
+  EXPECT_THAT(
+    projection.names(), ElementsAre("ok", "point.y", "values[1]", "flag", "points[1].z"));
+
+  auto sample = make_sample();
+  std::vector<double> values(projection.size());
+  ASSERT_TRUE(projection.extract(sample.array(), values.data()));
+  EXPECT_THAT(values, ElementsAre(1.0, 2.0, 4.0, 7.0, 60.0));
+
+  // The length of strings before the selected fields doesn't matter
+  sample = make_sample("a much longer frame id");
+  ASSERT_TRUE(projection.extract(sample.array(), values.data()));
+  EXPECT_THAT(values, ElementsAre(1.0, 2.0, 4.0, 7.0, 60.0));
+}
+
+TEST_F(FieldProjectionTest, expands_nested_messages_and_fixed_arrays) {
+  rosbag2_cpp::FieldProjection projection(&sample_ts_, {"point", "fixed", "points[0]"});
+  EXPECT_THAT(
+    projection.names(), ElementsAre(
+      "point.x", "point.y", "point.z", "fixed[0]", "fixed[1]", "fixed[2]",
+      "points[0].x", "points[0].y", "points[0].z"));
+  EXPECT_THAT(
+    extract({"point", "fixed", "points[0]"}, make_sample()),
+    ElementsAre(1.0, 2.0, 3.0, 0.5, 1.5, 2.5, 10.0, 20.0, 30.0));
+}
+
+TEST_F(FieldProjectionTest, elements_past_the_end_of_sequences_are_nan) {
+  const auto values = extract({"values[2]", "points[5].x", "ok"}, make_sample());
+  ASSERT_THAT(values, SizeIs(3));
+  EXPECT_TRUE(std::isnan(values[0]));
+  EXPECT_TRUE(std::isnan(values[1]));
+  EXPECT_EQ(values[2], 1.0);
+}
+
+TEST_F(FieldProjectionTest, reads_big_endian_messages) {
+  // flag = 7, label = "", point.x = 1.0
+  CdrWriter writer;
+  writer.data = {
+    0x00, 0x00, 0x00, 0x00,
+    0x07, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x01,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x3f, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+  EXPECT_THAT(extract({"flag", "point.x"}, writer), ElementsAre(7.0, 1.0));
+}
+
+TEST_F(FieldProjectionTest, rejects_truncated_and_non_cdr_messages) {
+  auto sample = make_sample();
+  sample.data.resize(sample.data.size() - 1);
+  extract({"ok"}, sample, false);
+  // Fields before the truncation can still be read
+  extract({"points[1].y"}, sample, true);
+
+  sample = make_sample();
+  sample.data[0] = 0x00;
+  sample.data[1] = 0x07;
+  extract({"flag"}, sample, false);
+
+  // A string length pointing past the end of the message
+  CdrWriter writer;
+  writer.write<uint8_t>(7).write<uint32_t>(1000);
+  extract({"point.x"}, writer, false);
+}
+
+TEST_F(FieldProjectionTest, rejects_invalid_paths) {
+  for (const auto & path : {
+      "missing", "label", "values", "point.x.y", "point.w", "fixed[3]", "flag[0]", "values[x]",
+      "values[1", "point..x", ""})
+  {
+    EXPECT_THROW(rosbag2_cpp::FieldProjection(&sample_ts_, {path}), std::runtime_error) << path;
+  }
+  EXPECT_THROW(
+    rosbag2_cpp::FieldProjection(&sample_ts_, {"point", "point.x"}), std::runtime_error);
+}
@@ -0,0 +1,78 @@
+// Copyright 2022 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <gmock/gmock.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "rosbag2_cpp/header_stamp.hpp"
+
+using namespace testing;  // NOLINT
+
+namespace
+{
+rcutils_uint8_array_t as_array(std::vector<uint8_t> & bytes)
+{
+  rcutils_uint8_array_t array = rcutils_get_zero_initialized_uint8_array();
+  array.buffer = bytes.data();
+  array.buffer_length = bytes.size();
+  array.buffer_capacity = bytes.size();
+  return array;
+}
+}  // namespace
+
+TEST(HeaderStampTest, reads_little_endian_stamp) {
+  // sec = 2, nanosec = 500, followed by an empty frame_id
+  std::vector<uint8_t> cdr = {
+    0x00, 0x01, 0x00, 0x00,
+    0x02, 0x00, 0x00, 0x00,
+    0xf4, 0x01, 0x00, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0x00};
+  rcutils_time_point_value_t stamp = 0;
+  ASSERT_TRUE(rosbag2_cpp::read_cdr_header_stamp(as_array(cdr), stamp));
+  EXPECT_EQ(stamp, 2000000500);
+}
+
+TEST(HeaderStampTest, reads_big_endian_stamp) {
+  std::vector<uint8_t> cdr = {
+    0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x02,
+    0x00, 0x00, 0x01, 0xf4};
+  rcutils_time_point_value_t stamp = 0;
+  ASSERT_TRUE(rosbag2_cpp::read_cdr_header_stamp(as_array(cdr), stamp));
+  EXPECT_EQ(stamp, 2000000500);
+}
+
+TEST(HeaderStampTest, reads_negative_seconds) {
+  std::vector<uint8_t> cdr = {
+    0x00, 0x01, 0x00, 0x00,
+    0xff, 0xff, 0xff, 0xff,
+    0x00, 0x00, 0x00, 0x00};
+  rcutils_time_point_value_t stamp = 0;
+  ASSERT_TRUE(rosbag2_cpp::read_cdr_header_stamp(as_array(cdr), stamp));
+  EXPECT_EQ(stamp, -1000000000);
+}
+
+TEST(HeaderStampTest, rejects_truncated_message) {
+  std::vector<uint8_t> cdr = {0x00, 0x01, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00};
+  rcutils_time_point_value_t stamp = 42;
+  EXPECT_FALSE(rosbag2_cpp::read_cdr_header_stamp(as_array(cdr), stamp));
+  EXPECT_EQ(stamp, 42);
+}
+
+TEST(HeaderStampTest, types_without_typesupport_have_no_header) {
+  EXPECT_FALSE(rosbag2_cpp::type_starts_with_header("not_a_package/msg/NotAType"));
+}
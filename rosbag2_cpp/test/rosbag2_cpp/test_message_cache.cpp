@@ -105,3 +105,31 @@ TEST_F(MessageCacheTest, message_cache_writes_full_producer_buffer) {
   mock_cache_consumer->stop();
   EXPECT_EQ(consumed_message_count, message_count - should_be_dropped_count);
 }
+
+TEST_F(MessageCacheTest, blocking_message_cache_does_not_drop_messages) {
+  const uint32_t message_count = 1000;
+  size_t consumed_message_count {0};
+
+  auto mock_message_cache = std::make_shared<NiceMock<MockMessageCache>>(
+    cache_size_, true);
+
+  auto cb = [&consumed_message_count](
+    const std::vector<std::shared_ptr<const rosbag2_storage::SerializedBagMessage>> & msgs) {
+      using namespace std::chrono_literals;
+      // Consume slower than the producer to make it wait for the buffers to swap
+      std::this_thread::sleep_for(1ms);
+      consumed_message_count += msgs.size();
+    };
+
+  auto mock_cache_consumer = std::make_unique<NiceMock<MockCacheConsumer>>(
+    mock_message_cache,
+    cb);
+
+  for (uint32_t i = 0; i < message_count; ++i) {
+    mock_message_cache->push(make_test_msg());
+  }
+
+  mock_cache_consumer->stop();
+  EXPECT_EQ(sum_up(mock_message_cache->messages_dropped()), 0u);
+  EXPECT_EQ(consumed_message_count, message_count);
+}
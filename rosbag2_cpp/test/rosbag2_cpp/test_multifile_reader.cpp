@@ -14,6 +14,7 @@
 
 #include <gmock/gmock.h>
 
+#include <chrono>
 #include <memory>
 #include <string>
 #include <utility>
@@ -119,6 +120,25 @@ public:
   }
 };
 
+class MultifileReaderTestWithFileTopics : public MultifileReaderTest
+{
+public:
+  // Ten seconds per file, the middle one only has messages on another topic
+  rosbag2_storage::BagMetadata get_metadata() const override
+  {
+    auto metadata = MultifileReaderTest::get_metadata();
+    metadata.version = 7;
+    const auto paths = metadata.relative_file_paths;
+    for (size_t i = 0; i < paths.size(); ++i) {
+      const auto topic = i == 1 ? "other_topic" : "topic";
+      metadata.files.push_back(
+        {paths[i], std::chrono::time_point<std::chrono::high_resolution_clock>(
+            std::chrono::seconds(10 * i)), std::chrono::seconds(10), 5, {{topic, 5}}});
+    }
+    return metadata;
+  }
+};
+
 TEST_F(MultifileReaderTest, has_next_reads_next_file)
 {
   init();
@@ -234,3 +254,40 @@ TEST_F(MultifileReaderTest, seek_bag)
   reader_->seek(9999999999999);
   reader_->has_next();
 }
+
+TEST_F(MultifileReaderTestWithFileTopics, has_next_skips_files_without_filtered_topics)
+{
+  init();
+
+  EXPECT_CALL(*storage_, has_next()).Times(2)
+  .WillOnce(Return(false))
+  .WillOnce(Return(true));
+  reader_->open(default_storage_options_, {"", storage_serialization_format_});
+  reader_->set_filter({{"topic"}});
+
+  auto & sr = static_cast<rosbag2_cpp::readers::SequentialReader &>(
+    reader_->get_implementation_handle());
+  EXPECT_EQ(sr.get_current_file(), (rcpputils::fs::path(storage_uri_) / relative_path_1_).string());
+  EXPECT_TRUE(sr.has_next_file());
+  reader_->read_next();  // calls has_next false then true
+  EXPECT_EQ(sr.get_current_file(), rcpputils::fs::path(absolute_path_1_).string());
+  EXPECT_FALSE(sr.has_next_file());
+}
+
+TEST_F(MultifileReaderTestWithFileTopics, seek_skips_files_before_timestamp)
+{
+  init();
+  reader_->open(default_storage_options_, {"", storage_serialization_format_});
+
+  auto & sr = static_cast<rosbag2_cpp::readers::SequentialReader &>(
+    reader_->get_implementation_handle());
+  EXPECT_CALL(*storage_, seek(_)).Times(2);
+  reader_->seek(25000000000);
+  EXPECT_EQ(sr.get_current_file(), rcpputils::fs::path(absolute_path_1_).string());
+
+  // Only the middle file has messages on the topic
+  reader_->set_filter({{"other_topic"}});
+  reader_->seek(15000000000);
+  EXPECT_EQ(sr.get_current_file(), (rcpputils::fs::path(storage_uri_) / relative_path_2_).string());
+  EXPECT_FALSE(sr.has_next_file());
+}
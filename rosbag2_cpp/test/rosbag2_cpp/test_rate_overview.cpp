@@ -0,0 +1,84 @@
+// Copyright 2022 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+
+#include <chrono>
+
+#include "rosbag2_cpp/rate_overview.hpp"
+
+using namespace testing;  // NOLINT
+using namespace std::chrono_literals;  // NOLINT
+
+namespace
+{
+constexpr rcutils_time_point_value_t kSecond = 1000000000;
+}  // namespace
+
+TEST(RateOverviewCollectorTest, counts_messages_and_bytes_per_aligned_bucket) {
+  rosbag2_cpp::RateOverviewCollector collector(1s);
+  collector.add("/b", 10 * kSecond + 500, 100);
+  collector.add("/a", 10 * kSecond + 900, 10);
+  collector.add("/a", 12 * kSecond, 20);
+  collector.add("/a", 12 * kSecond + 1, 30);
+
+  const auto overview = collector.get_overview();
+  EXPECT_EQ(overview.starting_time.time_since_epoch(), 10s);
+  EXPECT_EQ(overview.bucket_duration, 1s);
+  ASSERT_THAT(overview.topics, SizeIs(2));
+  EXPECT_EQ(overview.topics[0].topic_name, "/a");
+  EXPECT_THAT(overview.topics[0].message_counts, ElementsAre(1, 0, 2));
+  EXPECT_THAT(overview.topics[0].message_bytes, ElementsAre(10, 0, 50));
+  EXPECT_EQ(overview.topics[1].topic_name, "/b");
+  EXPECT_THAT(overview.topics[1].message_counts, ElementsAre(1, 0, 0));
+  EXPECT_THAT(overview.topics[1].message_bytes, ElementsAre(100, 0, 0));
+}
+
+TEST(RateOverviewCollectorTest, prepends_buckets_for_earlier_messages) {
+  rosbag2_cpp::RateOverviewCollector collector(1s);
+  collector.add("/a", 10 * kSecond, 1);
+  collector.add("/a", 8 * kSecond, 1);
+
+  const auto overview = collector.get_overview();
+  EXPECT_EQ(overview.starting_time.time_since_epoch(), 8s);
+  ASSERT_THAT(overview.topics, SizeIs(1));
+  EXPECT_THAT(overview.topics[0].message_counts, ElementsAre(1, 0, 1));
+}
+
+TEST(RateOverviewCollectorTest, merges_buckets_beyond_max_buckets) {
+  rosbag2_cpp::RateOverviewCollector collector(1s, 4);
+  for (int i = 1; i <= 8; ++i) {
+    collector.add("/a", i * kSecond, static_cast<uint64_t>(i));
+  }
+
+  // 1..8 s don't fit into 4 buckets of 2 s aligned to even seconds, so they take 4 s each
+  const auto overview = collector.get_overview();
+  EXPECT_EQ(overview.bucket_duration, 4s);
+  EXPECT_EQ(overview.starting_time.time_since_epoch(), 0s);
+  ASSERT_THAT(overview.topics, SizeIs(1));
+  EXPECT_THAT(overview.topics[0].message_counts, ElementsAre(3, 4, 1));
+  EXPECT_THAT(overview.topics[0].message_bytes, ElementsAre(6, 22, 8));
+}
+
+TEST(RateOverviewCollectorTest, is_disabled_by_zero_bucket_duration) {
+  rosbag2_cpp::RateOverviewCollector collector;
+  collector.add("/a", kSecond, 1);
+  const auto overview = collector.get_overview();
+  EXPECT_EQ(overview.bucket_duration, 0ns);
+  EXPECT_THAT(overview.topics, IsEmpty());
+
+  collector.reset(1s);
+  collector.add("/a", kSecond, 1);
+  EXPECT_THAT(collector.get_overview().topics, SizeIs(1));
+}
@@ -14,6 +14,7 @@
 
 #include <gmock/gmock.h>
 
+#include <chrono>
 #include <memory>
 #include <stdexcept>
 #include <string>
@@ -36,6 +37,7 @@
 #include "mock_storage_factory.hpp"
 
 using namespace testing;  // NOLINT
+using namespace std::chrono_literals;  // NOLINT
 
 class SequentialWriterTest : public Test
 {
@@ -561,3 +563,89 @@ TEST_F(SequentialWriterTest, split_event_calls_callback)
   EXPECT_EQ(closed_file, expected_closed.string());
   EXPECT_EQ(opened_file, fake_storage_uri_);
 }
+
+TEST_F(SequentialWriterTest, writes_rate_overview_to_metadata)
+{
+  ON_CALL(*metadata_io_, write_metadata).WillByDefault(
+    [this](const std::string &, const rosbag2_storage::BagMetadata & metadata) {
+      fake_metadata_ = metadata;
+    });
+
+  auto sequential_writer = std::make_unique<rosbag2_cpp::writers::SequentialWriter>(
+    std::move(storage_factory_), converter_factory_, std::move(metadata_io_));
+  writer_ = std::make_unique<rosbag2_cpp::Writer>(std::move(sequential_writer));
+
+  storage_options_.rate_overview_bucket_duration = 1000;
+
+  writer_->open(storage_options_, {"rmw_format", "rmw_format"});
+  writer_->create_topic({"test_topic", "test_msgs/BasicTypes", "", ""});
+
+  // Two messages in the first second, none in the second one and one in the third one
+  for (const auto time_stamp : {1000ms, 1500ms, 3000ms}) {
+    auto message = make_test_msg();
+    message->time_stamp = std::chrono::nanoseconds(time_stamp).count();
+    writer_->write(message);
+  }
+  writer_.reset();
+
+  const auto & overview = fake_metadata_.rate_overview;
+  EXPECT_EQ(overview.bucket_duration, std::chrono::seconds(1));
+  EXPECT_EQ(overview.starting_time.time_since_epoch(), std::chrono::seconds(1));
+  ASSERT_THAT(overview.topics, SizeIs(1));
+  EXPECT_EQ(overview.topics[0].topic_name, "test_topic");
+  EXPECT_THAT(overview.topics[0].message_counts, ElementsAre(2u, 0u, 1u));
+  EXPECT_EQ(overview.topics[0].message_bytes.size(), 3u);
+  EXPECT_EQ(overview.topics[0].message_bytes[1], 0u);
+}
+
+TEST_F(SequentialWriterTest, writes_topic_message_counts_and_time_range_of_each_file)
+{
+  ON_CALL(
+    *storage_,
+    write(An<std::shared_ptr<const rosbag2_storage::SerializedBagMessage>>())).WillByDefault(
+    [this](std::shared_ptr<const rosbag2_storage::SerializedBagMessage>) {
+      fake_storage_size_++;
+    });
+  ON_CALL(*storage_, get_bagfile_size).WillByDefault(
+    [this]() {
+      return fake_storage_size_.load();
+    });
+  ON_CALL(*metadata_io_, write_metadata).WillByDefault(
+    [this](const std::string &, const rosbag2_storage::BagMetadata & metadata) {
+      fake_metadata_ = metadata;
+    });
+
+  auto sequential_writer = std::make_unique<rosbag2_cpp::writers::SequentialWriter>(
+    std::move(storage_factory_), converter_factory_, std::move(metadata_io_));
+  writer_ = std::make_unique<rosbag2_cpp::Writer>(std::move(sequential_writer));
+
+  storage_options_.max_bagfile_size = 2;
+
+  writer_->open(storage_options_, {"rmw_format", "rmw_format"});
+  writer_->create_topic({"topic_a", "test_msgs/BasicTypes", "", ""});
+  writer_->create_topic({"topic_b", "test_msgs/BasicTypes", "", ""});
+
+  // Two messages per file, the first file receives an earlier message after a later one
+  const std::vector<std::pair<std::string, std::chrono::milliseconds>> messages = {
+    {"topic_a", 2000ms}, {"topic_b", 1000ms}, {"topic_a", 3000ms}, {"topic_a", 3500ms},
+    {"topic_b", 4000ms}};
+  for (const auto & topic_and_time : messages) {
+    auto message = make_test_msg();
+    message->topic_name = topic_and_time.first;
+    message->time_stamp = std::chrono::nanoseconds(topic_and_time.second).count();
+    writer_->write(message);
+  }
+  writer_.reset();
+
+  const auto & files = fake_metadata_.files;
+  ASSERT_THAT(files, SizeIs(3));
+  EXPECT_THAT(files[0].topic_message_counts, ElementsAre(Pair("topic_a", 1u), Pair("topic_b", 1u)));
+  EXPECT_THAT(files[1].topic_message_counts, ElementsAre(Pair("topic_a", 2u)));
+  EXPECT_THAT(files[2].topic_message_counts, ElementsAre(Pair("topic_b", 1u)));
+
+  EXPECT_EQ(files[0].starting_time.time_since_epoch(), 1000ms);
+  EXPECT_EQ(files[0].duration, 1000ms);
+  EXPECT_EQ(files[1].starting_time.time_since_epoch(), 3000ms);
+  EXPECT_EQ(files[1].duration, 500ms);
+  EXPECT_EQ(files[2].duration, 0ms);
+}
@@ -0,0 +1,95 @@
+// Copyright 2022 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+
+#include <map>
+#include <string>
+#include <thread>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "rosbag2_cpp/thread_options.hpp"
+
+using namespace testing;  // NOLINT
+
+TEST(ThreadOptionsTest, yaml_round_trip) {
+  rosbag2_cpp::ThreadOptions options;
+  options.cpu_affinity = {1, 3};
+  options.nice = 5;
+  options.fifo_priority = 10;
+
+  YAML::Node node;
+  node["cache_consumer"] = options;
+  auto decoded = YAML::Load(YAML::Dump(node))
+    .as<std::map<std::string, rosbag2_cpp::ThreadOptions>>();
+  ASSERT_EQ(decoded.count("cache_consumer"), 1u);
+  EXPECT_THAT(decoded["cache_consumer"].cpu_affinity, ElementsAre(1, 3));
+  EXPECT_EQ(decoded["cache_consumer"].nice, 5);
+  EXPECT_EQ(decoded["cache_consumer"].fifo_priority, 10);
+}
+
+TEST(ThreadOptionsTest, missing_yaml_fields_keep_defaults) {
+  auto options = YAML::Load("{nice: 3}").as<rosbag2_cpp::ThreadOptions>();
+  EXPECT_TRUE(options.cpu_affinity.empty());
+  EXPECT_EQ(options.nice, 3);
+  EXPECT_EQ(options.fifo_priority, 0);
+}
+
+#ifdef __linux__
+TEST(ThreadOptionsTest, configures_name_and_affinity_of_current_thread) {
+  cpu_set_t allowed;
+  ASSERT_EQ(pthread_getaffinity_np(pthread_self(), sizeof(allowed), &allowed), 0);
+  int first_cpu = 0;
+  while (!CPU_ISSET(first_cpu, &allowed)) {
+    first_cpu++;
+  }
+
+  rosbag2_cpp::ThreadOptionsMap thread_options;
+  thread_options[rosbag2_cpp::thread_class::kCacheConsumer].cpu_affinity = {first_cpu};
+
+  std::string name;
+  cpu_set_t affinity;
+  std::thread thread(
+    [&]() {
+      rosbag2_cpp::configure_current_thread(
+        rosbag2_cpp::thread_class::kCacheConsumer, thread_options);
+      char buffer[16] = {};
+      pthread_getname_np(pthread_self(), buffer, sizeof(buffer));
+      name = buffer;
+      pthread_getaffinity_np(pthread_self(), sizeof(affinity), &affinity);
+    });
+  thread.join();
+
+  EXPECT_EQ(name, "cache_consumer");
+  EXPECT_EQ(CPU_COUNT(&affinity), 1);
+  EXPECT_TRUE(CPU_ISSET(first_cpu, &affinity));
+}
+
+TEST(ThreadOptionsTest, thread_names_are_truncated) {
+  std::string name;
+  std::thread thread(
+    [&]() {
+      rosbag2_cpp::configure_current_thread("a_very_long_thread_class", {});
+      char buffer[16] = {};
+      pthread_getname_np(pthread_self(), buffer, sizeof(buffer));
+      name = buffer;
+    });
+  thread.join();
+  EXPECT_EQ(name, "a_very_long_thr");
+}
+#endif
@@ -326,3 +326,40 @@ TEST_F(TimeControllerClockTest, jump_backward_with_playback_rate)
 
   EXPECT_EQ(testing_clock.now(), expected_ros_time);
 }
+
+TEST_F(TimeControllerClockTest, concurrent_queries_see_consistent_state)
+{
+  // Without jumps, time must never go backwards for a reader, regardless of concurrent
+  // pause, resume and rate changes.
+  rosbag2_cpp::TimeControllerClock clock(ros_start_time);
+  std::atomic_bool stop{false};
+  std::atomic<size_t> inconsistencies{0};
+
+  auto reader = std::thread(
+    [&clock, &stop, &inconsistencies]() {
+      rcutils_time_point_value_t last_time = clock.now();
+      while (!stop) {
+        const auto current_time = clock.now();
+        if (current_time < last_time) {
+          inconsistencies++;
+        }
+        last_time = current_time;
+        const double rate = clock.get_rate();
+        if (rate != 1.0 && rate != 2.0) {
+          inconsistencies++;
+        }
+      }
+    });
+
+  for (size_t i = 0; i < 100000; i++) {
+    clock.set_rate(i % 2 ? 1.0 : 2.0);
+    if (i % 3 == 0) {
+      clock.pause();
+    } else {
+      clock.resume();
+    }
+  }
+  stop = true;
+  reader.join();
+  EXPECT_EQ(inconsistencies, 0u);
+}
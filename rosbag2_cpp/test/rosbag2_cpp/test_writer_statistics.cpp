@@ -0,0 +1,79 @@
+// Copyright 2022 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+
+#include <chrono>
+
+#include "rosbag2_cpp/writer_statistics.hpp"
+
+using namespace testing;  // NOLINT
+using namespace std::chrono_literals;  // NOLINT
+
+TEST(WriterStatisticsCollectorTest, reports_batches_and_latency_percentiles) {
+  rosbag2_cpp::WriterStatisticsCollector collector;
+  for (int i = 1; i <= 100; i++) {
+    collector.on_write(static_cast<size_t>(i % 10 + 1), std::chrono::microseconds(i));
+  }
+
+  rosbag2_cpp::WriterStatistics statistics;
+  collector.report(statistics);
+  EXPECT_EQ(statistics.write_batches, 100u);
+  EXPECT_EQ(statistics.max_batch_size, 10u);
+  EXPECT_EQ(statistics.messages_written, 10u * (1 + 10) / 2 * 10);
+  EXPECT_EQ(statistics.write_latency_p50, std::chrono::microseconds(51));
+  EXPECT_EQ(statistics.write_latency_p90, std::chrono::microseconds(90));
+  EXPECT_EQ(statistics.write_latency_p99, std::chrono::microseconds(99));
+  EXPECT_EQ(statistics.write_latency_max, std::chrono::microseconds(100));
+}
+
+TEST(WriterStatisticsCollectorTest, report_starts_a_new_period) {
+  rosbag2_cpp::WriterStatisticsCollector collector;
+  collector.on_write(5, 1ms);
+  collector.on_split(3ms);
+
+  rosbag2_cpp::WriterStatistics statistics;
+  collector.report(statistics);
+  collector.report(statistics);
+  EXPECT_EQ(statistics.write_batches, 0u);
+  EXPECT_EQ(statistics.messages_written, 0u);
+  EXPECT_EQ(statistics.write_latency_max, 0ns);
+  // Splits are counted since the writer was opened
+  EXPECT_EQ(statistics.splits, 1u);
+  EXPECT_EQ(statistics.last_split_duration, 3ms);
+}
+
+TEST(WriterStatisticsCollectorTest, storage_drops_accumulate_across_splits) {
+  rosbag2_cpp::WriterStatisticsCollector collector;
+  collector.set_storage_dropped(2);
+  collector.set_storage_dropped(3);
+  collector.on_storage_closed();
+  collector.set_storage_dropped(1);
+
+  rosbag2_cpp::WriterStatistics statistics;
+  collector.report(statistics);
+  EXPECT_EQ(statistics.messages_dropped_storage, 4u);
+}
+
+TEST(WriterStatisticsCollectorTest, latency_samples_are_bounded) {
+  rosbag2_cpp::WriterStatisticsCollector collector(2);
+  collector.on_write(1, 1ms);
+  collector.on_write(1, 2ms);
+  collector.on_write(1, 10ms);
+
+  rosbag2_cpp::WriterStatistics statistics;
+  collector.report(statistics);
+  EXPECT_EQ(statistics.write_batches, 3u);
+  EXPECT_EQ(statistics.write_latency_max, 2ms);
+}
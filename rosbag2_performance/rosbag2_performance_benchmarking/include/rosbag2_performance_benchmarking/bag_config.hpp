@@ -22,6 +22,8 @@ struct BagConfig
 {
   rosbag2_storage::StorageOptions storage_options;
   std::string compression_format;
+  // "message" or "file"
+  std::string compression_mode;
   unsigned int compression_queue_size;
   unsigned int compression_threads;
 };
@@ -0,0 +1,43 @@
+// Copyright 2022 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROSBAG2_PERFORMANCE_BENCHMARKING__BAG_GENERATOR_HPP_
+#define ROSBAG2_PERFORMANCE_BENCHMARKING__BAG_GENERATOR_HPP_
+
+#include <string>
+#include <vector>
+
+#include "rclcpp/rclcpp.hpp"
+
+#include "rosbag2_performance_benchmarking/bag_config.hpp"
+#include "rosbag2_performance_benchmarking/generator_config.hpp"
+#include "rosbag2_performance_benchmarking/publisher_group_config.hpp"
+
+/// Writes a bag with all messages the configured publisher groups would send, as fast as the
+/// storage allows, to test reading, seeking and other operations on large bags without
+/// recording them in real time. Message sizes and time stamps vary as configured for each
+/// group, drawn from a seeded random generator, so the same configuration gives the same bag.
+class BagGenerator : public rclcpp::Node
+{
+public:
+  explicit BagGenerator(const std::string & name);
+  void generate();
+
+private:
+  std::vector<PublisherGroupConfig> configurations_;
+  BagConfig bag_config_;
+  GeneratorConfig generator_config_;
+};
+
+#endif  // ROSBAG2_PERFORMANCE_BENCHMARKING__BAG_GENERATOR_HPP_
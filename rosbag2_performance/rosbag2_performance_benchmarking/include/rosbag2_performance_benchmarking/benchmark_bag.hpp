@@ -0,0 +1,51 @@
+// Copyright 2022 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROSBAG2_PERFORMANCE_BENCHMARKING__BENCHMARK_BAG_HPP_
+#define ROSBAG2_PERFORMANCE_BENCHMARKING__BENCHMARK_BAG_HPP_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "rosbag2_cpp/writers/sequential_writer.hpp"
+#include "rosbag2_storage/storage_factory.hpp"
+#include "rosbag2_storage/storage_factory_interface.hpp"
+
+#include "rosbag2_performance_benchmarking/bag_config.hpp"
+#include "rosbag2_performance_benchmarking/publisher_group_config.hpp"
+
+namespace benchmark_bag
+{
+
+/// Create and open a writer for the bag described by bag_config, compressing messages
+/// if a compression format is set
+std::shared_ptr<rosbag2_cpp::writers::SequentialWriter> open_writer(
+  const BagConfig & bag_config,
+  std::unique_ptr<rosbag2_storage::StorageFactoryInterface> storage_factory =
+  std::make_unique<rosbag2_storage::StorageFactory>());
+
+/// Name of the topic of the publisher with the given index in a publisher group
+std::string topic_name(const PublisherGroupConfig & group_config, unsigned int index);
+
+/// Write a bag with all messages the publisher groups would send, as fast as the writer allows.
+/// Messages are serialized std_msgs/msg/ByteMultiArray, stamped as if each publisher sent them
+/// at the rate of its group, so the bag can be played back.
+void write_bag(
+  const std::vector<PublisherGroupConfig> & publisher_groups_config,
+  const BagConfig & bag_config);
+
+}  // namespace benchmark_bag
+
+#endif  // ROSBAG2_PERFORMANCE_BENCHMARKING__BENCHMARK_BAG_HPP_
@@ -0,0 +1,93 @@
+// Copyright 2022 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROSBAG2_PERFORMANCE_BENCHMARKING__COMMIT_OBSERVING_STORAGE_HPP_
+#define ROSBAG2_PERFORMANCE_BENCHMARKING__COMMIT_OBSERVING_STORAGE_HPP_
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "rcutils/time.h"
+#include "rosbag2_storage/storage_factory.hpp"
+#include "rosbag2_storage/storage_factory_interface.hpp"
+#include "rosbag2_storage/storage_interfaces/read_write_interface.hpp"
+
+/// Called for each message after the storage write containing it returned, with the system
+/// time at which the write returned
+using commit_callback_t = std::function<void (
+      const rosbag2_storage::SerializedBagMessage & message,
+      rcutils_time_point_value_t commit_time)>;
+
+/// Storage which forwards all calls to another storage and reports each written message
+class CommitObservingStorage : public rosbag2_storage::storage_interfaces::ReadWriteInterface
+{
+public:
+  CommitObservingStorage(
+    std::shared_ptr<rosbag2_storage::storage_interfaces::ReadWriteInterface> storage,
+    commit_callback_t commit_callback);
+
+  void open(
+    const rosbag2_storage::StorageOptions & storage_options,
+    rosbag2_storage::storage_interfaces::IOFlag io_flag =
+    rosbag2_storage::storage_interfaces::IOFlag::READ_WRITE) override;
+
+  void write(std::shared_ptr<const rosbag2_storage::SerializedBagMessage> msg) override;
+  void write(
+    const std::vector<std::shared_ptr<const rosbag2_storage::SerializedBagMessage>> & msg)
+  override;
+  void create_topic(const rosbag2_storage::TopicMetadata & topic) override;
+  void remove_topic(const rosbag2_storage::TopicMetadata & topic) override;
+
+  bool has_next() override;
+  std::shared_ptr<rosbag2_storage::SerializedBagMessage> read_next() override;
+  std::vector<rosbag2_storage::TopicMetadata> get_all_topics_and_types() override;
+  void set_filter(const rosbag2_storage::StorageFilter & storage_filter) override;
+  void reset_filter() override;
+  void seek(const rcutils_time_point_value_t & timestamp) override;
+
+  rosbag2_storage::BagMetadata get_metadata() override;
+  std::string get_relative_file_path() const override;
+  uint64_t get_bagfile_size() const override;
+  std::string get_storage_identifier() const override;
+  uint64_t get_minimum_split_file_size() const override;
+  uint64_t get_number_of_dropped_messages() const override;
+
+private:
+  void notify_commit(
+    const std::vector<std::shared_ptr<const rosbag2_storage::SerializedBagMessage>> & messages);
+
+  std::shared_ptr<rosbag2_storage::storage_interfaces::ReadWriteInterface> storage_;
+  commit_callback_t commit_callback_;
+};
+
+/// Storage factory wrapping each storage opened for writing in a CommitObservingStorage
+class CommitObservingStorageFactory : public rosbag2_storage::StorageFactoryInterface
+{
+public:
+  explicit CommitObservingStorageFactory(commit_callback_t commit_callback);
+
+  std::shared_ptr<rosbag2_storage::storage_interfaces::ReadOnlyInterface>
+  open_read_only(const rosbag2_storage::StorageOptions & storage_options) override;
+
+  std::shared_ptr<rosbag2_storage::storage_interfaces::ReadWriteInterface>
+  open_read_write(const rosbag2_storage::StorageOptions & storage_options) override;
+
+private:
+  rosbag2_storage::StorageFactory storage_factory_;
+  commit_callback_t commit_callback_;
+};
+
+#endif  // ROSBAG2_PERFORMANCE_BENCHMARKING__COMMIT_OBSERVING_STORAGE_HPP_
@@ -20,7 +20,10 @@
 
 #include "rclcpp/node.hpp"
 #include "rosbag2_performance_benchmarking/bag_config.hpp"
+#include "rosbag2_performance_benchmarking/generator_config.hpp"
+#include "rosbag2_performance_benchmarking/player_config.hpp"
 #include "rosbag2_performance_benchmarking/publisher_group_config.hpp"
+#include "rosbag2_performance_benchmarking/reader_config.hpp"
 
 namespace config_utils
 {
@@ -41,6 +44,16 @@ std::vector<PublisherGroupConfig> publisher_groups_from_node_parameters(
 /// Acquires bag parameters from the node
 BagConfig bag_config_from_node_parameters(rclcpp::Node & node);
 
+/// Acquires reader benchmark parameters from the node
+ReaderConfig reader_config_from_node_parameters(rclcpp::Node & node);
+
+/// Acquires player benchmark parameters from the node
+PlayerConfig player_config_from_node_parameters(rclcpp::Node & node);
+
+/// Acquires bag generator parameters from the node, including those of each publisher group.
+/// Publisher groups have to be acquired before.
+GeneratorConfig generator_config_from_node_parameters(rclcpp::Node & node);
+
 }  // namespace config_utils
 
 #endif  // ROSBAG2_PERFORMANCE_BENCHMARKING__CONFIG_UTILS_HPP_
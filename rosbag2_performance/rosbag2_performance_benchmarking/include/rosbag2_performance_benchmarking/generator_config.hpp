@@ -0,0 +1,44 @@
+// Copyright 2022 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROSBAG2_PERFORMANCE_BENCHMARKING__GENERATOR_CONFIG_HPP_
+#define ROSBAG2_PERFORMANCE_BENCHMARKING__GENERATOR_CONFIG_HPP_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// How the generator varies the messages of a publisher group
+struct GeneratorGroupConfig
+{
+  // "fixed", "uniform" or "normal" sizes around the message size of the group
+  std::string size_distribution;
+  // Half width of the uniform distribution, standard deviation of the normal one
+  unsigned int size_spread;
+  // Each publisher stamps its messages with a constant offset of up to this
+  double clock_skew_ms;
+  // Each message is stamped up to this late
+  double jitter_ms;
+};
+
+struct GeneratorConfig
+{
+  unsigned int seed;
+  // Time stamp of the first messages, the current time if 0
+  int64_t start_time_ns;
+  // In the order of the publisher groups
+  std::vector<GeneratorGroupConfig> groups;
+};
+
+#endif  // ROSBAG2_PERFORMANCE_BENCHMARKING__GENERATOR_CONFIG_HPP_
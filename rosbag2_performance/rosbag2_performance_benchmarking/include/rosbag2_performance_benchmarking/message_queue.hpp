@@ -23,6 +23,7 @@
 #include <string>
 #include <utility>
 
+#include "rcutils/time.h"
 #include "std_msgs/msg/byte_multi_array.hpp"
 
 template<typename T>
@@ -35,14 +36,16 @@ public:
     unsuccessful_insert_count_(0)
   {}
 
-  void push(std::shared_ptr<T> elem)
+  /// \return false if the queue is full and the element was dropped
+  bool push(std::shared_ptr<T> elem)
   {
     std::lock_guard<std::mutex> lock(mutex_);
     if (queue_.size() > max_size_) {  // We skip the element and consider it "lost"
       ++unsuccessful_insert_count_;
-      return;
+      return false;
     }
     queue_.push(elem);
+    return true;
   }
 
   bool is_complete() const
@@ -83,7 +86,7 @@ public:
   }
 
 private:
-  bool complete_ = false;
+  std::atomic<bool> complete_{false};
   unsigned int max_size_;
   std::string topic_name_;
   std::atomic<unsigned int> unsuccessful_insert_count_;
@@ -91,6 +94,13 @@ private:
   mutable std::mutex mutex_;
 };
 
-typedef MessageQueue<std_msgs::msg::ByteMultiArray> ByteMessageQueue;
+/// A produced message and the system time it was produced at
+struct StampedByteMessage
+{
+  std::shared_ptr<std_msgs::msg::ByteMultiArray> message;
+  rcutils_time_point_value_t produced_time;
+};
+
+typedef MessageQueue<StampedByteMessage> ByteMessageQueue;
 
 #endif  // ROSBAG2_PERFORMANCE_BENCHMARKING__MESSAGE_QUEUE_HPP_
@@ -0,0 +1,42 @@
+// Copyright 2022 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROSBAG2_PERFORMANCE_BENCHMARKING__PLAYER_BENCHMARK_HPP_
+#define ROSBAG2_PERFORMANCE_BENCHMARKING__PLAYER_BENCHMARK_HPP_
+
+#include <string>
+#include <vector>
+
+#include "rclcpp/rclcpp.hpp"
+
+#include "rosbag2_performance_benchmarking/bag_config.hpp"
+#include "rosbag2_performance_benchmarking/player_config.hpp"
+#include "rosbag2_performance_benchmarking/publisher_group_config.hpp"
+
+/// Writes a bag with the messages of the configured producers, then plays it back and measures
+/// how far behind its schedule the player publishes each message.
+class PlayerBenchmark : public rclcpp::Node
+{
+public:
+  explicit PlayerBenchmark(const std::string & name);
+  void start_benchmark();
+
+private:
+  std::vector<PublisherGroupConfig> configurations_;
+  std::string results_file_;
+  BagConfig bag_config_;
+  PlayerConfig player_config_;
+};
+
+#endif  // ROSBAG2_PERFORMANCE_BENCHMARKING__PLAYER_BENCHMARK_HPP_
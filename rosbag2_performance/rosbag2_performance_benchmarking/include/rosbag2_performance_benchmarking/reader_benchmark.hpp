@@ -0,0 +1,53 @@
+// Copyright 2022 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROSBAG2_PERFORMANCE_BENCHMARKING__READER_BENCHMARK_HPP_
+#define ROSBAG2_PERFORMANCE_BENCHMARKING__READER_BENCHMARK_HPP_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "rclcpp/rclcpp.hpp"
+#include "rosbag2_cpp/reader.hpp"
+
+#include "rosbag2_performance_benchmarking/bag_config.hpp"
+#include "rosbag2_performance_benchmarking/publisher_group_config.hpp"
+#include "rosbag2_performance_benchmarking/reader_config.hpp"
+#include "rosbag2_performance_benchmarking/result_utils.hpp"
+
+/// Writes a bag with the messages of the configured producers, then measures how fast it can be
+/// opened, read sequentially, read with a topic filter and seeked in.
+class ReaderBenchmark : public rclcpp::Node
+{
+public:
+  explicit ReaderBenchmark(const std::string & name);
+  void start_benchmark();
+
+private:
+  std::unique_ptr<rosbag2_cpp::Reader> open_reader() const;
+  void measure_read(
+    const std::string & name, const std::vector<std::string> & topics,
+    result_utils::Measurements & measurements);
+  void measure_seek(result_utils::Measurements & measurements);
+  std::vector<std::string> filtered_topics() const;
+
+  std::vector<PublisherGroupConfig> configurations_;
+  std::vector<std::string> group_names_;
+  std::string results_file_;
+  BagConfig bag_config_;
+  ReaderConfig reader_config_;
+};
+
+#endif  // ROSBAG2_PERFORMANCE_BENCHMARKING__READER_BENCHMARK_HPP_
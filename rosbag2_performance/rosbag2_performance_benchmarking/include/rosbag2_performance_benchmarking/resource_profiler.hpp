@@ -0,0 +1,100 @@
+// Copyright 2022 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROSBAG2_PERFORMANCE_BENCHMARKING__RESOURCE_PROFILER_HPP_
+#define ROSBAG2_PERFORMANCE_BENCHMARKING__RESOURCE_PROFILER_HPP_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "rosbag2_performance_benchmarking/result_utils.hpp"
+
+/// Samples the resource usage of this process from /proc/self on a background thread, from
+/// start() until stop(). CPU time, I/O and context switches are counted from start(), so that
+/// whatever the benchmark did before, like writing the bag to read, doesn't count.
+/// Without /proc, all usage is reported as zero.
+class ResourceProfiler
+{
+public:
+  explicit ResourceProfiler(
+    std::chrono::milliseconds sampling_period = std::chrono::milliseconds(100));
+  ~ResourceProfiler();
+
+  ResourceProfiler(const ResourceProfiler &) = delete;
+  ResourceProfiler & operator=(const ResourceProfiler &) = delete;
+
+  void start();
+  /// Takes a last sample and stops the sampling thread
+  void stop();
+
+  /// Append the usage of the process between start() and stop() to measurements
+  void add_measurements(result_utils::Measurements & measurements) const;
+
+  /// Write the CPU time and context switches of each thread seen while sampling, one per line
+  void write_thread_usage(const std::string & file) const;
+
+private:
+  // Cumulative counts of a thread, CPU times in clock ticks
+  struct ThreadCounters
+  {
+    uint64_t user_ticks = 0;
+    uint64_t system_ticks = 0;
+    uint64_t voluntary_switches = 0;
+    uint64_t involuntary_switches = 0;
+  };
+
+  struct ThreadUsage
+  {
+    std::string name;
+    ThreadCounters at_start;
+    ThreadCounters last;
+  };
+
+  // Cumulative counts of the whole process, including threads which already exited
+  struct ProcessCounters
+  {
+    uint64_t user_ticks = 0;
+    uint64_t system_ticks = 0;
+    uint64_t read_bytes = 0;
+    uint64_t write_bytes = 0;
+    uint64_t write_syscalls = 0;
+  };
+
+  void run();
+  void sample(bool at_start);
+
+  const std::chrono::milliseconds sampling_period_;
+  std::thread sampling_thread_;
+  std::mutex mutex_;
+  std::condition_variable stop_condition_;
+  bool stopped_ = true;
+  // The sampling thread leaves itself out of the threads it samples
+  int sampling_thread_id_ = 0;
+
+  ProcessCounters process_at_start_;
+  ProcessCounters process_last_;
+  // Exited threads keep the counts of their last sample, which may miss the end of their work
+  std::map<int, ThreadUsage> threads_;
+  uint64_t peak_rss_kb_ = 0;
+  bool peak_rss_reset_ = false;
+  std::chrono::steady_clock::time_point start_time_;
+  std::chrono::steady_clock::time_point stop_time_;
+};
+
+#endif  // ROSBAG2_PERFORMANCE_BENCHMARKING__RESOURCE_PROFILER_HPP_
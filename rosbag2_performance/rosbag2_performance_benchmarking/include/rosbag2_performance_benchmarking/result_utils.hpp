@@ -16,6 +16,7 @@
 #define ROSBAG2_PERFORMANCE_BENCHMARKING__RESULT_UTILS_HPP_
 
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "rclcpp/node.hpp"
@@ -25,6 +26,24 @@
 namespace result_utils
 {
 
+/// Named values measured by a benchmark run, written as additional result columns
+using Measurements = std::vector<std::pair<std::string, double>>;
+
+/// Nearest rank percentiles of a set of samples, all zero if there are no samples
+struct Percentiles
+{
+  double p50 = 0.0;
+  double p90 = 0.0;
+  double p99 = 0.0;
+  double max = 0.0;
+};
+
+Percentiles percentiles(std::vector<double> samples);
+
+/// Append the percentiles of samples to measurements, as <name>_p50 ... <name>_max
+void add_percentiles(
+  Measurements & measurements, const std::string & name, std::vector<double> samples);
+
 /// Read total count of recorded messages from metadata.yaml file
 int get_message_count_from_metadata(const std::string & uri);
 
@@ -34,6 +53,13 @@ void write_benchmark_results(
   const BagConfig & bag_config,
   const std::string & results_file);
 
+/// Write results like above, followed by the measurements, which are the same in each row
+void write_benchmark_results(
+  const std::vector<PublisherGroupConfig> & publisher_groups_config,
+  const BagConfig & bag_config,
+  const std::string & results_file,
+  const Measurements & measurements);
+
 /// this version works with a standalone node using node parameters
 void write_benchmark_results(rclcpp::Node & node);
 
@@ -15,7 +15,11 @@
 #ifndef ROSBAG2_PERFORMANCE_BENCHMARKING__WRITER_BENCHMARK_HPP_
 #define ROSBAG2_PERFORMANCE_BENCHMARKING__WRITER_BENCHMARK_HPP_
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <thread>
 #include <vector>
@@ -23,12 +27,18 @@
 #include "rclcpp/rclcpp.hpp"
 #include "rosbag2_compression/compression_options.hpp"
 #include "rosbag2_cpp/writers/sequential_writer.hpp"
+#include "rosbag2_storage/serialized_bag_message.hpp"
 
 #include "rosbag2_performance_benchmarking/byte_producer.hpp"
 #include "rosbag2_performance_benchmarking/message_queue.hpp"
 #include "rosbag2_performance_benchmarking/publisher_group_config.hpp"
 #include "rosbag2_performance_benchmarking/bag_config.hpp"
+#include "rosbag2_performance_benchmarking/resource_profiler.hpp"
+#include "rosbag2_performance_benchmarking/result_utils.hpp"
 
+/// Writes messages of producer threads to a bag, mimicking subscription queues of a recorder.
+/// Each message is stamped when produced and when its storage write returns, to measure the
+/// latency of recording besides the messages lost.
 class WriterBenchmark : public rclcpp::Node
 {
 public:
@@ -36,11 +46,28 @@ public:
   void start_benchmark();
 
 private:
+  // Cumulative counts at a point in time since the start of the benchmark
+  struct TimelineSample
+  {
+    double time_s;
+    uint64_t produced;
+    uint64_t queue_dropped;
+    uint64_t writer_dropped;
+    uint64_t committed;
+    uint64_t committed_bytes;
+  };
+
   void create_producers();
   void create_writer();
   void start_producers();
-  void write_results() const;
-  int get_message_count_from_metadata() const;
+  void notify_producer_event(bool completed);
+  void write_queued_messages();
+  void on_commit(
+    const rosbag2_storage::SerializedBagMessage & message,
+    rcutils_time_point_value_t commit_time);
+  void sample_timeline(bool writer_open);
+  void write_timeline() const;
+  result_utils::Measurements summarize();
 
   std::vector<PublisherGroupConfig> configurations_;
   std::string results_file_;
@@ -50,6 +77,27 @@ private:
   std::vector<std::unique_ptr<ByteProducer>> producers_;
   std::vector<std::shared_ptr<ByteMessageQueue>> queues_;
   std::shared_ptr<rosbag2_cpp::writers::SequentialWriter> writer_;
+
+  // Producers signal queued messages and their completion, so the benchmark doesn't poll
+  std::mutex producer_events_mutex_;
+  std::condition_variable producer_events_condition_;
+  bool messages_queued_ = false;
+  size_t completed_producers_ = 0;
+
+  std::atomic<uint64_t> produced_count_{0};
+
+  // Updated by the thread writing to storage
+  std::mutex commit_mutex_;
+  std::vector<double> commit_latencies_ms_;
+  uint64_t committed_count_ = 0;
+  uint64_t committed_bytes_ = 0;
+  rcutils_time_point_value_t last_commit_time_ = 0;
+
+  rcutils_time_point_value_t start_time_ = 0;
+  std::chrono::steady_clock::time_point start_steady_time_;
+  uint64_t writer_dropped_ = 0;
+  std::vector<TimelineSample> timeline_;
+  ResourceProfiler resource_profiler_;
 };
 
 #endif  // ROSBAG2_PERFORMANCE_BENCHMARKING__WRITER_BENCHMARK_HPP_
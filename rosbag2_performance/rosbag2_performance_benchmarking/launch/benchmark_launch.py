@@ -41,6 +41,14 @@ producer node. Result writer node writes final result file.
 
 ROSBAG starts -> PN starts -> PN exits -> ROSBAG exits -> RW starts
 
+READER / PLAYER:
+When 'type' parameter in benchmark description is 'reader' or 'player', the 'reader_benchmark'
+or 'player_benchmark' node is used as producer node instead. It writes a bag with messages of
+the producers as fast as possible, then reads or plays it back and fills up a result file.
+Parameters from 'reader' or 'player' section of benchmark description are passed to the node.
+
+PN starts -> PN exits
+
 After the whole sequence is finished, both producers and benchmark description files are copied
 to benchmark folder.
 """
@@ -263,7 +271,13 @@ def generate_launch_description():
     repeat_each = benchmark_params.get('repeat_each')
     db_root_folder = benchmark_params.get('db_root_folder')
     summary_result_file = benchmark_params.get('summary_result_file')
-    transport = not benchmark_params.get('no_transport')
+    benchmark_type = benchmark_params.get('type', 'writer')
+    if benchmark_type not in ('writer', 'reader', 'player'):
+        raise RuntimeError('Unknown benchmark type {}.'.format(benchmark_type))
+    # Reader and player benchmarks write their own bag, without transport
+    transport = benchmark_type == 'writer' and not benchmark_params.get('no_transport')
+    # Parameters for reader or player benchmark node
+    benchmark_type_params = benchmark_params.get(benchmark_type, {}) or {}
     preserve_bags = benchmark_params.get('preserve_bags')
 
     # Producers options
@@ -285,6 +299,8 @@ def generate_launch_description():
     producer_cfg_name = pathlib.Path(_producers_cfg_path).name.replace('.yaml', '')
     timestamp = datetime.datetime.now().strftime('%Y-%m-%d_%H-%M-%S')
     transport_postfix = 'transport' if transport else 'no_transport'
+    if benchmark_type != 'writer':
+        transport_postfix = benchmark_type
     benchmark_dir_name = benchmark_cfg_name + \
         '_' + producer_cfg_name + \
         '_' + transport_postfix + \
@@ -395,7 +411,19 @@ def generate_launch_description():
         if producer_param['compression_format'] != '':
             parameters.append({'compression_format': producer_param['compression_format']})
 
-        if not transport:
+        if benchmark_type != 'writer':
+            parameters += [
+                {benchmark_type + '.' + name: value}
+                for name, value in benchmark_type_params.items()
+            ]
+            # Reader and player benchmark nodes write their bag and then read or play it back
+            producer_node = launch_ros.actions.Node(
+                package='rosbag2_performance_benchmarking',
+                executable=benchmark_type + '_benchmark',
+                name='rosbag2_performance_benchmarking_node',
+                parameters=parameters
+            )
+        elif not transport:
             # Writer benchmark node writes messages directly to a storage, uses no publishers
             producer_node = launch_ros.actions.Node(
                 package='rosbag2_performance_benchmarking',
@@ -158,6 +158,62 @@ class PostprocessStorageConfig(Postprocess):
         ]
 
 
+class PostprocessMeasurements(Postprocess):
+    """
+    Postprocess.
+
+    Summarize measurements written after the standard result columns, like read throughput or
+    playback lateness of reader and player benchmarks, for each benchmarked configuration.
+    """
+
+    RESULT_COLUMNS = [
+        'instances', 'frequency', 'message_size', 'total_messages_sent', 'cache_size',
+        'max_bagfile_size', 'storage_config', 'compression', 'compression_queue',
+        'compression_threads', 'total_produced', 'total_recorded_count'
+    ]
+
+    def process(self, grouped_data, benchmark_config, producers_config):
+        """
+        Print minimum, average and maximum of each measurement over repetitions.
+
+        :param: grouped data List of grouped results, see PostprocessStorageConfig.
+        :param: benchmark_config Benchmark description from yaml config.
+        :param: producers_config Producers description from yaml config.
+        """
+        if not grouped_data:
+            return
+        measurement_names = [
+            name for name in grouped_data[0][0].keys() if name not in self.RESULT_COLUMNS
+        ]
+        if not measurement_names:
+            return
+
+        # Measurements are the same in all rows of a sample
+        samples_per_config = {}
+        for sample in grouped_data:
+            row = sample[0]
+            config = (
+                row['storage_config'] if row['storage_config'] else 'default',
+                int(row['cache_size']),
+                row['compression'] if row['compression'] else '<default>',
+                int(row['compression_queue']),
+                int(row['compression_threads']),
+                int(row['max_bagfile_size'])
+            )
+            samples_per_config.setdefault(config, []).append(row)
+
+        print('Measurements (min / average / max):')
+        for config, rows in samples_per_config.items():
+            print(
+                '\tstorage config: {}, cache {:,}, compression: {}, compression queue size: {}, '
+                'compression threads: {}, max bagfile size: {}'.format(
+                    pathlib.Path(config[0]).name, *config[1:]))
+            for name in measurement_names:
+                values = [float(row[name]) for row in rows]
+                print('\t\t{}: {:.3f} / {:.3f} / {:.3f}'.format(
+                    name, min(values), statistics.mean(values), max(values)))
+
+
 class Report:
     """Report generator main class."""
 
@@ -175,6 +231,12 @@ class Report:
             self.__benchmark_config,
             self.__producers_config
         )
+        pm = PostprocessMeasurements()
+        pm.process(
+            self.__results_data,
+            self.__benchmark_config,
+            self.__producers_config
+        )
 
     def __load_configs(self):
         producers_config_path = pathlib.Path(self.__benchmark_dir).joinpath('producers.yaml')
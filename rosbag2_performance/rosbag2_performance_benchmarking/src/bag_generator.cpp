@@ -0,0 +1,283 @@
+// Copyright 2022 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "rcutils/allocator.h"
+#include "rcutils/time.h"
+#include "rmw/rmw.h"
+#include "rosbag2_storage/serialized_bag_message.hpp"
+#include "rosbag2_storage/topic_metadata.hpp"
+#include "rosidl_typesupport_cpp/message_type_support.hpp"
+#include "std_msgs/msg/byte_multi_array.hpp"
+
+#include "rosbag2_performance_benchmarking/bag_generator.hpp"
+#include "rosbag2_performance_benchmarking/benchmark_bag.hpp"
+#include "rosbag2_performance_benchmarking/byte_producer.hpp"
+#include "rosbag2_performance_benchmarking/config_utils.hpp"
+
+using namespace std::chrono_literals;
+
+namespace
+{
+// Draws the sizes of the messages of a publisher group around its message size
+class MessageSizes
+{
+public:
+  MessageSizes(
+    const ProducerConfig & producer_config, const GeneratorGroupConfig & generator_config)
+  : distribution_(generator_config.size_distribution),
+    size_(producer_config.message_size),
+    spread_(generator_config.size_spread)
+  {
+    // Normally distributed sizes are cut off at four standard deviations
+    unsigned int width = 0;
+    if (distribution_ == "uniform") {
+      width = spread_;
+    } else if (distribution_ == "normal") {
+      width = 4 * spread_;
+    }
+    min_ = size_ > width ? size_ - width : 0;
+    max_ = size_ + width;
+  }
+
+  unsigned int max() const
+  {
+    return max_;
+  }
+
+  unsigned int next(std::mt19937 & random) const
+  {
+    if (distribution_ == "uniform") {
+      return std::uniform_int_distribution<unsigned int>(min_, max_)(random);
+    }
+    if (distribution_ == "normal" && spread_ > 0) {
+      const double size = std::round(std::normal_distribution<double>(size_, spread_)(random));
+      return static_cast<unsigned int>(
+        std::min(std::max(size, static_cast<double>(min_)), static_cast<double>(max_)));
+    }
+    return size_;
+  }
+
+private:
+  std::string distribution_;
+  unsigned int size_;
+  unsigned int spread_;
+  unsigned int min_;
+  unsigned int max_;
+};
+
+// Messages of a publisher are due at the rate of its group and stamped with its own clock skew
+struct Publisher
+{
+  size_t group_index;
+  std::string topic;
+  rcutils_duration_value_t clock_skew;
+  unsigned int sent_count;
+};
+
+// Time at which a message of the publisher with the index is due
+using DueMessage = std::pair<rcutils_time_point_value_t, size_t>;
+
+// The compressor may resize the serialized data, so it is allocated with the default allocator
+std::shared_ptr<rcutils_uint8_array_t> serialize(const std_msgs::msg::ByteMultiArray & message)
+{
+  static rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  static const auto type_support =
+    rosidl_typesupport_cpp::get_message_type_support_handle<std_msgs::msg::ByteMultiArray>();
+
+  auto msg_array = new rcutils_uint8_array_t;
+  *msg_array = rcutils_get_zero_initialized_uint8_array();
+  // Room for the data and the small layout in front of it, rmw_serialize grows it if needed
+  int error = rcutils_uint8_array_init(msg_array, message.data.size() + 64, &allocator);
+  if (error != RCUTILS_RET_OK) {
+    delete msg_array;
+    throw std::runtime_error(
+            "Error allocating resources for serialized message: " +
+            std::string(rcutils_get_error_string().str));
+  }
+  auto serialized_data = std::shared_ptr<rcutils_uint8_array_t>(
+    msg_array,
+    [](rcutils_uint8_array_t * msg) {
+      rcutils_uint8_array_fini(msg);
+      delete msg;
+    });
+
+  if (rmw_serialize(&message, type_support, serialized_data.get()) != RMW_RET_OK) {
+    throw std::runtime_error("Failed to serialize message");
+  }
+  return serialized_data;
+}
+
+double megabytes(uint64_t bytes)
+{
+  return static_cast<double>(bytes) / 1e6;
+}
+}  // namespace
+
+BagGenerator::BagGenerator(const std::string & name)
+: rclcpp::Node(name)
+{
+  RCLCPP_INFO(get_logger(), "BagGenerator parsing configurations");
+  configurations_ = config_utils::publisher_groups_from_node_parameters(*this);
+  if (configurations_.empty()) {
+    RCLCPP_ERROR(get_logger(), "No publishers/producers found in node parameters");
+    return;
+  }
+
+  bag_config_ = config_utils::bag_config_from_node_parameters(*this);
+  generator_config_ = config_utils::generator_config_from_node_parameters(*this);
+
+  RCLCPP_INFO(get_logger(), "configuration parameters processed");
+}
+
+void BagGenerator::generate()
+{
+  if (configurations_.empty()) {
+    return;
+  }
+
+  rcutils_time_point_value_t start_time = generator_config_.start_time_ns;
+  if (start_time == 0 && rcutils_system_time_now(&start_time) != RCUTILS_RET_OK) {
+    throw std::runtime_error(
+            "Error getting current time: " + std::string(rcutils_get_error_string().str));
+  }
+
+  // Payloads are made with std::rand, like those of the producers. Sizes and time stamps are
+  // drawn from a generator of their own, in the order the messages are written.
+  std::srand(generator_config_.seed);
+  std::mt19937 random(generator_config_.seed);
+
+  // Every message has to end up in the bag, however slow the storage is
+  BagConfig complete_bag_config = bag_config_;
+  complete_bag_config.storage_options.block_on_full_cache = true;
+  auto writer = benchmark_bag::open_writer(complete_bag_config);
+
+  std::vector<MessageSizes> sizes;
+  std::vector<std::shared_ptr<std_msgs::msg::ByteMultiArray>> payloads;
+  std::vector<Publisher> publishers;
+  // Earliest first, publishers in order of configuration for messages due at the same time
+  std::priority_queue<DueMessage, std::vector<DueMessage>, std::greater<DueMessage>> due;
+
+  for (size_t i = 0; i < configurations_.size(); ++i) {
+    const auto & c = configurations_[i];
+    const auto & g = generator_config_.groups[i];
+    sizes.emplace_back(c.producer_config, g);
+
+    // Each message is the start of the random payload of its group, as long as its size
+    auto payload_config = c.producer_config;
+    payload_config.message_size = sizes.back().max();
+    payloads.push_back(generate_random_message(payload_config));
+
+    std::uniform_real_distribution<double> clock_skew_ms(-g.clock_skew_ms, g.clock_skew_ms);
+    for (unsigned int j = 0; j < c.count; ++j) {
+      rosbag2_storage::TopicMetadata topic;
+      topic.name = benchmark_bag::topic_name(c, j);
+      topic.type = "std_msgs/msg/ByteMultiArray";
+      topic.serialization_format = rmw_get_serialization_format();
+      writer->create_topic(topic);
+
+      if (c.producer_config.max_count > 0) {
+        due.emplace(start_time, publishers.size());
+      }
+      publishers.push_back(
+        {i, topic.name,
+          static_cast<rcutils_duration_value_t>(clock_skew_ms(random) * 1e6), 0});
+    }
+  }
+
+  RCLCPP_INFO_STREAM(
+    get_logger(), "Generating bag " << bag_config_.storage_options.uri << " from " <<
+      publishers.size() << " publishers with seed " << generator_config_.seed);
+
+  // Messages are written in the order they are due, so clock skew and jitter make time stamps
+  // go back and forth between topics, like in bags of sources with unsynchronized clocks
+  std_msgs::msg::ByteMultiArray message;
+  uint64_t written_count = 0;
+  uint64_t written_bytes = 0;
+  const auto progress_period = 10s;
+  const auto generation_start = std::chrono::steady_clock::now();
+  auto next_progress_time = generation_start + progress_period;
+  while (!due.empty() && rclcpp::ok()) {
+    const auto next = due.top();
+    due.pop();
+    auto & publisher = publishers[next.second];
+    const auto & c = configurations_[publisher.group_index];
+    const auto & g = generator_config_.groups[publisher.group_index];
+
+    const auto & payload = payloads[publisher.group_index]->data;
+    const auto size = sizes[publisher.group_index].next(random);
+    message.data.assign(payload.begin(), payload.begin() + size);
+    const auto jitter = static_cast<rcutils_duration_value_t>(
+      std::uniform_real_distribution<double>(0.0, g.jitter_ms)(random) * 1e6);
+
+    auto bag_message = std::make_shared<rosbag2_storage::SerializedBagMessage>();
+    bag_message->serialized_data = serialize(message);
+    bag_message->time_stamp = next.first + publisher.clock_skew + jitter;
+    bag_message->topic_name = publisher.topic;
+    // The compressor may shrink the data once written
+    written_bytes += bag_message->serialized_data->buffer_length;
+    writer->write(bag_message);
+    ++written_count;
+
+    if (++publisher.sent_count < c.producer_config.max_count) {
+      due.emplace(
+        start_time + publisher.sent_count * (1000000000LL / c.producer_config.frequency),
+        next.second);
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    if (now >= next_progress_time) {
+      const double elapsed_s = std::chrono::duration<double>(now - generation_start).count();
+      RCLCPP_INFO_STREAM(
+        get_logger(), "Written " << written_count << " messages, " <<
+          megabytes(written_bytes) << " MB at " << megabytes(written_bytes) / elapsed_s <<
+          " MB/s");
+      next_progress_time += progress_period;
+    }
+  }
+  if (!due.empty()) {
+    RCLCPP_WARN(get_logger(), "Interrupted, the bag has only the messages written until now");
+  }
+
+  // Writes the messages left in the cache
+  writer->close();
+  const double elapsed_s =
+    std::chrono::duration<double>(std::chrono::steady_clock::now() - generation_start).count();
+  RCLCPP_INFO_STREAM(
+    get_logger(), "Generated " << written_count << " messages, " << megabytes(written_bytes) <<
+      " MB in " << elapsed_s << " s");
+}
+
+int main(int argc, char * argv[])
+{
+  rclcpp::init(argc, argv);
+  auto generator = std::make_shared<BagGenerator>("bag_generator");
+  generator->generate();
+  RCLCPP_INFO(generator->get_logger(), "Generator terminated");
+  rclcpp::shutdown();
+  return 0;
+}
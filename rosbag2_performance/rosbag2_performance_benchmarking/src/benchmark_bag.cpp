@@ -0,0 +1,178 @@
+// Copyright 2022 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rosbag2_performance_benchmarking/benchmark_bag.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "rclcpp/serialization.hpp"
+#include "rclcpp/serialized_message.hpp"
+#include "rcutils/allocator.h"
+#include "rcutils/time.h"
+#include "rmw/rmw.h"
+#include "rosbag2_compression/compression_factory.hpp"
+#include "rosbag2_compression/compression_options.hpp"
+#include "rosbag2_compression/sequential_compression_writer.hpp"
+#include "rosbag2_cpp/serialization_format_converter_factory.hpp"
+#include "rosbag2_storage/metadata_io.hpp"
+#include "rosbag2_storage/serialized_bag_message.hpp"
+#include "rosbag2_storage/topic_metadata.hpp"
+#include "std_msgs/msg/byte_multi_array.hpp"
+
+#include "rosbag2_performance_benchmarking/byte_producer.hpp"
+
+namespace benchmark_bag
+{
+
+namespace
+{
+// The compressor modifies messages in place, so each message needs its own buffer
+std::shared_ptr<rcutils_uint8_array_t> copy_serialized_data(const rcutils_uint8_array_t & data)
+{
+  static rcutils_allocator_t allocator = rcutils_get_default_allocator();
+
+  auto msg_array = new rcutils_uint8_array_t;
+  *msg_array = rcutils_get_zero_initialized_uint8_array();
+  int error = rcutils_uint8_array_init(msg_array, data.buffer_length, &allocator);
+  if (error != RCUTILS_RET_OK) {
+    delete msg_array;
+    throw std::runtime_error(
+            "Error allocating resources for serialized message: " +
+            std::string(rcutils_get_error_string().str));
+  }
+  std::copy(data.buffer, data.buffer + data.buffer_length, msg_array->buffer);
+  msg_array->buffer_length = data.buffer_length;
+
+  return std::shared_ptr<rcutils_uint8_array_t>(
+    msg_array,
+    [](rcutils_uint8_array_t * msg) {
+      rcutils_uint8_array_fini(msg);
+      delete msg;
+    });
+}
+
+// Messages of all publishers of a group are stamped alike, at the rate of the group
+struct GroupStream
+{
+  size_t group_index;
+  unsigned int sent_count;
+  rcutils_time_point_value_t next_time_stamp;
+};
+}  // namespace
+
+std::shared_ptr<rosbag2_cpp::writers::SequentialWriter> open_writer(
+  const BagConfig & bag_config,
+  std::unique_ptr<rosbag2_storage::StorageFactoryInterface> storage_factory)
+{
+  std::shared_ptr<rosbag2_cpp::writers::SequentialWriter> writer;
+  if (!bag_config.compression_format.empty()) {
+    const auto compression_mode =
+      rosbag2_compression::compression_mode_from_string(bag_config.compression_mode);
+    if (compression_mode == rosbag2_compression::CompressionMode::NONE) {
+      throw std::runtime_error("Invalid compression mode: " + bag_config.compression_mode);
+    }
+    rosbag2_compression::CompressionOptions compression_options{
+      bag_config.compression_format, compression_mode,
+      bag_config.compression_queue_size, bag_config.compression_threads};
+
+    writer = std::make_shared<rosbag2_compression::SequentialCompressionWriter>(
+      compression_options,
+      std::make_unique<rosbag2_compression::CompressionFactory>(),
+      std::move(storage_factory),
+      std::make_shared<rosbag2_cpp::SerializationFormatConverterFactory>(),
+      std::make_unique<rosbag2_storage::MetadataIo>());
+  } else {
+    writer = std::make_shared<rosbag2_cpp::writers::SequentialWriter>(std::move(storage_factory));
+  }
+
+  // TODO(adamdbrw) generalize if converters are to be included in benchmarks
+  std::string serialization_format = rmw_get_serialization_format();
+  writer->open(bag_config.storage_options, {serialization_format, serialization_format});
+  return writer;
+}
+
+std::string topic_name(const PublisherGroupConfig & group_config, unsigned int index)
+{
+  return "/" + group_config.topic_root + "_" + std::to_string(index + 1);
+}
+
+void write_bag(
+  const std::vector<PublisherGroupConfig> & publisher_groups_config,
+  const BagConfig & bag_config)
+{
+  // Every produced message has to end up in the bag, however slow the storage is
+  BagConfig complete_bag_config = bag_config;
+  complete_bag_config.storage_options.block_on_full_cache = true;
+  auto writer = open_writer(complete_bag_config);
+
+  rcutils_time_point_value_t start_time;
+  if (rcutils_system_time_now(&start_time) != RCUTILS_RET_OK) {
+    throw std::runtime_error(
+            "Error getting current time: " + std::string(rcutils_get_error_string().str));
+  }
+
+  rclcpp::Serialization<std_msgs::msg::ByteMultiArray> serialization;
+  std::vector<rclcpp::SerializedMessage> group_messages(publisher_groups_config.size());
+  auto later = [](const GroupStream & a, const GroupStream & b) {
+      return a.next_time_stamp > b.next_time_stamp;
+    };
+  std::priority_queue<GroupStream, std::vector<GroupStream>, decltype(later)> streams(later);
+
+  for (size_t i = 0; i < publisher_groups_config.size(); ++i) {
+    const auto & c = publisher_groups_config[i];
+    for (unsigned int j = 0; j < c.count; ++j) {
+      rosbag2_storage::TopicMetadata topic;
+      topic.name = topic_name(c, j);
+      topic.type = "std_msgs/msg/ByteMultiArray";
+      topic.serialization_format = rmw_get_serialization_format();
+      writer->create_topic(topic);
+    }
+    auto message = generate_random_message(c.producer_config);
+    serialization.serialize_message(message.get(), &group_messages[i]);
+    if (c.count > 0 && c.producer_config.max_count > 0) {
+      streams.push({i, 0, start_time});
+    }
+  }
+
+  // Write in order of time stamps, as messages would arrive when recording
+  while (!streams.empty()) {
+    auto stream = streams.top();
+    streams.pop();
+    const auto & c = publisher_groups_config[stream.group_index];
+    const auto & serialized_data =
+      group_messages[stream.group_index].get_rcl_serialized_message();
+    for (unsigned int j = 0; j < c.count; ++j) {
+      auto message = std::make_shared<rosbag2_storage::SerializedBagMessage>();
+      message->serialized_data = copy_serialized_data(serialized_data);
+      message->time_stamp = stream.next_time_stamp;
+      message->topic_name = topic_name(c, j);
+      writer->write(message);
+    }
+    if (++stream.sent_count < c.producer_config.max_count) {
+      stream.next_time_stamp =
+        start_time + stream.sent_count * (1000000000LL / c.producer_config.frequency);
+      streams.push(stream);
+    }
+  }
+  writer->close();
+}
+
+}  // namespace benchmark_bag
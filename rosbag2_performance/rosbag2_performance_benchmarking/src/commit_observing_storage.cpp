@@ -0,0 +1,152 @@
+// Copyright 2022 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rosbag2_performance_benchmarking/commit_observing_storage.hpp"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+CommitObservingStorage::CommitObservingStorage(
+  std::shared_ptr<rosbag2_storage::storage_interfaces::ReadWriteInterface> storage,
+  commit_callback_t commit_callback)
+: storage_(std::move(storage)),
+  commit_callback_(std::move(commit_callback))
+{}
+
+void CommitObservingStorage::open(
+  const rosbag2_storage::StorageOptions & storage_options,
+  rosbag2_storage::storage_interfaces::IOFlag io_flag)
+{
+  storage_->open(storage_options, io_flag);
+}
+
+void CommitObservingStorage::write(
+  std::shared_ptr<const rosbag2_storage::SerializedBagMessage> msg)
+{
+  storage_->write(msg);
+  rcutils_time_point_value_t commit_time;
+  rcutils_system_time_now(&commit_time);
+  commit_callback_(*msg, commit_time);
+}
+
+void CommitObservingStorage::write(
+  const std::vector<std::shared_ptr<const rosbag2_storage::SerializedBagMessage>> & msg)
+{
+  storage_->write(msg);
+  notify_commit(msg);
+}
+
+void CommitObservingStorage::notify_commit(
+  const std::vector<std::shared_ptr<const rosbag2_storage::SerializedBagMessage>> & messages)
+{
+  rcutils_time_point_value_t commit_time;
+  rcutils_system_time_now(&commit_time);
+  for (const auto & message : messages) {
+    commit_callback_(*message, commit_time);
+  }
+}
+
+void CommitObservingStorage::create_topic(const rosbag2_storage::TopicMetadata & topic)
+{
+  storage_->create_topic(topic);
+}
+
+void CommitObservingStorage::remove_topic(const rosbag2_storage::TopicMetadata & topic)
+{
+  storage_->remove_topic(topic);
+}
+
+bool CommitObservingStorage::has_next()
+{
+  return storage_->has_next();
+}
+
+std::shared_ptr<rosbag2_storage::SerializedBagMessage> CommitObservingStorage::read_next()
+{
+  return storage_->read_next();
+}
+
+std::vector<rosbag2_storage::TopicMetadata> CommitObservingStorage::get_all_topics_and_types()
+{
+  return storage_->get_all_topics_and_types();
+}
+
+void CommitObservingStorage::set_filter(const rosbag2_storage::StorageFilter & storage_filter)
+{
+  storage_->set_filter(storage_filter);
+}
+
+void CommitObservingStorage::reset_filter()
+{
+  storage_->reset_filter();
+}
+
+void CommitObservingStorage::seek(const rcutils_time_point_value_t & timestamp)
+{
+  storage_->seek(timestamp);
+}
+
+rosbag2_storage::BagMetadata CommitObservingStorage::get_metadata()
+{
+  return storage_->get_metadata();
+}
+
+std::string CommitObservingStorage::get_relative_file_path() const
+{
+  return storage_->get_relative_file_path();
+}
+
+uint64_t CommitObservingStorage::get_bagfile_size() const
+{
+  return storage_->get_bagfile_size();
+}
+
+std::string CommitObservingStorage::get_storage_identifier() const
+{
+  return storage_->get_storage_identifier();
+}
+
+uint64_t CommitObservingStorage::get_minimum_split_file_size() const
+{
+  return storage_->get_minimum_split_file_size();
+}
+
+uint64_t CommitObservingStorage::get_number_of_dropped_messages() const
+{
+  return storage_->get_number_of_dropped_messages();
+}
+
+CommitObservingStorageFactory::CommitObservingStorageFactory(commit_callback_t commit_callback)
+: commit_callback_(std::move(commit_callback))
+{}
+
+std::shared_ptr<rosbag2_storage::storage_interfaces::ReadOnlyInterface>
+CommitObservingStorageFactory::open_read_only(
+  const rosbag2_storage::StorageOptions & storage_options)
+{
+  return storage_factory_.open_read_only(storage_options);
+}
+
+std::shared_ptr<rosbag2_storage::storage_interfaces::ReadWriteInterface>
+CommitObservingStorageFactory::open_read_write(
+  const rosbag2_storage::StorageOptions & storage_options)
+{
+  auto storage = storage_factory_.open_read_write(storage_options);
+  if (!storage) {
+    return storage;
+  }
+  return std::make_shared<CommitObservingStorage>(storage, commit_callback_);
+}
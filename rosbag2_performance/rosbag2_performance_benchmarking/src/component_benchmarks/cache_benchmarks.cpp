@@ -0,0 +1,133 @@
+// Copyright 2022 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "rosbag2_cpp/cache/circular_message_cache.hpp"
+#include "rosbag2_cpp/cache/message_cache.hpp"
+
+#include "component_benchmarks.hpp"
+
+namespace component_benchmarks
+{
+
+namespace
+{
+// Room for several of the largest messages, while the smallest ones need many swaps to fill it
+constexpr size_t kCacheSize = 16 * 1024 * 1024;
+
+void message_sizes_counts_and_producers(benchmark::internal::Benchmark * benchmark)
+{
+  for (int64_t size : {64, 4 * 1024, 256 * 1024}) {
+    for (int64_t count : {1000, 10000}) {
+      for (int64_t producers : {1, 2, 4, 8}) {
+        benchmark->Args({size, count, producers});
+      }
+    }
+  }
+  benchmark->ArgNames({"size", "count", "producers"});
+}
+}  // namespace
+
+// Producers push all messages into a blocking cache, split evenly between them, while this thread
+// swaps and drains the buffers like the cache consumer does, until all messages got through.
+static void BM_MessageCachePushSwap(benchmark::State & state)
+{
+  const auto messages = make_messages(state.range(0), state.range(1));
+  const auto producer_count = static_cast<size_t>(state.range(2));
+  int64_t swaps = 0;
+
+  for (auto _ : state) {
+    rosbag2_cpp::cache::MessageCache cache(kCacheSize, true);
+    std::vector<std::thread> producers;
+    for (size_t p = 0; p < producer_count; ++p) {
+      producers.emplace_back(
+        [&cache, &messages, p, producer_count]() {
+          for (size_t i = p; i < messages.size(); i += producer_count) {
+            cache.push(messages[i]);
+          }
+        });
+    }
+
+    size_t consumed = 0;
+    while (consumed < messages.size()) {
+      cache.wait_for_data();
+      cache.swap_buffers();
+      auto buffer = cache.get_consumer_buffer();
+      consumed += buffer->size();
+      buffer->clear();
+      cache.release_consumer_buffer();
+      ++swaps;
+    }
+
+    for (auto & producer : producers) {
+      producer.join();
+    }
+  }
+
+  set_throughput(state, messages);
+  state.counters["swaps_per_iteration"] =
+    benchmark::Counter(static_cast<double>(swaps), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_MessageCachePushSwap)->Apply(message_sizes_counts_and_producers)->UseRealTime();
+
+// Pushing into a full circular cache, which drops the oldest message for each new one
+static void BM_CircularMessageCachePush(benchmark::State & state)
+{
+  const auto messages = make_messages(state.range(0), state.range(1));
+  // Holds half of the messages, so the second half evicts the first one
+  rosbag2_cpp::cache::CircularMessageCache cache(serialized_size(messages) / 2);
+
+  for (auto _ : state) {
+    for (const auto & message : messages) {
+      cache.push(message);
+    }
+  }
+
+  set_throughput(state, messages);
+}
+BENCHMARK(BM_CircularMessageCachePush)->Apply(message_sizes_and_counts);
+
+// Taking a snapshot of a full circular cache and walking through the snapshot
+static void BM_CircularMessageCacheSnapshot(benchmark::State & state)
+{
+  const auto messages = make_messages(state.range(0), state.range(1));
+  rosbag2_cpp::cache::CircularMessageCache cache(serialized_size(messages));
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    for (const auto & message : messages) {
+      cache.push(message);
+    }
+    state.ResumeTiming();
+
+    cache.notify_data_ready();
+    cache.swap_buffers();
+    auto buffer = cache.get_consumer_buffer();
+    for (const auto & message : buffer->data()) {
+      benchmark::DoNotOptimize(message->time_stamp);
+    }
+    buffer->clear();
+    cache.release_consumer_buffer();
+  }
+
+  set_throughput(state, messages);
+}
+BENCHMARK(BM_CircularMessageCacheSnapshot)->Apply(message_sizes_and_counts);
+
+}  // namespace component_benchmarks
@@ -0,0 +1,69 @@
+// Copyright 2022 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+
+#include "rosbag2_cpp/clocks/time_controller_clock.hpp"
+
+namespace component_benchmarks
+{
+
+namespace
+{
+void sleep_periods_and_counts(benchmark::internal::Benchmark * benchmark)
+{
+  for (int64_t period_us : {10, 100, 1000, 10000}) {
+    for (int64_t count : {10, 100}) {
+      benchmark->Args({period_us, count});
+    }
+  }
+  benchmark->ArgNames({"period_us", "count"});
+}
+}  // namespace
+
+// Sleeping until count deadlines period_us apart, as the player does between messages. The time
+// is what the sleeps take, and the counters show how late sleep_until returns after each deadline,
+// which shows up as message lateness in playback.
+static void BM_TimeControllerClockSleepUntil(benchmark::State & state)
+{
+  const auto period = state.range(0) * 1000;
+  const auto count = state.range(1);
+  rosbag2_cpp::TimeControllerClock clock(0);
+  int64_t total_late = 0;
+  int64_t max_late = 0;
+
+  for (auto _ : state) {
+    // Deadlines follow each other regardless of how late the previous sleep returned
+    auto until = clock.now();
+    for (int64_t i = 0; i < count; ++i) {
+      until += period;
+      while (!clock.sleep_until(until)) {}
+      const auto late = clock.now() - until;
+      total_late += late;
+      max_late = std::max(max_late, late);
+    }
+  }
+
+  const auto sleeps = static_cast<double>(state.iterations() * count);
+  state.counters["late_us_mean"] = static_cast<double>(total_late) / 1000.0 / sleeps;
+  state.counters["late_us_max"] = static_cast<double>(max_late) / 1000.0;
+  state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_TimeControllerClockSleepUntil)
+->Apply(sleep_periods_and_counts)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+}  // namespace component_benchmarks
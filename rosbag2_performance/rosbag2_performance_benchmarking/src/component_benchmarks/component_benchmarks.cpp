@@ -0,0 +1,110 @@
+// Copyright 2022 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "component_benchmarks.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "rclcpp/serialization.hpp"
+#include "rclcpp/serialized_message.hpp"
+#include "rosbag2_storage/ros_helper.hpp"
+#include "std_msgs/msg/byte_multi_array.hpp"
+
+#include "rosbag2_performance_benchmarking/byte_producer.hpp"
+
+namespace component_benchmarks
+{
+
+const char kTopic[] = "/component_benchmark";
+const char kTopicType[] = "std_msgs/msg/ByteMultiArray";
+
+namespace
+{
+constexpr int64_t kMaxBytesPerIteration = 256 * 1024 * 1024;
+}  // namespace
+
+void message_sizes_and_counts(benchmark::internal::Benchmark * benchmark)
+{
+  for (int64_t size : {64, 4 * 1024, 256 * 1024, 4 * 1024 * 1024}) {
+    for (int64_t count : {10, 100, 1000, 10000}) {
+      if (size * count <= kMaxBytesPerIteration) {
+        benchmark->Args({size, count});
+      }
+    }
+  }
+  benchmark->ArgNames({"size", "count"});
+}
+
+std::vector<MessagePtr> make_messages(size_t message_size, size_t message_count)
+{
+  ProducerConfig config;
+  config.frequency = 0;
+  config.max_count = static_cast<unsigned int>(message_count);
+  config.message_size = static_cast<unsigned int>(message_size);
+
+  rclcpp::SerializedMessage serialized;
+  rclcpp::Serialization<std_msgs::msg::ByteMultiArray>().serialize_message(
+    generate_random_message(config).get(), &serialized);
+  const auto & data = serialized.get_rcl_serialized_message();
+
+  std::vector<MessagePtr> messages;
+  messages.reserve(message_count);
+  for (size_t i = 0; i < message_count; ++i) {
+    auto message = std::make_shared<rosbag2_storage::SerializedBagMessage>();
+    message->topic_name = kTopic;
+    message->time_stamp = static_cast<rcutils_time_point_value_t>(i) * 1000000;
+    message->serialized_data =
+      rosbag2_storage::make_serialized_message(data.buffer, data.buffer_length);
+    messages.push_back(message);
+  }
+  return messages;
+}
+
+std::shared_ptr<rosbag2_storage::SerializedBagMessage> copy_message(
+  const rosbag2_storage::SerializedBagMessage & message)
+{
+  auto copy = std::make_shared<rosbag2_storage::SerializedBagMessage>(message);
+  copy->serialized_data = rosbag2_storage::make_serialized_message(
+    message.serialized_data->buffer, message.serialized_data->buffer_length);
+  return copy;
+}
+
+size_t serialized_size(const std::vector<MessagePtr> & messages)
+{
+  size_t size = 0;
+  for (const auto & message : messages) {
+    size += message->serialized_data->buffer_length;
+  }
+  return size;
+}
+
+void set_throughput(benchmark::State & state, const std::vector<MessagePtr> & messages)
+{
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(messages.size()));
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(serialized_size(messages)));
+}
+
+TemporaryDirectory::TemporaryDirectory(const std::string & base_name)
+: path_(rcpputils::fs::create_temp_directory(base_name))
+{}
+
+TemporaryDirectory::~TemporaryDirectory()
+{
+  rcpputils::fs::remove_all(path_);
+}
+
+}  // namespace component_benchmarks
@@ -0,0 +1,74 @@
+// Copyright 2022 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef COMPONENT_BENCHMARKS__COMPONENT_BENCHMARKS_HPP_
+#define COMPONENT_BENCHMARKS__COMPONENT_BENCHMARKS_HPP_
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "rcpputils/filesystem_helper.hpp"
+#include "rosbag2_storage/serialized_bag_message.hpp"
+
+namespace component_benchmarks
+{
+
+using MessagePtr = std::shared_ptr<const rosbag2_storage::SerializedBagMessage>;
+
+/// Topic of all messages made by make_messages
+extern const char kTopic[];
+/// Type of all messages made by make_messages
+extern const char kTopicType[];
+
+/// Run a benchmark for each combination of message size (range 0) and message count (range 1),
+/// leaving out combinations of more than a few hundred MB per iteration.
+void message_sizes_and_counts(benchmark::internal::Benchmark * benchmark);
+
+/// CDR serialized std_msgs/msg/ByteMultiArray messages with message_size bytes of random data,
+/// stamped one millisecond apart. The data is the same as in the writer benchmark.
+std::vector<MessagePtr> make_messages(size_t message_size, size_t message_count);
+
+/// Deep copy, for components which modify messages in place
+std::shared_ptr<rosbag2_storage::SerializedBagMessage> copy_message(
+  const rosbag2_storage::SerializedBagMessage & message);
+
+/// Total size of the serialized data of the messages
+size_t serialized_size(const std::vector<MessagePtr> & messages);
+
+/// Report messages and bytes per second, for messages processed in each iteration
+void set_throughput(benchmark::State & state, const std::vector<MessagePtr> & messages);
+
+/// Directory which is removed with all its contents on destruction
+class TemporaryDirectory
+{
+public:
+  explicit TemporaryDirectory(const std::string & base_name);
+  ~TemporaryDirectory();
+
+  TemporaryDirectory(const TemporaryDirectory &) = delete;
+  TemporaryDirectory & operator=(const TemporaryDirectory &) = delete;
+
+  const rcpputils::fs::path & path() const {return path_;}
+
+private:
+  rcpputils::fs::path path_;
+};
+
+}  // namespace component_benchmarks
+
+#endif  // COMPONENT_BENCHMARKS__COMPONENT_BENCHMARKS_HPP_
@@ -0,0 +1,163 @@
+// Copyright 2022 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "rosbag2_compression_zstd/zstd_compressor.hpp"
+#include "rosbag2_compression_zstd/zstd_decompressor.hpp"
+
+#include "component_benchmarks.hpp"
+
+namespace component_benchmarks
+{
+
+namespace
+{
+// Both compress and decompress modify messages in place, so each iteration works on copies
+std::vector<std::shared_ptr<rosbag2_storage::SerializedBagMessage>> copy_messages(
+  const std::vector<MessagePtr> & messages)
+{
+  std::vector<std::shared_ptr<rosbag2_storage::SerializedBagMessage>> copies;
+  copies.reserve(messages.size());
+  for (const auto & message : messages) {
+    copies.push_back(copy_message(*message));
+  }
+  return copies;
+}
+
+std::vector<MessagePtr> compress_messages(const std::vector<MessagePtr> & messages)
+{
+  rosbag2_compression_zstd::ZstdCompressor compressor;
+  std::vector<MessagePtr> compressed;
+  for (const auto & message : copy_messages(messages)) {
+    compressor.compress_serialized_bag_message(message.get());
+    compressed.push_back(message);
+  }
+  return compressed;
+}
+
+// A file with the serialized data of all messages, one after the other
+std::string write_file(
+  const rcpputils::fs::path & directory, const std::vector<MessagePtr> & messages)
+{
+  const auto uri = (directory / "messages.bin").string();
+  std::ofstream file(uri, std::ios::out | std::ios::binary);
+  for (const auto & message : messages) {
+    file.write(
+      reinterpret_cast<const char *>(message->serialized_data->buffer),
+      static_cast<std::streamsize>(message->serialized_data->buffer_length));
+  }
+  return uri;
+}
+
+void set_compression_ratio(benchmark::State & state, size_t compressed, size_t uncompressed)
+{
+  state.counters["compression_ratio"] =
+    static_cast<double>(uncompressed) / static_cast<double>(compressed);
+}
+}  // namespace
+
+static void BM_ZstdCompressMessage(benchmark::State & state)
+{
+  const auto messages = make_messages(state.range(0), state.range(1));
+  rosbag2_compression_zstd::ZstdCompressor compressor;
+  size_t compressed_size = 0;
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto copies = copy_messages(messages);
+    state.ResumeTiming();
+
+    for (const auto & message : copies) {
+      compressor.compress_serialized_bag_message(message.get());
+    }
+
+    state.PauseTiming();
+    compressed_size = serialized_size({copies.begin(), copies.end()});
+    copies.clear();
+    state.ResumeTiming();
+  }
+
+  set_throughput(state, messages);
+  set_compression_ratio(state, compressed_size, serialized_size(messages));
+}
+BENCHMARK(BM_ZstdCompressMessage)->Apply(message_sizes_and_counts);
+
+static void BM_ZstdDecompressMessage(benchmark::State & state)
+{
+  const auto messages = make_messages(state.range(0), state.range(1));
+  const auto compressed = compress_messages(messages);
+  rosbag2_compression_zstd::ZstdDecompressor decompressor;
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto copies = copy_messages(compressed);
+    state.ResumeTiming();
+
+    for (const auto & message : copies) {
+      decompressor.decompress_serialized_bag_message(message.get());
+    }
+
+    state.PauseTiming();
+    copies.clear();
+    state.ResumeTiming();
+  }
+
+  // Throughput of the decompressed data
+  set_throughput(state, messages);
+}
+BENCHMARK(BM_ZstdDecompressMessage)->Apply(message_sizes_and_counts);
+
+static void BM_ZstdCompressFile(benchmark::State & state)
+{
+  const auto messages = make_messages(state.range(0), state.range(1));
+  TemporaryDirectory directory("component_benchmark_zstd");
+  const auto uri = write_file(directory.path(), messages);
+  rosbag2_compression_zstd::ZstdCompressor compressor;
+  std::string compressed_uri;
+
+  for (auto _ : state) {
+    compressed_uri = compressor.compress_uri(uri);
+  }
+
+  set_throughput(state, messages);
+  set_compression_ratio(
+    state, rcpputils::fs::file_size(rcpputils::fs::path(compressed_uri)),
+    serialized_size(messages));
+}
+BENCHMARK(BM_ZstdCompressFile)->Apply(message_sizes_and_counts)->UseRealTime();
+
+static void BM_ZstdDecompressFile(benchmark::State & state)
+{
+  const auto messages = make_messages(state.range(0), state.range(1));
+  TemporaryDirectory directory("component_benchmark_zstd");
+  const auto compressed_uri =
+    rosbag2_compression_zstd::ZstdCompressor().compress_uri(write_file(directory.path(), messages));
+  rosbag2_compression_zstd::ZstdDecompressor decompressor;
+
+  // Each iteration overwrites the uncompressed file
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(decompressor.decompress_uri(compressed_uri));
+  }
+
+  set_throughput(state, messages);
+}
+BENCHMARK(BM_ZstdDecompressFile)->Apply(message_sizes_and_counts)->UseRealTime();
+
+}  // namespace component_benchmarks
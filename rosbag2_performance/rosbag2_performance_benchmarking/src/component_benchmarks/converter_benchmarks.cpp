@@ -0,0 +1,122 @@
+// Copyright 2022 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "rmw/rmw.h"
+#include "rosbag2_cpp/converter.hpp"
+#include "rosbag2_cpp/converter_interfaces/serialization_format_converter.hpp"
+#include "rosbag2_cpp/serialization_format_converter_factory_interface.hpp"
+#include "rosidl_typesupport_cpp/message_type_support.hpp"
+#include "std_msgs/msg/byte_multi_array.hpp"
+
+#include "component_benchmarks.hpp"
+
+namespace component_benchmarks
+{
+
+namespace
+{
+// Converter plugins are not part of rosbag2 and which one gets loaded depends on the environment,
+// so the benchmark brings its own. It converts the messages of the benchmarks with the rmw
+// serialization of the rmw implementation in use, without going through pluginlib.
+class ByteMultiArrayCdrConverter
+  : public rosbag2_cpp::converter_interfaces::SerializationFormatConverter
+{
+public:
+  void deserialize(
+    std::shared_ptr<const rosbag2_storage::SerializedBagMessage> serialized_message,
+    const rosidl_message_type_support_t * /* introspection type support */,
+    std::shared_ptr<rosbag2_cpp::rosbag2_introspection_message_t> ros_message) override
+  {
+    if (rmw_deserialize(
+        serialized_message->serialized_data.get(), type_support_, ros_message->message) !=
+      RMW_RET_OK)
+    {
+      throw std::runtime_error("Failed to deserialize message");
+    }
+  }
+
+  void serialize(
+    std::shared_ptr<const rosbag2_cpp::rosbag2_introspection_message_t> ros_message,
+    const rosidl_message_type_support_t * /* introspection type support */,
+    std::shared_ptr<rosbag2_storage::SerializedBagMessage> serialized_message) override
+  {
+    if (rmw_serialize(
+        ros_message->message, type_support_, serialized_message->serialized_data.get()) !=
+      RMW_RET_OK)
+    {
+      throw std::runtime_error("Failed to serialize message");
+    }
+  }
+
+private:
+  const rosidl_message_type_support_t * type_support_ =
+    rosidl_typesupport_cpp::get_message_type_support_handle<std_msgs::msg::ByteMultiArray>();
+};
+
+class ByteMultiArrayConverterFactory
+  : public rosbag2_cpp::SerializationFormatConverterFactoryInterface
+{
+public:
+  std::unique_ptr<rosbag2_cpp::converter_interfaces::SerializationFormatDeserializer>
+  load_deserializer(const std::string & format) override
+  {
+    if (format != "cdr") {
+      return nullptr;
+    }
+    return std::make_unique<ByteMultiArrayCdrConverter>();
+  }
+
+  std::unique_ptr<rosbag2_cpp::converter_interfaces::SerializationFormatSerializer>
+  load_serializer(const std::string & format) override
+  {
+    if (format != "cdr") {
+      return nullptr;
+    }
+    return std::make_unique<ByteMultiArrayCdrConverter>();
+  }
+
+  std::vector<std::string> get_declared_serialization_plugins() const override
+  {
+    return {"cdr"};
+  }
+};
+}  // namespace
+
+// Deserializing each message into a message allocated from its introspection type support and
+// serializing it again, as the readers and writers do when converting between formats.
+static void BM_ConverterConvert(benchmark::State & state)
+{
+  const auto messages = make_messages(state.range(0), state.range(1));
+  rosbag2_cpp::Converter converter(
+    "cdr", "cdr", std::make_shared<ByteMultiArrayConverterFactory>());
+  converter.add_topic(kTopic, kTopicType);
+
+  for (auto _ : state) {
+    for (const auto & message : messages) {
+      benchmark::DoNotOptimize(converter.convert(message));
+    }
+  }
+
+  set_throughput(state, messages);
+}
+BENCHMARK(BM_ConverterConvert)->Apply(message_sizes_and_counts);
+
+}  // namespace component_benchmarks
@@ -0,0 +1,120 @@
+// Copyright 2022 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "rosbag2_storage/storage_interfaces/base_io_interface.hpp"
+#include "rosbag2_storage/storage_options.hpp"
+#include "rosbag2_storage/topic_metadata.hpp"
+#include "rosbag2_storage_default_plugins/sqlite/sqlite_storage.hpp"
+
+#include "component_benchmarks.hpp"
+
+namespace component_benchmarks
+{
+
+namespace
+{
+using rosbag2_storage::storage_interfaces::IOFlag;
+using rosbag2_storage_plugins::SqliteStorage;
+
+// Opens a new database in the directory, named after the number of databases opened before
+std::unique_ptr<SqliteStorage> open_for_writing(const rcpputils::fs::path & directory)
+{
+  static unsigned int opened = 0;
+  rosbag2_storage::StorageOptions options;
+  options.uri = (directory / ("bag_" + std::to_string(opened++))).string();
+  options.storage_id = "sqlite3";
+
+  auto storage = std::make_unique<SqliteStorage>();
+  storage->open(options, IOFlag::READ_WRITE);
+  storage->create_topic({kTopic, kTopicType, "cdr", ""});
+  return storage;
+}
+
+// Writing includes closing the storage, so that committing the last messages is accounted for
+template<typename WriteFunction>
+void write_benchmark(benchmark::State & state, WriteFunction write)
+{
+  const auto messages = make_messages(state.range(0), state.range(1));
+  TemporaryDirectory directory("component_benchmark_sqlite");
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto storage = open_for_writing(directory.path());
+    state.ResumeTiming();
+
+    write(*storage, messages);
+    storage.reset();
+  }
+
+  set_throughput(state, messages);
+}
+}  // namespace
+
+// One write call per message, each in a transaction of its own
+static void BM_SqliteWriteSingle(benchmark::State & state)
+{
+  write_benchmark(
+    state, [](SqliteStorage & storage, const std::vector<MessagePtr> & messages) {
+      for (const auto & message : messages) {
+        storage.write(message);
+      }
+    });
+}
+BENCHMARK(BM_SqliteWriteSingle)->Apply(message_sizes_and_counts)->UseRealTime();
+
+// All messages in one write call, as the cache consumer does with a full cache buffer
+static void BM_SqliteWriteBatch(benchmark::State & state)
+{
+  write_benchmark(
+    state, [](SqliteStorage & storage, const std::vector<MessagePtr> & messages) {
+      storage.write(messages);
+    });
+}
+BENCHMARK(BM_SqliteWriteBatch)->Apply(message_sizes_and_counts)->UseRealTime();
+
+// Opening a written database and reading all of its messages
+static void BM_SqliteReadNext(benchmark::State & state)
+{
+  const auto messages = make_messages(state.range(0), state.range(1));
+  TemporaryDirectory directory("component_benchmark_sqlite");
+  std::string uri;
+  {
+    auto storage = open_for_writing(directory.path());
+    storage->write(messages);
+    // The path of the database file, as the uri of the storage was already absolute
+    uri = storage->get_relative_file_path();
+  }
+
+  rosbag2_storage::StorageOptions options;
+  options.uri = uri;
+  options.storage_id = "sqlite3";
+  for (auto _ : state) {
+    SqliteStorage storage;
+    storage.open(options, IOFlag::READ_ONLY);
+    while (storage.has_next()) {
+      benchmark::DoNotOptimize(storage.read_next());
+    }
+  }
+
+  set_throughput(state, messages);
+}
+BENCHMARK(BM_SqliteReadNext)->Apply(message_sizes_and_counts)->UseRealTime();
+
+}  // namespace component_benchmarks
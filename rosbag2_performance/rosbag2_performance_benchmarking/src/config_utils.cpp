@@ -14,6 +14,7 @@
 
 #include "rosbag2_performance_benchmarking/config_utils.hpp"
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -112,22 +113,113 @@ BagConfig bag_config_from_node_parameters(
   node.declare_parameter<std::string>("storage_id", "sqlite3");
   node.declare_parameter<int>("max_cache_size", 10000000);
   node.declare_parameter<int>("max_bag_size", 0);
+  node.declare_parameter<int>("max_bag_duration", 0);
   node.declare_parameter<std::string>("db_folder", default_bag_folder);
   node.declare_parameter<std::string>("storage_config_file", "");
   node.declare_parameter<std::string>("compression_format", "");
+  node.declare_parameter<std::string>("compression_mode", "message");
   node.declare_parameter<int>("compression_queue_size", 1);
   node.declare_parameter<int>("compression_threads", 0);
 
   node.get_parameter("storage_id", bag_config.storage_options.storage_id);
   node.get_parameter("max_cache_size", bag_config.storage_options.max_cache_size);
   node.get_parameter("max_bag_size", bag_config.storage_options.max_bagfile_size);
+  node.get_parameter("max_bag_duration", bag_config.storage_options.max_bagfile_duration);
   node.get_parameter("db_folder", bag_config.storage_options.uri);
   node.get_parameter("storage_config_file", bag_config.storage_options.storage_config_uri);
   node.get_parameter("compression_format", bag_config.compression_format);
+  node.get_parameter("compression_mode", bag_config.compression_mode);
   node.get_parameter("compression_queue_size", bag_config.compression_queue_size);
   node.get_parameter("compression_threads", bag_config.compression_threads);
 
   return bag_config;
 }
 
+ReaderConfig reader_config_from_node_parameters(
+  rclcpp::Node & node)
+{
+  const std::string parameters_ns = "reader";
+  ReaderConfig reader_config;
+
+  node.declare_parameter<std::vector<std::string>>(
+    parameters_ns + ".filter_groups", std::vector<std::string>());
+  node.declare_parameter<int>(parameters_ns + ".seek_count", 100);
+
+  node.get_parameter(parameters_ns + ".filter_groups", reader_config.filter_groups);
+  node.get_parameter(parameters_ns + ".seek_count", reader_config.seek_count);
+
+  return reader_config;
+}
+
+PlayerConfig player_config_from_node_parameters(
+  rclcpp::Node & node)
+{
+  const std::string parameters_ns = "player";
+  PlayerConfig player_config;
+
+  node.declare_parameter<double>(parameters_ns + ".rate", 1.0);
+  node.declare_parameter<int>(parameters_ns + ".read_ahead_queue_size", 1000);
+
+  node.get_parameter(parameters_ns + ".rate", player_config.rate);
+  node.get_parameter(
+    parameters_ns + ".read_ahead_queue_size", player_config.read_ahead_queue_size);
+
+  if (player_config.rate <= 0.0) {
+    RCLCPP_ERROR(node.get_logger(), "Playback rate must be positive, using 1.0");
+    player_config.rate = 1.0;
+  }
+
+  return player_config;
+}
+
+GeneratorConfig generator_config_from_node_parameters(
+  rclcpp::Node & node)
+{
+  const std::string parameters_ns = "generator";
+  GeneratorConfig generator_config;
+
+  node.declare_parameter<int>(parameters_ns + ".seed", 0);
+  node.declare_parameter<int64_t>(parameters_ns + ".start_time_ns", 0);
+
+  node.get_parameter(parameters_ns + ".seed", generator_config.seed);
+  node.get_parameter(parameters_ns + ".start_time_ns", generator_config.start_time_ns);
+
+  std::vector<std::string> publisher_groups;
+  node.get_parameter("publishers.publisher_groups", publisher_groups);
+  for (const auto & group_name : publisher_groups) {
+    auto group_prefix = "publishers." + group_name;
+    node.declare_parameter<std::string>(group_prefix + ".size_distribution", "fixed");
+    node.declare_parameter<int>(group_prefix + ".size_spread_bytes", 0);
+    node.declare_parameter<double>(group_prefix + ".clock_skew_ms", 0.0);
+    node.declare_parameter<double>(group_prefix + ".jitter_ms", 0.0);
+
+    GeneratorGroupConfig group_config;
+    node.get_parameter(group_prefix + ".size_distribution", group_config.size_distribution);
+    node.get_parameter(group_prefix + ".size_spread_bytes", group_config.size_spread);
+    node.get_parameter(group_prefix + ".clock_skew_ms", group_config.clock_skew_ms);
+    node.get_parameter(group_prefix + ".jitter_ms", group_config.jitter_ms);
+
+    if (group_config.size_distribution != "fixed" &&
+      group_config.size_distribution != "uniform" &&
+      group_config.size_distribution != "normal")
+    {
+      RCLCPP_ERROR_STREAM(
+        node.get_logger(), "Unknown size distribution " << group_config.size_distribution <<
+          " of group " << group_name << ", using fixed sizes");
+      group_config.size_distribution = "fixed";
+    }
+    if (group_config.clock_skew_ms < 0.0 || group_config.jitter_ms < 0.0) {
+      RCLCPP_ERROR_STREAM(
+        node.get_logger(), "Clock skew and jitter of group " << group_name <<
+          " can't be negative, using 0");
+      group_config.clock_skew_ms = std::max(group_config.clock_skew_ms, 0.0);
+      group_config.jitter_ms = std::max(group_config.jitter_ms, 0.0);
+    }
+
+    generator_config.groups.push_back(group_config);
+  }
+
+  return generator_config;
+}
+
 }  // namespace config_utils
@@ -0,0 +1,132 @@
+// Copyright 2022 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <ctime>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "rclcpp/executors/single_threaded_executor.hpp"
+#include "rosbag2_storage/serialized_bag_message.hpp"
+#include "rosbag2_transport/play_options.hpp"
+#include "rosbag2_transport/player.hpp"
+
+#include "rosbag2_performance_benchmarking/benchmark_bag.hpp"
+#include "rosbag2_performance_benchmarking/config_utils.hpp"
+#include "rosbag2_performance_benchmarking/player_benchmark.hpp"
+#include "rosbag2_performance_benchmarking/resource_profiler.hpp"
+#include "rosbag2_performance_benchmarking/result_utils.hpp"
+
+PlayerBenchmark::PlayerBenchmark(const std::string & name)
+: rclcpp::Node(name)
+{
+  RCLCPP_INFO(get_logger(), "PlayerBenchmark parsing configurations");
+  configurations_ = config_utils::publisher_groups_from_node_parameters(*this);
+  if (configurations_.empty()) {
+    RCLCPP_ERROR(get_logger(), "No publishers/producers found in node parameters");
+    return;
+  }
+
+  bag_config_ = config_utils::bag_config_from_node_parameters(*this);
+  player_config_ = config_utils::player_config_from_node_parameters(*this);
+
+  this->declare_parameter("results_file", bag_config_.storage_options.uri + "/results.csv");
+  this->get_parameter("results_file", results_file_);
+
+  RCLCPP_INFO(get_logger(), "configuration parameters processed");
+}
+
+void PlayerBenchmark::start_benchmark()
+{
+  if (configurations_.empty()) {
+    return;
+  }
+  RCLCPP_INFO(get_logger(), "Writing the bag to benchmark playback");
+  benchmark_bag::write_bag(configurations_, bag_config_);
+
+  rosbag2_transport::PlayOptions play_options;
+  play_options.rate = static_cast<float>(player_config_.rate);
+  play_options.read_ahead_queue_size = player_config_.read_ahead_queue_size;
+  play_options.disable_keyboard_controls = true;
+  // The player must not pick up the node name and parameters meant for the benchmark node
+  auto player = std::make_shared<rosbag2_transport::Player>(
+    bag_config_.storage_options, play_options, "rosbag2_player_benchmark",
+    rclcpp::NodeOptions().use_global_arguments(false));
+
+  size_t message_count = 0;
+  for (const auto & c : configurations_) {
+    message_count += static_cast<size_t>(c.count) * c.producer_config.max_count;
+  }
+
+  // Time stamp and publish time of each message, in order of playback. The callback runs on
+  // the thread calling play().
+  std::vector<std::pair<rcutils_time_point_value_t, std::chrono::steady_clock::time_point>>
+  published;
+  published.reserve(message_count);
+  player->add_on_play_message_post_callback(
+    [&published](std::shared_ptr<rosbag2_storage::SerializedBagMessage> message) {
+      published.emplace_back(message->time_stamp, std::chrono::steady_clock::now());
+    });
+
+  RCLCPP_INFO(get_logger(), "Starting the PlayerBenchmark");
+  ResourceProfiler resource_profiler;
+  resource_profiler.start();
+  const auto cpu_start = std::clock();
+  player->play();
+  const double cpu_us = 1e6 * static_cast<double>(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+  resource_profiler.stop();
+
+  // Lateness is measured against the first published message, so that opening the bag and
+  // filling the read ahead queue don't count. Negative values mean early publication.
+  std::vector<double> lateness_us;
+  lateness_us.reserve(published.size());
+  for (const auto & message : published) {
+    const auto scheduled = published.front().second +
+      std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+      std::chrono::duration<double, std::nano>(
+        (message.first - published.front().first) / player_config_.rate));
+    lateness_us.push_back(
+      std::chrono::duration<double, std::micro>(message.second - scheduled).count());
+  }
+
+  result_utils::Measurements measurements;
+  measurements.emplace_back("played_count", static_cast<double>(published.size()));
+  measurements.emplace_back(
+    "play_cpu_us_per_msg", published.empty() ? 0.0 : cpu_us / published.size());
+  result_utils::add_percentiles(measurements, "lateness_us", lateness_us);
+  resource_profiler.add_measurements(measurements);
+  resource_profiler.write_thread_usage(bag_config_.storage_options.uri + "/resource_threads.csv");
+
+  result_utils::write_benchmark_results(
+    configurations_, bag_config_, results_file_, measurements);
+}
+
+int main(int argc, char * argv[])
+{
+  rclcpp::init(argc, argv);
+  auto bench = std::make_shared<PlayerBenchmark>("rosbag2_performance_benchmarking_node");
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(bench);
+
+  // The benchmark has its own control loop but uses spinning for parameters
+  std::thread spin_thread([&executor]() {executor.spin();});
+  bench->start_benchmark();
+  RCLCPP_INFO(bench->get_logger(), "Benchmark terminated");
+  rclcpp::shutdown();
+  spin_thread.join();
+  return 0;
+}
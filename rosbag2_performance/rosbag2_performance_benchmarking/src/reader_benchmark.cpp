@@ -0,0 +1,224 @@
+// Copyright 2022 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "rclcpp/executors/single_threaded_executor.hpp"
+#include "rmw/rmw.h"
+#include "rosbag2_cpp/bag_events.hpp"
+#include "rosbag2_storage/storage_filter.hpp"
+#include "rosbag2_transport/reader_writer_factory.hpp"
+
+#include "rosbag2_performance_benchmarking/benchmark_bag.hpp"
+#include "rosbag2_performance_benchmarking/config_utils.hpp"
+#include "rosbag2_performance_benchmarking/reader_benchmark.hpp"
+#include "rosbag2_performance_benchmarking/resource_profiler.hpp"
+#include "rosbag2_performance_benchmarking/result_utils.hpp"
+
+namespace
+{
+double elapsed_ms(
+  const std::chrono::steady_clock::time_point & start,
+  const std::chrono::steady_clock::time_point & end)
+{
+  return std::chrono::duration<double, std::milli>(end - start).count();
+}
+}  // namespace
+
+ReaderBenchmark::ReaderBenchmark(const std::string & name)
+: rclcpp::Node(name)
+{
+  RCLCPP_INFO(get_logger(), "ReaderBenchmark parsing configurations");
+  configurations_ = config_utils::publisher_groups_from_node_parameters(*this);
+  if (configurations_.empty()) {
+    RCLCPP_ERROR(get_logger(), "No publishers/producers found in node parameters");
+    return;
+  }
+  this->get_parameter("publishers.publisher_groups", group_names_);
+
+  bag_config_ = config_utils::bag_config_from_node_parameters(*this);
+  reader_config_ = config_utils::reader_config_from_node_parameters(*this);
+
+  this->declare_parameter("results_file", bag_config_.storage_options.uri + "/results.csv");
+  this->get_parameter("results_file", results_file_);
+
+  RCLCPP_INFO(get_logger(), "configuration parameters processed");
+}
+
+void ReaderBenchmark::start_benchmark()
+{
+  if (configurations_.empty()) {
+    return;
+  }
+  RCLCPP_INFO(get_logger(), "Writing the bag to benchmark reading");
+  benchmark_bag::write_bag(configurations_, bag_config_);
+
+  RCLCPP_INFO(get_logger(), "Starting the ReaderBenchmark");
+  result_utils::Measurements measurements;
+  ResourceProfiler resource_profiler;
+  resource_profiler.start();
+
+  // Includes reading the metadata and, for bags compressed per file, decompressing the first
+  // file. Closing the reader is not part of it.
+  {
+    const auto open_start = std::chrono::steady_clock::now();
+    auto reader = open_reader();
+    const auto open_end = std::chrono::steady_clock::now();
+    measurements.emplace_back("open_ms", elapsed_ms(open_start, open_end));
+  }
+
+  measure_read("read", {}, measurements);
+  measure_read("filtered_read", filtered_topics(), measurements);
+  measure_seek(measurements);
+  resource_profiler.stop();
+  resource_profiler.add_measurements(measurements);
+  resource_profiler.write_thread_usage(bag_config_.storage_options.uri + "/resource_threads.csv");
+
+  result_utils::write_benchmark_results(
+    configurations_, bag_config_, results_file_, measurements);
+}
+
+std::unique_ptr<rosbag2_cpp::Reader> ReaderBenchmark::open_reader() const
+{
+  auto reader = rosbag2_transport::ReaderWriterFactory::make_reader(bag_config_.storage_options);
+  reader->open(bag_config_.storage_options, {"", rmw_get_serialization_format()});
+  return reader;
+}
+
+void ReaderBenchmark::measure_read(
+  const std::string & name, const std::vector<std::string> & topics,
+  result_utils::Measurements & measurements)
+{
+  auto reader = open_reader();
+  if (!topics.empty()) {
+    rosbag2_storage::StorageFilter filter;
+    filter.topics = topics;
+    reader->set_filter(filter);
+  }
+
+  bool split = false;
+  rosbag2_cpp::bag_events::ReaderEventCallbacks callbacks;
+  callbacks.read_split_callback = [&split](rosbag2_cpp::bag_events::BagSplitInfo &) {
+      split = true;
+    };
+  reader->add_event_callbacks(callbacks);
+
+  size_t message_count = 0;
+  size_t byte_count = 0;
+  // Time from the previous message to the first message of each newly opened file
+  std::vector<double> split_stalls_ms;
+
+  const auto cpu_start = std::clock();
+  const auto start = std::chrono::steady_clock::now();
+  auto message_start = start;
+  while (reader->has_next()) {
+    auto message = reader->read_next();
+    ++message_count;
+    byte_count += message->serialized_data->buffer_length;
+    const auto message_end = std::chrono::steady_clock::now();
+    if (split) {
+      split_stalls_ms.push_back(elapsed_ms(message_start, message_end));
+      split = false;
+    }
+    message_start = message_end;
+  }
+  const double seconds = elapsed_ms(start, std::chrono::steady_clock::now()) / 1000.0;
+  const double cpu_us = 1e6 * static_cast<double>(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+
+  RCLCPP_INFO_STREAM(
+    get_logger(), name << ": " << message_count << " messages, " << byte_count <<
+      " bytes in " << seconds << " s");
+
+  measurements.emplace_back(name + "_count", static_cast<double>(message_count));
+  measurements.emplace_back(name + "_mb_per_s", seconds > 0 ? byte_count / 1e6 / seconds : 0.0);
+  measurements.emplace_back(
+    name + "_cpu_us_per_msg", message_count > 0 ? cpu_us / message_count : 0.0);
+  measurements.emplace_back(name + "_splits", static_cast<double>(split_stalls_ms.size()));
+  measurements.emplace_back(
+    name + "_split_stall_max_ms",
+    split_stalls_ms.empty() ? 0.0 : *std::max_element(
+      split_stalls_ms.begin(), split_stalls_ms.end()));
+}
+
+void ReaderBenchmark::measure_seek(result_utils::Measurements & measurements)
+{
+  auto reader = open_reader();
+  const auto & metadata = reader->get_metadata();
+  const int64_t bag_start = std::chrono::duration_cast<std::chrono::nanoseconds>(
+    metadata.starting_time.time_since_epoch()).count();
+  const int64_t bag_duration = std::max<int64_t>(metadata.duration.count(), 0);
+
+  // Fixed seed, so that each run seeks to the same points of the bag
+  std::mt19937_64 generator(0);
+  std::uniform_int_distribution<int64_t> offsets(0, bag_duration);
+
+  // Seeking is lazy, so the latency includes reading the first message after the seek point
+  std::vector<double> latencies_us;
+  latencies_us.reserve(reader_config_.seek_count);
+  for (unsigned int i = 0; i < reader_config_.seek_count; ++i) {
+    const auto seek_time = bag_start + offsets(generator);
+    const auto start = std::chrono::steady_clock::now();
+    reader->seek(seek_time);
+    if (reader->has_next()) {
+      reader->read_next();
+    }
+    latencies_us.push_back(1000.0 * elapsed_ms(start, std::chrono::steady_clock::now()));
+  }
+  result_utils::add_percentiles(measurements, "seek_us", latencies_us);
+}
+
+std::vector<std::string> ReaderBenchmark::filtered_topics() const
+{
+  std::vector<std::string> filter_groups = reader_config_.filter_groups;
+  if (filter_groups.empty()) {
+    filter_groups.push_back(group_names_.front());
+  }
+
+  std::vector<std::string> topics;
+  for (const auto & group_name : filter_groups) {
+    const auto group = std::find(group_names_.begin(), group_names_.end(), group_name);
+    if (group == group_names_.end()) {
+      RCLCPP_ERROR_STREAM(get_logger(), "Unknown publisher group to filter: " << group_name);
+      continue;
+    }
+    const auto & c = configurations_[group - group_names_.begin()];
+    for (unsigned int i = 0; i < c.count; ++i) {
+      topics.push_back(benchmark_bag::topic_name(c, i));
+    }
+  }
+  return topics;
+}
+
+int main(int argc, char * argv[])
+{
+  rclcpp::init(argc, argv);
+  auto bench = std::make_shared<ReaderBenchmark>("rosbag2_performance_benchmarking_node");
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(bench);
+
+  // The benchmark has its own control loop but uses spinning for parameters
+  std::thread spin_thread([&executor]() {executor.spin();});
+  bench->start_benchmark();
+  RCLCPP_INFO(bench->get_logger(), "Benchmark terminated");
+  rclcpp::shutdown();
+  spin_thread.join();
+  return 0;
+}
@@ -0,0 +1,291 @@
+// Copyright 2022 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rosbag2_performance_benchmarking/resource_profiler.hpp"
+
+#include <dirent.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+// Positions of utime and stime in a stat file, counted from the field after the command name
+constexpr size_t kUserTicksField = 11;
+constexpr size_t kSystemTicksField = 12;
+
+// Fields of a stat file which follow the command name. The name is in parentheses and may
+// contain spaces, so the fields start after the last closing parenthesis.
+std::vector<std::string> stat_fields(const std::string & stat_file, std::string & name)
+{
+  std::ifstream file(stat_file);
+  std::string content;
+  std::getline(file, content);
+  const auto name_start = content.find('(');
+  const auto name_end = content.rfind(')');
+  if (name_start == std::string::npos || name_end == std::string::npos || name_end < name_start) {
+    return {};
+  }
+  name = content.substr(name_start + 1, name_end - name_start - 1);
+
+  std::vector<std::string> fields;
+  std::istringstream rest(content.substr(name_end + 1));
+  std::string field;
+  while (rest >> field) {
+    fields.push_back(field);
+  }
+  return fields;
+}
+
+uint64_t to_count(const std::string & field)
+{
+  return std::strtoull(field.c_str(), nullptr, 10);
+}
+
+// Numbers of "key: value" lines as in status and io files, without units like kB
+std::map<std::string, uint64_t> key_values(const std::string & file_name)
+{
+  std::map<std::string, uint64_t> values;
+  std::ifstream file(file_name);
+  std::string line;
+  while (std::getline(file, line)) {
+    const auto colon = line.find(':');
+    if (colon == std::string::npos) {
+      continue;
+    }
+    std::istringstream value_stream(line.substr(colon + 1));
+    uint64_t value = 0;
+    if (value_stream >> value) {
+      values[line.substr(0, colon)] = value;
+    }
+  }
+  return values;
+}
+
+uint64_t value_of(const std::map<std::string, uint64_t> & values, const std::string & key)
+{
+  const auto value = values.find(key);
+  return value == values.end() ? 0 : value->second;
+}
+
+std::vector<int> thread_ids()
+{
+  std::vector<int> ids;
+  DIR * directory = opendir("/proc/self/task");
+  if (directory == nullptr) {
+    return ids;
+  }
+  while (const auto * entry = readdir(directory)) {
+    const int id = std::atoi(entry->d_name);
+    if (id > 0) {
+      ids.push_back(id);
+    }
+  }
+  closedir(directory);
+  return ids;
+}
+
+int current_thread_id()
+{
+  return static_cast<int>(syscall(SYS_gettid));
+}
+
+// Resets the peak resident set size of the process to its current size, see clear_refs in
+// proc(5). Kernels before 4.0 don't support it.
+bool reset_peak_rss()
+{
+  std::ofstream clear_refs("/proc/self/clear_refs");
+  clear_refs << "5";
+  clear_refs.flush();
+  return clear_refs.good();
+}
+
+double megabytes(uint64_t bytes)
+{
+  return static_cast<double>(bytes) / 1e6;
+}
+}  // namespace
+
+ResourceProfiler::ResourceProfiler(std::chrono::milliseconds sampling_period)
+: sampling_period_(sampling_period)
+{}
+
+ResourceProfiler::~ResourceProfiler()
+{
+  stop();
+}
+
+void ResourceProfiler::start()
+{
+  if (!stopped_) {
+    return;
+  }
+  threads_.clear();
+  peak_rss_kb_ = 0;
+  peak_rss_reset_ = reset_peak_rss();
+  start_time_ = std::chrono::steady_clock::now();
+  sample(true);
+
+  stopped_ = false;
+  sampling_thread_ = std::thread(&ResourceProfiler::run, this);
+}
+
+void ResourceProfiler::stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stopped_) {
+      return;
+    }
+    stopped_ = true;
+  }
+  stop_condition_.notify_one();
+  sampling_thread_.join();
+
+  sample(false);
+  stop_time_ = std::chrono::steady_clock::now();
+}
+
+void ResourceProfiler::run()
+{
+  sampling_thread_id_ = current_thread_id();
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!stop_condition_.wait_for(lock, sampling_period_, [this] {return stopped_;})) {
+    sample(false);
+  }
+}
+
+void ResourceProfiler::sample(bool at_start)
+{
+  std::string name;
+  const auto process_stat = stat_fields("/proc/self/stat", name);
+  const auto io = key_values("/proc/self/io");
+  ProcessCounters process;
+  if (process_stat.size() > kSystemTicksField) {
+    process.user_ticks = to_count(process_stat[kUserTicksField]);
+    process.system_ticks = to_count(process_stat[kSystemTicksField]);
+  }
+  process.read_bytes = value_of(io, "read_bytes");
+  process.write_bytes = value_of(io, "write_bytes");
+  process.write_syscalls = value_of(io, "syscw");
+  if (at_start) {
+    process_at_start_ = process;
+  }
+  process_last_ = process;
+
+  // Without the reset, the high water mark may be from before the start, so only the sampled
+  // sizes count
+  const auto status = key_values("/proc/self/status");
+  peak_rss_kb_ = std::max(peak_rss_kb_, value_of(status, "VmRSS"));
+  if (peak_rss_reset_) {
+    peak_rss_kb_ = std::max(peak_rss_kb_, value_of(status, "VmHWM"));
+  }
+
+  // Context switches in the status of the process are those of its main thread only
+  for (const auto id : thread_ids()) {
+    if (id == sampling_thread_id_) {
+      continue;
+    }
+    const std::string task_directory = "/proc/self/task/" + std::to_string(id);
+    const auto thread_stat = stat_fields(task_directory + "/stat", name);
+    if (thread_stat.size() <= kSystemTicksField) {
+      // The thread exited since listing the threads
+      continue;
+    }
+    const auto thread_status = key_values(task_directory + "/status");
+    ThreadCounters counters;
+    counters.user_ticks = to_count(thread_stat[kUserTicksField]);
+    counters.system_ticks = to_count(thread_stat[kSystemTicksField]);
+    counters.voluntary_switches = value_of(thread_status, "voluntary_ctxt_switches");
+    counters.involuntary_switches = value_of(thread_status, "nonvoluntary_ctxt_switches");
+
+    auto & usage = threads_[id];
+    usage.name = name;
+    if (at_start) {
+      usage.at_start = counters;
+    }
+    usage.last = counters;
+  }
+}
+
+void ResourceProfiler::add_measurements(result_utils::Measurements & measurements) const
+{
+  const double ticks_per_s = static_cast<double>(sysconf(_SC_CLK_TCK));
+  const double user_s = (process_last_.user_ticks - process_at_start_.user_ticks) / ticks_per_s;
+  const double system_s =
+    (process_last_.system_ticks - process_at_start_.system_ticks) / ticks_per_s;
+  const double duration_s = std::chrono::duration<double>(stop_time_ - start_time_).count();
+
+  double busiest_thread_s = 0.0;
+  uint64_t voluntary_switches = 0;
+  uint64_t involuntary_switches = 0;
+  for (const auto & thread : threads_) {
+    const auto & usage = thread.second;
+    busiest_thread_s = std::max(
+      busiest_thread_s,
+      (usage.last.user_ticks + usage.last.system_ticks -
+      usage.at_start.user_ticks - usage.at_start.system_ticks) / ticks_per_s);
+    voluntary_switches += usage.last.voluntary_switches - usage.at_start.voluntary_switches;
+    involuntary_switches += usage.last.involuntary_switches - usage.at_start.involuntary_switches;
+  }
+
+  measurements.emplace_back("cpu_user_s", user_s);
+  measurements.emplace_back("cpu_system_s", system_s);
+  measurements.emplace_back(
+    "cpu_cores_used", duration_s > 0 ? (user_s + system_s) / duration_s : 0.0);
+  measurements.emplace_back("busiest_thread_cpu_s", busiest_thread_s);
+  measurements.emplace_back("thread_count", static_cast<double>(threads_.size()));
+  measurements.emplace_back("peak_rss_mb", megabytes(peak_rss_kb_ * 1024));
+  measurements.emplace_back(
+    "disk_read_mb", megabytes(process_last_.read_bytes - process_at_start_.read_bytes));
+  measurements.emplace_back(
+    "disk_write_mb", megabytes(process_last_.write_bytes - process_at_start_.write_bytes));
+  measurements.emplace_back(
+    "write_syscalls",
+    static_cast<double>(process_last_.write_syscalls - process_at_start_.write_syscalls));
+  measurements.emplace_back("voluntary_ctxt_switches", static_cast<double>(voluntary_switches));
+  measurements.emplace_back(
+    "involuntary_ctxt_switches", static_cast<double>(involuntary_switches));
+}
+
+void ResourceProfiler::write_thread_usage(const std::string & file) const
+{
+  std::ofstream output_file(file);
+  if (!output_file.is_open()) {
+    throw std::runtime_error(std::string("Could not open file: ") + file);
+  }
+
+  const double ticks_per_s = static_cast<double>(sysconf(_SC_CLK_TCK));
+  output_file <<
+    "tid name cpu_user_s cpu_system_s voluntary_ctxt_switches involuntary_ctxt_switches\n";
+  for (const auto & thread : threads_) {
+    const auto & usage = thread.second;
+    // Names are space delimited like the other columns
+    auto name = usage.name;
+    std::replace(name.begin(), name.end(), ' ', '_');
+    output_file << thread.first << " " << name << " ";
+    output_file << (usage.last.user_ticks - usage.at_start.user_ticks) / ticks_per_s << " ";
+    output_file << (usage.last.system_ticks - usage.at_start.system_ticks) / ticks_per_s << " ";
+    output_file << usage.last.voluntary_switches - usage.at_start.voluntary_switches << " ";
+    output_file << usage.last.involuntary_switches - usage.at_start.involuntary_switches << "\n";
+  }
+}
@@ -14,10 +14,14 @@
 
 #include "rosbag2_performance_benchmarking/result_utils.hpp"
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <fstream>
+#include <iomanip>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "rosbag2_storage/storage_options.hpp"
@@ -31,6 +35,34 @@
 namespace result_utils
 {
 
+Percentiles percentiles(std::vector<double> samples)
+{
+  Percentiles result;
+  if (samples.empty()) {
+    return result;
+  }
+  std::sort(samples.begin(), samples.end());
+  const auto rank = [&samples](double percentile) {
+      auto index = static_cast<size_t>(std::ceil(percentile * samples.size()));
+      return samples[std::max<size_t>(index, 1) - 1];
+    };
+  result.p50 = rank(0.5);
+  result.p90 = rank(0.9);
+  result.p99 = rank(0.99);
+  result.max = samples.back();
+  return result;
+}
+
+void add_percentiles(
+  Measurements & measurements, const std::string & name, std::vector<double> samples)
+{
+  const auto result = percentiles(std::move(samples));
+  measurements.emplace_back(name + "_p50", result.p50);
+  measurements.emplace_back(name + "_p90", result.p90);
+  measurements.emplace_back(name + "_p99", result.p99);
+  measurements.emplace_back(name + "_max", result.max);
+}
+
 /// Read total count of recorded messages from metadata.yaml file
 int get_message_count_from_metadata(const std::string & uri)
 {
@@ -54,6 +86,15 @@ void write_benchmark_results(
   const std::vector<PublisherGroupConfig> & publisher_groups_config,
   const BagConfig & bag_config,
   const std::string & results_file)
+{
+  write_benchmark_results(publisher_groups_config, bag_config, results_file, {});
+}
+
+void write_benchmark_results(
+  const std::vector<PublisherGroupConfig> & publisher_groups_config,
+  const BagConfig & bag_config,
+  const std::string & results_file,
+  const Measurements & measurements)
 {
   bool new_file = false;
   { // test if file exists - we want to write a csv header after creation if not
@@ -74,7 +115,11 @@ void write_benchmark_results(
     output_file << "instances frequency message_size total_messages_sent cache_size ";
     output_file << "max_bagfile_size storage_config ";
     output_file << "compression compression_queue compression_threads ";
-    output_file << "total_produced total_recorded_count\n";
+    output_file << "total_produced total_recorded_count";
+    for (const auto & measurement : measurements) {
+      output_file << " " << measurement.first;
+    }
+    output_file << "\n";
   }
 
   int total_recorded_count = get_message_count_from_metadata(bag_config.storage_options.uri);
@@ -96,7 +141,13 @@ void write_benchmark_results(
     // For now, these need to be summed for each group
     auto total_messages_produced = c.producer_config.max_count * c.count;
     output_file << total_messages_produced << " ";
-    output_file << total_recorded_count << std::endl;
+    output_file << total_recorded_count;
+    // Keep large counts exact instead of switching to scientific notation
+    output_file << std::setprecision(12);
+    for (const auto & measurement : measurements) {
+      output_file << " " << measurement.second;
+    }
+    output_file << std::endl;
   }
 }
 
@@ -12,16 +12,20 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <chrono>
+#include <fstream>
 #include <memory>
 #include <string>
+#include <utility>
 
 #include "rclcpp/executors/single_threaded_executor.hpp"
-#include "rosbag2_compression/sequential_compression_writer.hpp"
 #include "rosbag2_storage/serialized_bag_message.hpp"
 #include "rmw/rmw.h"
 #include "std_msgs/msg/byte_multi_array.hpp"
 
+#include "rosbag2_performance_benchmarking/benchmark_bag.hpp"
+#include "rosbag2_performance_benchmarking/commit_observing_storage.hpp"
 #include "rosbag2_performance_benchmarking/config_utils.hpp"
 #include "rosbag2_performance_benchmarking/result_utils.hpp"
 #include "rosbag2_performance_benchmarking/writer_benchmark.hpp"
@@ -57,93 +61,241 @@ WriterBenchmark::WriterBenchmark(const std::string & name)
 
 void WriterBenchmark::start_benchmark()
 {
+  if (!writer_) {
+    return;
+  }
   RCLCPP_INFO(get_logger(), "Starting the WriterBenchmark");
+  rcutils_system_time_now(&start_time_);
+  start_steady_time_ = std::chrono::steady_clock::now();
+  resource_profiler_.start();
   start_producers();
+
+  const auto timeline_period = 100ms;
+  auto next_sample_time = start_steady_time_ + timeline_period;
   while (rclcpp::ok()) {
-    int count = 0;
-    unsigned int complete_count = 0;
+    bool all_completed = false;
+    {
+      std::unique_lock<std::mutex> lock(producer_events_mutex_);
+      producer_events_condition_.wait_until(
+        lock, next_sample_time, [this] {
+          return messages_queued_ || completed_producers_ == producers_.size();
+        });
+      messages_queued_ = false;
+      all_completed = completed_producers_ == producers_.size();
+    }
+
+    // Completed producers don't queue messages anymore, so this writes the last of them
+    write_queued_messages();
+    if (all_completed) {
+      break;
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    if (now >= next_sample_time) {
+      sample_timeline(true);
+      while (next_sample_time <= now) {
+        next_sample_time += timeline_period;
+      }
+    }
+  }
+
+  for (auto & prod_thread : producer_threads_) {
+    prod_thread.join();
+  }
+  sample_timeline(true);
+  // Writes the messages left in the cache
+  writer_->close();
+  sample_timeline(false);
+  resource_profiler_.stop();
 
-    // TODO(adamdbrw) Performance can be improved. Use conditional variables
+  write_timeline();
+  resource_profiler_.write_thread_usage(
+    bag_config_.storage_options.uri + "/resource_threads.csv");
+  result_utils::write_benchmark_results(
+    configurations_, bag_config_, results_file_, summarize());
+}
+
+void WriterBenchmark::notify_producer_event(bool completed)
+{
+  {
+    std::lock_guard<std::mutex> lock(producer_events_mutex_);
+    if (completed) {
+      ++completed_producers_;
+    } else {
+      messages_queued_ = true;
+    }
+  }
+  producer_events_condition_.notify_one();
+}
+
+void WriterBenchmark::write_queued_messages()
+{
+  // One message per queue and round, so that a busy queue doesn't keep the others waiting
+  bool written = true;
+  while (written) {
+    written = false;
     for (auto & queue : queues_) {
-      if (queue->is_complete() && queue->is_empty()) {
-        ++complete_count;
+      if (queue->is_empty()) {
+        continue;
       }
+      written = true;
+      // behave as if we received the message.
+      auto message = std::make_shared<rosbag2_storage::SerializedBagMessage>();
 
-      if (!queue->is_empty()) {  // behave as if we received the message.
-        auto message = std::make_shared<rosbag2_storage::SerializedBagMessage>();
-
-        // The pointer memory is owned by the producer until past the termination of the while loop.
-        // Note this ownership model should be changed if we want to generate messages on the fly
-        auto byte_ma_message = queue->pop_and_return();
-
-        // The compressor may resize this array, so it needs to be initialized with
-        // rcutils_uint8_array_init to ensure the allocator is set properly.
-        auto msg_array = new rcutils_uint8_array_t;
-        *msg_array = rcutils_get_zero_initialized_uint8_array();
-        int error = rcutils_uint8_array_init(msg_array, byte_ma_message->data.size(), &allocator);
-        if (error != RCUTILS_RET_OK) {
-          throw std::runtime_error(
-                  "Error allocating resources for serialized message: " +
-                  std::string(rcutils_get_error_string().str));
-        }
-        // The compressor may modify this buffer in-place, so it should take ownership of it.
-        std::move(
-          byte_ma_message->data.data(),
-          byte_ma_message->data.data() + byte_ma_message->data.size(),
-          msg_array->buffer);
-
-        auto serialized_data = std::shared_ptr<rcutils_uint8_array_t>(
-          msg_array,
-          [this](rcutils_uint8_array_t * msg) {
-            int error = rcutils_uint8_array_fini(msg);
-            delete msg;
-            if (error != RCUTILS_RET_OK) {
-              RCLCPP_ERROR_STREAM(
-                get_logger(),
-                "Leaking memory. Error: " << rcutils_get_error_string().str);
-            }
-          });
-
-        serialized_data->buffer_length = byte_ma_message->data.size();
-
-        message->serialized_data = serialized_data;
-
-        rcutils_time_point_value_t time_stamp;
-        error = rcutils_system_time_now(&time_stamp);
-        if (error != RCUTILS_RET_OK) {
-          RCLCPP_ERROR_STREAM(
-            get_logger(), "Error getting current time. Error:" <<
-              rcutils_get_error_string().str);
-        }
-        message->time_stamp = time_stamp;
-        message->topic_name = queue->topic_name();
-
-        try {
-          writer_->write(message);
-        } catch (const std::runtime_error & e) {
-          RCLCPP_ERROR_STREAM(get_logger(), "Failed to record: " << e.what());
-        }
-        ++count;
+      // The pointer memory is owned by the producer until past the termination of the while loop.
+      // Note this ownership model should be changed if we want to generate messages on the fly
+      auto stamped_message = queue->pop_and_return();
+      const auto & byte_ma_message = stamped_message->message;
+
+      // The compressor may resize this array, so it needs to be initialized with
+      // rcutils_uint8_array_init to ensure the allocator is set properly.
+      auto msg_array = new rcutils_uint8_array_t;
+      *msg_array = rcutils_get_zero_initialized_uint8_array();
+      int error = rcutils_uint8_array_init(msg_array, byte_ma_message->data.size(), &allocator);
+      if (error != RCUTILS_RET_OK) {
+        throw std::runtime_error(
+                "Error allocating resources for serialized message: " +
+                std::string(rcutils_get_error_string().str));
+      }
+      // The compressor may modify this buffer in-place, so it should take ownership of it.
+      std::move(
+        byte_ma_message->data.data(),
+        byte_ma_message->data.data() + byte_ma_message->data.size(),
+        msg_array->buffer);
+
+      auto serialized_data = std::shared_ptr<rcutils_uint8_array_t>(
+        msg_array,
+        [this](rcutils_uint8_array_t * msg) {
+          int error = rcutils_uint8_array_fini(msg);
+          delete msg;
+          if (error != RCUTILS_RET_OK) {
+            RCLCPP_ERROR_STREAM(
+              get_logger(),
+              "Leaking memory. Error: " << rcutils_get_error_string().str);
+          }
+        });
+
+      serialized_data->buffer_length = byte_ma_message->data.size();
+
+      message->serialized_data = serialized_data;
+      // Stamped at production, so that the commit latency covers waiting in the queue
+      message->time_stamp = stamped_message->produced_time;
+      message->topic_name = queue->topic_name();
+
+      try {
+        writer_->write(message);
+      } catch (const std::runtime_error & e) {
+        RCLCPP_ERROR_STREAM(get_logger(), "Failed to record: " << e.what());
       }
     }
-    if (complete_count == queues_.size()) {
-      break;
+  }
+}
+
+void WriterBenchmark::on_commit(
+  const rosbag2_storage::SerializedBagMessage & message,
+  rcutils_time_point_value_t commit_time)
+{
+  std::lock_guard<std::mutex> lock(commit_mutex_);
+  commit_latencies_ms_.push_back((commit_time - message.time_stamp) / 1e6);
+  ++committed_count_;
+  committed_bytes_ += message.serialized_data->buffer_length;
+  last_commit_time_ = std::max(last_commit_time_, commit_time);
+}
+
+void WriterBenchmark::sample_timeline(bool writer_open)
+{
+  // The writer doesn't report drops anymore once it is closed
+  if (writer_open) {
+    const auto statistics = writer_->get_statistics();
+    uint64_t writer_dropped = statistics.messages_dropped_storage;
+    for (const auto & topic_dropped : statistics.messages_dropped_cache_full) {
+      writer_dropped += topic_dropped.second;
     }
+    for (const auto & topic_dropped : statistics.messages_dropped_compression_queue) {
+      writer_dropped += topic_dropped.second;
+    }
+    writer_dropped_ = writer_dropped;
+  }
 
-    std::this_thread::sleep_for(1ms);
+  TimelineSample sample;
+  sample.time_s = std::chrono::duration<double>(
+    std::chrono::steady_clock::now() - start_steady_time_).count();
+  sample.produced = produced_count_;
+  sample.queue_dropped = 0;
+  for (const auto & queue : queues_) {
+    sample.queue_dropped += queue->get_missed_elements_count();
+  }
+  sample.writer_dropped = writer_dropped_;
+  {
+    std::lock_guard<std::mutex> lock(commit_mutex_);
+    sample.committed = committed_count_;
+    sample.committed_bytes = committed_bytes_;
   }
+  timeline_.push_back(sample);
+}
 
-  for (auto & prod_thread : producer_threads_) {
-    prod_thread.join();
+void WriterBenchmark::write_timeline() const
+{
+  const std::string timeline_file = bag_config_.storage_options.uri + "/writer_timeline.csv";
+  std::ofstream output_file(timeline_file);
+  if (!output_file.is_open()) {
+    throw std::runtime_error(std::string("Could not open file: ") + timeline_file);
   }
-  writer_->close();
 
-  result_utils::write_benchmark_results(configurations_, bag_config_, results_file_);
+  // Counts during each period between samples
+  output_file << "time_s produced queue_dropped writer_dropped committed committed_mb_per_s\n";
+  TimelineSample previous{0.0, 0, 0, 0, 0, 0};
+  for (const auto & sample : timeline_) {
+    const double period_s = sample.time_s - previous.time_s;
+    output_file << sample.time_s << " ";
+    output_file << sample.produced - previous.produced << " ";
+    output_file << sample.queue_dropped - previous.queue_dropped << " ";
+    output_file << sample.writer_dropped - previous.writer_dropped << " ";
+    output_file << sample.committed - previous.committed << " ";
+    output_file << (period_s > 0 ?
+      (sample.committed_bytes - previous.committed_bytes) / 1e6 / period_s : 0.0) << "\n";
+    previous = sample;
+  }
+}
+
+result_utils::Measurements WriterBenchmark::summarize()
+{
+  result_utils::Measurements measurements;
+  std::lock_guard<std::mutex> lock(commit_mutex_);
+  result_utils::add_percentiles(
+    measurements, "commit_latency_ms", std::move(commit_latencies_ms_));
+
+  const double duration_s = (last_commit_time_ - start_time_) / 1e9;
+  measurements.emplace_back(
+    "throughput_mb_per_s", duration_s > 0 ? committed_bytes_ / 1e6 / duration_s : 0.0);
+
+  // Drops are counted when sampling the timeline, so their timing has the resolution of it
+  double first_drop_s = -1.0;
+  double last_drop_s = -1.0;
+  uint64_t previous_dropped = 0;
+  for (const auto & sample : timeline_) {
+    const auto dropped = sample.queue_dropped + sample.writer_dropped;
+    if (dropped > previous_dropped) {
+      if (first_drop_s < 0) {
+        first_drop_s = sample.time_s;
+      }
+      last_drop_s = sample.time_s;
+    }
+    previous_dropped = dropped;
+  }
+  measurements.emplace_back("queue_dropped", static_cast<double>(timeline_.back().queue_dropped));
+  measurements.emplace_back(
+    "writer_dropped", static_cast<double>(timeline_.back().writer_dropped));
+  measurements.emplace_back("first_drop_s", first_drop_s);
+  measurements.emplace_back("last_drop_s", last_drop_s);
+  resource_profiler_.add_measurements(measurements);
+  return measurements;
 }
 
 void WriterBenchmark::create_producers()
 {
   RCLCPP_INFO_STREAM(get_logger(), "creating producers");
+  size_t message_count = 0;
   for (const auto & c : configurations_) {
     RCLCPP_INFO_STREAM(
       get_logger(), "\nWriterBenchmark: creating " << c.count <<
@@ -161,33 +313,37 @@ void WriterBenchmark::create_producers()
         std::make_unique<ByteProducer>(
           c.producer_config,
           [] { /* empty lambda */},
-          [queue](std::shared_ptr<std_msgs::msg::ByteMultiArray> msg) {
-            queue->push(msg);
+          [this, queue](std::shared_ptr<std_msgs::msg::ByteMultiArray> msg) {
+            auto stamped_message = std::make_shared<StampedByteMessage>();
+            stamped_message->message = msg;
+            rcutils_system_time_now(&stamped_message->produced_time);
+            ++produced_count_;
+            if (queue->push(stamped_message)) {
+              notify_producer_event(false);
+            }
           },
-          [queue] {
+          [this, queue] {
             queue->set_complete();
+            notify_producer_event(true);
           }));
     }
+    message_count += static_cast<size_t>(c.count) * c.producer_config.max_count;
   }
+  commit_latencies_ms_.reserve(message_count);
 }
 
 void WriterBenchmark::create_writer()
 {
-  if (!bag_config_.compression_format.empty()) {
-    rosbag2_compression::CompressionOptions compression_options{
-      bag_config_.compression_format, rosbag2_compression::CompressionMode::MESSAGE,
-      bag_config_.compression_queue_size, bag_config_.compression_threads};
+  writer_ = benchmark_bag::open_writer(
+    bag_config_,
+    std::make_unique<CommitObservingStorageFactory>(
+      [this](
+        const rosbag2_storage::SerializedBagMessage & message,
+        rcutils_time_point_value_t commit_time) {
+        on_commit(message, commit_time);
+      }));
 
-    writer_ = std::make_unique<rosbag2_compression::SequentialCompressionWriter>(
-      compression_options);
-  } else {
-    writer_ = std::make_shared<rosbag2_cpp::writers::SequentialWriter>();
-  }
-
-  // TODO(adamdbrw) generalize if converters are to be included in benchmarks
   std::string serialization_format = rmw_get_serialization_format();
-  writer_->open(bag_config_.storage_options, {serialization_format, serialization_format});
-
   for (const auto & queue : queues_) {
     rosbag2_storage::TopicMetadata topic;
     topic.name = queue->topic_name();
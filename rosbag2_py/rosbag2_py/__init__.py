@@ -19,6 +19,7 @@ from rpyutils import add_dll_directories_from_env
 # See https://docs.python.org/3/whatsnew/3.8.html#bpo-36085-whatsnew
 with add_dll_directories_from_env('PATH'):
     from rosbag2_py._reader import (
+        ProjectedFields,
         SequentialCompressionReader,
         SequentialReader,
         get_registered_readers,
@@ -29,6 +30,8 @@ with add_dll_directories_from_env('PATH'):
         StorageOptions,
         TopicMetadata,
         TopicInformation,
+        TopicRateOverview,
+        RateOverview,
         BagMetadata,
     )
     from rosbag2_py._writer import (
@@ -39,7 +42,11 @@ with add_dll_directories_from_env('PATH'):
         get_registered_serializers,
     )
     from rosbag2_py._info import (
+        BagStatistics,
+        BagStatisticsOptions,
         Info,
+        TopicGap,
+        TopicStatistics,
     )
     from rosbag2_py._transport import (
         bag_rewrite,
@@ -47,18 +54,29 @@ with add_dll_directories_from_env('PATH'):
         PlayOptions,
         Recorder,
         RecordOptions,
+        ThreadOptions,
+        TopicThrottleOptions,
     )
     from rosbag2_py._reindexer import (
         Reindexer
     )
+    from rosbag2_py._catalog import (
+        BagCatalog,
+        BagCatalogEntry,
+        BagCatalogQuery,
+    )
 
 __all__ = [
     'bag_rewrite',
+    'BagCatalog',
+    'BagCatalogEntry',
+    'BagCatalogQuery',
     'ConverterOptions',
     'get_registered_readers',
     'get_registered_writers',
     'get_registered_compressors',
     'get_registered_serializers',
+    'ProjectedFields',
     'Reindexer',
     'SequentialCompressionReader',
     'SequentialCompressionWriter',
@@ -68,10 +86,18 @@ __all__ = [
     'StorageOptions',
     'TopicMetadata',
     'TopicInformation',
+    'TopicRateOverview',
+    'RateOverview',
     'BagMetadata',
+    'BagStatistics',
+    'BagStatisticsOptions',
     'Info',
+    'TopicGap',
+    'TopicStatistics',
     'Player',
     'PlayOptions',
     'Recorder',
     'RecordOptions',
+    'ThreadOptions',
+    'TopicThrottleOptions',
 ]
@@ -0,0 +1,59 @@
+// Copyright 2022 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "rosbag2_cpp/bag_catalog.hpp"
+#include "rosbag2_storage/bag_metadata.hpp"
+
+#include "./pybind11.hpp"
+
+PYBIND11_MODULE(_catalog, m) {
+  m.doc() = "Python wrapper of the rosbag2_cpp bag catalog API";
+
+  pybind11::class_<rosbag2_cpp::BagCatalogQuery>(m, "BagCatalogQuery")
+  .def(
+    pybind11::init<std::vector<std::string>, rcutils_time_point_value_t,
+    rcutils_time_point_value_t>(),
+    pybind11::arg("topics") = std::vector<std::string>(),
+    pybind11::arg("start_time") = INT64_MIN,
+    pybind11::arg("end_time") = INT64_MAX)
+  .def_readwrite("topics", &rosbag2_cpp::BagCatalogQuery::topics)
+  .def_readwrite("start_time", &rosbag2_cpp::BagCatalogQuery::start_time)
+  .def_readwrite("end_time", &rosbag2_cpp::BagCatalogQuery::end_time);
+
+  pybind11::class_<rosbag2_cpp::BagCatalogEntry>(m, "BagCatalogEntry")
+  .def_readonly("uri", &rosbag2_cpp::BagCatalogEntry::uri)
+  .def_readonly("storage_identifier", &rosbag2_cpp::BagCatalogEntry::storage_identifier)
+  .def_readonly("topics", &rosbag2_cpp::BagCatalogEntry::topics)
+  .def_readonly("files", &rosbag2_cpp::BagCatalogEntry::files)
+  .def_readonly("file_sizes", &rosbag2_cpp::BagCatalogEntry::file_sizes)
+  .def_readonly("size", &rosbag2_cpp::BagCatalogEntry::size)
+  .def_readonly("start_time", &rosbag2_cpp::BagCatalogEntry::start_time)
+  .def_readonly("end_time", &rosbag2_cpp::BagCatalogEntry::end_time);
+
+  pybind11::class_<rosbag2_cpp::BagCatalog>(m, "BagCatalog")
+  .def(pybind11::init<const std::string &>(), pybind11::arg("catalog_path"))
+  .def(
+    "index", &rosbag2_cpp::BagCatalog::index, pybind11::arg("directory"),
+    pybind11::call_guard<pybind11::gil_scoped_release>())
+  .def("index_bag", &rosbag2_cpp::BagCatalog::index_bag, pybind11::arg("uri"))
+  .def("remove_bag", &rosbag2_cpp::BagCatalog::remove_bag, pybind11::arg("uri"))
+  .def(
+    "query", &rosbag2_cpp::BagCatalog::query,
+    pybind11::arg("query") = rosbag2_cpp::BagCatalogQuery())
+  .def("size", &rosbag2_cpp::BagCatalog::size);
+}
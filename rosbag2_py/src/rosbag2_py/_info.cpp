@@ -15,9 +15,11 @@
 #include <memory>
 #include <string>
 
+#include "rosbag2_cpp/bag_statistics.hpp"
 #include "rosbag2_cpp/info.hpp"
 #include "rosbag2_storage/bag_metadata.hpp"
 
+#include "./format_bag_metadata.hpp"
 #include "./pybind11.hpp"
 
 namespace rosbag2_py
@@ -38,6 +40,14 @@ public:
     return info_->read_metadata(uri, storage_id);
   }
 
+  rosbag2_cpp::BagStatistics read_statistics(
+    const std::string & uri, const std::string & storage_id,
+    const rosbag2_cpp::BagStatisticsOptions & options)
+  {
+    pybind11::gil_scoped_release release;
+    return info_->read_statistics(uri, storage_id, options);
+  }
+
 protected:
   std::unique_ptr<rosbag2_cpp::Info> info_;
 };
@@ -47,7 +57,51 @@ protected:
 PYBIND11_MODULE(_info, m) {
   m.doc() = "Python wrapper of the rosbag2_cpp info API";
 
+  pybind11::class_<rosbag2_cpp::BagStatisticsOptions>(m, "BagStatisticsOptions")
+  .def(
+    pybind11::init<double, size_t, size_t>(),
+    pybind11::arg("gap_factor") = 5.0,
+    pybind11::arg("max_gaps_per_topic") = 10,
+    pybind11::arg("num_threads") = 0)
+  .def_readwrite("gap_factor", &rosbag2_cpp::BagStatisticsOptions::gap_factor)
+  .def_readwrite("max_gaps_per_topic", &rosbag2_cpp::BagStatisticsOptions::max_gaps_per_topic)
+  .def_readwrite("num_threads", &rosbag2_cpp::BagStatisticsOptions::num_threads);
+
+  pybind11::class_<rosbag2_cpp::TopicGap>(m, "TopicGap")
+  .def_readonly("start", &rosbag2_cpp::TopicGap::start)
+  .def_readonly("end", &rosbag2_cpp::TopicGap::end);
+
+  pybind11::class_<rosbag2_cpp::TopicStatistics>(m, "TopicStatistics")
+  .def_readonly("topic_name", &rosbag2_cpp::TopicStatistics::topic_name)
+  .def_readonly("message_count", &rosbag2_cpp::TopicStatistics::message_count)
+  .def_readonly("total_bytes", &rosbag2_cpp::TopicStatistics::total_bytes)
+  .def_readonly("min_message_size", &rosbag2_cpp::TopicStatistics::min_message_size)
+  .def_readonly("max_message_size", &rosbag2_cpp::TopicStatistics::max_message_size)
+  .def_readonly(
+    "message_size_histogram", &rosbag2_cpp::TopicStatistics::message_size_histogram)
+  .def_readonly("first_timestamp", &rosbag2_cpp::TopicStatistics::first_timestamp)
+  .def_readonly("last_timestamp", &rosbag2_cpp::TopicStatistics::last_timestamp)
+  .def_readonly("period_histogram", &rosbag2_cpp::TopicStatistics::period_histogram)
+  .def_readonly("min_period", &rosbag2_cpp::TopicStatistics::min_period)
+  .def_readonly("max_period", &rosbag2_cpp::TopicStatistics::max_period)
+  .def_readonly("gap_count", &rosbag2_cpp::TopicStatistics::gap_count)
+  .def_readonly("gaps", &rosbag2_cpp::TopicStatistics::gaps);
+
+  pybind11::class_<rosbag2_cpp::BagStatistics>(m, "BagStatistics")
+  .def_readonly("topics", &rosbag2_cpp::BagStatistics::topics)
+  .def_readonly("message_count", &rosbag2_cpp::BagStatistics::message_count)
+  .def_readonly("total_bytes", &rosbag2_cpp::BagStatistics::total_bytes)
+  .def(
+    "__repr__", [](const rosbag2_cpp::BagStatistics & statistics) {
+      return format_bag_statistics(statistics);
+    });
+
   pybind11::class_<rosbag2_py::Info>(m, "Info")
   .def(pybind11::init())
-  .def("read_metadata", &rosbag2_py::Info::read_metadata);
+  .def("read_metadata", &rosbag2_py::Info::read_metadata)
+  .def(
+    "read_statistics", &rosbag2_py::Info::read_statistics,
+    pybind11::arg("uri"),
+    pybind11::arg("storage_id"),
+    pybind11::arg("options") = rosbag2_cpp::BagStatisticsOptions());
 }
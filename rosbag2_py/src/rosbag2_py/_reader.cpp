@@ -20,6 +20,7 @@
 
 #include "rosbag2_compression/sequential_compression_reader.hpp"
 #include "rosbag2_cpp/converter_options.hpp"
+#include "rosbag2_cpp/field_projection.hpp"
 #include "rosbag2_cpp/plugins/plugin_utils.hpp"
 #include "rosbag2_cpp/readers/sequential_reader.hpp"
 #include "rosbag2_cpp/reader.hpp"
@@ -88,6 +89,12 @@ public:
     reader_->seek(timestamp);
   }
 
+  rosbag2_cpp::ProjectedFields project_fields(
+    const std::string & topic_name, const std::vector<std::string> & field_paths)
+  {
+    return rosbag2_cpp::project_fields(*reader_, topic_name, field_paths);
+  }
+
 protected:
   std::unique_ptr<rosbag2_cpp::Reader> reader_;
 };
@@ -122,7 +129,13 @@ PYBIND11_MODULE(_reader, m) {
     &rosbag2_py::Reader<rosbag2_cpp::readers::SequentialReader>::get_all_topics_and_types)
   .def("set_filter", &rosbag2_py::Reader<rosbag2_cpp::readers::SequentialReader>::set_filter)
   .def("reset_filter", &rosbag2_py::Reader<rosbag2_cpp::readers::SequentialReader>::reset_filter)
-  .def("seek", &rosbag2_py::Reader<rosbag2_cpp::readers::SequentialReader>::seek);
+  .def("seek", &rosbag2_py::Reader<rosbag2_cpp::readers::SequentialReader>::seek)
+  .def(
+    "project_fields",
+    &rosbag2_py::Reader<rosbag2_cpp::readers::SequentialReader>::project_fields,
+    pybind11::arg("topic_name"),
+    pybind11::arg("field_paths"),
+    pybind11::call_guard<pybind11::gil_scoped_release>());
 
   pybind11::class_<rosbag2_py::Reader<rosbag2_compression::SequentialCompressionReader>>(
     m, "SequentialCompressionReader")
@@ -144,7 +157,18 @@ PYBIND11_MODULE(_reader, m) {
     &rosbag2_py::Reader<rosbag2_compression::SequentialCompressionReader>::reset_filter)
   .def(
     "seek",
-    &rosbag2_py::Reader<rosbag2_compression::SequentialCompressionReader>::seek);
+    &rosbag2_py::Reader<rosbag2_compression::SequentialCompressionReader>::seek)
+  .def(
+    "project_fields",
+    &rosbag2_py::Reader<rosbag2_compression::SequentialCompressionReader>::project_fields,
+    pybind11::arg("topic_name"),
+    pybind11::arg("field_paths"),
+    pybind11::call_guard<pybind11::gil_scoped_release>());
+
+  pybind11::class_<rosbag2_cpp::ProjectedFields>(m, "ProjectedFields")
+  .def_readonly("names", &rosbag2_cpp::ProjectedFields::names)
+  .def_readonly("time_stamps", &rosbag2_cpp::ProjectedFields::time_stamps)
+  .def_readonly("columns", &rosbag2_cpp::ProjectedFields::columns);
 
   m.def(
     "get_registered_readers",
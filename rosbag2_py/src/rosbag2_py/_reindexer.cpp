@@ -24,6 +24,7 @@
 #include <string>
 #include <vector>
 
+#include "rosbag2_compression/compression_reindexer.hpp"
 #include "rosbag2_cpp/reindexer.hpp"
 #include "rosbag2_storage/storage_options.hpp"
 
@@ -36,7 +37,7 @@ class Reindexer
 {
 public:
   Reindexer()
-  : reindexer_(std::make_unique<rosbag2_cpp::Reindexer>())
+  : reindexer_(std::make_unique<rosbag2_compression::CompressionReindexer>())
   {
   }
 
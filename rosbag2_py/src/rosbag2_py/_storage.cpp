@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -43,7 +44,8 @@ PYBIND11_MODULE(_storage, m) {
   pybind11::class_<rosbag2_storage::StorageOptions>(m, "StorageOptions")
   .def(
     pybind11::init<
-      std::string, std::string, uint64_t, uint64_t, uint64_t, std::string, std::string, bool>(),
+      std::string, std::string, uint64_t, uint64_t, uint64_t, std::string, std::string, bool,
+      bool, uint64_t>(),
     pybind11::arg("uri"),
     pybind11::arg("storage_id") = "",
     pybind11::arg("max_bagfile_size") = 0,
@@ -51,7 +53,9 @@ PYBIND11_MODULE(_storage, m) {
     pybind11::arg("max_cache_size") = 0,
     pybind11::arg("storage_preset_profile") = "",
     pybind11::arg("storage_config_uri") = "",
-    pybind11::arg("snapshot_mode") = false)
+    pybind11::arg("snapshot_mode") = false,
+    pybind11::arg("index_header_stamps") = false,
+    pybind11::arg("rate_overview_bucket_duration") = 0)
   .def_readwrite("uri", &rosbag2_storage::StorageOptions::uri)
   .def_readwrite("storage_id", &rosbag2_storage::StorageOptions::storage_id)
   .def_readwrite(
@@ -71,13 +75,29 @@ PYBIND11_MODULE(_storage, m) {
     &rosbag2_storage::StorageOptions::storage_config_uri)
   .def_readwrite(
     "snapshot_mode",
-    &rosbag2_storage::StorageOptions::snapshot_mode);
+    &rosbag2_storage::StorageOptions::snapshot_mode)
+  .def_readwrite(
+    "index_header_stamps",
+    &rosbag2_storage::StorageOptions::index_header_stamps)
+  .def_readwrite(
+    "rate_overview_bucket_duration",
+    &rosbag2_storage::StorageOptions::rate_overview_bucket_duration);
 
   pybind11::class_<rosbag2_storage::StorageFilter>(m, "StorageFilter")
   .def(
-    pybind11::init<std::vector<std::string>>(),
-    pybind11::arg("topics"))
-  .def_readwrite("topics", &rosbag2_storage::StorageFilter::topics);
+    pybind11::init<
+      std::vector<std::string>, bool, rcutils_time_point_value_t, rcutils_time_point_value_t,
+      bool>(),
+    pybind11::arg("topics") = std::vector<std::string>{},
+    pybind11::arg("filter_header_stamp") = false,
+    pybind11::arg("header_stamp_start") = INT64_MIN,
+    pybind11::arg("header_stamp_end") = INT64_MAX,
+    pybind11::arg("skip_serialized_data") = false)
+  .def_readwrite("topics", &rosbag2_storage::StorageFilter::topics)
+  .def_readwrite("filter_header_stamp", &rosbag2_storage::StorageFilter::filter_header_stamp)
+  .def_readwrite("header_stamp_start", &rosbag2_storage::StorageFilter::header_stamp_start)
+  .def_readwrite("header_stamp_end", &rosbag2_storage::StorageFilter::header_stamp_end)
+  .def_readwrite("skip_serialized_data", &rosbag2_storage::StorageFilter::skip_serialized_data);
 
   pybind11::class_<rosbag2_storage::TopicMetadata>(m, "TopicMetadata")
   .def(
@@ -117,7 +137,21 @@ PYBIND11_MODULE(_storage, m) {
   .def_readwrite("path", &rosbag2_storage::FileInformation::path)
   .def_readwrite("starting_time", &rosbag2_storage::FileInformation::starting_time)
   .def_readwrite("duration", &rosbag2_storage::FileInformation::duration)
-  .def_readwrite("message_count", &rosbag2_storage::FileInformation::message_count);
+  .def_readwrite("message_count", &rosbag2_storage::FileInformation::message_count)
+  .def_readwrite(
+    "topic_message_counts", &rosbag2_storage::FileInformation::topic_message_counts);
+
+  pybind11::class_<rosbag2_storage::TopicRateOverview>(m, "TopicRateOverview")
+  .def(pybind11::init<>())
+  .def_readwrite("topic_name", &rosbag2_storage::TopicRateOverview::topic_name)
+  .def_readwrite("message_counts", &rosbag2_storage::TopicRateOverview::message_counts)
+  .def_readwrite("message_bytes", &rosbag2_storage::TopicRateOverview::message_bytes);
+
+  pybind11::class_<rosbag2_storage::RateOverview>(m, "RateOverview")
+  .def(pybind11::init<>())
+  .def_readwrite("starting_time", &rosbag2_storage::RateOverview::starting_time)
+  .def_readwrite("bucket_duration", &rosbag2_storage::RateOverview::bucket_duration)
+  .def_readwrite("topics", &rosbag2_storage::RateOverview::topics);
 
   pybind11::class_<rosbag2_storage::BagMetadata>(m, "BagMetadata")
   .def(
@@ -157,6 +191,7 @@ PYBIND11_MODULE(_storage, m) {
     &rosbag2_storage::BagMetadata::topics_with_message_count)
   .def_readwrite("compression_format", &rosbag2_storage::BagMetadata::compression_format)
   .def_readwrite("compression_mode", &rosbag2_storage::BagMetadata::compression_mode)
+  .def_readwrite("rate_overview", &rosbag2_storage::BagMetadata::rate_overview)
   .def(
     "__repr__", [](const rosbag2_storage::BagMetadata & metadata) {
       return format_bag_meta_data(metadata);
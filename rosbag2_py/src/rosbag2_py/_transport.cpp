@@ -14,12 +14,16 @@
 
 #include <csignal>
 #include <chrono>
+#include <exception>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "rosbag2_cpp/thread_options.hpp"
 #include "rosbag2_storage/storage_options.hpp"
 #include "rosbag2_storage/yaml.hpp"
 #include "rosbag2_transport/bag_rewrite.hpp"
@@ -154,10 +158,26 @@ public:
       [&exec]() {
         exec.spin();
       });
-    player->play();
+    // Play from a thread of our own, so that thread options don't apply to the Python thread.
+    // Errors of playback are raised in the calling thread.
+    std::exception_ptr play_error;
+    auto play_thread = std::thread(
+      [&player, &play_options, &play_error]() {
+        try {
+          rosbag2_cpp::configure_current_thread(
+            rosbag2_cpp::thread_class::kPlayback, play_options.thread_options);
+          player->play();
+        } catch (...) {
+          play_error = std::current_exception();
+        }
+      });
+    play_thread.join();
 
     exec.cancel();
     spin_thread.join();
+    if (play_error) {
+      std::rethrow_exception(play_error);
+    }
   }
 
   void burst(
@@ -190,13 +210,14 @@ public:
 class Recorder
 {
 private:
-  std::unique_ptr<rclcpp::executors::SingleThreadedExecutor> exec_;
+  std::mutex exec_mutex_;
+  std::shared_ptr<rclcpp::Executor> exec_;
 
 public:
   Recorder()
   {
     rclcpp::init(0, nullptr);
-    exec_ = std::make_unique<rclcpp::executors::SingleThreadedExecutor>();
+    exec_ = std::make_shared<rclcpp::executors::SingleThreadedExecutor>();
     std::signal(
       SIGTERM, [](int /* signal */) {
         rclcpp::shutdown();
@@ -221,16 +242,26 @@ public:
       std::move(writer), storage_options, record_options);
     recorder->record();
 
-    exec_->add_node(recorder);
+    std::shared_ptr<rclcpp::Executor> exec;
+    {
+      std::lock_guard<std::mutex> lock(exec_mutex_);
+      if (record_options.num_executor_threads != 1) {
+        exec_ = std::make_shared<rclcpp::executors::MultiThreadedExecutor>(
+          rclcpp::ExecutorOptions(), record_options.num_executor_threads);
+      }
+      exec = exec_;
+    }
+    exec->add_node(recorder);
     // Release the GIL for long-running record, so that calling Python code can use other threads
     {
       py::gil_scoped_release release;
-      exec_->spin();
+      exec->spin();
     }
   }
 
   void cancel()
   {
+    std::lock_guard<std::mutex> lock(exec_mutex_);
     exec_->cancel();
   }
 };
@@ -272,6 +303,13 @@ PYBIND11_MODULE(_transport, m) {
   // the names of the members multiple times, as well as the default values from the struct
   // definitions.
 
+  py::class_<rosbag2_cpp::ThreadOptions>(m, "ThreadOptions")
+  .def(py::init<>())
+  .def_readwrite("cpu_affinity", &rosbag2_cpp::ThreadOptions::cpu_affinity)
+  .def_readwrite("nice", &rosbag2_cpp::ThreadOptions::nice)
+  .def_readwrite("fifo_priority", &rosbag2_cpp::ThreadOptions::fifo_priority)
+  ;
+
   py::class_<PlayOptions>(m, "PlayOptions")
   .def(py::init<>())
   .def_readwrite("read_ahead_queue_size", &PlayOptions::read_ahead_queue_size)
@@ -305,6 +343,16 @@ PYBIND11_MODULE(_transport, m) {
     &PlayOptions::setPlaybackUntilTimestamp)
   .def_readwrite("wait_acked_timeout", &PlayOptions::wait_acked_timeout)
   .def_readwrite("disable_loan_message", &PlayOptions::disable_loan_message)
+  .def_readwrite("flow_control_window", &PlayOptions::flow_control_window)
+  .def_readwrite("flow_control_consumers", &PlayOptions::flow_control_consumers)
+  .def_readwrite("thread_options", &PlayOptions::thread_options)
+  ;
+
+  py::class_<rosbag2_transport::TopicThrottleOptions>(m, "TopicThrottleOptions")
+  .def(py::init<>())
+  .def_readwrite("max_rate", &rosbag2_transport::TopicThrottleOptions::max_rate)
+  .def_readwrite("keep_every_nth", &rosbag2_transport::TopicThrottleOptions::keep_every_nth)
+  .def_readwrite("min_interval", &rosbag2_transport::TopicThrottleOptions::min_interval)
   ;
 
   py::class_<RecordOptions>(m, "RecordOptions")
@@ -330,6 +378,16 @@ PYBIND11_MODULE(_transport, m) {
   .def_readwrite("start_paused", &RecordOptions::start_paused)
   .def_readwrite("ignore_leaf_topics", &RecordOptions::ignore_leaf_topics)
   .def_readwrite("use_sim_time", &RecordOptions::use_sim_time)
+  .def_readwrite("callback_group_policy", &RecordOptions::callback_group_policy)
+  .def_readwrite("topic_callback_groups", &RecordOptions::topic_callback_groups)
+  .def_readwrite("num_executor_threads", &RecordOptions::num_executor_threads)
+  .def_readwrite("topic_throttles", &RecordOptions::topic_throttles)
+  .def_readwrite("topic_content_filters", &RecordOptions::topic_content_filters)
+  .def_readwrite("statistics_publish_period", &RecordOptions::statistics_publish_period)
+  .def_readwrite("subscription_history_budget", &RecordOptions::subscription_history_budget)
+  .def_readwrite(
+    "max_subscription_history_depth", &RecordOptions::max_subscription_history_depth)
+  .def_readwrite("thread_options", &RecordOptions::thread_options)
   ;
 
   py::class_<rosbag2_py::Player>(m, "Player")
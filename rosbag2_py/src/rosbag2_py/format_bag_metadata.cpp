@@ -26,6 +26,8 @@
 #include <time.h>
 #endif
 
+#include "rosbag2_cpp/bag_statistics.hpp"
+
 #include "rosbag2_storage/bag_metadata.hpp"
 
 namespace
@@ -132,6 +134,81 @@ void format_topics_with_type(
   }
 }
 
+std::string format_period(rcutils_duration_value_t period)
+{
+  std::stringstream formatted_period;
+  formatted_period << std::setprecision(3) << std::fixed;
+  if (period < 1000000) {
+    formatted_period << static_cast<double>(period) / 1e3 << "us";
+  } else if (period < 1000000000) {
+    formatted_period << static_cast<double>(period) / 1e6 << "ms";
+  } else {
+    formatted_period << static_cast<double>(period) / 1e9 << "s";
+  }
+  return formatted_period.str();
+}
+
+// Non empty buckets of a log2 histogram, each as "[lower bound, upper bound): count"
+template<typename FormatBoundT>
+void format_histogram(
+  const std::vector<uint64_t> & histogram,
+  FormatBoundT format_bound,
+  std::stringstream & info_stream)
+{
+  const char * separator = "";
+  for (size_t i = 0; i < histogram.size(); ++i) {
+    if (histogram[i] == 0) {
+      continue;
+    }
+    info_stream << separator << "[" << format_bound(uint64_t{1} << i) << ", " <<
+      format_bound(uint64_t{1} << (i + 1)) << "): " << histogram[i];
+    separator = ", ";
+  }
+  info_stream << std::endl;
+}
+
+void format_topic_statistics(
+  const rosbag2_cpp::TopicStatistics & topic,
+  std::stringstream & info_stream,
+  int indentation_spaces)
+{
+  const int detail_indentation_spaces = indentation_spaces + 2;
+  info_stream << "Topic: " << topic.topic_name << " | ";
+  info_stream << "Count: " << topic.message_count << " | ";
+  info_stream << "Size: " << format_file_size(topic.total_bytes) << " | ";
+  info_stream << "Gaps: " << topic.gap_count << std::endl;
+
+  indent(info_stream, detail_indentation_spaces);
+  info_stream << "Message size: min " << format_file_size(topic.min_message_size) <<
+    ", max " << format_file_size(topic.max_message_size) << " | ";
+  format_histogram(topic.message_size_histogram, format_file_size, info_stream);
+
+  if (!topic.period_histogram.empty()) {
+    indent(info_stream, detail_indentation_spaces);
+    info_stream << "Period: min " << format_period(topic.min_period) <<
+      ", max " << format_period(topic.max_period) << " | ";
+    // Period buckets are in microseconds
+    format_histogram(
+      topic.period_histogram,
+      [](uint64_t bound) {
+        return format_period(static_cast<rcutils_duration_value_t>(bound) * 1000);
+      },
+      info_stream);
+  }
+
+  for (const auto & gap : topic.gaps) {
+    indent(info_stream, detail_indentation_spaces);
+    info_stream << "Gap: " << std::setprecision(3) << std::fixed <<
+      static_cast<double>(gap.start) / 1e9 << " - " << static_cast<double>(gap.end) / 1e9 <<
+      " (" << format_period(gap.end - gap.start) << ")" << std::endl;
+  }
+  if (topic.gap_count > topic.gaps.size()) {
+    indent(info_stream, detail_indentation_spaces);
+    info_stream << "... and " << topic.gap_count - topic.gaps.size() << " more gaps" <<
+      std::endl;
+  }
+}
+
 }  // namespace
 
 std::string format_bag_meta_data(const rosbag2_storage::BagMetadata & metadata)
@@ -159,3 +236,25 @@ std::string format_bag_meta_data(const rosbag2_storage::BagMetadata & metadata)
 
   return info_stream.str();
 }
+
+std::string format_bag_statistics(const rosbag2_cpp::BagStatistics & statistics)
+{
+  std::stringstream info_stream;
+  int indentation_spaces = 19;  // The longest info field (Topic statistics:) plus one space.
+
+  info_stream << std::endl;
+  info_stream << "Messages:          " << statistics.message_count << std::endl;
+  info_stream << "Message size:      " << format_file_size(statistics.total_bytes) << std::endl;
+  info_stream << "Topic statistics:  ";
+  if (statistics.topics.empty()) {
+    info_stream << std::endl;
+  }
+  for (size_t i = 0; i < statistics.topics.size(); ++i) {
+    if (i > 0) {
+      indent(info_stream, indentation_spaces);
+    }
+    format_topic_statistics(statistics.topics[i], info_stream, indentation_spaces);
+  }
+
+  return info_stream.str();
+}
@@ -17,8 +17,12 @@
 
 #include <string>
 
+#include "rosbag2_cpp/bag_statistics.hpp"
+
 #include "rosbag2_storage/bag_metadata.hpp"
 
 std::string format_bag_meta_data(const rosbag2_storage::BagMetadata & metadata);
 
+std::string format_bag_statistics(const rosbag2_cpp::BagStatistics & statistics);
+
 #endif  // ROSBAG2_PY__FORMAT_BAG_METADATA_HPP_
@@ -0,0 +1,58 @@
+# Copyright 2022 Open Source Robotics Foundation, Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import os
+from pathlib import Path
+import sys
+
+if os.environ.get('ROSBAG2_PY_TEST_WITH_RTLD_GLOBAL', None) is not None:
+    # This is needed on Linux when compiling with clang/libc++.
+    # TL;DR This makes class_loader work when using a python extension compiled with libc++.
+    #
+    # For the fun RTTI ABI details, see https://whatofhow.wordpress.com/2015/03/17/odr-rtti-dso/.
+    sys.setdlopenflags(os.RTLD_GLOBAL | os.RTLD_LAZY)
+
+import rosbag2_py  # noqa
+
+RESOURCES_PATH = Path(os.environ['ROSBAG2_PY_TEST_RESOURCES_DIR'])
+# Receive time of the first message of the talker bag, and the time after its last one
+TALKER_START = 1585866235112411371
+TALKER_END = TALKER_START + 4531096768
+
+
+def test_catalog_index_and_query(tmp_path):
+    bag_path = RESOURCES_PATH / 'talker'
+    catalog = rosbag2_py.BagCatalog(str(tmp_path / 'catalog.db3'))
+    assert catalog.index(str(bag_path)) == 1
+    assert catalog.size() == 1
+    # Unchanged bags are not indexed again
+    assert catalog.index(str(bag_path)) == 0
+
+    entries = catalog.query(rosbag2_py.BagCatalogQuery(topics=['/topic']))
+    assert len(entries) == 1
+    entry = entries[0]
+    assert Path(entry.uri).name == 'talker'
+    assert entry.storage_identifier == 'sqlite3'
+    assert [topic.topic_metadata.name for topic in entry.topics] == ['/topic']
+    assert entry.topics[0].message_count == 10
+    assert entry.start_time == TALKER_START
+    assert [file.path for file in entry.files] == ['talker.db3']
+    assert entry.file_sizes == [(bag_path / 'talker.db3').stat().st_size]
+    assert entry.size == sum(path.stat().st_size for path in bag_path.iterdir())
+
+    assert not catalog.query(rosbag2_py.BagCatalogQuery(topics=['/not_recorded']))
+    assert not catalog.query(rosbag2_py.BagCatalogQuery(start_time=TALKER_END + 1))
+
+    catalog.remove_bag(entry.uri)
+    assert catalog.size() == 0
@@ -144,6 +144,32 @@ def test_sequential_reader_seek():
     assert msg.data == f'Hello, world! {msg_counter}'
 
 
+def test_sequential_reader_project_fields():
+    bag_path = str(RESOURCES_PATH / 'talker')
+    storage_options, converter_options = get_rosbag_options(bag_path)
+
+    reader = rosbag2_py.SequentialReader()
+    reader.open(storage_options, converter_options)
+    fields = reader.project_fields('/rosout', ['stamp', 'level', 'line'])
+    assert fields.names == ['stamp.sec', 'stamp.nanosec', 'level', 'line']
+
+    reader = rosbag2_py.SequentialReader()
+    reader.open(storage_options, converter_options)
+    reader.set_filter(rosbag2_py.StorageFilter(topics=['/rosout']))
+    time_stamps = []
+    while reader.has_next():
+        (topic, data, t) = reader.read_next()
+        msg = deserialize_message(data, Log)
+        index = len(time_stamps)
+        assert fields.columns[0][index] == msg.stamp.sec
+        assert fields.columns[1][index] == msg.stamp.nanosec
+        assert fields.columns[2][index] == msg.level
+        assert fields.columns[3][index] == msg.line
+        time_stamps.append(t)
+    assert fields.time_stamps == time_stamps
+    assert len(time_stamps) > 0
+
+
 def test_plugin_list():
     reader_plugins = rosbag2_py.get_registered_readers()
     assert 'my_read_only_test_plugin' in reader_plugins
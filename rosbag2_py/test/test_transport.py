@@ -15,11 +15,13 @@
 import datetime
 import os
 from pathlib import Path
+import shutil
 import sys
 import threading
 
 
 from common import get_rosbag_options, wait_for
+import pytest
 import rclpy
 from rclpy.qos import QoSProfile
 import rosbag2_py
@@ -32,6 +34,8 @@ if os.environ.get('ROSBAG2_PY_TEST_WITH_RTLD_GLOBAL', None) is not None:
     # For the fun RTTI ABI details, see https://whatofhow.wordpress.com/2015/03/17/odr-rtti-dso/.
     sys.setdlopenflags(os.RTLD_GLOBAL | os.RTLD_LAZY)
 
+RESOURCES_PATH = Path(os.environ['ROSBAG2_PY_TEST_RESOURCES_DIR'])
+
 
 def test_options_qos_conversion():
     # Tests that the to-and-from C++ conversions are working properly in the pybind structs
@@ -48,6 +52,24 @@ def test_options_qos_conversion():
     assert record_options.topic_qos_profile_overrides == simple_overrides
 
 
+def test_play_raises_errors_of_playback(tmp_path):
+    # The second file of the bag is only opened once the first one was played
+    bag_path = tmp_path / 'corrupt_talker'
+    shutil.copytree(RESOURCES_PATH / 'talker', bag_path)
+    (bag_path / 'corrupt.db3').write_bytes(b'not a database' * 100)
+    metadata_path = bag_path / 'metadata.yaml'
+    metadata = metadata_path.read_text()
+    metadata_path.write_text(
+        metadata.replace('    - talker.db3', '    - talker.db3\n    - corrupt.db3'))
+    storage_options, _ = get_rosbag_options(str(bag_path))
+
+    play_options = rosbag2_py.PlayOptions()
+    play_options.rate = 100
+    player = rosbag2_py.Player()
+    with pytest.raises(RuntimeError):
+        player.play(storage_options, play_options)
+
+
 def test_record_cancel(tmp_path):
     bag_path = str(tmp_path / 'test_record_cancel')
     storage_options, converter_options = get_rosbag_options(bag_path)
@@ -16,6 +16,8 @@
 #define ROSBAG2_STORAGE__BAG_METADATA_HPP_
 
 #include <chrono>
+#include <cstdint>
+#include <map>
 #include <string>
 #include <vector>
 #include <utility>
@@ -37,11 +39,31 @@ struct FileInformation
   std::chrono::time_point<std::chrono::high_resolution_clock> starting_time;
   std::chrono::nanoseconds duration;
   size_t message_count;
+  // Number of messages of each topic in the file, used to skip files when reading
+  std::map<std::string, size_t> topic_message_counts;
+};
+
+struct TopicRateOverview
+{
+  std::string topic_name;
+  // Number and total size of the messages in each bucket
+  std::vector<uint64_t> message_counts;
+  std::vector<uint64_t> message_bytes;
+};
+
+// Messages per topic in consecutive buckets of receive time, collected while recording
+struct RateOverview
+{
+  // Start of the first bucket, a multiple of bucket_duration
+  std::chrono::time_point<std::chrono::high_resolution_clock> starting_time;
+  // Zero if the bag has no overview
+  std::chrono::nanoseconds bucket_duration{0};
+  std::vector<TopicRateOverview> topics;
 };
 
 struct BagMetadata
 {
-  int version = 5;  // upgrade this number when changing the content of the struct
+  int version = 7;  // upgrade this number when changing the content of the struct
   uint64_t bag_size = 0;  // Will not be serialized
   std::string storage_identifier;
   std::vector<std::string> relative_file_paths;
@@ -52,6 +74,7 @@ struct BagMetadata
   std::vector<TopicInformation> topics_with_message_count;
   std::string compression_format;
   std::string compression_mode;
+  RateOverview rate_overview;
 };
 
 }  // namespace rosbag2_storage
@@ -29,6 +29,9 @@ struct SerializedBagMessage
   std::shared_ptr<rcutils_uint8_array_t> serialized_data;
   rcutils_time_point_value_t time_stamp;
   std::string topic_name;
+  // Stamp of the std_msgs/Header leading the message, if it was extracted when recording.
+  bool has_header_stamp = false;
+  rcutils_time_point_value_t header_stamp = 0;
 };
 
 typedef std::shared_ptr<SerializedBagMessage> SerializedBagMessageSharedPtr;
@@ -15,9 +15,12 @@
 #ifndef ROSBAG2_STORAGE__STORAGE_FILTER_HPP_
 #define ROSBAG2_STORAGE__STORAGE_FILTER_HPP_
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
+#include "rcutils/time.h"
+
 namespace rosbag2_storage
 {
 
@@ -27,6 +30,18 @@ struct StorageFilter
   // specified topics will be returned. If list is empty, the filter is ignored
   // and all messages are returned.
   std::vector<std::string> topics;
+
+  // Range of std_msgs/Header stamps to return when filter_header_stamp is set, both bounds
+  // included. Only messages whose header stamp was indexed when recording can match.
+  // Messages are still returned in the order of their receive timestamp.
+  bool filter_header_stamp = false;
+  rcutils_time_point_value_t header_stamp_start = INT64_MIN;
+  rcutils_time_point_value_t header_stamp_end = INT64_MAX;
+
+  // Return messages without their serialized data, for passes which only need timestamps and
+  // sizes. The serialized_data of such messages has no buffer, only its buffer_length is set to
+  // the size of the data in the storage. Storages which can't skip the data return it as usual.
+  bool skip_serialized_data = false;
 };
 
 }  // namespace rosbag2_storage
@@ -44,6 +44,13 @@ public:
 
   virtual uint64_t get_minimum_split_file_size() const = 0;
 
+  /// Number of messages passed to write() which the storage could not store,
+  /// e.g. because they exceed a size limit of the storage format.
+  virtual uint64_t get_number_of_dropped_messages() const
+  {
+    return 0;
+  }
+
   void set_filter(const StorageFilter & storage_filter) override = 0;
 
   void reset_filter() override = 0;
@@ -53,6 +53,22 @@ public:
   // Enable snapshot mode.
   // Defaults to disabled.
   bool snapshot_mode = false;
+
+  // Extract the stamp of messages whose type starts with a std_msgs/Header while writing and
+  // index it in storage, so that messages can be filtered by header stamp when reading.
+  // Defaults to disabled.
+  bool index_header_stamps = false;
+
+  // Block the writing thread until there is room instead of dropping messages when the cache
+  // or the message compression queue is full. Meant for offline writers which produce messages
+  // faster than storage can take them, like bag rewriting.
+  // Defaults to disabled.
+  bool block_on_full_cache = false;
+
+  // Duration in milliseconds of the buckets of the per topic rate overview which is stored
+  // with the metadata of the bag. The buckets are coarsened for long recordings.
+  // Defaults to 0, which disables the rate overview. The recorder enables it by default.
+  uint64_t rate_overview_bucket_duration = 0;
 };
 
 }  // namespace rosbag2_storage
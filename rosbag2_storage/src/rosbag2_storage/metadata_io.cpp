@@ -15,6 +15,7 @@
 #include "rosbag2_storage/metadata_io.hpp"
 
 #include <fstream>
+#include <map>
 #include <string>
 #include <vector>
 
@@ -133,6 +134,8 @@ struct convert<rosbag2_storage::FileInformation>
     node["starting_time"] = metadata.starting_time;
     node["duration"] = metadata.duration;
     node["message_count"] = metadata.message_count;
+    node["topic_message_counts"] = metadata.topic_message_counts;
+    node["topic_message_counts"].SetStyle(EmitterStyle::Flow);
     return node;
   }
 
@@ -143,6 +146,11 @@ struct convert<rosbag2_storage::FileInformation>
       node["starting_time"].as<std::chrono::time_point<std::chrono::high_resolution_clock>>();
     metadata.duration = node["duration"].as<std::chrono::nanoseconds>();
     metadata.message_count = node["message_count"].as<uint64_t>();
+    // Not written before version 7
+    if (node["topic_message_counts"]) {
+      metadata.topic_message_counts =
+        node["topic_message_counts"].as<std::map<std::string, size_t>>();
+    }
     return true;
   }
 };
@@ -183,6 +191,52 @@ struct convert<std::chrono::time_point<std::chrono::high_resolution_clock>>
   }
 };
 
+template<>
+struct convert<rosbag2_storage::TopicRateOverview>
+{
+  static Node encode(const rosbag2_storage::TopicRateOverview & topic)
+  {
+    Node node;
+    node["topic_name"] = topic.topic_name;
+    // One line per topic instead of one per bucket keeps long overviews readable
+    node["message_counts"] = topic.message_counts;
+    node["message_counts"].SetStyle(EmitterStyle::Flow);
+    node["message_bytes"] = topic.message_bytes;
+    node["message_bytes"].SetStyle(EmitterStyle::Flow);
+    return node;
+  }
+
+  static bool decode(const Node & node, rosbag2_storage::TopicRateOverview & topic)
+  {
+    topic.topic_name = node["topic_name"].as<std::string>();
+    topic.message_counts = node["message_counts"].as<std::vector<uint64_t>>();
+    topic.message_bytes = node["message_bytes"].as<std::vector<uint64_t>>();
+    return true;
+  }
+};
+
+template<>
+struct convert<rosbag2_storage::RateOverview>
+{
+  static Node encode(const rosbag2_storage::RateOverview & overview)
+  {
+    Node node;
+    node["starting_time"] = overview.starting_time;
+    node["bucket_duration"] = overview.bucket_duration;
+    node["topics"] = overview.topics;
+    return node;
+  }
+
+  static bool decode(const Node & node, rosbag2_storage::RateOverview & overview)
+  {
+    overview.starting_time = node["starting_time"]
+      .as<std::chrono::time_point<std::chrono::high_resolution_clock>>();
+    overview.bucket_duration = node["bucket_duration"].as<std::chrono::nanoseconds>();
+    overview.topics = node["topics"].as<std::vector<rosbag2_storage::TopicRateOverview>>();
+    return true;
+  }
+};
+
 template<>
 struct convert<rosbag2_storage::BagMetadata>
 {
@@ -199,6 +253,9 @@ struct convert<rosbag2_storage::BagMetadata>
     node["compression_mode"] = metadata.compression_mode;
     node["relative_file_paths"] = metadata.relative_file_paths;
     node["files"] = metadata.files;
+    if (metadata.rate_overview.bucket_duration.count() > 0) {
+      node["rate_overview"] = metadata.rate_overview;
+    }
 
     return node;
   }
@@ -225,6 +282,10 @@ struct convert<rosbag2_storage::BagMetadata>
       metadata.files =
         node["files"].as<std::vector<rosbag2_storage::FileInformation>>();
     }
+    // Only written if the rate overview was enabled while recording
+    if (metadata.version >= 6 && node["rate_overview"]) {
+      metadata.rate_overview = node["rate_overview"].as<rosbag2_storage::RateOverview>();
+    }
     return true;
   }
 };
@@ -31,6 +31,9 @@ Node convert<rosbag2_storage::StorageOptions>::encode(
   node["storage_preset_profile"] = storage_options.storage_preset_profile;
   node["storage_config_uri"] = storage_options.storage_config_uri;
   node["snapshot_mode"] = storage_options.snapshot_mode;
+  node["index_header_stamps"] = storage_options.index_header_stamps;
+  node["block_on_full_cache"] = storage_options.block_on_full_cache;
+  node["rate_overview_bucket_duration"] = storage_options.rate_overview_bucket_duration;
   return node;
 }
 
@@ -46,6 +49,10 @@ bool convert<rosbag2_storage::StorageOptions>::decode(
     node, "storage_preset_profile", storage_options.storage_preset_profile);
   optional_assign<std::string>(node, "storage_config_uri", storage_options.storage_config_uri);
   optional_assign<bool>(node, "snapshot_mode", storage_options.snapshot_mode);
+  optional_assign<bool>(node, "index_header_stamps", storage_options.index_header_stamps);
+  optional_assign<bool>(node, "block_on_full_cache", storage_options.block_on_full_cache);
+  optional_assign<uint64_t>(
+    node, "rate_overview_bucket_duration", storage_options.rate_overview_bucket_duration);
   return true;
 }
 
@@ -132,3 +132,56 @@ TEST_F(MetadataFixture, metadata_reads_v4_fills_offered_qos_profiles)
   auto actual_first_topic = read_metadata.topics_with_message_count[0];
   EXPECT_THAT(actual_first_topic.topic_metadata.offered_qos_profiles, Eq(offered_qos_profiles));
 }
+
+TEST_F(MetadataFixture, metadata_reads_rate_overview_from_version_6)
+{
+  BagMetadata metadata{};
+  metadata.rate_overview.starting_time =
+    std::chrono::time_point<std::chrono::high_resolution_clock>(std::chrono::seconds(10));
+  metadata.rate_overview.bucket_duration = std::chrono::seconds(1);
+  metadata.rate_overview.topics.push_back({"topic1", {1, 0, 3}, {10, 0, 30}});
+  metadata.rate_overview.topics.push_back({"topic2", {0, 2, 0}, {0, 200, 0}});
+
+  metadata_io_->write_metadata(temporary_dir_path_, metadata);
+  auto read_metadata = metadata_io_->read_metadata(temporary_dir_path_);
+  EXPECT_EQ(read_metadata.rate_overview.starting_time, metadata.rate_overview.starting_time);
+  EXPECT_EQ(read_metadata.rate_overview.bucket_duration, std::chrono::seconds(1));
+  ASSERT_THAT(read_metadata.rate_overview.topics, SizeIs(2));
+  EXPECT_EQ(read_metadata.rate_overview.topics[0].topic_name, "topic1");
+  EXPECT_THAT(read_metadata.rate_overview.topics[0].message_counts, ElementsAre(1, 0, 3));
+  EXPECT_THAT(read_metadata.rate_overview.topics[0].message_bytes, ElementsAre(10, 0, 30));
+  EXPECT_EQ(read_metadata.rate_overview.topics[1].topic_name, "topic2");
+  EXPECT_THAT(read_metadata.rate_overview.topics[1].message_counts, ElementsAre(0, 2, 0));
+
+  // Older bags have no overview
+  metadata.version = 5;
+  metadata_io_->write_metadata(temporary_dir_path_, metadata);
+  read_metadata = metadata_io_->read_metadata(temporary_dir_path_);
+  EXPECT_EQ(read_metadata.rate_overview.bucket_duration, std::chrono::nanoseconds(0));
+  EXPECT_THAT(read_metadata.rate_overview.topics, IsEmpty());
+
+  // Bags recorded with the overview disabled have none either
+  metadata.version = 6;
+  metadata.rate_overview = {};
+  metadata_io_->write_metadata(temporary_dir_path_, metadata);
+  read_metadata = metadata_io_->read_metadata(temporary_dir_path_);
+  EXPECT_EQ(read_metadata.rate_overview.bucket_duration, std::chrono::nanoseconds(0));
+  EXPECT_THAT(read_metadata.rate_overview.topics, IsEmpty());
+}
+
+TEST_F(MetadataFixture, metadata_reads_per_file_topic_message_counts)
+{
+  BagMetadata metadata{};
+  metadata.relative_file_paths = {"bag_0.db3", "bag_1.db3"};
+  metadata.files = {
+    {"bag_0.db3", {}, std::chrono::seconds(1), 3, {{"topic1", 1}, {"topic2", 2}}},
+    {"bag_1.db3", {}, std::chrono::seconds(1), 0, {}}};
+
+  metadata_io_->write_metadata(temporary_dir_path_, metadata);
+  auto read_metadata = metadata_io_->read_metadata(temporary_dir_path_);
+  ASSERT_THAT(read_metadata.files, SizeIs(2));
+  EXPECT_THAT(
+    read_metadata.files[0].topic_message_counts,
+    ElementsAre(Pair("topic1", 1u), Pair("topic2", 2u)));
+  EXPECT_THAT(read_metadata.files[1].topic_message_counts, IsEmpty());
+}
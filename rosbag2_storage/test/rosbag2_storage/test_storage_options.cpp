@@ -29,6 +29,9 @@ TEST(storage_options, test_yaml_serialization)
   original.storage_preset_profile = "profile";
   original.storage_config_uri = "config_uri";
   original.snapshot_mode = true;
+  original.index_header_stamps = true;
+  original.block_on_full_cache = true;
+  original.rate_overview_bucket_duration = 250;
 
   auto node = YAML::convert<rosbag2_storage::StorageOptions>().encode(original);
 
@@ -46,4 +49,8 @@ TEST(storage_options, test_yaml_serialization)
   ASSERT_EQ(original.storage_preset_profile, reconstructed.storage_preset_profile);
   ASSERT_EQ(original.storage_config_uri, reconstructed.storage_config_uri);
   ASSERT_EQ(original.snapshot_mode, reconstructed.snapshot_mode);
+  ASSERT_EQ(original.index_header_stamps, reconstructed.index_header_stamps);
+  ASSERT_EQ(original.block_on_full_cache, reconstructed.block_on_full_cache);
+  ASSERT_EQ(
+    original.rate_overview_bucket_duration, reconstructed.rate_overview_bucket_duration);
 }
@@ -80,6 +80,8 @@ public:
 
   uint64_t get_minimum_split_file_size() const override;
 
+  uint64_t get_number_of_dropped_messages() const override;
+
   void set_filter(const rosbag2_storage::StorageFilter & storage_filter) override;
 
   void reset_filter() override;
@@ -99,13 +101,15 @@ private:
   void prepare_for_writing();
   void prepare_for_reading();
   void fill_topics_and_types();
+  bool has_header_stamp_column();
   void activate_transaction();
   void commit_transaction();
   void write_locked(std::shared_ptr<const rosbag2_storage::SerializedBagMessage> message)
   RCPPUTILS_TSA_REQUIRES(database_write_mutex_);
 
   using ReadQueryResult = SqliteStatementWrapper::QueryResult<
-    std::shared_ptr<rcutils_uint8_array_t>, rcutils_time_point_value_t, std::string, int>;
+    std::shared_ptr<rcutils_uint8_array_t>, rcutils_time_point_value_t, std::string, int,
+    int, rcutils_time_point_value_t, int64_t>;
 
   std::shared_ptr<SqliteWrapper> database_ RCPPUTILS_TSA_GUARDED_BY(database_write_mutex_);
   SqliteStatement write_statement_ {};
@@ -117,6 +121,9 @@ private:
   std::vector<rosbag2_storage::TopicMetadata> all_topics_and_types_;
   std::string relative_path_;
   std::atomic_bool active_transaction_ {false};
+  std::atomic<uint64_t> dropped_messages_ {0};
+  // Bags written before header stamps were indexed don't have the column
+  bool header_stamp_column_ = false;
 
   rcutils_time_point_value_t seek_time_ = 0;
   int seek_row_id_ = 0;
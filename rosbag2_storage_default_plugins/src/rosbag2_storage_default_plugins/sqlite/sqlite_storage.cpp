@@ -195,6 +195,7 @@ void SqliteStorage::open(
   if (is_read_write(io_flag)) {
     initialize();
   }
+  header_stamp_column_ = has_header_stamp_column();
 
   // Reset the read and write statements in case the database changed.
   // These will be reinitialized lazily on the first read or write.
@@ -250,6 +251,10 @@ void SqliteStorage::write_locked(
 
   try {
     write_statement_->bind(message->time_stamp, topic_entry->second, message->serialized_data);
+    // Left unbound, the header stamp is stored as NULL
+    if (message->has_header_stamp && header_stamp_column_) {
+      write_statement_->bind(message->header_stamp);
+    }
   } catch (const SqliteException & exc) {
     if (SQLITE_TOOBIG == exc.get_sqlite_return_code()) {
       // Get the sqlite string/blob limit.
@@ -263,6 +268,7 @@ void SqliteStorage::write_locked(
           "' bytes failed to write because it exceeds the maximum size sqlite can store ('" <<
           sqlite_limit << "' bytes): " <<
           exc.what());
+      dropped_messages_++;
       return;
     } else {
       // Rethrow.
@@ -305,9 +311,18 @@ std::shared_ptr<rosbag2_storage::SerializedBagMessage> SqliteStorage::read_next(
   }
 
   auto bag_message = std::make_shared<rosbag2_storage::SerializedBagMessage>();
-  bag_message->serialized_data = std::get<0>(*current_message_row_);
+  if (storage_filter_.skip_serialized_data) {
+    bag_message->serialized_data = std::make_shared<rcutils_uint8_array_t>(
+      rcutils_get_zero_initialized_uint8_array());
+    bag_message->serialized_data->buffer_length = static_cast<size_t>(
+      std::get<6>(*current_message_row_));
+  } else {
+    bag_message->serialized_data = std::get<0>(*current_message_row_);
+  }
   bag_message->time_stamp = std::get<1>(*current_message_row_);
   bag_message->topic_name = std::get<2>(*current_message_row_);
+  bag_message->has_header_stamp = std::get<4>(*current_message_row_) != 0;
+  bag_message->header_stamp = std::get<5>(*current_message_row_);
 
   // set start time to current time
   // and set seek_row_id to the new row id up
@@ -347,10 +362,24 @@ void SqliteStorage::initialize()
     "id INTEGER PRIMARY KEY," \
     "topic_id INTEGER NOT NULL," \
     "timestamp INTEGER NOT NULL, " \
-    "data BLOB NOT NULL);";
+    "data BLOB NOT NULL, " \
+    "header_stamp INTEGER);";
   database_->prepare_statement(create_stmt)->execute_and_reset();
   create_stmt = "CREATE INDEX timestamp_idx ON messages (timestamp ASC);";
   database_->prepare_statement(create_stmt)->execute_and_reset();
+  // Partial index, costs nothing for messages without header stamp
+  create_stmt = "CREATE INDEX header_stamp_idx ON messages (header_stamp ASC) "
+    "WHERE header_stamp IS NOT NULL;";
+  database_->prepare_statement(create_stmt)->execute_and_reset();
+}
+
+bool SqliteStorage::has_header_stamp_column()
+{
+  auto statement = database_->prepare_statement(
+    "SELECT COUNT(*) FROM pragma_table_info('messages') WHERE name = 'header_stamp';");
+  auto query_results = statement->execute_query<int>();
+  auto result = query_results.begin();
+  return result != query_results.end() && std::get<0>(*result) > 0;
 }
 
 void SqliteStorage::create_topic(const rosbag2_storage::TopicMetadata & topic)
@@ -383,14 +412,25 @@ void SqliteStorage::remove_topic(const rosbag2_storage::TopicMetadata & topic)
 
 void SqliteStorage::prepare_for_writing()
 {
-  write_statement_ = database_->prepare_statement(
-    "INSERT INTO messages (timestamp, topic_id, data) VALUES (?, ?, ?);");
+  if (header_stamp_column_) {
+    write_statement_ = database_->prepare_statement(
+      "INSERT INTO messages (timestamp, topic_id, data, header_stamp) VALUES (?, ?, ?, ?);");
+  } else {
+    write_statement_ = database_->prepare_statement(
+      "INSERT INTO messages (timestamp, topic_id, data) VALUES (?, ?, ?);");
+  }
 }
 
 void SqliteStorage::prepare_for_reading()
 {
-  std::string statement_str = "SELECT data, timestamp, topics.name, messages.id "
-    "FROM messages JOIN topics ON messages.topic_id = topics.id WHERE ";
+  // length() of a blob doesn't load the blob, skipping the data saves reading it from disk
+  std::string statement_str = storage_filter_.skip_serialized_data ?
+    "SELECT NULL, " : "SELECT data, ";
+  statement_str += "timestamp, topics.name, messages.id, ";
+  statement_str += header_stamp_column_ ?
+    "header_stamp IS NOT NULL, IFNULL(header_stamp, 0), " : "0, 0, ";
+  statement_str += storage_filter_.skip_serialized_data ? "length(data) " : "0 ";
+  statement_str += "FROM messages JOIN topics ON messages.topic_id = topics.id WHERE ";
 
   // add topic filter
   if (!storage_filter_.topics.empty()) {
@@ -404,6 +444,17 @@ void SqliteStorage::prepare_for_reading()
     }
     statement_str += "(topics.name IN (" + topic_list + ")) AND ";
   }
+  // add header stamp filter
+  if (storage_filter_.filter_header_stamp) {
+    if (!header_stamp_column_) {
+      // No message of this bag has an indexed header stamp
+      statement_str += "0 AND ";
+    } else {
+      statement_str += "(header_stamp BETWEEN " +
+        std::to_string(storage_filter_.header_stamp_start) + " AND " +
+        std::to_string(storage_filter_.header_stamp_end) + ") AND ";
+    }
+  }
   // add start time filter
   statement_str += "(((timestamp = " + std::to_string(seek_time_) + ") "
     "AND (messages.id >= " + std::to_string(seek_row_id_) + ")) "
@@ -414,7 +465,8 @@ void SqliteStorage::prepare_for_reading()
 
   read_statement_ = database_->prepare_statement(statement_str);
   message_result_ = read_statement_->execute_query<
-    std::shared_ptr<rcutils_uint8_array_t>, rcutils_time_point_value_t, std::string, int>();
+    std::shared_ptr<rcutils_uint8_array_t>, rcutils_time_point_value_t, std::string, int,
+    int, rcutils_time_point_value_t, int64_t>();
   current_message_row_ = message_result_.begin();
 }
 
@@ -445,6 +497,11 @@ uint64_t SqliteStorage::get_minimum_split_file_size() const
   return MIN_SPLIT_FILE_SIZE;
 }
 
+uint64_t SqliteStorage::get_number_of_dropped_messages() const
+{
+  return dropped_messages_;
+}
+
 rosbag2_storage::BagMetadata SqliteStorage::get_metadata()
 {
   rosbag2_storage::BagMetadata metadata;
@@ -164,6 +164,84 @@ TEST_F(StorageTestFixture, read_next_returns_filtered_messages) {
   EXPECT_FALSE(readable_storage2->has_next());
 }
 
+TEST_F(StorageTestFixture, read_next_filters_by_indexed_header_stamp) {
+  auto db_filename = (rcpputils::fs::path(temporary_dir_path_) / "rosbag").string();
+  {
+    auto writable_storage = std::make_unique<rosbag2_storage_plugins::SqliteStorage>();
+    writable_storage->open({db_filename, kPluginID});
+    writable_storage->create_topic({"topic", "type", "rmw", ""});
+    // Receive order differs from header stamp order, the last message has no header stamp
+    const std::vector<std::pair<int64_t, int64_t>> stamps = {{1, 30}, {2, 10}, {3, 20}, {4, 0}};
+    for (const auto & stamp : stamps) {
+      auto bag_message = std::make_shared<rosbag2_storage::SerializedBagMessage>();
+      bag_message->serialized_data = make_serialized_message("message");
+      bag_message->time_stamp = stamp.first;
+      bag_message->topic_name = "topic";
+      bag_message->has_header_stamp = stamp.second != 0;
+      bag_message->header_stamp = stamp.second;
+      writable_storage->write(bag_message);
+    }
+  }
+
+  std::unique_ptr<rosbag2_storage::storage_interfaces::ReadOnlyInterface> readable_storage =
+    std::make_unique<rosbag2_storage_plugins::SqliteStorage>();
+  readable_storage->open({db_filename + ".db3", kPluginID});
+
+  rosbag2_storage::StorageFilter storage_filter;
+  storage_filter.filter_header_stamp = true;
+  storage_filter.header_stamp_start = 15;
+  storage_filter.header_stamp_end = 30;
+  readable_storage->set_filter(storage_filter);
+
+  ASSERT_TRUE(readable_storage->has_next());
+  auto first_message = readable_storage->read_next();
+  EXPECT_THAT(first_message->time_stamp, Eq(1));
+  EXPECT_TRUE(first_message->has_header_stamp);
+  EXPECT_THAT(first_message->header_stamp, Eq(30));
+  ASSERT_TRUE(readable_storage->has_next());
+  auto second_message = readable_storage->read_next();
+  EXPECT_THAT(second_message->time_stamp, Eq(3));
+  EXPECT_THAT(second_message->header_stamp, Eq(20));
+  EXPECT_FALSE(readable_storage->has_next());
+
+  auto all_messages = read_all_messages_from_sqlite();
+  ASSERT_THAT(all_messages, SizeIs(4));
+  EXPECT_FALSE(all_messages[3]->has_header_stamp);
+}
+
+TEST_F(StorageTestFixture, read_next_skips_serialized_data_but_returns_its_size) {
+  std::vector<std::tuple<std::string, int64_t, std::string, std::string, std::string>>
+  string_messages =
+  {std::make_tuple("first message", 1, "topic1", "type1", "rmw1"),
+    std::make_tuple("second message, longer", 2, "topic2", "type2", "rmw2")};
+  write_messages_to_sqlite(string_messages);
+
+  std::unique_ptr<rosbag2_storage::storage_interfaces::ReadOnlyInterface> readable_storage =
+    std::make_unique<rosbag2_storage_plugins::SqliteStorage>();
+  auto db_filename = (rcpputils::fs::path(temporary_dir_path_) / "rosbag.db3").string();
+  readable_storage->open({db_filename, kPluginID});
+
+  rosbag2_storage::StorageFilter storage_filter;
+  storage_filter.skip_serialized_data = true;
+  readable_storage->set_filter(storage_filter);
+
+  auto full_sizes = std::vector<size_t>{};
+  for (const auto & message : read_all_messages_from_sqlite()) {
+    full_sizes.push_back(message->serialized_data->buffer_length);
+  }
+  ASSERT_THAT(full_sizes, SizeIs(2));
+
+  for (size_t i = 0; i < full_sizes.size(); ++i) {
+    ASSERT_TRUE(readable_storage->has_next());
+    auto message = readable_storage->read_next();
+    EXPECT_THAT(message->time_stamp, Eq(std::get<1>(string_messages[i])));
+    EXPECT_THAT(message->topic_name, Eq(std::get<2>(string_messages[i])));
+    EXPECT_THAT(message->serialized_data->buffer, IsNull());
+    EXPECT_THAT(message->serialized_data->buffer_length, Eq(full_sizes[i]));
+  }
+  EXPECT_FALSE(readable_storage->has_next());
+}
+
 TEST_F(StorageTestFixture, get_all_topics_and_types_returns_the_correct_vector) {
   std::unique_ptr<rosbag2_storage::storage_interfaces::ReadWriteInterface> writable_storage =
     std::make_unique<rosbag2_storage_plugins::SqliteStorage>();
@@ -13,12 +13,5 @@
 #  See the License for the specific language governing permissions and
 #  limitations under the License.
 
-mkdir -p ./build
-
-cd build
-
-cmake ..
-make
-
-cd ..
-
+# Builds the benchmarks and their dependencies, run from the root of the colcon workspace
+colcon build --packages-up-to rosbag2_storage_evaluation --cmake-args -DBUILD_ROSBAG2_BENCHMARKS=1
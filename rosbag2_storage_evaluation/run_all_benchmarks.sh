@@ -13,11 +13,11 @@
 #  See the License for the specific language governing permissions and
 #  limitations under the License.
 
-cd ./build/bin
+# Runs all benchmarks in the current directory, which is where the bags and CSV files are written.
+# Arguments are the storage configurations to compare, see README.md.
 
-./small_messages_benchmark
-./big_messages_benchmark
-./mixed_messages_benchmark
-
-cd ../..
+BENCHMARKS_DIR=$(dirname "$0")
 
+"$BENCHMARKS_DIR"/small_messages_benchmark "$@"
+"$BENCHMARKS_DIR"/big_messages_benchmark "$@"
+"$BENCHMARKS_DIR"/mixed_messages_benchmark "$@"
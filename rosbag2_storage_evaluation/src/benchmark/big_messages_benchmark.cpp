@@ -14,63 +14,66 @@
  *  limitations under the License.
  */
 
-#include "writer/sqlite/separate_topic_table_sqlite_writer.h"
-#include "benchmark/writer/sqlite/sqlite_writer_benchmark.h"
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "benchmark/storage/storage_benchmark.h"
+#include "benchmark/storage/storage_configuration.h"
 #include "generators/message_generator.h"
 #include "profiler/profiler.h"
-#include "writer/sqlite/one_table_sqlite_writer.h"
 
 using namespace ros2bag;
 
 void run_benchmark(
-  std::string const & description,
-  std::shared_ptr<MessageWriter> writer,
-  std::string const & db_name,
+  StorageConfiguration const & configuration,
+  std::string const & uri,
   unsigned int number_of_messages,
   unsigned int message_blob_size,
-  unsigned int transaction_size,
+  unsigned int write_batch_size,
   bool with_header = false)
 {
-
   std::vector<std::pair<std::string, std::string>> meta_data = {
-    {"description",               description},
+    {"description",               configuration.description},
     {"number of messages",        std::to_string(number_of_messages)},
     {"message blob size (bytes)", std::to_string(message_blob_size)},
-    {"transaction size",          std::to_string(transaction_size)}
+    {"write batch size",          std::to_string(write_batch_size)}
   };
 
   MessageGenerator::Specification specification = {std::make_tuple("topic", message_blob_size)};
 
-  SqliteWriterBenchmark benchmark(
+  StorageBenchmark benchmark(
     std::make_unique<MessageGenerator>(number_of_messages, specification),
-    std::move(writer),
-    std::make_unique<Profiler>(meta_data, db_name));
+    configuration,
+    uri,
+    write_batch_size,
+    std::make_unique<Profiler>(meta_data));
 
-  std::remove(db_name.c_str());
   benchmark.run();
-  std::remove(db_name.c_str());
 
   write_csv_file("big_messages_benchmark.csv", benchmark, with_header);
 }
 
 void run_benchmark_repeatedly(
   unsigned int times,
-  std::string const & description,
-  std::shared_ptr<MessageWriter> writer,
-  std::string const & db_name,
+  StorageConfiguration const & configuration,
+  std::string const & uri,
   unsigned int number_of_messages,
   unsigned int message_blob_size,
-  unsigned int transaction_size,
+  unsigned int write_batch_size,
   bool with_header = false)
 {
-  for (int i = 0; i < times; ++i) {
+  for (unsigned int i = 0; i < times; ++i) {
     run_benchmark(
-      description,
-      writer,
-      db_name,
+      configuration,
+      uri,
       number_of_messages,
       message_blob_size,
-      transaction_size,
+      write_batch_size,
       with_header);
     with_header = false;
   }
@@ -82,46 +85,31 @@ int main(int argc, char ** argv)
    * We write the stream of a full HD camera to the Bagfile.
    * We write about 10GB into the file
    */
-  std::string db_name = "big_messages_benchmark.db";
+  std::string uri = "big_messages_benchmark";
   unsigned int msg_size_bytes = 30000000; // 30MB == one full HD image
   unsigned int msg_count = 300;
-  unsigned int transaction_size = 10;
+  unsigned int write_batch_size = 10;
 
-  auto const write_header = true;
+  auto write_header = true;
 
-  run_benchmark_repeatedly(5,
-    "OneTableSqlite",
-    std::make_shared<OneTableSqliteWriter>(
-      db_name,
-      transaction_size,
-      Indices({{"MESSAGES", "TIMESTAMP"},
-               {"MESSAGES", "TOPIC"}}),
-      // Setting to "journal_mode" to "OFF" increases writing speed, but turns off transactions.
-      Pragmas({{"journal_mode", "MEMORY"},
-               {"synchronous",  "OFF"}})
-    ),
-    db_name,
-    msg_count,
-    msg_size_bytes,
-    transaction_size, write_header);
+  std::vector<StorageConfiguration> configurations;
+  try {
+    configurations =
+      storage_configurations_from_arguments(argc, argv, {"sqlite3", "sqlite3:resilient"});
+  } catch (std::invalid_argument const & e) {
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
 
-  run_benchmark_repeatedly(5,
-    "SeparateTopicTableSqlite",
-    std::make_shared<SeparateTopicTableSqliteWriter>(
-      db_name,
-      transaction_size,
-      Indices({{"MESSAGES", "TIMESTAMP"},
-               {"MESSAGES", "TOPIC_ID"},
-               {"TOPICS",   "TOPIC"}}),
-      // Setting to "journal_mode" to "OFF" increases writing speed, but turns off transactions.
-      Pragmas({{"foreign_keys", "ON"},
-               {"journal_mode", "MEMORY"},
-               {"synchronous",  "OFF"}})
-    ),
-    db_name,
-    msg_count,
-    msg_size_bytes,
-    transaction_size);
+  for (auto const & configuration : configurations) {
+    run_benchmark_repeatedly(5,
+      configuration,
+      uri,
+      msg_count,
+      msg_size_bytes,
+      write_batch_size, write_header);
+    write_header = false;
+  }
 
   return EXIT_SUCCESS;
 }
@@ -0,0 +1,176 @@
+/*
+ *  Copyright (c) 2022,  Open Source Robotics Foundation, Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "benchmark/storage/storage_benchmark.h"
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "rcutils/types/uint8_array.h"
+#include "rosbag2_storage/serialized_bag_message.hpp"
+#include "rosbag2_storage/topic_metadata.hpp"
+
+using namespace ros2bag;
+
+namespace
+{
+
+// Storage plugins don't look into the messages, so any type will do
+char const * const kBlobType = "rosbag2_storage_evaluation/msg/Blob";
+
+// Refers to the blob of the message instead of copying it, like the recorder passes on the
+// serialized messages it receives
+std::shared_ptr<rosbag2_storage::SerializedBagMessage const> to_bag_message(
+  Message const & message)
+{
+  auto const blob = message.blob();
+  auto serialized_data = std::shared_ptr<rcutils_uint8_array_t>(
+    new rcutils_uint8_array_t(rcutils_get_zero_initialized_uint8_array()),
+    [blob](rcutils_uint8_array_t * data) {delete data;});
+  serialized_data->buffer = const_cast<uint8_t *>(blob->data());
+  serialized_data->buffer_length = blob->size();
+  serialized_data->buffer_capacity = blob->size();
+
+  auto bag_message = std::make_shared<rosbag2_storage::SerializedBagMessage>();
+  bag_message->serialized_data = serialized_data;
+  bag_message->topic_name = message.topic();
+  bag_message->time_stamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+    message.timestamp().time_since_epoch()).count();
+  return bag_message;
+}
+
+double megabytes_per_second(size_t bytes, std::chrono::system_clock::duration duration)
+{
+  auto const seconds = std::chrono::duration<double>(duration).count();
+  return static_cast<double>(bytes) / 1024 / 1024 / seconds;
+}
+
+}
+
+void StorageBenchmark::run() const
+{
+  generator_->reset();
+  rosbag2_storage::StorageFactory factory;
+
+  auto const written = write(factory);
+  profiler_->track_disk_usage(written.first);
+  auto const read_back = read(factory, written.first);
+  // Including files SQLite may leave behind after reading in WAL mode
+  for (auto const & suffix : {"", "-wal", "-shm"}) {
+    std::remove((written.first + suffix).c_str());
+  }
+
+  profiler_->add_measurement(
+    "write throughput (MB/s)",
+    megabytes_per_second(
+      written.second, profiler_->time_between("start writing time", "end closing time")));
+  profiler_->add_measurement(
+    "read throughput (MB/s)",
+    megabytes_per_second(
+      read_back.second, profiler_->time_between("start reading time", "end reading time")));
+  profiler_->add_measurement(
+    "write amplification",
+    static_cast<double>(profiler_->disk_usage()) / static_cast<double>(written.second));
+  profiler_->add_measurement("messages read", static_cast<double>(read_back.first));
+}
+
+std::pair<std::string, size_t> StorageBenchmark::write(
+  rosbag2_storage::StorageFactory & factory) const
+{
+  auto storage = factory.open_read_write(configuration_.storage_options(uri_));
+  if (!storage) {
+    throw std::runtime_error("Failed to open storage " + configuration_.description);
+  }
+
+  profiler_->take_time_for("start writing time");
+
+  Profiler::TickProgress throughput_tick = profiler_->measure_progress(
+    "write_throughput", generator_->total_msg_count());
+
+  std::unordered_set<std::string> topics;
+  std::vector<std::shared_ptr<rosbag2_storage::SerializedBagMessage const>> batch;
+  batch.reserve(write_batch_size_);
+  size_t bytes = 0;
+  while (generator_->has_next()) {
+    auto const message = generator_->next();
+    if (topics.insert(message->topic()).second) {
+      storage->create_topic({message->topic(), kBlobType, "cdr", ""});
+    }
+    bytes += message->blob()->size();
+    batch.push_back(to_bag_message(*message));
+    if (batch.size() >= write_batch_size_) {
+      storage->write(batch);
+      batch.clear();
+    }
+    throughput_tick();
+  }
+  if (!batch.empty()) {
+    storage->write(batch);
+  }
+
+  profiler_->take_time_for("end writing time");
+
+  // Plugins may finish writing the file when closed, e.g. build indices
+  profiler_->take_time_for("start closing time");
+
+  auto const file_path = storage->get_relative_file_path();
+  storage.reset();
+
+  profiler_->take_time_for("end closing time");
+
+  return {file_path, bytes};
+}
+
+std::pair<size_t, size_t> StorageBenchmark::read(
+  rosbag2_storage::StorageFactory & factory, std::string const & file_path) const
+{
+  profiler_->take_time_for("start reading time");
+
+  Profiler::TickProgress throughput_tick = profiler_->measure_progress(
+    "read_throughput", generator_->total_msg_count());
+
+  auto storage = factory.open_read_only(configuration_.storage_options(file_path));
+  if (!storage) {
+    throw std::runtime_error("Failed to open storage " + configuration_.description);
+  }
+
+  size_t count = 0;
+  size_t bytes = 0;
+  while (storage->has_next()) {
+    bytes += storage->read_next()->serialized_data->buffer_length;
+    ++count;
+    throughput_tick();
+  }
+  storage.reset();
+
+  profiler_->take_time_for("end reading time");
+
+  return {count, bytes};
+}
+
+void StorageBenchmark::write_csv(std::ostream & out_stream, bool with_header) const
+{
+  if (with_header) {
+    out_stream << profiler_->csv_header() << std::endl;
+  }
+  out_stream << profiler_->csv_entry() << std::endl;
+}
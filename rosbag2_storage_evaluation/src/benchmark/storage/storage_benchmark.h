@@ -0,0 +1,78 @@
+/*
+ *  Copyright (c) 2022,  Open Source Robotics Foundation, Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef ROS2_ROSBAG_EVALUATION_STORAGE_BENCHMARK_H
+#define ROS2_ROSBAG_EVALUATION_STORAGE_BENCHMARK_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "benchmark/benchmark.h"
+#include "benchmark/storage/storage_configuration.h"
+#include "generators/message_generator.h"
+#include "profiler/profiler.h"
+
+#include "rosbag2_storage/storage_factory.hpp"
+
+namespace ros2bag
+{
+
+/**
+ * Writes the generated messages into a bag with a storage plugin, in batches as the cache of
+ * the recorder does, and reads them back. Besides the time points of the profiler it reports the
+ * write and read throughput of the message data, and the write amplification, i.e. how many bytes
+ * end up on disk for each byte of message data.
+ */
+class StorageBenchmark : public Benchmark
+{
+public:
+  StorageBenchmark(
+    std::unique_ptr<MessageGenerator> generator,
+    StorageConfiguration const & configuration,
+    std::string const & uri,
+    unsigned int write_batch_size,
+    std::unique_ptr<Profiler> profiler)
+    : generator_(std::move(generator)), configuration_(configuration), uri_(uri),
+      write_batch_size_(write_batch_size), profiler_(std::move(profiler))
+  {}
+
+  ~StorageBenchmark() override = default;
+
+  /// Writes and reads the bag, which is removed afterwards
+  void run() const override;
+
+  void write_csv(std::ostream & out_stream, bool with_header) const override;
+
+private:
+  /// Returns the path of the written file and the size of the message data written
+  std::pair<std::string, size_t> write(rosbag2_storage::StorageFactory & factory) const;
+
+  /// Returns the number of messages and the size of the message data read
+  std::pair<size_t, size_t> read(
+    rosbag2_storage::StorageFactory & factory, std::string const & file_path) const;
+
+  std::unique_ptr<MessageGenerator> generator_;
+  StorageConfiguration const configuration_;
+  std::string const uri_;
+  unsigned int const write_batch_size_;
+  std::unique_ptr<Profiler> profiler_;
+};
+
+}
+
+#endif //ROS2_ROSBAG_EVALUATION_STORAGE_BENCHMARK_H
@@ -0,0 +1,72 @@
+/*
+ *  Copyright (c) 2022,  Open Source Robotics Foundation, Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "benchmark/storage/storage_configuration.h"
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace ros2bag;
+
+rosbag2_storage::StorageOptions StorageConfiguration::storage_options(
+  std::string const & uri) const
+{
+  rosbag2_storage::StorageOptions options;
+  options.uri = uri;
+  options.storage_id = storage_id;
+  options.storage_preset_profile = storage_preset_profile;
+  options.storage_config_uri = storage_config_uri;
+  return options;
+}
+
+StorageConfiguration ros2bag::parse_storage_configuration(std::string const & description)
+{
+  std::vector<std::string> parts;
+  std::string::size_type begin = 0;
+  while (true) {
+    auto const end = description.find(':', begin);
+    parts.push_back(description.substr(begin, end - begin));
+    if (end == std::string::npos) {
+      break;
+    }
+    begin = end + 1;
+  }
+
+  if (parts.size() > 3 || parts[0].empty()) {
+    throw std::invalid_argument(
+      "Invalid storage configuration '" + description +
+      "', expected <storage id>[:<storage preset profile>[:<storage config file>]]");
+  }
+  parts.resize(3);
+
+  return StorageConfiguration{description, parts[0], parts[1], parts[2]};
+}
+
+std::vector<StorageConfiguration> ros2bag::storage_configurations_from_arguments(
+  int argc, char ** argv, std::vector<std::string> const & default_configurations)
+{
+  std::vector<std::string> descriptions(argv + 1, argv + argc);
+  if (descriptions.empty()) {
+    descriptions = default_configurations;
+  }
+
+  std::vector<StorageConfiguration> configurations;
+  for (auto const & description : descriptions) {
+    configurations.push_back(parse_storage_configuration(description));
+  }
+  return configurations;
+}
@@ -0,0 +1,52 @@
+/*
+ *  Copyright (c) 2022,  Open Source Robotics Foundation, Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef ROS2_ROSBAG_EVALUATION_STORAGE_CONFIGURATION_H
+#define ROS2_ROSBAG_EVALUATION_STORAGE_CONFIGURATION_H
+
+#include <string>
+#include <vector>
+
+#include "rosbag2_storage/storage_options.hpp"
+
+namespace ros2bag
+{
+
+/**
+ * A storage plugin together with the options it is benchmarked with.
+ * Written on the command line as <storage id>[:<storage preset profile>[:<storage config file>]],
+ * e.g. "sqlite3", "sqlite3:resilient" or "sqlite3::pragmas.yaml".
+ */
+struct StorageConfiguration
+{
+  std::string description;
+  std::string storage_id;
+  std::string storage_preset_profile;
+  std::string storage_config_uri;
+
+  /// Options to open a bag at uri with this configuration
+  rosbag2_storage::StorageOptions storage_options(std::string const & uri) const;
+};
+
+StorageConfiguration parse_storage_configuration(std::string const & description);
+
+/// Configurations given as command line arguments, or the default ones if there are none
+std::vector<StorageConfiguration> storage_configurations_from_arguments(
+  int argc, char ** argv, std::vector<std::string> const & default_configurations);
+
+}
+
+#endif //ROS2_ROSBAG_EVALUATION_STORAGE_CONFIGURATION_H
@@ -23,9 +23,9 @@ using namespace ros2bag;
 
 MessageGenerator::MessageGenerator(unsigned int loop_count, Specification const & msgs) :
   loop_count_(loop_count)
-  , max_index_(msgs.size())
   , current_loop_(0)
   , current_index_(0)
+  , max_index_(msgs.size())
   , total_msg_count_(loop_count * msgs.size())
 {
   topics_ = std::vector<std::string>(msgs.size());
@@ -33,7 +33,7 @@ MessageGenerator::MessageGenerator(unsigned int loop_count, Specification const
 
   std::string topic;
   unsigned int blob_size;
-  for (int i = 0; i < msgs.size(); ++i) {
+  for (size_t i = 0; i < msgs.size(); ++i) {
     std::tie(topic, blob_size) = msgs[i];
 
     topics_[i] = topic;
@@ -16,8 +16,10 @@
 
 #include "profiler/profiler.h"
 
+#include <algorithm>
 #include <fstream>
 #include <sstream>
+#include <stdexcept>
 
 using namespace ros2bag;
 using namespace std::literals::chrono_literals;
@@ -27,10 +29,29 @@ void Profiler::take_time_for(std::string const & task)
   time_points_.emplace_back(task, std::chrono::system_clock::now());
 }
 
-void Profiler::track_disk_usage()
+std::chrono::system_clock::duration Profiler::time_between(
+  std::string const & first_task, std::string const & second_task) const
+{
+  auto const time_of = [this](std::string const & task) {
+    auto const time_point = std::find_if(time_points_.begin(), time_points_.end(),
+      [&task](auto const & t) {return t.first == task;});
+    if (time_point == time_points_.end()) {
+      throw std::runtime_error("No time taken for " + task);
+    }
+    return time_point->second;
+  };
+  return time_of(second_task) - time_of(first_task);
+}
+
+void Profiler::add_measurement(std::string const & name, double value)
+{
+  measurements_.emplace_back(name, value);
+}
+
+void Profiler::track_disk_usage(std::string const & file_name)
 {
   auto const mode = std::ifstream::binary | std::ifstream::ate;
-  std::ifstream file(file_name_, mode);
+  std::ifstream file(file_name, mode);
   disk_usage_ = file.tellg();
 }
 
@@ -46,6 +67,10 @@ std::string Profiler::csv_header() const
     header << t.first << " (ms),";
   }
 
+  for (auto const & m : measurements_) {
+    header << m.first << ",";
+  }
+
   header << "disk usage (bytes)";
 
   return header.str();
@@ -67,6 +92,10 @@ std::string Profiler::csv_entry() const
     }
   }
 
+  for (auto const & m : measurements_) {
+    entry << m.second << ",";
+  }
+
   entry << disk_usage_;
 
   return entry.str();
@@ -18,8 +18,10 @@
 #define ROS2_ROSBAG_EVALUATION_PROFILER_H
 
 #include <chrono>
-#include <vector>
 #include <functional>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "benchmark/benchmark.h"
 
@@ -29,17 +31,27 @@ namespace ros2bag
 class Profiler
 {
 public:
-  Profiler(
-    std::vector<std::pair<std::string, std::string>> const & meta_data,
-    std::string const & file_name)
-    : meta_data_(meta_data), file_name_(file_name)
+  explicit Profiler(std::vector<std::pair<std::string, std::string>> const & meta_data)
+    : meta_data_(meta_data)
   {}
 
   ~Profiler() = default;
 
   void take_time_for(std::string const & task);
 
-  void track_disk_usage();
+  /// Time between two tasks passed to take_time_for
+  std::chrono::system_clock::duration time_between(
+    std::string const & first_task, std::string const & second_task) const;
+
+  /// Adds a column with a value derived from the measurements
+  void add_measurement(std::string const & name, double value);
+
+  void track_disk_usage(std::string const & file_name);
+
+  long disk_usage() const
+  {
+    return disk_usage_;
+  }
 
   std::string csv_header() const;
 
@@ -54,10 +66,10 @@ public:
   );
 
 private:
-  std::string file_name_;
-  long disk_usage_;
+  long disk_usage_ = 0;
   std::vector<std::pair<std::string, std::string>> meta_data_;
   std::vector<std::pair<std::string, std::chrono::system_clock::time_point>> time_points_;
+  std::vector<std::pair<std::string, double>> measurements_;
 };
 
 }
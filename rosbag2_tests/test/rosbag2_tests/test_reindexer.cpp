@@ -31,6 +31,8 @@
 #include "rcpputils/asserts.hpp"
 #include "rcpputils/filesystem_helper.hpp"
 
+#include "rosbag2_compression/compression_reindexer.hpp"
+
 #include "rosbag2_cpp/readers/sequential_reader.hpp"
 #include "rosbag2_cpp/reindexer.hpp"
 
@@ -89,6 +91,16 @@ TEST_F(ReindexTestFixture, test_multiple_files) {
   // EXPECT_EQ(generated_metadata.duration, target_metadata.duration);
 
   EXPECT_EQ(generated_metadata.message_count, target_metadata.message_count);
+  ASSERT_EQ(generated_metadata.files.size(), generated_metadata.relative_file_paths.size());
+  size_t files_message_count = 0;
+  for (size_t i = 0; i < generated_metadata.files.size(); ++i) {
+    EXPECT_EQ(generated_metadata.files[i].path, generated_metadata.relative_file_paths[i]);
+    files_message_count += generated_metadata.files[i].message_count;
+    EXPECT_EQ(
+      generated_metadata.files[i].topic_message_counts,
+      target_metadata.files[i].topic_message_counts);
+  }
+  EXPECT_EQ(files_message_count, generated_metadata.message_count);
 
   // Reindexer can only reconstruct topics that had messages, so not all topics may exist
   for (const auto & gen_topic : generated_metadata.topics_with_message_count) {
@@ -111,3 +123,81 @@ TEST_F(ReindexTestFixture, test_multiple_files) {
     remove(generated_file);
   }
 }
+
+class CompressedReindexTestFixture : public ReindexTestFixture
+{
+public:
+  rosbag2_storage::BagMetadata reindex(const std::string & bag_name)
+  {
+    auto bag_dir = database_path / bag_name;
+    rosbag2_storage::StorageOptions so = rosbag2_storage::StorageOptions();
+    so.uri = bag_dir.string();
+    so.storage_id = "sqlite3";
+
+    rosbag2_compression::CompressionReindexer reindexer;
+    reindexer.reindex(so);
+
+    auto generated_file = rcpputils::fs::path(bag_dir) / "metadata.yaml";
+    EXPECT_TRUE(generated_file.exists());
+    rosbag2_storage::MetadataIo metadata_io;
+    auto generated_metadata = metadata_io.read_metadata(bag_dir.string());
+    remove(generated_file);
+    return generated_metadata;
+  }
+
+  void expect_topics_and_files_match(
+    const rosbag2_storage::BagMetadata & generated_metadata,
+    const rosbag2_storage::BagMetadata & target_metadata)
+  {
+    // Compressed target bags are version 4, which prefixes file paths with the bag name
+    ASSERT_EQ(
+      generated_metadata.relative_file_paths.size(), target_metadata.relative_file_paths.size());
+    for (size_t i = 0; i < generated_metadata.relative_file_paths.size(); ++i) {
+      EXPECT_EQ(
+        generated_metadata.relative_file_paths[i],
+        rcpputils::fs::path(target_metadata.relative_file_paths[i]).filename().string());
+    }
+    EXPECT_EQ(generated_metadata.message_count, target_metadata.message_count);
+
+    for (const auto & gen_topic : generated_metadata.topics_with_message_count) {
+      EXPECT_TRUE(
+        std::find_if(
+          target_metadata.topics_with_message_count.begin(),
+          target_metadata.topics_with_message_count.end(),
+          [&gen_topic](const rosbag2_storage::TopicInformation & t) {
+            return (t.topic_metadata.name == gen_topic.topic_metadata.name) &&
+            (t.message_count == gen_topic.message_count) &&
+            (t.topic_metadata.type == gen_topic.topic_metadata.type);
+          }
+        ) != target_metadata.topics_with_message_count.end()
+      ) << gen_topic.topic_metadata.name;
+    }
+  }
+};
+
+TEST_F(CompressedReindexTestFixture, test_file_compression) {
+  auto generated_metadata = reindex("file_compression");
+  rosbag2_storage::MetadataIo metadata_io;
+  auto target_metadata = metadata_io.read_metadata((target_dir / "file_compression").string());
+
+  expect_topics_and_files_match(generated_metadata, target_metadata);
+  EXPECT_EQ(generated_metadata.compression_format, "zstd");
+  EXPECT_EQ(generated_metadata.compression_mode, "FILE");
+
+  // The files decompressed for reindexing must be cleaned up
+  for (const auto & relative_path : generated_metadata.relative_file_paths) {
+    auto decompressed_path = rcpputils::fs::remove_extension(
+      database_path / "file_compression" / relative_path);
+    EXPECT_FALSE(decompressed_path.exists()) << decompressed_path.string();
+  }
+}
+
+TEST_F(CompressedReindexTestFixture, test_message_compression) {
+  auto generated_metadata = reindex("message_compression");
+  rosbag2_storage::MetadataIo metadata_io;
+  auto target_metadata = metadata_io.read_metadata((target_dir / "message_compression").string());
+
+  expect_topics_and_files_match(generated_metadata, target_metadata);
+  EXPECT_EQ(generated_metadata.compression_format, "zstd");
+  EXPECT_EQ(generated_metadata.compression_mode, "MESSAGE");
+}
@@ -25,11 +25,15 @@
 #include "rcpputils/filesystem_helper.hpp"
 #include "rcutils/time.h"
 
+#include "rosbag2_cpp/bag_catalog.hpp"
+#include "rosbag2_cpp/info.hpp"
 #include "rosbag2_cpp/reader.hpp"
 #include "rosbag2_cpp/readers/sequential_reader.hpp"
 #include "rosbag2_cpp/writer.hpp"
 #include "rosbag2_cpp/writers/sequential_writer.hpp"
 
+#include "rosbag2_storage/ros_helper.hpp"
+
 #include "test_msgs/msg/basic_types.hpp"
 
 TEST(TestRosbag2CPPAPI, minimal_writer_example)
@@ -129,3 +133,203 @@ TEST(TestRosbag2CPPAPI, minimal_writer_example)
   // remove the rosbag again after the test
   EXPECT_TRUE(rcpputils::fs::remove_all(rosbag_directory));
 }
+
+TEST(TestRosbag2CPPAPI, info_reads_statistics_across_split_files)
+{
+  auto rosbag_directory = rcpputils::fs::path("test_rosbag2_statistics_api_bag");
+  // in case the bag was previously not cleaned up
+  rcpputils::fs::remove_all(rosbag_directory);
+
+  const rcutils_time_point_value_t start = 1000000000;
+  const rcutils_duration_value_t period = 100000000;
+  {
+    rosbag2_storage::StorageOptions storage_options;
+    storage_options.uri = rosbag_directory.string();
+    storage_options.storage_id = "sqlite3";
+    storage_options.max_bagfile_duration = 1;
+
+    rosbag2_cpp::Writer writer;
+    writer.open(storage_options);
+    writer.create_topic({"/a", "test_msgs/msg/BasicTypes", "cdr", ""});
+    writer.create_topic({"/b", "test_msgs/msg/BasicTypes", "cdr", ""});
+
+    const std::vector<uint8_t> data(1000, 0);
+    auto write = [&writer, &data](
+      const std::string & topic, rcutils_time_point_value_t time_stamp, size_t size) {
+        auto message = std::make_shared<rosbag2_storage::SerializedBagMessage>();
+        message->topic_name = topic;
+        message->time_stamp = time_stamp;
+        message->serialized_data = rosbag2_storage::make_serialized_message(data.data(), size);
+        writer.write(message);
+      };
+    // Ten messages every 100 ms, a gap of 2.1 s which also splits the bag, and ten more
+    for (int i = 0; i < 10; ++i) {
+      write("/a", start + i * period, 10);
+      if (i == 5) {
+        write("/b", start + i * period, 1000);
+      }
+    }
+    for (int i = 30; i < 40; ++i) {
+      write("/a", start + i * period, 10);
+    }
+  }
+
+  rosbag2_cpp::Info info;
+  ASSERT_EQ(info.read_metadata(rosbag_directory.string(), "").relative_file_paths.size(), 2u);
+
+  rosbag2_cpp::BagStatisticsOptions options;
+  options.num_threads = 2;
+  const auto statistics = info.read_statistics(rosbag_directory.string(), "", options);
+  EXPECT_EQ(statistics.message_count, 21u);
+  EXPECT_EQ(statistics.total_bytes, 1200u);
+  ASSERT_EQ(statistics.topics.size(), 2u);
+
+  const auto & a = statistics.topics[0];
+  EXPECT_EQ(a.topic_name, "/a");
+  EXPECT_EQ(a.message_count, 20u);
+  EXPECT_EQ(a.total_bytes, 200u);
+  EXPECT_EQ(a.min_message_size, 10u);
+  EXPECT_EQ(a.max_message_size, 10u);
+  EXPECT_EQ(a.message_size_histogram, std::vector<uint64_t>({0, 0, 0, 20}));
+  EXPECT_EQ(a.first_timestamp, start);
+  EXPECT_EQ(a.last_timestamp, start + 39 * period);
+  EXPECT_EQ(a.min_period, period);
+  EXPECT_EQ(a.max_period, 21 * period);
+  // 100 ms fall into the 2^16 us bucket, 2.1 s into the 2^21 us bucket
+  ASSERT_EQ(a.period_histogram.size(), 22u);
+  EXPECT_EQ(a.period_histogram[16], 18u);
+  EXPECT_EQ(a.period_histogram[21], 1u);
+  EXPECT_EQ(a.gap_count, 1u);
+  ASSERT_EQ(a.gaps.size(), 1u);
+  EXPECT_EQ(a.gaps[0].start, start + 9 * period);
+  EXPECT_EQ(a.gaps[0].end, start + 30 * period);
+
+  const auto & b = statistics.topics[1];
+  EXPECT_EQ(b.topic_name, "/b");
+  EXPECT_EQ(b.message_count, 1u);
+  EXPECT_EQ(b.total_bytes, 1000u);
+  EXPECT_EQ(b.message_size_histogram.size(), 10u);
+  EXPECT_TRUE(b.period_histogram.empty());
+  EXPECT_EQ(b.gap_count, 0u);
+
+  // remove the rosbag again after the test
+  EXPECT_TRUE(rcpputils::fs::remove_all(rosbag_directory));
+}
+
+TEST(TestRosbag2CPPAPI, info_finds_gaps_of_short_lived_topics)
+{
+  auto rosbag_directory = rcpputils::fs::path("test_rosbag2_statistics_gaps_api_bag");
+  // in case the bag was previously not cleaned up
+  rcpputils::fs::remove_all(rosbag_directory);
+
+  const rcutils_time_point_value_t start = 1000000000;
+  const rcutils_duration_value_t period = 10000000;
+  {
+    rosbag2_storage::StorageOptions storage_options;
+    storage_options.uri = rosbag_directory.string();
+    storage_options.storage_id = "sqlite3";
+
+    rosbag2_cpp::Writer writer;
+    writer.open(storage_options);
+    writer.create_topic({"/long", "test_msgs/msg/BasicTypes", "cdr", ""});
+    writer.create_topic({"/short", "test_msgs/msg/BasicTypes", "cdr", ""});
+
+    const std::vector<uint8_t> data(10, 0);
+    auto write = [&writer, &data](
+      const std::string & topic, rcutils_time_point_value_t time_stamp) {
+        auto message = std::make_shared<rosbag2_storage::SerializedBagMessage>();
+        message->topic_name = topic;
+        message->time_stamp = time_stamp;
+        message->serialized_data = rosbag2_storage::make_serialized_message(data.data(), 10);
+        writer.write(message);
+      };
+    // /short is published every 10 ms for 300 ms only, with a gap of 100 ms. Over the 10 s of
+    // the bag, its mean period would be about 500 ms, which hides the gap.
+    for (int i = 0; i < 10; ++i) {
+      write("/short", start + i * period);
+    }
+    for (int i = 19; i < 29; ++i) {
+      write("/short", start + i * period);
+    }
+    for (int i = 0; i <= 10; ++i) {
+      write("/long", start + i * 100 * period);
+    }
+  }
+
+  rosbag2_cpp::Info info;
+  const auto statistics = info.read_statistics(rosbag_directory.string(), "", {});
+  ASSERT_EQ(statistics.topics.size(), 2u);
+
+  const auto & long_topic = statistics.topics[0];
+  EXPECT_EQ(long_topic.topic_name, "/long");
+  EXPECT_EQ(long_topic.gap_count, 0u);
+
+  const auto & short_topic = statistics.topics[1];
+  EXPECT_EQ(short_topic.topic_name, "/short");
+  EXPECT_EQ(short_topic.message_count, 20u);
+  EXPECT_EQ(short_topic.gap_count, 1u);
+  ASSERT_EQ(short_topic.gaps.size(), 1u);
+  EXPECT_EQ(short_topic.gaps[0].start, start + 9 * period);
+  EXPECT_EQ(short_topic.gaps[0].end, start + 19 * period);
+
+  // remove the rosbag again after the test
+  EXPECT_TRUE(rcpputils::fs::remove_all(rosbag_directory));
+}
+
+TEST(TestRosbag2CPPAPI, reader_opens_bag_catalog_entry)
+{
+  auto rosbag_directory = rcpputils::fs::path("test_rosbag2_catalog_api_bag");
+  auto catalog_file = rcpputils::fs::path("test_rosbag2_catalog_api.db3");
+  // in case the bag was previously not cleaned up
+  rcpputils::fs::remove_all(rosbag_directory);
+  rcpputils::fs::remove(catalog_file);
+
+  const rcutils_time_point_value_t start = 1000000000;
+  const rcutils_duration_value_t period = 100000000;
+  {
+    rosbag2_storage::StorageOptions storage_options;
+    storage_options.uri = rosbag_directory.string();
+    storage_options.storage_id = "sqlite3";
+
+    rosbag2_cpp::Writer writer;
+    writer.open(storage_options);
+    writer.create_topic({"/a", "test_msgs/msg/BasicTypes", "cdr", ""});
+    writer.create_topic({"/b", "test_msgs/msg/BasicTypes", "cdr", ""});
+    const std::vector<uint8_t> data(10, 0);
+    for (int i = 0; i < 10; ++i) {
+      for (const auto & topic : {"/a", "/b"}) {
+        auto message = std::make_shared<rosbag2_storage::SerializedBagMessage>();
+        message->topic_name = topic;
+        message->time_stamp = start + i * period;
+        message->serialized_data = rosbag2_storage::make_serialized_message(data.data(), 10);
+        writer.write(message);
+      }
+    }
+  }
+
+  rosbag2_cpp::BagCatalog catalog(catalog_file.string());
+  EXPECT_TRUE(catalog.index_bag(rosbag_directory.string()));
+  rosbag2_cpp::BagCatalogQuery query;
+  query.topics = {"/b"};
+  query.start_time = start + 6 * period;
+  const auto entries = catalog.query(query);
+  ASSERT_EQ(entries.size(), 1u);
+
+  // Only /b is read, from the start of the queried range on
+  rosbag2_cpp::Reader reader;
+  reader.open(entries[0]);
+  std::vector<rcutils_time_point_value_t> time_stamps;
+  while (reader.has_next()) {
+    auto message = reader.read_next();
+    EXPECT_EQ(message->topic_name, "/b");
+    time_stamps.push_back(message->time_stamp);
+  }
+  EXPECT_EQ(
+    time_stamps, std::vector<rcutils_time_point_value_t>(
+      {start + 6 * period, start + 7 * period, start + 8 * period, start + 9 * period}));
+  reader.close();
+
+  // remove the rosbag again after the test
+  EXPECT_TRUE(rcpputils::fs::remove_all(rosbag_directory));
+  EXPECT_TRUE(rcpputils::fs::remove(catalog_file));
+}
@@ -36,6 +36,14 @@ namespace rosbag2_transport
 /// Note: If a serialization format is not specified for an output bag's RecordOptions,
 /// any topic going into it will use the serialization format of the last input with that topic.
 ///
+/// Every input bag is read ahead on a thread of its own and every output bag is written on a
+/// thread of its own, the calling thread merges the inputs in timestamp order.
+/// Output bags are written through a cache which blocks instead of dropping messages when full.
+/// Outputs without max_cache_size use a cache of 100 MiB.
+///
+/// If all inputs and outputs are compressed per message with the same compression format and no
+/// output converts the serialization format, compressed messages are copied as they are.
+///
 /// \param input_options vector of settings to create Readers for bags to read messages from
 /// \param output_bags - full "recording" configuration of the bag(s) to write messages to
 ///   Each output bag will be passed messages from every input bag,
@@ -0,0 +1,45 @@
+// Copyright 2022 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROSBAG2_TRANSPORT__CONFIG_OPTIONS_FROM_NODE_PARAMS_HPP_
+#define ROSBAG2_TRANSPORT__CONFIG_OPTIONS_FROM_NODE_PARAMS_HPP_
+
+#include "rclcpp/node.hpp"
+
+#include "rosbag2_storage/storage_options.hpp"
+
+#include "rosbag2_transport/play_options.hpp"
+#include "rosbag2_transport/record_options.hpp"
+#include "rosbag2_transport/visibility_control.hpp"
+
+namespace rosbag2_transport
+{
+/// Declare the "storage.*" parameters on the node and build StorageOptions from their values.
+/// Parameters which are not set keep the defaults of rosbag2_storage::StorageOptions.
+ROSBAG2_TRANSPORT_PUBLIC
+rosbag2_storage::StorageOptions get_storage_options_from_node_params(rclcpp::Node & node);
+
+/// Declare the "play.*" parameters on the node and build PlayOptions from their values.
+/// Parameters which are not set keep the defaults of PlayOptions.
+/// Topic remapping is taken from the node's own remapping rules and is not a parameter.
+ROSBAG2_TRANSPORT_PUBLIC
+PlayOptions get_play_options_from_node_params(rclcpp::Node & node);
+
+/// Declare the "record.*" parameters on the node and build RecordOptions from their values.
+/// Parameters which are not set keep the defaults of RecordOptions.
+ROSBAG2_TRANSPORT_PUBLIC
+RecordOptions get_record_options_from_node_params(rclcpp::Node & node);
+}  // namespace rosbag2_transport
+
+#endif  // ROSBAG2_TRANSPORT__CONFIG_OPTIONS_FROM_NODE_PARAMS_HPP_
@@ -24,6 +24,7 @@
 #include "rclcpp/duration.hpp"
 #include "rclcpp/time.hpp"
 #include "rclcpp/qos.hpp"
+#include "rosbag2_cpp/thread_options.hpp"
 
 namespace rosbag2_transport
 {
@@ -82,6 +83,20 @@ public:
 
   // Disable to publish as loaned message
   bool disable_loan_message = false;
+
+  // Maximum number of published messages that may be waiting for acknowledgement from the
+  // flow control consumers. When positive, message timestamps and rate are ignored and the next
+  // message is published as soon as consumers have acknowledged enough of the previous ones.
+  // Zero disables flow-controlled playback.
+  size_t flow_control_window = 0;
+
+  // Identifiers of the consumers which must acknowledge every message on the "~/ack" topic when
+  // flow control is enabled. If empty, acknowledgements from any consumer are counted together.
+  std::vector<std::string> flow_control_consumers = {};
+
+  // Affinity, priority and nice level of the threads started for playback, by thread class:
+  // "player_loader", and "playback" for the thread calling play() when the player owns it.
+  rosbag2_cpp::ThreadOptionsMap thread_options = {};
 };
 
 }  // namespace rosbag2_transport
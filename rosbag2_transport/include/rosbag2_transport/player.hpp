@@ -22,6 +22,7 @@
 #include <memory>
 #include <queue>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -35,6 +36,7 @@
 #include "rclcpp/qos.hpp"
 
 #include "rosbag2_cpp/clocks/player_clock.hpp"
+#include "rosbag2_interfaces/msg/playback_ack.hpp"
 #include "rosbag2_interfaces/msg/read_split_event.hpp"
 #include "rosbag2_interfaces/srv/get_rate.hpp"
 #include "rosbag2_interfaces/srv/is_paused.hpp"
@@ -77,6 +79,10 @@ public:
   ROSBAG2_TRANSPORT_PUBLIC
   static constexpr callback_handle_t invalid_callback_handle = 0;
 
+  /// \brief Construct the player from "storage.*" and "play.*" node parameters.
+  /// \details Meant to be loaded as a component: playback starts on a background thread right
+  /// away and is stopped when the player is destroyed.
+  /// \throws std::invalid_argument if the "storage.uri" parameter is not set.
   ROSBAG2_TRANSPORT_PUBLIC
   explicit Player(
     const std::string & node_name = "rosbag2_player",
@@ -244,6 +250,7 @@ private:
   std::unordered_map<std::string, std::shared_ptr<PlayerPublisher>> publishers_;
 
 private:
+  void initialize(std::unique_ptr<rosbag2_cpp::Reader> reader);
   rosbag2_storage::SerializedBagMessageSharedPtr peek_next_message_from_queue();
   void load_storage_content();
   bool is_storage_completely_loaded() const;
@@ -270,6 +277,15 @@ private:
 
   void configure_play_until_timestamp();
 
+  void create_flow_control_subscription();
+  void on_playback_ack(const rosbag2_interfaces::msg::PlaybackAck & ack);
+  // Must be called with flow_control_mutex_ held
+  size_t get_number_of_messages_in_flight() const;
+  /// \brief Wait until flow control window has room for one more message.
+  /// \return true if the next message can be published, false if timeout elapsed or playback
+  /// is paused.
+  bool wait_for_flow_control_window(std::chrono::milliseconds timeout);
+
   rosbag2_storage::StorageOptions storage_options_;
   rosbag2_transport::PlayOptions play_options_;
   rcutils_time_point_value_t play_until_timestamp_ = -1;
@@ -283,6 +299,9 @@ private:
   bool skip_message_in_main_play_loop_ RCPPUTILS_TSA_GUARDED_BY(
     skip_message_in_main_play_loop_mutex_) = false;
   std::atomic_bool is_in_playback_{false};
+  // Only used when constructed as a component
+  std::thread playback_thread_;
+  std::atomic_bool stop_playback_{false};
 
   rcutils_time_point_value_t starting_time_;
 
@@ -300,6 +319,13 @@ private:
 
   rclcpp::Publisher<rosbag2_interfaces::msg::ReadSplitEvent>::SharedPtr split_event_pub_;
 
+  // flow control
+  std::mutex flow_control_mutex_;
+  std::condition_variable flow_control_cv_;
+  uint64_t flow_control_published_ = 0;
+  std::unordered_map<std::string, uint64_t> flow_control_acked_;
+  rclcpp::Subscription<rosbag2_interfaces::msg::PlaybackAck>::SharedPtr flow_control_ack_sub_;
+
   // defaults
   std::shared_ptr<KeyboardHandler> keyboard_handler_;
   std::vector<KeyboardHandler::callback_handle_t> keyboard_callbacks_;
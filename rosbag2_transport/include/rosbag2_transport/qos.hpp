@@ -15,6 +15,8 @@
 #ifndef ROSBAG2_TRANSPORT__QOS_HPP_
 #define ROSBAG2_TRANSPORT__QOS_HPP_
 
+#include <chrono>
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -65,6 +67,16 @@ public:
   static Rosbag2QoS adapt_offer_to_recorded_offers(
     const std::string & topic_name,
     const std::vector<Rosbag2QoS> & profiles);
+
+  // Compute the history depth needed to hold messages arriving at rate_hz for budget.
+  /**
+    * The depth never falls below the rosbag2_transport default, so that slow topics keep their
+    * usual depth, and is capped at max_depth.
+    */
+  static size_t history_depth_for_rate(
+    double rate_hz,
+    std::chrono::milliseconds budget,
+    size_t max_depth);
 };
 }  // namespace rosbag2_transport
 
@@ -22,11 +22,24 @@
 
 #include "keyboard_handler/keyboard_handler.hpp"
 #include "rclcpp/rclcpp.hpp"
+#include "rosbag2_cpp/thread_options.hpp"
 #include "rosbag2_storage/yaml.hpp"
 #include "rosbag2_transport/visibility_control.hpp"
 
 namespace rosbag2_transport
 {
+// Limits applied to the messages of one topic before they are written. A message is recorded
+// only if it passes all of them.
+struct TopicThrottleOptions
+{
+  // Maximum average rate in Hz, 0 for no limit
+  double max_rate = 0.0;
+  // Record only every n-th received message, 1 to record all of them
+  uint64_t keep_every_nth = 1;
+  // Minimum time between two recorded messages
+  std::chrono::nanoseconds min_interval{0};
+};
+
 struct RecordOptions
 {
 public:
@@ -34,6 +47,8 @@ public:
   bool is_discovery_disabled = false;
   std::vector<std::string> topics;
   std::string rmw_serialization_format;
+  // Minimum time between two queries of the available topics. Topics are queried when the ROS
+  // graph changes, and otherwise only after many polling intervals.
   std::chrono::milliseconds topic_polling_interval{100};
   std::string regex = "";
   std::string exclude = "";
@@ -48,6 +63,39 @@ public:
   bool ignore_leaf_topics = false;
   bool start_paused = false;
   bool use_sim_time = false;
+  // Don't read the pause/resume key from the terminal. Only honored by the constructors which
+  // create their own keyboard handler.
+  bool disable_keyboard_controls = false;
+  // Callback groups of the subscriptions: "default" uses the node's default mutually exclusive
+  // group for all topics, "per_topic" gives each topic its own mutually exclusive group and
+  // "reentrant" puts all topics into one reentrant group. Only relevant with a multithreaded
+  // executor. Messages of a topic may be written out of order with "reentrant". Callbacks only
+  // run concurrently up to the writer, rosbag2_cpp::Writer::write() still takes one mutex.
+  std::string callback_group_policy = "default";
+  // Topic name to callback group name. Topics with the same group name share one mutually
+  // exclusive group, regardless of callback_group_policy.
+  std::unordered_map<std::string, std::string> topic_callback_groups{};
+  // Threads of the executor spinning the recorder, 0 for the number of CPU cores.
+  // Used by the code which owns the executor, e.g. `ros2 bag record`.
+  size_t num_executor_threads = 1;
+  // Topic name to the limits applied to the messages of that topic while recording
+  std::unordered_map<std::string, TopicThrottleOptions> topic_throttles{};
+  // Topic name to conditions on fields of its messages, e.g. "level >= 2", evaluated on the
+  // serialized message. A message is recorded only if all conditions of its topic hold.
+  std::unordered_map<std::string, std::vector<std::string>> topic_content_filters{};
+  // Period of the rosbag2_interfaces/msg/RecorderStatistics messages published on
+  // "~/statistics", 0 to not publish statistics
+  std::chrono::milliseconds statistics_publish_period{0};
+  // Time span of messages the rmw history of each subscription should be able to hold while the
+  // recorder is busy. The history depth is sized from the observed rate of the topic and the
+  // subscription is replaced when the rate changes materially. 0 keeps the default depth.
+  // Only applies to topics without QoS override and requires topic discovery.
+  std::chrono::milliseconds subscription_history_budget{0};
+  // Upper bound of the history depth sized from subscription_history_budget
+  size_t max_subscription_history_depth = 10000;
+  // Affinity, priority and nice level of the threads started for recording, by thread class:
+  // "cache_consumer", "compression", "discovery" and "event_publisher"
+  rosbag2_cpp::ThreadOptionsMap thread_options{};
 };
 
 }  // namespace rosbag2_transport
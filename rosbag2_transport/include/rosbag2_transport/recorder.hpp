@@ -15,8 +15,12 @@
 #ifndef ROSBAG2_TRANSPORT__RECORDER_HPP_
 #define ROSBAG2_TRANSPORT__RECORDER_HPP_
 
+#include <atomic>
+#include <chrono>
+#include <functional>
 #include <future>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -32,10 +36,12 @@
 
 #include "rosbag2_interfaces/srv/snapshot.hpp"
 
+#include "rosbag2_interfaces/msg/recorder_statistics.hpp"
 #include "rosbag2_interfaces/msg/write_split_event.hpp"
 
 #include "rosbag2_storage/topic_metadata.hpp"
 
+#include "rosbag2_transport/qos.hpp"
 #include "rosbag2_transport/record_options.hpp"
 #include "rosbag2_transport/visibility_control.hpp"
 #include "rosbag2_transport/topic_filter.hpp"
@@ -48,9 +54,14 @@ class Writer;
 namespace rosbag2_transport
 {
 
+class SubscriptionHandover;
+
 class Recorder : public rclcpp::Node
 {
 public:
+  /// \brief Construct the recorder from "storage.*" and "record.*" node parameters.
+  /// \details Meant to be loaded as a component: recording starts right away.
+  /// Without "storage.uri" the bag is named after the current time, as `ros2 bag record` does.
   ROSBAG2_TRANSPORT_PUBLIC
   explicit Recorder(
     const std::string & node_name = "rosbag2_recorder",
@@ -113,10 +124,13 @@ public:
   inline constexpr static const auto kPauseResumeToggleKey = KeyboardHandler::KeyCode::SPACE;
 
 protected:
+  /// Called by record() and once per discovery pass.
   ROSBAG2_TRANSPORT_EXPORT
-  std::unordered_map<std::string, std::string> get_requested_or_available_topics();
+  virtual std::unordered_map<std::string, std::string> get_requested_or_available_topics();
 
 private:
+  void initialize();
+
   void topics_discovery();
 
   std::unordered_map<std::string, std::string>
@@ -127,8 +141,20 @@ private:
 
   void subscribe_topic(const rosbag2_storage::TopicMetadata & topic);
 
+  using MessageCallback = std::function<void (std::shared_ptr<rclcpp::SerializedMessage>)>;
+
+  /// Callback writing the messages of a topic. Holds the throttle and content filter of the
+  /// topic, so that a replacement subscription can reuse them.
+  MessageCallback create_message_callback(
+    const std::string & topic_name, const std::string & topic_type);
+
   std::shared_ptr<rclcpp::GenericSubscription> create_subscription(
-    const std::string & topic_name, const std::string & topic_type, const rclcpp::QoS & qos);
+    const std::string & topic_name, const std::string & topic_type, const rclcpp::QoS & qos,
+    const MessageCallback & callback);
+
+  /// Callback group for the subscription of the topic according to the record options,
+  /// nullptr for the node's default callback group.
+  rclcpp::CallbackGroup::SharedPtr callback_group_for_topic(const std::string & topic_name);
 
   /**
    * Find the QoS profile that should be used for subscribing.
@@ -146,6 +172,39 @@ private:
 
   void warn_if_new_qos_for_subscribed_topic(const std::string & topic_name);
 
+  void publish_statistics();
+
+  /// Replace subscriptions whose history depth doesn't fit the observed rate of their topic.
+  /// The replaced subscription keeps recording until its replacement takes over.
+  /// Transient local topics keep their subscription.
+  void adapt_subscription_depths();
+
+  // Counted in the subscription callbacks, which may run concurrently
+  struct TopicCounters
+  {
+    std::atomic<uint64_t> messages_received{0};
+    std::atomic<uint64_t> bytes_received{0};
+    std::atomic<uint64_t> messages_throttled{0};
+    std::atomic<uint64_t> messages_filtered{0};
+    std::atomic<uint64_t> messages_lost{0};
+    std::atomic<size_t> history_depth{0};
+  };
+
+  std::shared_ptr<TopicCounters> counters_for_topic(const std::string & topic_name);
+
+  // Rate measurement of a topic whose history depth is adapted
+  struct AdaptiveDepthTopic
+  {
+    std::string type;
+    Rosbag2QoS qos;
+    // Passes the messages of the subscriptions of the topic to its message callback
+    std::shared_ptr<SubscriptionHandover> handover;
+    uint64_t messages_received;
+    std::chrono::steady_clock::time_point since;
+    // Subscription which records until the one in subscriptions_ takes over
+    std::shared_ptr<rclcpp::GenericSubscription> replaced_subscription;
+  };
+
   std::unique_ptr<TopicFilter> topic_filter_;
   std::shared_ptr<rosbag2_cpp::Writer> writer_;
   rosbag2_storage::StorageOptions storage_options_;
@@ -153,11 +212,21 @@ private:
   std::atomic<bool> stop_discovery_;
   std::future<void> discovery_future_;
   std::unordered_map<std::string, std::shared_ptr<rclcpp::GenericSubscription>> subscriptions_;
+  // Callback groups by topic name or by group name from record_options_.topic_callback_groups
+  std::unordered_map<std::string, rclcpp::CallbackGroup::SharedPtr> callback_groups_;
   std::unordered_set<std::string> topics_warned_about_incompatibility_;
   std::string serialization_format_;
   std::unordered_map<std::string, rclcpp::QoS> topic_qos_profile_overrides_;
   std::unordered_set<std::string> topic_unknown_types_;
   rclcpp::Service<rosbag2_interfaces::srv::Snapshot>::SharedPtr srv_snapshot_;
+  std::mutex topic_counters_mutex_;
+  std::unordered_map<std::string, std::shared_ptr<TopicCounters>> topic_counters_;
+  rclcpp::Publisher<rosbag2_interfaces::msg::RecorderStatistics>::SharedPtr statistics_pub_;
+  rclcpp::TimerBase::SharedPtr statistics_timer_;
+  // Only accessed by the thread subscribing to topics
+  std::unordered_map<std::string, AdaptiveDepthTopic> adaptive_depth_topics_;
+  // Throttles warnings about lost messages independently of use_sim_time
+  rclcpp::Clock steady_clock_{RCL_STEADY_TIME};
   std::atomic<bool> paused_ = false;
   // Keyboard handler
   std::shared_ptr<KeyboardHandler> keyboard_handler_;
@@ -16,9 +16,10 @@
 #define ROSBAG2_TRANSPORT__TOPIC_FILTER_HPP_
 
 #include <map>
+#include <regex>
 #include <string>
 #include <unordered_map>
-#include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "rosbag2_transport/record_options.hpp"
@@ -50,18 +51,29 @@ public:
   /// - topics list
   /// - exclude regex
   /// - include regex OR "all"
+  /// - remove unpublished and leaf topics, if requested, by querying the ROS graph
+  /// Decisions for the steps which don't depend on the ROS graph are cached per topic.
   std::unordered_map<std::string, std::string> filter_topics(
     const std::map<std::string, std::vector<std::string>> & topic_names_and_types);
 
 private:
   /// Return true if the topic passes all filter criteria
   bool take_topic(const std::string & topic_name, const std::vector<std::string> & topic_types);
+  /// Return true if the topic passes the criteria which don't depend on the ROS graph.
+  /// The result only depends on its arguments, so it is cached per topic.
+  bool take_topic_by_name_and_type(const std::string & topic_name, const std::string & topic_type);
+  /// Cached lookup of the type support, warns once per unknown type
   bool type_is_known(const std::string & topic_name, const std::string & topic_type);
+  bool type_is_resolvable(const std::string & topic_name, const std::string & topic_type) const;
 
   RecordOptions record_options_;
   bool allow_unknown_types_ = false;
-  std::unordered_set<std::string> already_warned_unknown_types_;
   rclcpp::node_interfaces::NodeGraphInterface::SharedPtr node_graph_;
+  std::regex include_regex_;
+  std::regex exclude_regex_;
+  std::unordered_map<std::string, bool> known_types_;
+  // topic name -> (topic type, decision of take_topic_by_name_and_type)
+  std::unordered_map<std::string, std::pair<std::string, bool>> static_decisions_;
 };
 }  // namespace rosbag2_transport
 
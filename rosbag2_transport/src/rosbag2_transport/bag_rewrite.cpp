@@ -14,16 +14,29 @@
 
 #include "rosbag2_transport/bag_rewrite.hpp"
 
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <queue>
 #include <string>
+#include <thread>
+#include <tuple>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
+#include "rosbag2_compression/compression_options.hpp"
+#include "rosbag2_compression/sequential_compression_reader.hpp"
+#include "rosbag2_compression/sequential_compression_writer.hpp"
 #include "rosbag2_cpp/reader.hpp"
+#include "rosbag2_cpp/thread_options.hpp"
 #include "rosbag2_cpp/writer.hpp"
+#include "rosbag2_storage/ros_helper.hpp"
 #include "rosbag2_transport/reader_writer_factory.hpp"
 
 #include "logging.hpp"
@@ -32,60 +45,227 @@
 namespace
 {
 
-/// Find the next chronological message from all opened input bags.
-/// Updates the next_messages queue as necessary.
-/// next_messages is needed because Reader has no "peek" interface, we cannot put a message back.
-/// Returns nullptr when all input bags have been fully read.
-std::shared_ptr<rosbag2_storage::SerializedBagMessage> get_next(
-  const std::vector<std::unique_ptr<rosbag2_cpp::Reader>> & input_bags,
-  std::vector<std::shared_ptr<rosbag2_storage::SerializedBagMessage>> & next_messages)
+/// Bytes of serialized messages each input may read ahead, and each output may lag behind.
+/// A queue always takes at least one message, however large.
+constexpr size_t kMaxQueuedBytes = 32 * 1024 * 1024;
+
+/// Cache size of outputs which don't specify one, the same default as `ros2 bag record`.
+constexpr uint64_t kDefaultMaxCacheSize = 100 * 1024 * 1024;
+
+using MessageSharedPtr = std::shared_ptr<rosbag2_storage::SerializedBagMessage>;
+
+/// Queue between the threads of the rewrite pipeline, bounded by the size of the messages in it.
+/// push blocks while the queue is full, pop blocks while it is empty.
+class MessageQueue
 {
-  // find message with lowest timestamp
-  std::shared_ptr<rosbag2_storage::SerializedBagMessage> earliest_msg = nullptr;
-  size_t earliest_msg_index = -1;
-  for (size_t i = 0; i < next_messages.size(); i++) {
-    // refill queue if bag not empty
-    if (next_messages[i] == nullptr && input_bags[i]->has_next()) {
-      next_messages[i] = input_bags[i]->read_next();
+public:
+  /// \return false if the queue was cancelled, the message is then discarded
+  bool push(MessageSharedPtr message)
+  {
+    const size_t size = message->serialized_data ? message->serialized_data->buffer_length : 0;
+    std::unique_lock<std::mutex> lock(mutex_);
+    not_full_.wait(
+      lock, [&] {
+        return cancelled_ || messages_.empty() || bytes_ + size <= kMaxQueuedBytes;
+      });
+    if (cancelled_) {
+      return false;
     }
+    bytes_ += size;
+    messages_.emplace_back(std::move(message), size);
+    not_empty_.notify_one();
+    return true;
+  }
 
-    auto & msg = next_messages[i];
-    if (msg == nullptr) {
-      continue;
+  /// \return false once the queue is closed and empty, or cancelled
+  bool pop(MessageSharedPtr & message)
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    not_empty_.wait(lock, [this] {return cancelled_ || closed_ || !messages_.empty();});
+    if (cancelled_ || messages_.empty()) {
+      return false;
+    }
+    message = std::move(messages_.front().first);
+    bytes_ -= messages_.front().second;
+    messages_.pop_front();
+    not_full_.notify_one();
+    return true;
+  }
+
+  /// Producer is done, pop returns the remaining messages
+  void close()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_ = true;
+    not_empty_.notify_all();
+  }
+
+  /// Abort, unblock producer and consumer and drop the remaining messages
+  void cancel()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    cancelled_ = true;
+    messages_.clear();
+    not_empty_.notify_all();
+    not_full_.notify_all();
+  }
+
+private:
+  std::mutex mutex_;
+  std::condition_variable not_empty_;
+  std::condition_variable not_full_;
+  std::deque<std::pair<MessageSharedPtr, size_t>> messages_;
+  size_t bytes_ = 0;
+  bool closed_ = false;
+  bool cancelled_ = false;
+};
+
+/// Keeps the first exception thrown by any thread of the pipeline and cancels all queues,
+/// so that every thread winds down and the exception can be rethrown by the caller.
+class PipelineFailure
+{
+public:
+  explicit PipelineFailure(std::vector<MessageQueue *> queues)
+  : queues_(std::move(queues))
+  {}
+
+  void set(std::exception_ptr exception)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!exception_) {
+        exception_ = exception;
+      }
     }
-    if (earliest_msg == nullptr || msg->time_stamp < earliest_msg->time_stamp) {
-      earliest_msg = msg;
-      earliest_msg_index = i;
+    for (auto queue : queues_) {
+      queue->cancel();
     }
   }
 
-  // clear returned message from queue before returning it, so it can be refilled next time
-  if (earliest_msg != nullptr) {
-    next_messages[earliest_msg_index].reset();
+  void rethrow_if_failed()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (exception_) {
+      std::rethrow_exception(exception_);
+    }
+  }
+
+private:
+  std::vector<MessageQueue *> queues_;
+  std::mutex mutex_;
+  std::exception_ptr exception_;
+};
+
+struct InputBag
+{
+  std::unique_ptr<rosbag2_cpp::Reader> reader;
+  MessageQueue queue;
+};
+
+struct OutputBag
+{
+  std::unique_ptr<rosbag2_cpp::Writer> writer;
+  rosbag2_transport::RecordOptions record_options;
+  MessageQueue queue;
+  /// The writer compresses messages in place, so it can't share them with other outputs
+  bool modifies_messages = false;
+};
+
+/// Compression format of the messages of a bag written with options, empty unless the bag
+/// compresses every message on its own.
+std::string message_compression_format(const rosbag2_transport::RecordOptions & options)
+{
+  if (rosbag2_compression::compression_mode_from_string(options.compression_mode) !=
+    rosbag2_compression::CompressionMode::MESSAGE)
+  {
+    return "";
+  }
+  return options.compression_format;
+}
+
+std::string message_compression_format(const rosbag2_storage::BagMetadata & metadata)
+{
+  if (rosbag2_compression::compression_mode_from_string(metadata.compression_mode) !=
+    rosbag2_compression::CompressionMode::MESSAGE)
+  {
+    return "";
+  }
+  return metadata.compression_format;
+}
+
+/// If all inputs and outputs compress messages with the same format and no output converts
+/// the serialization format, copy the compressed messages as they are, instead of
+/// decompressing and compressing every message again.
+/// \return true if messages are passed through compressed
+bool setup_compressed_message_passthrough(
+  const std::vector<std::unique_ptr<InputBag>> & input_bags,
+  const std::vector<std::unique_ptr<OutputBag>> & output_bags)
+{
+  const auto format = message_compression_format(input_bags.front()->reader->get_metadata());
+  if (format.empty()) {
+    return false;
+  }
+  std::vector<rosbag2_compression::SequentialCompressionReader *> readers;
+  std::unordered_set<std::string> input_serialization_formats;
+  for (const auto & input_bag : input_bags) {
+    const auto & metadata = input_bag->reader->get_metadata();
+    auto reader = dynamic_cast<rosbag2_compression::SequentialCompressionReader *>(
+      &input_bag->reader->get_implementation_handle());
+    if (message_compression_format(metadata) != format || reader == nullptr) {
+      return false;
+    }
+    readers.push_back(reader);
+    for (const auto & topic : metadata.topics_with_message_count) {
+      input_serialization_formats.insert(topic.topic_metadata.serialization_format);
+    }
+  }
+  std::vector<rosbag2_compression::SequentialCompressionWriter *> writers;
+  for (const auto & output_bag : output_bags) {
+    const auto & record_options = output_bag->record_options;
+    auto writer = dynamic_cast<rosbag2_compression::SequentialCompressionWriter *>(
+      &output_bag->writer->get_implementation_handle());
+    if (message_compression_format(record_options) != format || writer == nullptr) {
+      return false;
+    }
+    if (!record_options.rmw_serialization_format.empty() &&
+      (input_serialization_formats.size() != 1 ||
+      *input_serialization_formats.begin() != record_options.rmw_serialization_format))
+    {
+      return false;
+    }
+    writers.push_back(writer);
+  }
+
+  for (auto reader : readers) {
+    reader->set_compressed_message_passthrough(true);
+  }
+  for (auto writer : writers) {
+    writer->set_compressed_message_passthrough(true);
   }
-  return earliest_msg;
+  for (const auto & output_bag : output_bags) {
+    output_bag->modifies_messages = false;
+  }
+  return true;
 }
 
 /// Discover what topics are in the inputs, filter out topics that can't be processed,
 /// create_topic on Writers that will receive topics.
-/// Return a map f topic -> vector of which Writers want to receive that topic,
+/// Return a map of topic -> vector of which outputs want to receive that topic,
 /// based on the RecordOptions.
-/// The output vector has bare pointers to the uniquely owned Writers,
-/// so this may not outlive the output_bags Writers.
-std::unordered_map<std::string, std::vector<rosbag2_cpp::Writer *>>
+/// The output vector has bare pointers to the uniquely owned outputs,
+/// so this may not outlive output_bags.
+std::unordered_map<std::string, std::vector<OutputBag *>>
 setup_topic_filtering(
-  const std::vector<std::unique_ptr<rosbag2_cpp::Reader>> & input_bags,
-  const std::vector<
-    std::pair<std::unique_ptr<rosbag2_cpp::Writer>, rosbag2_transport::RecordOptions>
-  > & output_bags)
+  const std::vector<std::unique_ptr<InputBag>> & input_bags,
+  const std::vector<std::unique_ptr<OutputBag>> & output_bags)
 {
-  std::unordered_map<std::string, std::vector<rosbag2_cpp::Writer *>> filtered_outputs;
+  std::unordered_map<std::string, std::vector<OutputBag *>> filtered_outputs;
   std::map<std::string, std::vector<std::string>> input_topics;
   std::unordered_map<std::string, YAML::Node> input_topics_qos_profiles;
   std::unordered_map<std::string, std::string> input_topics_serialization_format;
 
   for (const auto & input_bag : input_bags) {
-    auto bag_topics_and_types = input_bag->get_all_topics_and_types();
+    auto bag_topics_and_types = input_bag->reader->get_all_topics_and_types();
     for (const auto & topic_metadata : bag_topics_and_types) {
       const std::string & topic_name = topic_metadata.name;
       input_topics.try_emplace(topic_name);
@@ -102,7 +282,8 @@ setup_topic_filtering(
     }
   }
 
-  for (const auto & [writer, record_options] : output_bags) {
+  for (const auto & output_bag : output_bags) {
+    const auto & record_options = output_bag->record_options;
     rosbag2_transport::TopicFilter topic_filter{record_options};
     auto filtered_topics_and_types = topic_filter.filter_topics(input_topics);
 
@@ -122,21 +303,110 @@ setup_topic_filtering(
       std::stringstream qos_profiles;
       qos_profiles << input_topics_qos_profiles[topic_name];
       topic_metadata.offered_qos_profiles = qos_profiles.str();
-      writer->create_topic(topic_metadata);
+      output_bag->writer->create_topic(topic_metadata);
 
       filtered_outputs.try_emplace(topic_name);
-      filtered_outputs[topic_name].push_back(writer.get());
+      filtered_outputs[topic_name].push_back(output_bag.get());
     }
   }
 
   return filtered_outputs;
 }
 
+/// Reads one input bag ahead into its queue.
+void read_input(InputBag & input_bag, PipelineFailure & failure)
+{
+  rosbag2_cpp::configure_current_thread(rosbag2_cpp::thread_class::kRewriteReader, {});
+  try {
+    while (input_bag.reader->has_next()) {
+      if (!input_bag.queue.push(input_bag.reader->read_next())) {
+        return;
+      }
+    }
+    input_bag.queue.close();
+  } catch (...) {
+    failure.set(std::current_exception());
+  }
+}
+
+/// Writes the messages queued for one output bag, then closes the bag.
+void write_output(OutputBag & output_bag, PipelineFailure & failure)
+{
+  rosbag2_cpp::configure_current_thread(
+    rosbag2_cpp::thread_class::kRewriteWriter, output_bag.record_options.thread_options);
+  try {
+    MessageSharedPtr message;
+    while (output_bag.queue.pop(message)) {
+      output_bag.writer->write(message);
+    }
+    // Flushing the cache and compressing the last file happen on this thread as well
+    output_bag.writer.reset();
+  } catch (...) {
+    failure.set(std::current_exception());
+  }
+}
+
+/// Each output gets its own message, sharing serialized data where that's safe.
+MessageSharedPtr copy_for_output(
+  const rosbag2_storage::SerializedBagMessage & message, bool copy_serialized_data)
+{
+  auto copy = std::make_shared<rosbag2_storage::SerializedBagMessage>(message);
+  if (copy_serialized_data && message.serialized_data) {
+    copy->serialized_data = rosbag2_storage::make_serialized_message(
+      message.serialized_data->buffer, message.serialized_data->buffer_length);
+  }
+  return copy;
+}
+
+/// Merge the inputs in chronological order and distribute the messages to the outputs.
+/// Runs on the calling thread, while every input is read and every output is written on a
+/// thread of its own.
+void merge_inputs(
+  const std::vector<std::unique_ptr<InputBag>> & input_bags,
+  const std::unordered_map<std::string, std::vector<OutputBag *>> & topic_outputs)
+{
+  // Next message of every input which isn't exhausted, earliest on top.
+  // Ties are broken by input index, so that merging is deterministic.
+  using HeapEntry = std::tuple<rcutils_time_point_value_t, size_t, MessageSharedPtr>;
+  auto later = [](const HeapEntry & a, const HeapEntry & b) {
+      return std::tie(std::get<0>(a), std::get<1>(a)) > std::tie(std::get<0>(b), std::get<1>(b));
+    };
+  std::priority_queue<HeapEntry, std::vector<HeapEntry>, decltype(later)> next_messages(later);
+
+  auto take_next = [&](size_t input_index) {
+      MessageSharedPtr message;
+      if (input_bags[input_index]->queue.pop(message)) {
+        next_messages.emplace(message->time_stamp, input_index, std::move(message));
+      }
+    };
+  for (size_t i = 0; i < input_bags.size(); i++) {
+    take_next(i);
+  }
+
+  while (!next_messages.empty()) {
+    const size_t input_index = std::get<1>(next_messages.top());
+    const MessageSharedPtr message = std::get<2>(next_messages.top());
+    next_messages.pop();
+    take_next(input_index);
+
+    auto topic_writers = topic_outputs.find(message->topic_name);
+    if (topic_writers == topic_outputs.end()) {
+      continue;
+    }
+    const bool shared = topic_writers->second.size() > 1;
+    for (auto output_bag : topic_writers->second) {
+      if (!output_bag->queue.push(
+          copy_for_output(*message, shared && output_bag->modifies_messages)))
+      {
+        return;
+      }
+    }
+  }
+}
+
 void perform_rewrite(
-  const std::vector<std::unique_ptr<rosbag2_cpp::Reader>> & input_bags,
-  const std::vector<
-    std::pair<std::unique_ptr<rosbag2_cpp::Writer>, rosbag2_transport::RecordOptions>
-  > & output_bags
+  const std::vector<std::unique_ptr<InputBag>> & input_bags,
+  const std::vector<std::unique_ptr<OutputBag>> & output_bags
 )
 {
   if (input_bags.empty() || output_bags.empty()) {
@@ -144,19 +414,40 @@ void perform_rewrite(
   }
 
   auto topic_outputs = setup_topic_filtering(input_bags, output_bags);
+  if (setup_compressed_message_passthrough(input_bags, output_bags)) {
+    ROSBAG2_TRANSPORT_LOG_INFO("Copying compressed messages without recompressing them.");
+  }
 
-  std::vector<std::shared_ptr<rosbag2_storage::SerializedBagMessage>> next_messages;
-  next_messages.resize(input_bags.size(), nullptr);
+  std::vector<MessageQueue *> queues;
+  for (const auto & input_bag : input_bags) {
+    queues.push_back(&input_bag->queue);
+  }
+  for (const auto & output_bag : output_bags) {
+    queues.push_back(&output_bag->queue);
+  }
+  PipelineFailure failure(queues);
 
-  std::shared_ptr<rosbag2_storage::SerializedBagMessage> next_msg;
-  while ((next_msg = get_next(input_bags, next_messages))) {
-    auto topic_writers = topic_outputs.find(next_msg->topic_name);
-    if (topic_writers != topic_outputs.end()) {
-      for (auto writer : topic_writers->second) {
-        writer->write(next_msg);
-      }
+  std::vector<std::thread> threads;
+  for (const auto & output_bag : output_bags) {
+    threads.emplace_back(write_output, std::ref(*output_bag), std::ref(failure));
+  }
+  for (const auto & input_bag : input_bags) {
+    threads.emplace_back(read_input, std::ref(*input_bag), std::ref(failure));
+  }
+
+  try {
+    merge_inputs(input_bags, topic_outputs);
+    for (const auto & output_bag : output_bags) {
+      output_bag->queue.close();
     }
+  } catch (...) {
+    failure.set(std::current_exception());
   }
+
+  for (auto & thread : threads) {
+    thread.join();
+  }
+  failure.rethrow_if_failed();
 }
 
 }  // namespace
@@ -170,28 +461,32 @@ void bag_rewrite(
   > & output_options
 )
 {
-  std::vector<std::unique_ptr<rosbag2_cpp::Reader>> input_bags;
-  std::vector<
-    std::pair<std::unique_ptr<rosbag2_cpp::Writer>, rosbag2_transport::RecordOptions>
-  > output_bags;
+  std::vector<std::unique_ptr<InputBag>> input_bags;
+  std::vector<std::unique_ptr<OutputBag>> output_bags;
 
   for (const auto & storage_options : input_options) {
-    auto reader = ReaderWriterFactory::make_reader(storage_options);
-    reader->open(storage_options);
-    input_bags.push_back(std::move(reader));
+    auto input_bag = std::make_unique<InputBag>();
+    input_bag->reader = ReaderWriterFactory::make_reader(storage_options);
+    input_bag->reader->open(storage_options);
+    input_bags.push_back(std::move(input_bag));
   }
 
   for (auto & [storage_options, record_options] : output_options) {
-    // TODO(emersonknapp) - utilize cache to get better performance.
-    // For now, zero cache allows for synchronous writes which are guaranteed to go through.
-    // With cache enabled, the buffer could overflow and drop messages in this fast-write loop.
-    // To enable the cache we will need to implement a mechanism for the writer to take messages
-    // only when it is able to, which will likely require some new APIs.
-    auto zero_cache_storage_options = storage_options;
-    zero_cache_storage_options.max_cache_size = 0u;
-    auto writer = ReaderWriterFactory::make_writer(record_options);
-    writer->open(zero_cache_storage_options);
-    output_bags.push_back(std::make_pair(std::move(writer), record_options));
+    // Writing is only limited by storage, so wait for room in the cache instead of dropping
+    // messages the way a recorder has to.
+    auto rewrite_storage_options = storage_options;
+    if (rewrite_storage_options.max_cache_size == 0u) {
+      rewrite_storage_options.max_cache_size = kDefaultMaxCacheSize;
+    }
+    rewrite_storage_options.block_on_full_cache = true;
+    auto output_bag = std::make_unique<OutputBag>();
+    output_bag->record_options = record_options;
+    output_bag->modifies_messages = !record_options.compression_format.empty() &&
+      rosbag2_compression::compression_mode_from_string(record_options.compression_mode) ==
+      rosbag2_compression::CompressionMode::MESSAGE;
+    output_bag->writer = ReaderWriterFactory::make_writer(record_options);
+    output_bag->writer->open(rewrite_storage_options);
+    output_bags.push_back(std::move(output_bag));
   }
 
   perform_rewrite(input_bags, output_bags);
@@ -0,0 +1,288 @@
+// Copyright 2022 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "rcl_interfaces/msg/parameter_descriptor.hpp"
+#include "rcutils/time.h"
+#include "rmw/rmw.h"
+
+#include "rosbag2_cpp/thread_options.hpp"
+
+#include "rosbag2_transport/config_options_from_node_params.hpp"
+#include "rosbag2_transport/qos.hpp"
+
+namespace
+{
+template<typename T>
+T declare_param(
+  rclcpp::Node & node,
+  const std::string & name,
+  const T & default_value,
+  const std::string & description)
+{
+  rcl_interfaces::msg::ParameterDescriptor descriptor;
+  descriptor.description = description;
+  descriptor.read_only = true;
+  return node.declare_parameter<T>(name, default_value, descriptor);
+}
+
+uint64_t declare_non_negative_param(
+  rclcpp::Node & node,
+  const std::string & name,
+  uint64_t default_value,
+  const std::string & description)
+{
+  auto value = declare_param<int64_t>(
+    node, name, static_cast<int64_t>(default_value), description);
+  if (value < 0) {
+    throw std::invalid_argument("Parameter '" + name + "' must not be negative");
+  }
+  return static_cast<uint64_t>(value);
+}
+
+rclcpp::Duration duration_from_seconds(double seconds)
+{
+  return rclcpp::Duration::from_nanoseconds(
+    static_cast<rcl_duration_value_t>(RCUTILS_S_TO_NS(seconds)));
+}
+
+std::unordered_map<std::string, rclcpp::QoS> qos_profile_overrides_from_file(
+  const std::string & path)
+{
+  std::unordered_map<std::string, rclcpp::QoS> overrides;
+  if (path.empty()) {
+    return overrides;
+  }
+  // yaml-cpp doesn't implement unordered_map
+  auto profiles = YAML::LoadFile(path).as<std::map<std::string, rosbag2_transport::Rosbag2QoS>>();
+  overrides.insert(profiles.begin(), profiles.end());
+  return overrides;
+}
+
+// Entries are TOPIC:GROUP, split at the last colon like `ros2 bag record --topic-callback-groups`
+std::unordered_map<std::string, std::string> topic_callback_groups_from_entries(
+  const std::vector<std::string> & entries)
+{
+  std::unordered_map<std::string, std::string> topic_callback_groups;
+  for (const auto & entry : entries) {
+    const auto separator = entry.rfind(':');
+    if (separator == std::string::npos || separator == 0 || separator == entry.size() - 1) {
+      throw std::invalid_argument(
+              "Invalid topic callback group '" + entry + "', expected TOPIC:GROUP");
+    }
+    topic_callback_groups[entry.substr(0, separator)] = entry.substr(separator + 1);
+  }
+  return topic_callback_groups;
+}
+
+rosbag2_cpp::ThreadOptionsMap thread_options_from_file(const std::string & path)
+{
+  rosbag2_cpp::ThreadOptionsMap thread_options;
+  if (path.empty()) {
+    return thread_options;
+  }
+  auto options = YAML::LoadFile(path).as<std::map<std::string, rosbag2_cpp::ThreadOptions>>();
+  thread_options.insert(options.begin(), options.end());
+  return thread_options;
+}
+}  // namespace
+
+namespace rosbag2_transport
+{
+
+rosbag2_storage::StorageOptions get_storage_options_from_node_params(rclcpp::Node & node)
+{
+  rosbag2_storage::StorageOptions storage_options;
+  storage_options.uri = declare_param<std::string>(
+    node, "storage.uri", storage_options.uri, "Path of the bag to open");
+  storage_options.storage_id = declare_param<std::string>(
+    node, "storage.storage_id", storage_options.storage_id,
+    "Storage implementation of the bag");
+  storage_options.max_bagfile_size = declare_non_negative_param(
+    node, "storage.max_bagfile_size", storage_options.max_bagfile_size,
+    "Maximum size in bytes before the bagfile is split, 0 disables splitting");
+  storage_options.max_bagfile_duration = declare_non_negative_param(
+    node, "storage.max_bagfile_duration", storage_options.max_bagfile_duration,
+    "Maximum duration in seconds before the bagfile is split, 0 disables splitting");
+  storage_options.max_cache_size = declare_non_negative_param(
+    node, "storage.max_cache_size", storage_options.max_cache_size,
+    "Maximum size in bytes of messages held in each buffer of the cache, 0 disables caching");
+  storage_options.storage_preset_profile = declare_param<std::string>(
+    node, "storage.storage_preset_profile", storage_options.storage_preset_profile,
+    "Storage configuration preset");
+  storage_options.storage_config_uri = declare_param<std::string>(
+    node, "storage.storage_config_uri", storage_options.storage_config_uri,
+    "Path to a storage specific configuration file");
+  storage_options.snapshot_mode = declare_param<bool>(
+    node, "storage.snapshot_mode", storage_options.snapshot_mode, "Enable snapshot mode");
+  storage_options.index_header_stamps = declare_param<bool>(
+    node, "storage.index_header_stamps", storage_options.index_header_stamps,
+    "Index the header stamp of messages to allow filtering by header stamp when reading");
+  // Enabled by default for recording, like in ros2 bag record
+  storage_options.rate_overview_bucket_duration = declare_non_negative_param(
+    node, "storage.rate_overview_bucket_duration", 1000,
+    "Duration in milliseconds of the buckets of the rate overview, 0 disables it");
+  return storage_options;
+}
+
+PlayOptions get_play_options_from_node_params(rclcpp::Node & node)
+{
+  PlayOptions play_options;
+  play_options.read_ahead_queue_size = declare_non_negative_param(
+    node, "play.read_ahead_queue_size", play_options.read_ahead_queue_size,
+    "Size of the message queue held in memory");
+  play_options.rate = static_cast<float>(
+    declare_param<double>(node, "play.rate", play_options.rate, "Playback rate"));
+  play_options.topics_to_filter = declare_param<std::vector<std::string>>(
+    node, "play.topics_to_filter", play_options.topics_to_filter,
+    "Topics to replay, all topics if empty");
+  play_options.topic_qos_profile_overrides = qos_profile_overrides_from_file(
+    declare_param<std::string>(
+      node, "play.qos_profile_overrides_path", "",
+      "Path to a yaml file defining overrides of the QoS profile for specific topics"));
+  play_options.loop = declare_param<bool>(
+    node, "play.loop", play_options.loop, "Restart playback at the end of the bag");
+  play_options.clock_publish_frequency = declare_param<double>(
+    node, "play.clock_publish_frequency", play_options.clock_publish_frequency,
+    "Rate in Hz at which to publish /clock, 0 disables publishing");
+  play_options.delay = duration_from_seconds(
+    declare_param<double>(
+      node, "play.delay", 0.0, "Sleep duration in seconds before each playback loop"));
+  play_options.playback_duration = duration_from_seconds(
+    declare_param<double>(
+      node, "play.playback_duration", -1.0,
+      "Playback duration in seconds, negative for an unlimited playback"));
+  play_options.playback_until_timestamp = declare_param<int64_t>(
+    node, "play.playback_until_timestamp", play_options.playback_until_timestamp,
+    "Timestamp in nanoseconds at which playback stops, negative to disable");
+  play_options.start_paused = declare_param<bool>(
+    node, "play.start_paused", play_options.start_paused, "Start the player paused");
+  play_options.start_offset = static_cast<rcutils_time_point_value_t>(
+    RCUTILS_S_TO_NS(
+      declare_param<double>(
+        node, "play.start_offset", 0.0,
+        "Start playback this many seconds into the bag")));
+  play_options.disable_keyboard_controls = declare_param<bool>(
+    node, "play.disable_keyboard_controls", play_options.disable_keyboard_controls,
+    "Disable keyboard controls for playback");
+  play_options.wait_acked_timeout = declare_param<int64_t>(
+    node, "play.wait_acked_timeout", play_options.wait_acked_timeout,
+    "Timeout in milliseconds to wait for published messages to be acknowledged, "
+    "negative to disable");
+  play_options.disable_loan_message = declare_param<bool>(
+    node, "play.disable_loan_message", play_options.disable_loan_message,
+    "Disable publishing as loaned message");
+  play_options.flow_control_window = declare_non_negative_param(
+    node, "play.flow_control_window", play_options.flow_control_window,
+    "Maximum number of unacknowledged messages in flow-controlled playback, 0 disables it");
+  play_options.flow_control_consumers = declare_param<std::vector<std::string>>(
+    node, "play.flow_control_consumers", play_options.flow_control_consumers,
+    "Consumers which must acknowledge every message in flow-controlled playback");
+  play_options.thread_options = thread_options_from_file(
+    declare_param<std::string>(
+      node, "play.thread_options_path", "",
+      "Path to a yaml file defining affinity and priority of the player threads by thread class"));
+  return play_options;
+}
+
+RecordOptions get_record_options_from_node_params(rclcpp::Node & node)
+{
+  RecordOptions record_options;
+  record_options.all = declare_param<bool>(
+    node, "record.all", record_options.all, "Record all topics");
+  record_options.is_discovery_disabled = declare_param<bool>(
+    node, "record.is_discovery_disabled", record_options.is_discovery_disabled,
+    "Only record topics present at startup");
+  record_options.topics = declare_param<std::vector<std::string>>(
+    node, "record.topics", record_options.topics, "Topics to record");
+  record_options.rmw_serialization_format = declare_param<std::string>(
+    node, "record.rmw_serialization_format", rmw_get_serialization_format(),
+    "Serialization format in which messages are saved");
+  record_options.topic_polling_interval = std::chrono::milliseconds(
+    declare_param<int64_t>(
+      node, "record.topic_polling_interval", record_options.topic_polling_interval.count(),
+      "Time in milliseconds between queries for available topics"));
+  record_options.regex = declare_param<std::string>(
+    node, "record.regex", record_options.regex,
+    "Record only topics matching the regular expression");
+  record_options.exclude = declare_param<std::string>(
+    node, "record.exclude", record_options.exclude,
+    "Exclude topics matching the regular expression");
+  record_options.compression_mode = declare_param<std::string>(
+    node, "record.compression_mode", record_options.compression_mode,
+    "Compression mode, FILE or MESSAGE");
+  record_options.compression_format = declare_param<std::string>(
+    node, "record.compression_format", record_options.compression_format,
+    "Compression format, empty for no compression");
+  record_options.compression_queue_size = declare_non_negative_param(
+    node, "record.compression_queue_size", record_options.compression_queue_size,
+    "Number of files or messages that may be queued for compression");
+  record_options.compression_threads = declare_non_negative_param(
+    node, "record.compression_threads", record_options.compression_threads,
+    "Number of compression threads, 0 for the number of CPU cores");
+  record_options.topic_qos_profile_overrides = qos_profile_overrides_from_file(
+    declare_param<std::string>(
+      node, "record.qos_profile_overrides_path", "",
+      "Path to a yaml file defining overrides of the QoS profile for specific topics"));
+  record_options.include_hidden_topics = declare_param<bool>(
+    node, "record.include_hidden_topics", record_options.include_hidden_topics,
+    "Discover and record hidden topics");
+  record_options.include_unpublished_topics = declare_param<bool>(
+    node, "record.include_unpublished_topics", record_options.include_unpublished_topics,
+    "Discover and record topics which have no publisher");
+  record_options.ignore_leaf_topics = declare_param<bool>(
+    node, "record.ignore_leaf_topics", record_options.ignore_leaf_topics,
+    "Ignore topics without a subscription");
+  record_options.start_paused = declare_param<bool>(
+    node, "record.start_paused", record_options.start_paused, "Start the recorder paused");
+  record_options.disable_keyboard_controls = declare_param<bool>(
+    node, "record.disable_keyboard_controls", record_options.disable_keyboard_controls,
+    "Disable keyboard controls for recording");
+  record_options.callback_group_policy = declare_param<std::string>(
+    node, "record.callback_group_policy", record_options.callback_group_policy,
+    "Callback groups of the subscriptions: default, per_topic or reentrant");
+  record_options.topic_callback_groups = topic_callback_groups_from_entries(
+    declare_param<std::vector<std::string>>(
+      node, "record.topic_callback_groups", {},
+      "Topics assigned to named callback groups, as TOPIC:GROUP"));
+  record_options.statistics_publish_period = std::chrono::milliseconds(
+    declare_non_negative_param(
+      node, "record.statistics_publish_period",
+      static_cast<uint64_t>(record_options.statistics_publish_period.count()),
+      "Period in milliseconds of the statistics published on ~/statistics, 0 disables them"));
+  record_options.subscription_history_budget = std::chrono::milliseconds(
+    declare_non_negative_param(
+      node, "record.subscription_history_budget",
+      static_cast<uint64_t>(record_options.subscription_history_budget.count()),
+      "Time span in milliseconds of messages the history of each subscription should hold, "
+      "0 keeps the default history depth"));
+  record_options.max_subscription_history_depth = declare_non_negative_param(
+    node, "record.max_subscription_history_depth", record_options.max_subscription_history_depth,
+    "Upper bound of the history depth sized from record.subscription_history_budget");
+  record_options.thread_options = thread_options_from_file(
+    declare_param<std::string>(
+      node, "record.thread_options_path", "",
+      "Path to a yaml file defining affinity and priority of the recorder threads by thread class"));
+  // use_sim_time is declared by every node
+  record_options.use_sim_time = node.get_parameter("use_sim_time").as_bool();
+  return record_options;
+}
+
+}  // namespace rosbag2_transport
@@ -0,0 +1,177 @@
+// Copyright 2022 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "content_filter.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace rosbag2_transport
+{
+
+namespace
+{
+std::string trim(const std::string & text)
+{
+  const auto begin = text.find_first_not_of(" \t");
+  if (begin == std::string::npos) {
+    return "";
+  }
+  return text.substr(begin, text.find_last_not_of(" \t") - begin + 1);
+}
+
+std::vector<ContentFilter::Predicate> parse_all(const std::vector<std::string> & predicates)
+{
+  std::vector<ContentFilter::Predicate> parsed;
+  parsed.reserve(predicates.size());
+  for (const auto & predicate : predicates) {
+    parsed.push_back(ContentFilter::parse(predicate));
+  }
+  return parsed;
+}
+
+// Fields compared by several predicates, e.g. both bounds of a range, are extracted once
+std::vector<std::string> unique_field_paths(
+  const std::vector<ContentFilter::Predicate> & predicates)
+{
+  std::vector<std::string> paths;
+  for (const auto & predicate : predicates) {
+    if (std::find(paths.begin(), paths.end(), predicate.field_path) == paths.end()) {
+      paths.push_back(predicate.field_path);
+    }
+  }
+  return paths;
+}
+}  // namespace
+
+ContentFilter::Predicate ContentFilter::parse(const std::string & predicate)
+{
+  const auto invalid = [&predicate](const std::string & reason) {
+      return std::runtime_error(
+        "Invalid content filter '" + predicate + "': " + reason +
+        ", expected FIELD OP VALUE with OP one of ==, !=, <, <=, >, >=");
+    };
+
+  const auto op_begin = predicate.find_first_of("<>=!");
+  if (op_begin == std::string::npos) {
+    throw invalid("no comparison");
+  }
+  auto op_end = op_begin + 1;
+  if (op_end < predicate.size() && predicate[op_end] == '=') {
+    ++op_end;
+  }
+  const auto op = predicate.substr(op_begin, op_end - op_begin);
+
+  Predicate parsed;
+  if (op == "==") {
+    parsed.comparison = Comparison::EQUAL;
+  } else if (op == "!=") {
+    parsed.comparison = Comparison::NOT_EQUAL;
+  } else if (op == "<") {
+    parsed.comparison = Comparison::LESS;
+  } else if (op == "<=") {
+    parsed.comparison = Comparison::LESS_EQUAL;
+  } else if (op == ">") {
+    parsed.comparison = Comparison::GREATER;
+  } else if (op == ">=") {
+    parsed.comparison = Comparison::GREATER_EQUAL;
+  } else {
+    throw invalid("unknown comparison '" + op + "'");
+  }
+
+  parsed.field_path = trim(predicate.substr(0, op_begin));
+  if (parsed.field_path.empty()) {
+    throw invalid("no field");
+  }
+
+  const auto value = trim(predicate.substr(op_end));
+  if (value == "true") {
+    parsed.value = 1.0;
+  } else if (value == "false") {
+    parsed.value = 0.0;
+  } else {
+    size_t parsed_length = 0;
+    try {
+      parsed.value = std::stod(value, &parsed_length);
+    } catch (const std::logic_error &) {
+      throw invalid("value is not a number");
+    }
+    if (parsed_length != value.size()) {
+      throw invalid("value is not a number");
+    }
+  }
+  return parsed;
+}
+
+ContentFilter::ContentFilter(
+  const std::string & topic_type, const std::vector<std::string> & predicates)
+: predicates_(parse_all(predicates)),
+  projection_(topic_type, unique_field_paths(predicates_))
+{
+  // A path naming a message or an array expands to several columns, none of which is the path
+  const auto & names = projection_.names();
+  columns_.reserve(predicates_.size());
+  for (const auto & predicate : predicates_) {
+    const auto column = std::find(names.begin(), names.end(), predicate.field_path);
+    if (column == names.end()) {
+      throw std::runtime_error(
+              "Content filter field '" + predicate.field_path + "' of " + topic_type +
+              " is not a single numeric or boolean field");
+    }
+    columns_.push_back(static_cast<size_t>(column - names.begin()));
+  }
+}
+
+bool ContentFilter::accept(const rcutils_uint8_array_t & serialized_message) const
+{
+  // Reused by all filters running on this thread, so evaluating doesn't allocate
+  thread_local std::vector<double> values;
+  values.resize(projection_.size());
+  if (!projection_.extract(serialized_message, values.data())) {
+    return true;
+  }
+  for (size_t i = 0; i < predicates_.size(); ++i) {
+    const double field = values[columns_[i]];
+    const double value = predicates_[i].value;
+    bool holds = false;
+    switch (predicates_[i].comparison) {
+      case Comparison::EQUAL:
+        holds = field == value;
+        break;
+      case Comparison::NOT_EQUAL:
+        holds = field != value;
+        break;
+      case Comparison::LESS:
+        holds = field < value;
+        break;
+      case Comparison::LESS_EQUAL:
+        holds = field <= value;
+        break;
+      case Comparison::GREATER:
+        holds = field > value;
+        break;
+      case Comparison::GREATER_EQUAL:
+        holds = field >= value;
+        break;
+    }
+    if (!holds) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace rosbag2_transport
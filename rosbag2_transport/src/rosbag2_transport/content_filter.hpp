@@ -0,0 +1,79 @@
+// Copyright 2022 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROSBAG2_TRANSPORT__CONTENT_FILTER_HPP_
+#define ROSBAG2_TRANSPORT__CONTENT_FILTER_HPP_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "rcutils/types/uint8_array.h"
+
+#include "rosbag2_cpp/field_projection.hpp"
+
+namespace rosbag2_transport
+{
+
+/// Decides which messages of a single topic get recorded by comparing fields of the serialized
+/// message with constants, e.g. "level >= 2" or "twist.linear.x > 0.5".
+/// The predicates are compiled once for the message type and evaluated on the CDR buffer, without
+/// deserializing or copying the message. Elements past the end of a sequence compare as NaN, so
+/// they only satisfy "!=". Thread safe, accept() doesn't modify the filter.
+class ContentFilter
+{
+public:
+  enum class Comparison
+  {
+    EQUAL,
+    NOT_EQUAL,
+    LESS,
+    LESS_EQUAL,
+    GREATER,
+    GREATER_EQUAL
+  };
+
+  struct Predicate
+  {
+    std::string field_path;
+    Comparison comparison;
+    double value;
+  };
+
+  /// Parse a predicate of the form "FIELD OP VALUE", where OP is one of ==, !=, <, <=, > or >=
+  /// and VALUE is a number, true or false.
+  /// \throws std::runtime_error if the predicate can't be parsed
+  static Predicate parse(const std::string & predicate);
+
+  /// \param topic_type Full type name of the messages, e.g. diagnostic_msgs/msg/DiagnosticStatus
+  /// \param predicates Conditions which must all hold for a message to be recorded
+  /// \throws std::runtime_error if a predicate can't be parsed, or its field is not a single
+  ///   numeric or boolean field of the type
+  ContentFilter(const std::string & topic_type, const std::vector<std::string> & predicates);
+
+  /// \param serialized_message CDR serialized message, including the encapsulation header
+  /// \return true if all predicates hold, or if the message can't be read as plain CDR of the
+  ///   type, so that such messages are never lost silently
+  bool accept(const rcutils_uint8_array_t & serialized_message) const;
+
+private:
+  std::vector<Predicate> predicates_;
+  rosbag2_cpp::FieldProjection projection_;
+  // Column of the projection holding the field of each predicate
+  std::vector<size_t> columns_;
+};
+
+}  // namespace rosbag2_transport
+
+#endif  // ROSBAG2_TRANSPORT__CONTENT_FILTER_HPP_
@@ -18,6 +18,7 @@
 #include <chrono>
 #include <memory>
 #include <queue>
+#include <stdexcept>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -31,11 +32,14 @@
 
 #include "rosbag2_cpp/clocks/time_controller_clock.hpp"
 #include "rosbag2_cpp/reader.hpp"
+#include "rosbag2_cpp/thread_options.hpp"
 #include "rosbag2_cpp/typesupport_helpers.hpp"
 
 #include "rosbag2_storage/storage_filter.hpp"
 
+#include "rosbag2_transport/config_options_from_node_params.hpp"
 #include "rosbag2_transport/qos.hpp"
+#include "rosbag2_transport/reader_writer_factory.hpp"
 
 namespace
 {
@@ -90,12 +94,24 @@ namespace rosbag2_transport
 constexpr Player::callback_handle_t Player::invalid_callback_handle;
 
 Player::Player(const std::string & node_name, const rclcpp::NodeOptions & node_options)
-: rclcpp::Node(node_name, node_options)
-{
-  // TODO(karsten1987): Use this constructor later with parameter parsing.
-  // The reader, storage_options as well as play_options can be loaded via parameter.
-  // That way, the player can be used as a simple component in a component manager.
-  throw rclcpp::exceptions::UnimplementedError();
+: rclcpp::Node(node_name, node_options),
+  storage_options_(get_storage_options_from_node_params(*this)),
+  play_options_(get_play_options_from_node_params(*this))
+{
+  if (storage_options_.uri.empty()) {
+    throw std::invalid_argument("Parameter 'storage.uri' must be set to the bag to play.");
+  }
+  if (!play_options_.disable_keyboard_controls) {
+    keyboard_handler_ = std::make_shared<KeyboardHandler>();
+  }
+  initialize(ReaderWriterFactory::make_reader(storage_options_));
+  // play() blocks, don't stall the component container loading this node
+  playback_thread_ = std::thread(
+    [this]() {
+      rosbag2_cpp::configure_current_thread(
+        rosbag2_cpp::thread_class::kPlayback, play_options_.thread_options);
+      play();
+    });
 }
 
 Player::Player(
@@ -134,6 +150,11 @@ Player::Player(
   storage_options_(storage_options),
   play_options_(play_options),
   keyboard_handler_(keyboard_handler)
+{
+  initialize(std::move(reader));
+}
+
+void Player::initialize(std::unique_ptr<rosbag2_cpp::Reader> reader)
 {
   {
     std::lock_guard<std::mutex> lk(reader_mutex_);
@@ -163,11 +184,19 @@ Player::Player(
     configure_play_until_timestamp();
   }
   create_control_services();
+  create_flow_control_subscription();
   add_keyboard_callbacks();
 }
 
 Player::~Player()
 {
+  if (playback_thread_.joinable()) {
+    stop_playback_ = true;
+    if (is_paused()) {
+      resume();
+    }
+    playback_thread_.join();
+  }
   // remove callbacks on key_codes to prevent race conditions
   // Note: keyboard_handler handles locks between removing & executing callbacks
   for (auto cb_handle : keyboard_callbacks_) {
@@ -236,7 +265,7 @@ bool Player::play()
         is_ready_to_play_from_queue_ = false;
         ready_to_play_from_queue_cv_.notify_all();
       }
-    } while (rclcpp::ok() && play_options_.loop);
+    } while (rclcpp::ok() && !stop_playback_ && play_options_.loop);
   } catch (std::runtime_error & e) {
     RCLCPP_ERROR(get_logger(), "Failed to play: %s", e.what());
     load_storage_content_ = false;
@@ -285,6 +314,7 @@ void Player::pause()
 void Player::resume()
 {
   clock_->resume();
+  flow_control_cv_.notify_all();
   RCLCPP_INFO_STREAM(get_logger(), "Resuming play.");
 }
 
@@ -487,6 +517,8 @@ void Player::wait_for_filled_queue() const
 
 void Player::load_storage_content()
 {
+  rosbag2_cpp::configure_current_thread(
+    rosbag2_cpp::thread_class::kPlayerLoader, play_options_.thread_options);
   auto queue_lower_boundary =
     static_cast<size_t>(play_options_.read_ahead_queue_size * read_ahead_lower_bound_percentage_);
   auto queue_upper_boundary = play_options_.read_ahead_queue_size;
@@ -529,17 +561,29 @@ void Player::play_messages_from_queue()
     is_ready_to_play_from_queue_ = true;
     ready_to_play_from_queue_cv_.notify_all();
   }
-  while (message_ptr != nullptr && rclcpp::ok()) {
+  while (message_ptr != nullptr && rclcpp::ok() && !stop_playback_) {
     if (play_until_timestamp_ >= starting_time_ &&
       message_ptr->time_stamp > play_until_timestamp_)
     {
       break;
     }
-    // Do not move on until sleep_until returns true
-    // It will always sleep, so this is not a tight busy loop on pause
-    while (rclcpp::ok() && !clock_->sleep_until(message_ptr->time_stamp)) {
-      if (std::atomic_exchange(&cancel_wait_for_next_message_, false)) {
-        break;
+    if (play_options_.flow_control_window > 0) {
+      // Timing is driven by consumers: wait for room in the window instead of the clock
+      while (rclcpp::ok() && !stop_playback_ &&
+        !wait_for_flow_control_window(queue_read_wait_period_))
+      {
+        if (std::atomic_exchange(&cancel_wait_for_next_message_, false)) {
+          break;
+        }
+      }
+      clock_->jump(message_ptr->time_stamp);
+    } else {
+      // Do not move on until sleep_until returns true
+      // It will always sleep, so this is not a tight busy loop on pause
+      while (rclcpp::ok() && !stop_playback_ && !clock_->sleep_until(message_ptr->time_stamp)) {
+        if (std::atomic_exchange(&cancel_wait_for_next_message_, false)) {
+          break;
+        }
       }
     }
     std::lock_guard<std::mutex> lk(skip_message_in_main_play_loop_mutex_);
@@ -557,7 +601,7 @@ void Player::play_messages_from_queue()
   }
   // while we're in pause state, make sure we don't return
   // if we happen to be at the end of queue
-  while (is_paused() && rclcpp::ok()) {
+  while (is_paused() && rclcpp::ok() && !stop_playback_) {
     clock_->sleep_until(clock_->now());
   }
 }
@@ -665,10 +709,19 @@ bool Player::publish_message(rosbag2_storage::SerializedBagMessageSharedPtr mess
       }
     }
 
+    if (play_options_.flow_control_window > 0) {
+      // Count the message before publishing, since acknowledgement may arrive before return
+      std::lock_guard<std::mutex> lk(flow_control_mutex_);
+      flow_control_published_++;
+    }
     try {
       publisher_iter->second->publish(rclcpp::SerializedMessage(*message->serialized_data));
       message_published = true;
     } catch (const std::exception & e) {
+      if (play_options_.flow_control_window > 0) {
+        std::lock_guard<std::mutex> lk(flow_control_mutex_);
+        flow_control_published_--;
+      }
       RCLCPP_ERROR_STREAM(
         get_logger(), "Failed to publish message on '" << message->topic_name <<
           "' topic. \nError: %s" << e.what());
@@ -828,6 +881,71 @@ void Player::create_control_services()
     });
 }
 
+void Player::create_flow_control_subscription()
+{
+  if (play_options_.flow_control_window == 0) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lk(flow_control_mutex_);
+    for (const auto & consumer : play_options_.flow_control_consumers) {
+      flow_control_acked_.emplace(consumer, 0);
+    }
+    if (flow_control_acked_.empty()) {
+      // Anonymous consumers share a single counter
+      flow_control_acked_.emplace("", 0);
+    }
+  }
+  flow_control_ack_sub_ = create_subscription<rosbag2_interfaces::msg::PlaybackAck>(
+    "~/ack",
+    rclcpp::QoS(rclcpp::KeepAll()).reliable(),
+    [this](rosbag2_interfaces::msg::PlaybackAck::ConstSharedPtr ack) {
+      on_playback_ack(*ack);
+    });
+  RCLCPP_INFO_STREAM(
+    get_logger(),
+    "Flow-controlled playback enabled with window of " << play_options_.flow_control_window <<
+      " messages. Waiting for acknowledgements on " << flow_control_ack_sub_->get_topic_name());
+}
+
+void Player::on_playback_ack(const rosbag2_interfaces::msg::PlaybackAck & ack)
+{
+  {
+    std::lock_guard<std::mutex> lk(flow_control_mutex_);
+    const std::string consumer_id =
+      play_options_.flow_control_consumers.empty() ? "" : ack.consumer_id;
+    auto acked_it = flow_control_acked_.find(consumer_id);
+    if (acked_it == flow_control_acked_.end()) {
+      RCLCPP_WARN_STREAM_THROTTLE(
+        get_logger(), *get_clock(), 1000,
+        "Ignoring acknowledgement from unknown consumer '" << ack.consumer_id << "'");
+      return;
+    }
+    acked_it->second += ack.num_messages;
+  }
+  flow_control_cv_.notify_all();
+}
+
+size_t Player::get_number_of_messages_in_flight() const
+{
+  uint64_t slowest_acked = flow_control_published_;
+  for (const auto & consumer_acked : flow_control_acked_) {
+    slowest_acked = std::min(slowest_acked, consumer_acked.second);
+  }
+  // Consumers acknowledging more than was published are treated as fully caught up
+  return static_cast<size_t>(flow_control_published_ - slowest_acked);
+}
+
+bool Player::wait_for_flow_control_window(std::chrono::milliseconds timeout)
+{
+  std::unique_lock<std::mutex> lk(flow_control_mutex_);
+  return flow_control_cv_.wait_for(
+    lk, timeout, [this]() {
+      return !clock_->is_paused() &&
+      get_number_of_messages_in_flight() < play_options_.flow_control_window;
+    });
+}
+
 void Player::configure_play_until_timestamp()
 {
   if (play_options_.playback_duration >= rclcpp::Duration(0, 0) ||
@@ -842,3 +960,10 @@ void Player::configure_play_until_timestamp()
 }
 
 }  // namespace rosbag2_transport
+
+#include "rclcpp_components/register_node_macro.hpp"
+
+// Register the component with class_loader.
+// This acts as a sort of entry point, allowing the component to be discoverable when its library
+// is being loaded into a running process.
+RCLCPP_COMPONENTS_REGISTER_NODE(rosbag2_transport::Player)
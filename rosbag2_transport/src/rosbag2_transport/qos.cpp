@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <cmath>
 #include <string>
 #include <vector>
 
@@ -224,4 +226,18 @@ Rosbag2QoS Rosbag2QoS::adapt_offer_to_recorded_offers(
       "Falling back to the rosbag2_transport default publisher offer.");
   return Rosbag2QoS{};
 }
+
+size_t Rosbag2QoS::history_depth_for_rate(
+  double rate_hz, std::chrono::milliseconds budget, size_t max_depth)
+{
+  const size_t default_depth = rmw_qos_profile_default.depth;
+  const double needed = std::ceil(rate_hz * std::chrono::duration<double>(budget).count());
+  if (!(needed > static_cast<double>(default_depth))) {
+    return std::min(default_depth, max_depth);
+  }
+  if (needed >= static_cast<double>(max_depth)) {
+    return max_depth;
+  }
+  return static_cast<size_t>(needed);
+}
 }  // namespace rosbag2_transport
@@ -64,6 +64,7 @@ std::unique_ptr<rosbag2_cpp::Writer> ReaderWriterFactory::make_writer(
     writer_impl = std::make_unique<rosbag2_cpp::writers::SequentialWriter>();
   }
 
+  writer_impl->set_thread_options(record_options.thread_options);
   return std::make_unique<rosbag2_cpp::Writer>(std::move(writer_impl));
 }
 
@@ -38,6 +38,29 @@ struct convert<std::chrono::milliseconds>
   }
 };
 
+template<>
+struct convert<rosbag2_transport::TopicThrottleOptions>
+{
+  static Node encode(const rosbag2_transport::TopicThrottleOptions & throttle)
+  {
+    Node node;
+    node["max_rate"] = throttle.max_rate;
+    node["keep_every_nth"] = throttle.keep_every_nth;
+    node["min_interval"] = throttle.min_interval.count();
+    return node;
+  }
+
+  static bool decode(const Node & node, rosbag2_transport::TopicThrottleOptions & throttle)
+  {
+    optional_assign<double>(node, "max_rate", throttle.max_rate);
+    optional_assign<uint64_t>(node, "keep_every_nth", throttle.keep_every_nth);
+    int64_t min_interval = throttle.min_interval.count();
+    optional_assign<int64_t>(node, "min_interval", min_interval);
+    throttle.min_interval = std::chrono::nanoseconds{min_interval};
+    return true;
+  }
+};
+
 Node convert<rosbag2_transport::RecordOptions>::encode(
   const rosbag2_transport::RecordOptions & record_options)
 {
@@ -60,6 +83,19 @@ Node convert<rosbag2_transport::RecordOptions>::encode(
   node["topic_qos_profile_overrides"] = qos_overrides;
   node["include_hidden_topics"] = record_options.include_hidden_topics;
   node["include_unpublished_topics"] = record_options.include_unpublished_topics;
+  node["callback_group_policy"] = record_options.callback_group_policy;
+  node["topic_callback_groups"] = std::map<std::string, std::string>(
+    record_options.topic_callback_groups.begin(), record_options.topic_callback_groups.end());
+  node["num_executor_threads"] = record_options.num_executor_threads;
+  node["topic_throttles"] = std::map<std::string, rosbag2_transport::TopicThrottleOptions>(
+    record_options.topic_throttles.begin(), record_options.topic_throttles.end());
+  node["topic_content_filters"] = std::map<std::string, std::vector<std::string>>(
+    record_options.topic_content_filters.begin(), record_options.topic_content_filters.end());
+  node["statistics_publish_period"] = record_options.statistics_publish_period;
+  node["subscription_history_budget"] = record_options.subscription_history_budget;
+  node["max_subscription_history_depth"] = record_options.max_subscription_history_depth;
+  node["thread_options"] = std::map<std::string, rosbag2_cpp::ThreadOptions>(
+    record_options.thread_options.begin(), record_options.thread_options.end());
   return node;
 }
 
@@ -91,6 +127,33 @@ bool convert<rosbag2_transport::RecordOptions>::decode(
   optional_assign<bool>(
     node, "include_unpublished_topics",
     record_options.include_unpublished_topics);
+  optional_assign<std::string>(
+    node, "callback_group_policy", record_options.callback_group_policy);
+  std::map<std::string, std::string> topic_callback_groups;
+  optional_assign<std::map<std::string, std::string>>(
+    node, "topic_callback_groups", topic_callback_groups);
+  record_options.topic_callback_groups.insert(
+    topic_callback_groups.begin(), topic_callback_groups.end());
+  optional_assign<size_t>(node, "num_executor_threads", record_options.num_executor_threads);
+  std::map<std::string, rosbag2_transport::TopicThrottleOptions> topic_throttles;
+  optional_assign<std::map<std::string, rosbag2_transport::TopicThrottleOptions>>(
+    node, "topic_throttles", topic_throttles);
+  record_options.topic_throttles.insert(topic_throttles.begin(), topic_throttles.end());
+  std::map<std::string, std::vector<std::string>> topic_content_filters;
+  optional_assign<std::map<std::string, std::vector<std::string>>>(
+    node, "topic_content_filters", topic_content_filters);
+  record_options.topic_content_filters.insert(
+    topic_content_filters.begin(), topic_content_filters.end());
+  optional_assign<std::chrono::milliseconds>(
+    node, "statistics_publish_period", record_options.statistics_publish_period);
+  optional_assign<std::chrono::milliseconds>(
+    node, "subscription_history_budget", record_options.subscription_history_budget);
+  optional_assign<size_t>(
+    node, "max_subscription_history_depth", record_options.max_subscription_history_depth);
+  std::map<std::string, rosbag2_cpp::ThreadOptions> thread_options;
+  optional_assign<std::map<std::string, rosbag2_cpp::ThreadOptions>>(
+    node, "thread_options", thread_options);
+  record_options.thread_options.insert(thread_options.begin(), thread_options.end());
   return true;
 }
 
@@ -15,40 +15,91 @@
 #include "rosbag2_transport/recorder.hpp"
 
 #include <algorithm>
+#include <ctime>
 #include <future>
+#include <iomanip>
 #include <memory>
 #include <regex>
+#include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "rclcpp/logging.hpp"
 #include "rclcpp/clock.hpp"
+#include "rclcpp/exceptions.hpp"
 
 #include "rosbag2_cpp/bag_events.hpp"
+#include "rosbag2_cpp/thread_options.hpp"
 #include "rosbag2_cpp/writer.hpp"
 
 #include "rosbag2_interfaces/srv/snapshot.hpp"
 
 #include "rosbag2_storage/yaml.hpp"
+#include "rosbag2_transport/config_options_from_node_params.hpp"
 #include "rosbag2_transport/qos.hpp"
+#include "rosbag2_transport/reader_writer_factory.hpp"
 
 #include "rosbag2_transport/topic_filter.hpp"
 
+#include "content_filter.hpp"
+#include "subscription_handover.hpp"
+#include "topic_throttle.hpp"
+
+namespace
+{
+// Minimum time over which the rate of a topic is measured to adapt its history depth
+constexpr std::chrono::seconds kRateMeasurementWindow{1};
+// Headroom of an adapted history depth over the one needed at the measured rate
+constexpr double kHistoryDepthHeadroom = 1.5;
+// Polling intervals after which topics are queried again although the graph didn't change, in
+// case a graph event was missed
+constexpr int kIdleGraphPollingIntervals = 50;
+
+std::string default_bag_name()
+{
+  std::time_t now = std::time(nullptr);
+  tm time;
+#ifdef _WIN32
+  localtime_s(&time, &now);
+#else
+  localtime_r(&now, &time);
+#endif
+  std::stringstream bag_name;
+  bag_name << std::put_time(&time, "rosbag2_%Y_%m_%d-%H_%M_%S");
+  return bag_name.str();
+}
+}  // namespace
+
 namespace rosbag2_transport
 {
 
 Recorder::Recorder(
   const std::string & node_name,
   const rclcpp::NodeOptions & node_options)
-: rclcpp::Node(node_name, node_options)
+: rclcpp::Node(node_name, rclcpp::NodeOptions(node_options).start_parameter_event_publisher(false)),
+  storage_options_(get_storage_options_from_node_params(*this)),
+  record_options_(get_record_options_from_node_params(*this)),
+  stop_discovery_(record_options_.is_discovery_disabled),
+  paused_(record_options_.start_paused)
 {
-  // TODO(karsten1987): Use this constructor later with parameter parsing.
-  // The reader, storage_options as well as record_options can be loaded via parameter.
-  // That way, the recorder can be used as a simple component in a component manager.
-  throw rclcpp::exceptions::UnimplementedError();
+  if (!record_options_.disable_keyboard_controls) {
+    keyboard_handler_ = std::make_shared<KeyboardHandler>();
+  }
+  // Same defaults as `ros2 bag record`
+  if (storage_options_.uri.empty()) {
+    storage_options_.uri = default_bag_name();
+  }
+  if (storage_options_.storage_id.empty()) {
+    storage_options_.storage_id = "sqlite3";
+  }
+  writer_ = ReaderWriterFactory::make_writer(record_options_);
+  initialize();
+  // record() doesn't block, subscriptions are served by the component container's executor
+  record();
 }
 
 Recorder::Recorder(
@@ -59,7 +110,7 @@ Recorder::Recorder(
   const rclcpp::NodeOptions & node_options)
 : Recorder(
     std::move(writer),
-    std::make_shared<KeyboardHandler>(),
+    record_options.disable_keyboard_controls ? nullptr : std::make_shared<KeyboardHandler>(),
     storage_options,
     record_options,
     node_name,
@@ -83,26 +134,54 @@ Recorder::Recorder(
   paused_(record_options.start_paused),
   keyboard_handler_(std::move(keyboard_handler))
 {
-  std::string key_str = enum_key_code_to_str(Recorder::kPauseResumeToggleKey);
-  toggle_paused_key_callback_handle_ =
-    keyboard_handler_->add_key_press_callback(
-    [this](KeyboardHandler::KeyCode /*key_code*/,
-    KeyboardHandler::KeyModifiers /*key_modifiers*/) {this->toggle_paused();},
-    Recorder::kPauseResumeToggleKey);
-  topic_filter_ = std::make_unique<TopicFilter>(record_options, this->get_node_graph_interface());
-  // show instructions
-  RCLCPP_INFO_STREAM(
-    get_logger(),
-    "Press " << key_str << " for pausing/resuming");
+  initialize();
+}
+
+void Recorder::initialize()
+{
+  if (keyboard_handler_) {
+    std::string key_str = enum_key_code_to_str(Recorder::kPauseResumeToggleKey);
+    toggle_paused_key_callback_handle_ =
+      keyboard_handler_->add_key_press_callback(
+      [this](KeyboardHandler::KeyCode /*key_code*/,
+      KeyboardHandler::KeyModifiers /*key_modifiers*/) {this->toggle_paused();},
+      Recorder::kPauseResumeToggleKey);
+    // show instructions
+    RCLCPP_INFO_STREAM(
+      get_logger(),
+      "Press " << key_str << " for pausing/resuming");
+  }
+  topic_filter_ = std::make_unique<TopicFilter>(record_options_, this->get_node_graph_interface());
 
   for (auto & topic : record_options_.topics) {
     topic = rclcpp::expand_topic_or_service_name(topic, get_name(), get_namespace(), false);
   }
+  std::unordered_map<std::string, TopicThrottleOptions> topic_throttles;
+  for (const auto & [topic, throttle] : record_options_.topic_throttles) {
+    topic_throttles.emplace(
+      rclcpp::expand_topic_or_service_name(topic, get_name(), get_namespace(), false), throttle);
+  }
+  record_options_.topic_throttles = std::move(topic_throttles);
+  std::unordered_map<std::string, std::vector<std::string>> topic_content_filters;
+  for (const auto & [topic, predicates] : record_options_.topic_content_filters) {
+    topic_content_filters.emplace(
+      rclcpp::expand_topic_or_service_name(topic, get_name(), get_namespace(), false),
+      predicates);
+  }
+  record_options_.topic_content_filters = std::move(topic_content_filters);
+  std::unordered_map<std::string, std::string> topic_callback_groups;
+  for (const auto & [topic, group] : record_options_.topic_callback_groups) {
+    topic_callback_groups.emplace(
+      rclcpp::expand_topic_or_service_name(topic, get_name(), get_namespace(), false), group);
+  }
+  record_options_.topic_callback_groups = std::move(topic_callback_groups);
 }
 
 Recorder::~Recorder()
 {
-  keyboard_handler_->delete_key_press_callback(toggle_paused_key_callback_handle_);
+  if (keyboard_handler_) {
+    keyboard_handler_->delete_key_press_callback(toggle_paused_key_callback_handle_);
+  }
   stop_discovery_ = true;
   if (discovery_future_.valid()) {
     discovery_future_.wait();
@@ -126,6 +205,18 @@ void Recorder::record()
   if (record_options_.rmw_serialization_format.empty()) {
     throw std::runtime_error("No serialization format specified!");
   }
+  if (record_options_.callback_group_policy != "default" &&
+    record_options_.callback_group_policy != "per_topic" &&
+    record_options_.callback_group_policy != "reentrant")
+  {
+    throw std::runtime_error(
+            "Unknown callback group policy '" + record_options_.callback_group_policy + "'");
+  }
+  if (record_options_.subscription_history_budget.count() > 0 &&
+    record_options_.max_subscription_history_depth == 0)
+  {
+    throw std::runtime_error("Maximum subscription history depth must be greater than 0");
+  }
 
   writer_->open(
     storage_options_,
@@ -166,6 +257,13 @@ void Recorder::record()
   RCLCPP_INFO(this->get_logger(), "Listening for topics...");
   subscribe_topics(get_requested_or_available_topics());
 
+  if (record_options_.statistics_publish_period.count() > 0) {
+    statistics_pub_ = create_publisher<rosbag2_interfaces::msg::RecorderStatistics>(
+      "~/statistics", 10);
+    statistics_timer_ = create_wall_timer(
+      record_options_.statistics_publish_period, [this]() {publish_statistics();});
+  }
+
   if (!record_options_.is_discovery_disabled) {
     discovery_future_ =
       std::async(std::launch::async, std::bind(&Recorder::topics_discovery, this));
@@ -174,6 +272,8 @@ void Recorder::record()
 
 void Recorder::event_publisher_thread_main()
 {
+  rosbag2_cpp::configure_current_thread(
+    rosbag2_cpp::thread_class::kEventPublisher, record_options_.thread_options);
   RCLCPP_INFO(get_logger(), "Event publisher thread: Starting");
 
   bool should_exit = false;
@@ -199,6 +299,52 @@ void Recorder::event_publisher_thread_main()
   RCLCPP_INFO(get_logger(), "Event publisher thread: Exiting");
 }
 
+void Recorder::publish_statistics()
+{
+  auto writer_statistics = writer_->get_statistics();
+  rosbag2_interfaces::msg::RecorderStatistics message;
+  message.stamp = now();
+  {
+    std::lock_guard<std::mutex> lock(topic_counters_mutex_);
+    message.topics.reserve(topic_counters_.size());
+    for (const auto & [topic_name, counters] : topic_counters_) {
+      rosbag2_interfaces::msg::RecorderTopicStatistics topic;
+      topic.topic_name = topic_name;
+      topic.messages_received = counters->messages_received.load();
+      topic.bytes_received = counters->bytes_received.load();
+      topic.messages_throttled = counters->messages_throttled.load();
+      topic.messages_filtered = counters->messages_filtered.load();
+      topic.messages_lost = counters->messages_lost.load();
+      topic.history_depth = counters->history_depth.load();
+      auto dropped = writer_statistics.messages_dropped_cache_full.find(topic_name);
+      if (dropped != writer_statistics.messages_dropped_cache_full.end()) {
+        topic.messages_dropped_cache_full = dropped->second;
+      }
+      dropped = writer_statistics.messages_dropped_compression_queue.find(topic_name);
+      if (dropped != writer_statistics.messages_dropped_compression_queue.end()) {
+        topic.messages_dropped_compression_queue = dropped->second;
+      }
+      message.topics.push_back(std::move(topic));
+    }
+  }
+  auto to_duration = [](std::chrono::nanoseconds duration) {
+      return rclcpp::Duration(duration);
+    };
+  message.messages_dropped_storage = writer_statistics.messages_dropped_storage;
+  message.cache_bytes = writer_statistics.cache_bytes;
+  message.cache_capacity_bytes = writer_statistics.cache_capacity_bytes;
+  message.write_batches = writer_statistics.write_batches;
+  message.max_batch_size = writer_statistics.max_batch_size;
+  message.messages_written = writer_statistics.messages_written;
+  message.write_latency_p50 = to_duration(writer_statistics.write_latency_p50);
+  message.write_latency_p90 = to_duration(writer_statistics.write_latency_p90);
+  message.write_latency_p99 = to_duration(writer_statistics.write_latency_p99);
+  message.write_latency_max = to_duration(writer_statistics.write_latency_max);
+  message.splits = writer_statistics.splits;
+  message.last_split_duration = to_duration(writer_statistics.last_split_duration);
+  statistics_pub_->publish(message);
+}
+
 bool Recorder::event_publisher_thread_should_wake()
 {
   return write_split_has_occurred_ || event_publisher_thread_should_exit_;
@@ -237,7 +383,18 @@ bool Recorder::is_paused()
 
 void Recorder::topics_discovery()
 {
+  rosbag2_cpp::configure_current_thread(
+    rosbag2_cpp::thread_class::kDiscovery, record_options_.thread_options);
+  // Rediscover when the ROS graph changes. The polling interval bounds the wait, so that
+  // stop_discovery_ is noticed while the graph is idle.
+  auto graph_event = this->get_graph_event();
+  const auto idle_graph_interval =
+    record_options_.topic_polling_interval * kIdleGraphPollingIntervals;
+  // With adaptive history depths, discovery keeps running to measure the rates of the topics
+  const bool adapt_depths = record_options_.subscription_history_budget.count() > 0;
   while (rclcpp::ok() && stop_discovery_ == false) {
+    const auto pass_start = std::chrono::steady_clock::now();
+    graph_event->check_and_clear();
     auto topics_to_subscribe =
       get_requested_or_available_topics();
     for (const auto & topic_and_type : topics_to_subscribe) {
@@ -246,13 +403,31 @@ void Recorder::topics_discovery()
     auto missing_topics = get_missing_topics(topics_to_subscribe);
     subscribe_topics(missing_topics);
 
-    if (!record_options_.topics.empty() && subscriptions_.size() == record_options_.topics.size()) {
+    if (adapt_depths) {
+      adapt_subscription_depths();
+    }
+
+    if (!adapt_depths && !record_options_.topics.empty() &&
+      subscriptions_.size() == record_options_.topics.size())
+    {
       RCLCPP_INFO(
         this->get_logger(),
         "All requested topics are subscribed. Stopping discovery...");
       return;
     }
-    std::this_thread::sleep_for(record_options_.topic_polling_interval);
+
+    while (rclcpp::ok() && stop_discovery_ == false) {
+      this->wait_for_graph_change(graph_event, record_options_.topic_polling_interval);
+      if (graph_event->check()) {
+        // Graph events come in bursts, e.g. when a node creates its publishers. Passes are at
+        // least a polling interval apart, so that the rest of a burst is handled by one pass.
+        std::this_thread::sleep_until(pass_start + record_options_.topic_polling_interval);
+        break;
+      }
+      if (adapt_depths || std::chrono::steady_clock::now() - pass_start >= idle_graph_interval) {
+        break;
+      }
+    }
   }
 }
 
@@ -298,32 +473,223 @@ void Recorder::subscribe_topic(const rosbag2_storage::TopicMetadata & topic)
   writer_->create_topic(topic);
 
   Rosbag2QoS subscription_qos{subscription_qos_for_topic(topic.name)};
-  auto subscription = create_subscription(topic.name, topic.type, subscription_qos);
+  auto callback = create_message_callback(topic.name, topic.type);
+  // A new transient local subscription would receive the history of the publishers again
+  const auto & profile = subscription_qos.get_rmw_qos_profile();
+  const bool adapt_depth = record_options_.subscription_history_budget.count() > 0 &&
+    topic_qos_profile_overrides_.count(topic.name) == 0 &&
+    profile.history == RMW_QOS_POLICY_HISTORY_KEEP_LAST &&
+    profile.durability != RMW_QOS_POLICY_DURABILITY_TRANSIENT_LOCAL;
+  std::shared_ptr<SubscriptionHandover> handover;
+  if (adapt_depth) {
+    handover = std::make_shared<SubscriptionHandover>(callback);
+    callback = [handover](std::shared_ptr<rclcpp::SerializedMessage> message) {
+        handover->receive(0, std::move(message));
+      };
+  }
+  auto subscription = create_subscription(topic.name, topic.type, subscription_qos, callback);
   if (subscription) {
     subscriptions_.insert({topic.name, subscription});
     RCLCPP_INFO_STREAM(
       this->get_logger(),
       "Subscribed to topic '" << topic.name << "'");
+    if (adapt_depth) {
+      adaptive_depth_topics_.insert_or_assign(
+        topic.name,
+        AdaptiveDepthTopic{
+          topic.type, subscription_qos, handover,
+          counters_for_topic(topic.name)->messages_received.load(),
+          std::chrono::steady_clock::now(), nullptr});
+    }
   } else {
     writer_->remove_topic(topic);
     subscriptions_.erase(topic.name);
   }
 }
 
+Recorder::MessageCallback
+Recorder::create_message_callback(const std::string & topic_name, const std::string & topic_type)
+{
+  std::shared_ptr<TopicThrottle> throttle;
+  auto throttle_options = record_options_.topic_throttles.find(topic_name);
+  if (throttle_options != record_options_.topic_throttles.end()) {
+    throttle = std::make_shared<TopicThrottle>(throttle_options->second);
+  }
+  std::shared_ptr<ContentFilter> content_filter;
+  auto predicates = record_options_.topic_content_filters.find(topic_name);
+  if (predicates != record_options_.topic_content_filters.end() && !predicates->second.empty()) {
+    try {
+      content_filter = std::make_shared<ContentFilter>(topic_type, predicates->second);
+    } catch (const std::runtime_error & e) {
+      // Recording everything is better than losing the topic
+      RCLCPP_ERROR_STREAM(
+        get_logger(),
+        "Recording all messages of topic '" << topic_name << "': " << e.what());
+    }
+  }
+  auto counters = counters_for_topic(topic_name);
+  return
+    [this, topic_name, topic_type, throttle, content_filter, counters](
+    std::shared_ptr<rclcpp::SerializedMessage> message) {
+      // Counted while paused as well, since the rate of the topic sizes its history
+      counters->messages_received.fetch_add(1, std::memory_order_relaxed);
+      counters->bytes_received.fetch_add(message->size(), std::memory_order_relaxed);
+      if (paused_.load()) {
+        return;
+      }
+      auto receive_time = this->get_clock()->now();
+      // Drop messages before they are copied into the writer's cache. Filtered messages don't
+      // count against the rate of the throttle.
+      if (content_filter && !content_filter->accept(message->get_rcl_serialized_message())) {
+        counters->messages_filtered.fetch_add(1, std::memory_order_relaxed);
+        return;
+      }
+      if (throttle && !throttle->take(receive_time.nanoseconds())) {
+        counters->messages_throttled.fetch_add(1, std::memory_order_relaxed);
+        return;
+      }
+      writer_->write(message, topic_name, topic_type, receive_time);
+    };
+}
+
 std::shared_ptr<rclcpp::GenericSubscription>
 Recorder::create_subscription(
-  const std::string & topic_name, const std::string & topic_type, const rclcpp::QoS & qos)
+  const std::string & topic_name, const std::string & topic_type, const rclcpp::QoS & qos,
+  const MessageCallback & callback)
 {
-  auto subscription = this->create_generic_subscription(
-    topic_name,
-    topic_type,
-    qos,
-    [this, topic_name, topic_type](std::shared_ptr<rclcpp::SerializedMessage> message) {
-      if (!paused_.load()) {
-        writer_->write(message, topic_name, topic_type, this->get_clock()->now());
+  rclcpp::SubscriptionOptions subscription_options;
+  subscription_options.callback_group = callback_group_for_topic(topic_name);
+  auto counters = counters_for_topic(topic_name);
+  counters->history_depth = qos.get_rmw_qos_profile().depth;
+  subscription_options.event_callbacks.message_lost_callback =
+    [this, topic_name, counters](rclcpp::QOSMessageLostInfo & info) {
+      counters->messages_lost.fetch_add(info.total_count_change, std::memory_order_relaxed);
+      RCLCPP_WARN_STREAM_THROTTLE(
+        get_logger(), steady_clock_, 5000,
+        "Topic '" << topic_name << "' lost " << info.total_count << " messages in total "
+          "before they reached the recorder.");
+    };
+  try {
+    return this->create_generic_subscription(
+      topic_name, topic_type, qos, callback, subscription_options);
+  } catch (const rclcpp::UnsupportedEventTypeException &) {
+    RCLCPP_INFO_ONCE(
+      get_logger(), "The rmw implementation doesn't report lost messages of subscriptions.");
+  }
+  subscription_options.event_callbacks.message_lost_callback = nullptr;
+  return this->create_generic_subscription(
+    topic_name, topic_type, qos, callback, subscription_options);
+}
+
+std::shared_ptr<Recorder::TopicCounters> Recorder::counters_for_topic(
+  const std::string & topic_name)
+{
+  std::lock_guard<std::mutex> lock(topic_counters_mutex_);
+  auto & counters = topic_counters_[topic_name];
+  if (!counters) {
+    counters = std::make_shared<TopicCounters>();
+  }
+  return counters;
+}
+
+void Recorder::adapt_subscription_depths()
+{
+  const auto now = std::chrono::steady_clock::now();
+  for (auto & [topic_name, topic] : adaptive_depth_topics_) {
+    if (topic.replaced_subscription) {
+      // The replacement takes over at the first message both subscriptions received. Without
+      // messages, it takes over once it matched the publishers of the replaced subscription.
+      if (topic.handover->in_progress() &&
+        (now - topic.since < kRateMeasurementWindow ||
+        subscriptions_.at(topic_name)->get_publisher_count() <
+        topic.replaced_subscription->get_publisher_count()))
+      {
+        continue;
       }
-    });
-  return subscription;
+      topic.handover->complete();
+      topic.replaced_subscription.reset();
+      topic.messages_received = counters_for_topic(topic_name)->messages_received.load();
+      topic.since = now;
+      continue;
+    }
+
+    const auto elapsed = now - topic.since;
+    if (elapsed < kRateMeasurementWindow) {
+      continue;
+    }
+    const auto messages_received = counters_for_topic(topic_name)->messages_received.load();
+    const double rate =
+      static_cast<double>(messages_received - topic.messages_received) /
+      std::chrono::duration<double>(elapsed).count();
+    topic.messages_received = messages_received;
+    topic.since = now;
+
+    // Grow as soon as the history is too short, but shrink only when it is far too long, so that
+    // a jittering rate doesn't recreate the subscription over and over
+    const size_t current_depth = topic.qos.get_rmw_qos_profile().depth;
+    const size_t needed_depth = Rosbag2QoS::history_depth_for_rate(
+      rate, record_options_.subscription_history_budget,
+      record_options_.max_subscription_history_depth);
+    if (needed_depth <= current_depth && needed_depth * 4 > current_depth) {
+      continue;
+    }
+    const size_t depth = Rosbag2QoS::history_depth_for_rate(
+      rate * kHistoryDepthHeadroom, record_options_.subscription_history_budget,
+      record_options_.max_subscription_history_depth);
+    if (depth == current_depth) {
+      continue;
+    }
+    Rosbag2QoS qos{topic.qos};
+    qos.keep_last(depth);
+    // The old subscription keeps recording until the new one received the same messages, so that
+    // no message is missed or recorded twice. The new subscription continues with the throttle,
+    // content filter and counters of the old one.
+    auto handover = topic.handover;
+    const auto generation = handover->begin(current_depth + depth);
+    auto subscription = create_subscription(
+      topic_name, topic.type, qos,
+      [handover, generation](std::shared_ptr<rclcpp::SerializedMessage> message) {
+        handover->receive(generation, std::move(message));
+      });
+    if (!subscription) {
+      handover->abort();
+      continue;
+    }
+    topic.replaced_subscription = subscriptions_[topic_name];
+    subscriptions_[topic_name] = subscription;
+    topic.qos = qos;
+    RCLCPP_INFO_STREAM(
+      get_logger(),
+      "Resized history of topic '" << topic_name << "' from " << current_depth << " to " <<
+        depth << " messages for a rate of " << rate << " Hz");
+  }
+}
+
+rclcpp::CallbackGroup::SharedPtr Recorder::callback_group_for_topic(const std::string & topic_name)
+{
+  auto group_name = record_options_.topic_callback_groups.find(topic_name);
+  if (group_name != record_options_.topic_callback_groups.end()) {
+    auto & group = callback_groups_["group:" + group_name->second];
+    if (!group) {
+      group = create_callback_group(rclcpp::CallbackGroupType::MutuallyExclusive);
+    }
+    return group;
+  }
+  if (record_options_.callback_group_policy == "per_topic") {
+    auto & group = callback_groups_["topic:" + topic_name];
+    if (!group) {
+      group = create_callback_group(rclcpp::CallbackGroupType::MutuallyExclusive);
+    }
+    return group;
+  }
+  if (record_options_.callback_group_policy == "reentrant") {
+    auto & group = callback_groups_["reentrant"];
+    if (!group) {
+      group = create_callback_group(rclcpp::CallbackGroupType::Reentrant);
+    }
+    return group;
+  }
+  return nullptr;
 }
 
 std::string Recorder::serialized_offered_qos_profiles_for_topic(const std::string & topic_name)
@@ -392,3 +758,10 @@ void Recorder::warn_if_new_qos_for_subscribed_topic(const std::string & topic_na
 }
 
 }  // namespace rosbag2_transport
+
+#include "rclcpp_components/register_node_macro.hpp"
+
+// Register the component with class_loader.
+// This acts as a sort of entry point, allowing the component to be discoverable when its library
+// is being loaded into a running process.
+RCLCPP_COMPONENTS_REGISTER_NODE(rosbag2_transport::Recorder)
@@ -0,0 +1,210 @@
+// Copyright 2022 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROSBAG2_TRANSPORT__SUBSCRIPTION_HANDOVER_HPP_
+#define ROSBAG2_TRANSPORT__SUBSCRIPTION_HANDOVER_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <utility>
+
+#include "rclcpp/serialized_message.hpp"
+
+namespace rosbag2_transport
+{
+
+/// Passes the messages of the subscriptions of a single topic to its message callback, so that a
+/// subscription can be replaced by another one while messages arrive.
+///
+/// Subscriptions are told apart by a generation, starting at 0. During a handover the replaced
+/// and the new subscription run side by side: the replaced one keeps recording and the new one
+/// takes over at the first message both received, which tells that it matched the publishers.
+/// Messages which the new subscription receives after the replaced one recorded them are skipped.
+/// Subscriptions don't see sequence numbers, so messages are matched by their serialized content.
+/// Messages with identical content are only told apart by their order.
+///
+/// Thread safe, since the subscriptions may run in different callback groups.
+class SubscriptionHandover
+{
+public:
+  using MessageCallback = std::function<void (std::shared_ptr<rclcpp::SerializedMessage>)>;
+
+  explicit SubscriptionHandover(MessageCallback callback)
+  : callback_(std::move(callback))
+  {}
+
+  /// Start a handover to a new subscription
+  /// \param capacity Number of messages by which the subscriptions may be apart
+  /// \return Generation of the new subscription
+  uint64_t begin(size_t capacity)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    capacity_ = std::max<size_t>(capacity, 1);
+    next_generation_ = current_generation_ + 1;
+    handing_over_ = true;
+    matching_ = true;
+    return next_generation_;
+  }
+
+  /// Drop the new subscription of a handover, e.g. when it couldn't be created
+  void abort()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    handing_over_ = false;
+    received_by_new_.clear();
+    recorded_by_old_.clear();
+    matching_ = false;
+  }
+
+  /// Let the new subscription record alone, also if it didn't receive a message of the replaced
+  /// one yet. Messages it received so far are recorded.
+  void complete()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!handing_over_) {
+      return;
+    }
+    for (const auto & message : received_by_new_) {
+      callback_(message.second);
+    }
+    switch_to_new();
+  }
+
+  bool in_progress() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return handing_over_;
+  }
+
+  /// Callback of the subscription with the given generation
+  void receive(uint64_t generation, std::shared_ptr<rclcpp::SerializedMessage> message)
+  {
+    if (!matching_.load()) {
+      if (generation == recording_generation_.load()) {
+        callback_(std::move(message));
+      }
+      return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (handing_over_ && generation == current_generation_) {
+      receive_from_old(std::move(message));
+    } else if (handing_over_ && generation == next_generation_) {
+      receive_from_new(std::move(message));
+    } else if (!handing_over_ && generation == current_generation_) {
+      receive_after_handover(std::move(message));
+    }
+  }
+
+private:
+  using Fingerprint = size_t;
+
+  static Fingerprint fingerprint(const rclcpp::SerializedMessage & message)
+  {
+    const auto & buffer = message.get_rcl_serialized_message();
+    return std::hash<std::string_view>{}(
+      std::string_view(reinterpret_cast<const char *>(buffer.buffer), buffer.buffer_length));
+  }
+
+  void receive_from_old(std::shared_ptr<rclcpp::SerializedMessage> message)
+  {
+    const auto id = fingerprint(*message);
+    auto received = std::find_if(
+      received_by_new_.begin(), received_by_new_.end(),
+      [id](const auto & entry) {return entry.first == id;});
+    callback_(std::move(message));
+    if (received == received_by_new_.end()) {
+      recorded_by_old_.push_back(id);
+      if (recorded_by_old_.size() > capacity_) {
+        recorded_by_old_.pop_front();
+      }
+      return;
+    }
+    // The new subscription is ahead, record what it received after this message
+    for (++received; received != received_by_new_.end(); ++received) {
+      callback_(received->second);
+    }
+    recorded_by_old_.clear();
+    switch_to_new();
+  }
+
+  void receive_from_new(std::shared_ptr<rclcpp::SerializedMessage> message)
+  {
+    const auto id = fingerprint(*message);
+    auto recorded = std::find(recorded_by_old_.begin(), recorded_by_old_.end(), id);
+    if (recorded == recorded_by_old_.end()) {
+      // The replaced subscription may still receive it
+      received_by_new_.emplace_back(id, std::move(message));
+      if (received_by_new_.size() > capacity_) {
+        received_by_new_.pop_front();
+      }
+      return;
+    }
+    // The replaced subscription is ahead. Messages it recorded before this one were published
+    // before the new subscription matched.
+    recorded_by_old_.erase(recorded_by_old_.begin(), recorded + 1);
+    switch_to_new();
+  }
+
+  void receive_after_handover(std::shared_ptr<rclcpp::SerializedMessage> message)
+  {
+    auto recorded =
+      std::find(recorded_by_old_.begin(), recorded_by_old_.end(), fingerprint(*message));
+    if (recorded != recorded_by_old_.end()) {
+      recorded_by_old_.erase(recorded_by_old_.begin(), recorded + 1);
+    } else {
+      callback_(std::move(message));
+    }
+    // Messages the replaced subscription was ahead by arrive within its capacity, or never
+    if (recorded_by_old_.empty() || --messages_until_caught_up_ == 0) {
+      recorded_by_old_.clear();
+      matching_ = false;
+    }
+  }
+
+  void switch_to_new()
+  {
+    handing_over_ = false;
+    current_generation_ = next_generation_;
+    recording_generation_ = current_generation_;
+    received_by_new_.clear();
+    messages_until_caught_up_ = capacity_;
+    matching_ = !recorded_by_old_.empty();
+  }
+
+  const MessageCallback callback_;
+  mutable std::mutex mutex_;
+  size_t capacity_ = 1;
+  bool handing_over_ = false;
+  uint64_t current_generation_ = 0;
+  uint64_t next_generation_ = 0;
+  // Lets messages pass without taking the mutex while no messages need to be matched
+  std::atomic<bool> matching_{false};
+  std::atomic<uint64_t> recording_generation_{0};
+  // Messages recorded from the replaced subscription which the new one didn't receive yet
+  std::deque<Fingerprint> recorded_by_old_;
+  // Messages the new subscription received before the replaced one
+  std::deque<std::pair<Fingerprint, std::shared_ptr<rclcpp::SerializedMessage>>> received_by_new_;
+  size_t messages_until_caught_up_ = 0;
+};
+
+}  // namespace rosbag2_transport
+
+#endif  // ROSBAG2_TRANSPORT__SUBSCRIPTION_HANDOVER_HPP_
@@ -96,7 +96,9 @@ TopicFilter::TopicFilter(
   bool allow_unknown_types)
 : record_options_(record_options),
   allow_unknown_types_(allow_unknown_types),
-  node_graph_(node_graph)
+  node_graph_(node_graph),
+  include_regex_(record_options_.regex),
+  exclude_regex_(record_options_.exclude)
 {}
 
 TopicFilter::~TopicFilter()
@@ -122,16 +124,16 @@ bool TopicFilter::take_topic(
   }
 
   const std::string & topic_type = topic_types[0];
-  if (!allow_unknown_types_ && !type_is_known(topic_name, topic_type)) {
-    return false;
+  auto cached = static_decisions_.find(topic_name);
+  if (cached == static_decisions_.end() || cached->second.first != topic_type) {
+    bool take = take_topic_by_name_and_type(topic_name, topic_type);
+    cached = static_decisions_.insert_or_assign(topic_name, std::make_pair(topic_type, take)).first;
   }
-
-  if (!record_options_.include_hidden_topics && topic_is_hidden(topic_name)) {
-    ROSBAG2_TRANSPORT_LOG_WARN_STREAM(
-      "Hidden topics are not recorded. Enable them with --include-hidden-topics");
+  if (!cached->second.second) {
     return false;
   }
 
+  // The graph changes over time, so these checks are never cached
   if (!record_options_.include_unpublished_topics && node_graph_ &&
     topic_is_unpublished(topic_name, *node_graph_))
   {
@@ -144,20 +146,34 @@ bool TopicFilter::take_topic(
     return false;
   }
 
+  return true;
+}
+
+bool TopicFilter::take_topic_by_name_and_type(
+  const std::string & topic_name, const std::string & topic_type)
+{
+  if (!allow_unknown_types_ && !type_is_known(topic_name, topic_type)) {
+    return false;
+  }
+
+  if (!record_options_.include_hidden_topics && topic_is_hidden(topic_name)) {
+    ROSBAG2_TRANSPORT_LOG_WARN_STREAM(
+      "Hidden topics are not recorded. Enable them with --include-hidden-topics");
+    return false;
+  }
+
   if (!record_options_.topics.empty() && !topic_in_list(topic_name, record_options_.topics)) {
     return false;
   }
 
-  std::regex exclude_regex(record_options_.exclude);
-  if (!record_options_.exclude.empty() && std::regex_search(topic_name, exclude_regex)) {
+  if (!record_options_.exclude.empty() && std::regex_search(topic_name, exclude_regex_)) {
     return false;
   }
 
-  std::regex include_regex(record_options_.regex);
   if (
     !record_options_.all &&  // All takes precedence over regex
     !record_options_.regex.empty() &&  // empty regex matches nothing, but should be ignored
-    !std::regex_search(topic_name, include_regex))
+    !std::regex_search(topic_name, include_regex_))
   {
     return false;
   }
@@ -166,18 +182,27 @@ bool TopicFilter::take_topic(
 }
 
 bool TopicFilter::type_is_known(const std::string & topic_name, const std::string & topic_type)
+{
+  auto known = known_types_.find(topic_type);
+  if (known != known_types_.end()) {
+    return known->second;
+  }
+  bool is_known = type_is_resolvable(topic_name, topic_type);
+  known_types_.emplace(topic_type, is_known);
+  return is_known;
+}
+
+bool TopicFilter::type_is_resolvable(
+  const std::string & topic_name, const std::string & topic_type) const
 {
   try {
     auto package_name = std::get<0>(rosbag2_cpp::extract_type_identifier(topic_type));
     rosbag2_cpp::get_typesupport_library_path(package_name, "rosidl_typesupport_cpp");
   } catch (std::runtime_error & e) {
-    if (already_warned_unknown_types_.find(topic_type) == already_warned_unknown_types_.end()) {
-      already_warned_unknown_types_.emplace(topic_type);
-      ROSBAG2_TRANSPORT_LOG_WARN_STREAM(
-        "Topic '" << topic_name <<
-          "' has unknown type '" << topic_type <<
-          "' . Only topics with known type are supported. Reason: '" << e.what());
-    }
+    ROSBAG2_TRANSPORT_LOG_WARN_STREAM(
+      "Topic '" << topic_name <<
+        "' has unknown type '" << topic_type <<
+        "' . Only topics with known type are supported. Reason: '" << e.what());
     return false;
   }
   return true;
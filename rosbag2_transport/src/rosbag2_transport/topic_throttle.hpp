@@ -0,0 +1,84 @@
+// Copyright 2022 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROSBAG2_TRANSPORT__TOPIC_THROTTLE_HPP_
+#define ROSBAG2_TRANSPORT__TOPIC_THROTTLE_HPP_
+
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
+
+#include "rcutils/time.h"
+
+#include "rosbag2_transport/record_options.hpp"
+
+namespace rosbag2_transport
+{
+
+/// Decides which messages of a single topic get recorded according to TopicThrottleOptions.
+/// Thread safe, since callbacks of one topic may run concurrently in a reentrant callback group.
+class TopicThrottle
+{
+public:
+  explicit TopicThrottle(const TopicThrottleOptions & options)
+  : keep_every_nth_(std::max<uint64_t>(options.keep_every_nth, 1)),
+    min_interval_(options.min_interval.count()),
+    period_(
+      options.max_rate > 0.0 ?
+      static_cast<rcutils_duration_value_t>(RCUTILS_S_TO_NS(1.0 / options.max_rate)) : 0)
+  {}
+
+  /// \param receive_time Time at which the message was received, in nanoseconds
+  /// \return true if the message should be recorded
+  bool take(rcutils_time_point_value_t receive_time)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (received_++ % keep_every_nth_ != 0) {
+      return false;
+    }
+    if (taken_any_) {
+      if (receive_time - last_taken_ < min_interval_) {
+        return false;
+      }
+      if (receive_time < next_slot_) {
+        return false;
+      }
+    }
+    // Advance the rate slot by one period rather than to receive_time, so that jitter of the
+    // incoming messages doesn't push the recorded rate below max_rate. After a gap in the
+    // incoming messages restart from receive_time instead of allowing a burst.
+    if (taken_any_ && receive_time - next_slot_ < period_) {
+      next_slot_ += period_;
+    } else {
+      next_slot_ = receive_time + period_;
+    }
+    last_taken_ = receive_time;
+    taken_any_ = true;
+    return true;
+  }
+
+private:
+  const uint64_t keep_every_nth_;
+  const rcutils_duration_value_t min_interval_;
+  const rcutils_duration_value_t period_;
+  std::mutex mutex_;
+  uint64_t received_ = 0;
+  bool taken_any_ = false;
+  rcutils_time_point_value_t last_taken_ = 0;
+  rcutils_time_point_value_t next_slot_ = 0;
+};
+
+}  // namespace rosbag2_transport
+
+#endif  // ROSBAG2_TRANSPORT__TOPIC_THROTTLE_HPP_
@@ -15,9 +15,11 @@
 #ifndef ROSBAG2_TRANSPORT__MOCK_RECORDER_HPP_
 #define ROSBAG2_TRANSPORT__MOCK_RECORDER_HPP_
 
+#include <atomic>
 #include <chrono>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <ratio>
 
 #include "rosbag2_transport/recorder.hpp"
@@ -65,6 +67,22 @@ public:
     }
     return available_for_recording;
   }
+
+  /// Number of calls to get_requested_or_available_topics(), by record() and discovery passes
+  size_t topic_queries() const
+  {
+    return topic_queries_.load();
+  }
+
+protected:
+  std::unordered_map<std::string, std::string> get_requested_or_available_topics() override
+  {
+    ++topic_queries_;
+    return Recorder::get_requested_or_available_topics();
+  }
+
+private:
+  std::atomic<size_t> topic_queries_{0};
 };
 
 #endif  // ROSBAG2_TRANSPORT__MOCK_RECORDER_HPP_
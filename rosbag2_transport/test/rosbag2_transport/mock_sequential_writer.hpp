@@ -16,6 +16,7 @@
 #define ROSBAG2_TRANSPORT__MOCK_SEQUENTIAL_WRITER_HPP_
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -83,6 +84,18 @@ public:
     }
   }
 
+  rosbag2_cpp::WriterStatistics get_statistics() override
+  {
+    std::lock_guard<std::mutex> lock(statistics_mutex_);
+    return statistics_;
+  }
+
+  void set_statistics(const rosbag2_cpp::WriterStatistics & statistics)
+  {
+    std::lock_guard<std::mutex> lock(statistics_mutex_);
+    statistics_ = statistics;
+  }
+
   const std::vector<std::shared_ptr<rosbag2_storage::SerializedBagMessage>> & get_messages()
   {
     return messages_;
@@ -118,6 +131,9 @@ private:
   rosbag2_cpp::bag_events::EventCallbackManager callback_manager_;
   size_t file_number_ = 0;
   const size_t max_messages_per_file_ = 5;
+  // Returned by get_statistics, which the recorder calls from its statistics timer
+  std::mutex statistics_mutex_;
+  rosbag2_cpp::WriterStatistics statistics_;
 };
 
 #endif  // ROSBAG2_TRANSPORT__MOCK_SEQUENTIAL_WRITER_HPP_
@@ -0,0 +1,113 @@
+// Copyright 2022 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "rclcpp/rclcpp.hpp"
+
+#include "rosbag2_transport/config_options_from_node_params.hpp"
+
+using namespace ::testing;  // NOLINT
+
+class ConfigOptionsFromNodeParamsTest : public Test
+{
+public:
+  static void SetUpTestCase()
+  {
+    rclcpp::init(0, nullptr);
+  }
+
+  static void TearDownTestCase()
+  {
+    rclcpp::shutdown();
+  }
+
+  std::shared_ptr<rclcpp::Node> make_node(const std::vector<rclcpp::Parameter> & parameters)
+  {
+    return std::make_shared<rclcpp::Node>(
+      "config_options_node", rclcpp::NodeOptions().parameter_overrides(parameters));
+  }
+};
+
+TEST_F(ConfigOptionsFromNodeParamsTest, unset_parameters_keep_defaults)
+{
+  auto node = make_node({});
+  auto storage_options = rosbag2_transport::get_storage_options_from_node_params(*node);
+  auto play_options = rosbag2_transport::get_play_options_from_node_params(*node);
+
+  rosbag2_transport::PlayOptions default_play_options;
+  EXPECT_THAT(storage_options.uri, IsEmpty());
+  EXPECT_EQ(storage_options.max_bagfile_size, 0u);
+  // The recorder enables the rate overview, unlike StorageOptions
+  EXPECT_EQ(storage_options.rate_overview_bucket_duration, 1000u);
+  EXPECT_EQ(play_options.read_ahead_queue_size, default_play_options.read_ahead_queue_size);
+  EXPECT_FLOAT_EQ(play_options.rate, default_play_options.rate);
+  EXPECT_EQ(play_options.playback_duration, default_play_options.playback_duration);
+  EXPECT_EQ(play_options.start_offset, default_play_options.start_offset);
+}
+
+TEST_F(ConfigOptionsFromNodeParamsTest, parameters_are_applied)
+{
+  auto node = make_node(
+  {
+    rclcpp::Parameter("storage.uri", "some_bag"),
+    rclcpp::Parameter("storage.max_bagfile_size", 1024),
+    rclcpp::Parameter("play.rate", 2.5),
+    rclcpp::Parameter("play.loop", true),
+    rclcpp::Parameter("play.start_offset", 1.5),
+    rclcpp::Parameter("play.topics_to_filter", std::vector<std::string>{"/a", "/b"}),
+    rclcpp::Parameter("record.topics", std::vector<std::string>{"/c"}),
+    rclcpp::Parameter("record.topic_polling_interval", 250),
+    rclcpp::Parameter(
+      "record.topic_callback_groups", std::vector<std::string>{"/c:fast", "/ns/d:slow"}),
+  });
+  auto storage_options = rosbag2_transport::get_storage_options_from_node_params(*node);
+  auto play_options = rosbag2_transport::get_play_options_from_node_params(*node);
+  auto record_options = rosbag2_transport::get_record_options_from_node_params(*node);
+
+  EXPECT_EQ(storage_options.uri, "some_bag");
+  EXPECT_EQ(storage_options.max_bagfile_size, 1024u);
+  EXPECT_FLOAT_EQ(play_options.rate, 2.5f);
+  EXPECT_TRUE(play_options.loop);
+  EXPECT_EQ(play_options.start_offset, 1500000000);
+  EXPECT_THAT(play_options.topics_to_filter, ElementsAre("/a", "/b"));
+  EXPECT_THAT(record_options.topics, ElementsAre("/c"));
+  EXPECT_EQ(record_options.topic_polling_interval, std::chrono::milliseconds(250));
+  EXPECT_THAT(record_options.rmw_serialization_format, Not(IsEmpty()));
+  EXPECT_THAT(
+    record_options.topic_callback_groups,
+    UnorderedElementsAre(Pair("/c", "fast"), Pair("/ns/d", "slow")));
+}
+
+TEST_F(ConfigOptionsFromNodeParamsTest, negative_sizes_are_rejected)
+{
+  auto node = make_node({rclcpp::Parameter("storage.max_bagfile_size", -1)});
+  EXPECT_THROW(
+    rosbag2_transport::get_storage_options_from_node_params(*node), std::invalid_argument);
+}
+
+TEST_F(ConfigOptionsFromNodeParamsTest, malformed_topic_callback_groups_are_rejected)
+{
+  for (const std::string entry : {"/c", "/c:", ":fast"}) {
+    auto node = make_node(
+      {rclcpp::Parameter("record.topic_callback_groups", std::vector<std::string>{entry})});
+    EXPECT_THROW(
+      rosbag2_transport::get_record_options_from_node_params(*node), std::invalid_argument) <<
+      entry;
+  }
+}
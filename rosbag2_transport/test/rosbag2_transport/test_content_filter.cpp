@@ -0,0 +1,119 @@
+// Copyright 2022 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "rclcpp/serialization.hpp"
+#include "rclcpp/serialized_message.hpp"
+
+#include "test_msgs/msg/basic_types.hpp"
+#include "test_msgs/msg/nested.hpp"
+#include "test_msgs/msg/unbounded_sequences.hpp"
+
+#include "content_filter.hpp"
+
+using namespace ::testing;  // NOLINT
+using rosbag2_transport::ContentFilter;
+
+namespace
+{
+template<typename T>
+rclcpp::SerializedMessage serialize(const T & message)
+{
+  rclcpp::SerializedMessage serialized;
+  rclcpp::Serialization<T>().serialize_message(&message, &serialized);
+  return serialized;
+}
+
+bool accepts(
+  const std::string & type, const std::vector<std::string> & predicates,
+  const rclcpp::SerializedMessage & message)
+{
+  return ContentFilter(type, predicates).accept(message.get_rcl_serialized_message());
+}
+}  // namespace
+
+TEST(TestContentFilter, parses_comparisons_and_values) {
+  auto predicate = ContentFilter::parse(" status.level >= 2 ");
+  EXPECT_EQ(predicate.field_path, "status.level");
+  EXPECT_EQ(predicate.comparison, ContentFilter::Comparison::GREATER_EQUAL);
+  EXPECT_EQ(predicate.value, 2.0);
+
+  predicate = ContentFilter::parse("x<-0.5");
+  EXPECT_EQ(predicate.field_path, "x");
+  EXPECT_EQ(predicate.comparison, ContentFilter::Comparison::LESS);
+  EXPECT_EQ(predicate.value, -0.5);
+
+  predicate = ContentFilter::parse("ok != true");
+  EXPECT_EQ(predicate.comparison, ContentFilter::Comparison::NOT_EQUAL);
+  EXPECT_EQ(predicate.value, 1.0);
+
+  for (const auto & invalid : {"x", "x = 1", "x => 1", "x ! 1", "== 1", "x == ", "x == 1m"}) {
+    EXPECT_THROW(ContentFilter::parse(invalid), std::runtime_error) << invalid;
+  }
+}
+
+TEST(TestContentFilter, accepts_messages_satisfying_all_predicates) {
+  const std::string type = "test_msgs/msg/BasicTypes";
+  test_msgs::msg::BasicTypes message;
+  message.uint8_value = 2;
+  message.float64_value = 0.75;
+  message.bool_value = true;
+  const auto serialized = serialize(message);
+
+  EXPECT_TRUE(accepts(type, {"uint8_value >= 2"}, serialized));
+  EXPECT_FALSE(accepts(type, {"uint8_value > 2"}, serialized));
+  EXPECT_TRUE(accepts(type, {"bool_value == true", "float64_value < 1"}, serialized));
+  EXPECT_FALSE(accepts(type, {"bool_value == true", "float64_value < 0.5"}, serialized));
+  // Both bounds of a range on the same field
+  EXPECT_TRUE(accepts(type, {"float64_value > 0.5", "float64_value <= 0.75"}, serialized));
+  EXPECT_FALSE(accepts(type, {"float64_value > 0.5", "float64_value != 0.75"}, serialized));
+}
+
+TEST(TestContentFilter, evaluates_nested_fields_and_sequence_elements) {
+  test_msgs::msg::Nested nested;
+  nested.basic_types_value.int32_value = -7;
+  EXPECT_TRUE(
+    accepts("test_msgs/msg/Nested", {"basic_types_value.int32_value < 0"}, serialize(nested)));
+
+  test_msgs::msg::UnboundedSequences sequences;
+  sequences.int16_values = {1, 5};
+  const auto serialized = serialize(sequences);
+  const std::string type = "test_msgs/msg/UnboundedSequences";
+  EXPECT_TRUE(accepts(type, {"int16_values[1] == 5"}, serialized));
+  // Elements past the end of the sequence only satisfy !=
+  EXPECT_FALSE(accepts(type, {"int16_values[2] == 0"}, serialized));
+  EXPECT_TRUE(accepts(type, {"int16_values[2] != 0"}, serialized));
+}
+
+TEST(TestContentFilter, accepts_messages_which_cant_be_read) {
+  rclcpp::SerializedMessage truncated(2);
+  auto & buffer = truncated.get_rcl_serialized_message();
+  buffer.buffer[0] = 0;
+  buffer.buffer[1] = 1;
+  buffer.buffer_length = 2;
+  EXPECT_TRUE(accepts("test_msgs/msg/BasicTypes", {"uint8_value > 2"}, truncated));
+}
+
+TEST(TestContentFilter, rejects_fields_which_are_not_single_numbers) {
+  const std::string type = "test_msgs/msg/Nested";
+  EXPECT_THROW(ContentFilter(type, {"basic_types_value > 1"}), std::runtime_error);
+  EXPECT_THROW(ContentFilter(type, {"basic_types_value.missing > 1"}), std::runtime_error);
+  EXPECT_THROW(
+    ContentFilter("test_msgs/msg/Strings", {"string_value == 1"}), std::runtime_error);
+}
@@ -0,0 +1,163 @@
+// Copyright 2022 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "rclcpp/rclcpp.hpp"
+
+#include "rosbag2_interfaces/msg/playback_ack.hpp"
+
+#include "mock_player.hpp"
+#include "rosbag2_play_test_fixture.hpp"
+#include "test_msgs/message_fixtures.hpp"
+#include "test_msgs/msg/basic_types.hpp"
+
+using namespace ::testing;  // NOLINT
+using namespace rosbag2_transport;  // NOLINT
+using namespace std::chrono_literals;  // NOLINT
+
+namespace
+{
+template<typename Condition>
+bool wait_for(std::chrono::milliseconds timeout, Condition condition)
+{
+  auto start = std::chrono::steady_clock::now();
+  while (!condition()) {
+    if (std::chrono::steady_clock::now() - start > timeout) {
+      return false;
+    }
+    std::this_thread::sleep_for(10ms);
+  }
+  return true;
+}
+}  // namespace
+
+class PlayFlowControlTestFixture : public RosBag2PlayTestFixture
+{
+public:
+  PlayFlowControlTestFixture()
+  : RosBag2PlayTestFixture()
+  {
+    auto primitive_message = get_messages_basic_types()[0];
+    topic_types_ = {{"topic1", "test_msgs/BasicTypes", "", ""}};
+    // Messages are far apart in time, so timed playback would take several seconds
+    messages_ = {
+      serialize_test_message("topic1", 1000, primitive_message),
+      serialize_test_message("topic1", 4000, primitive_message),
+      serialize_test_message("topic1", 7000, primitive_message)
+    };
+    play_options_.flow_control_window = 1;
+    play_options_.flow_control_consumers = {"consumer"};
+
+    ack_node_ = std::make_shared<rclcpp::Node>("flow_control_consumer");
+    ack_pub_ = ack_node_->create_publisher<rosbag2_interfaces::msg::PlaybackAck>(
+      "/rosbag2_player/ack", rclcpp::QoS(rclcpp::KeepAll()).reliable());
+  }
+
+  void acknowledge(const std::string & consumer_id, uint32_t num_messages)
+  {
+    rosbag2_interfaces::msg::PlaybackAck ack;
+    ack.consumer_id = consumer_id;
+    ack.num_messages = num_messages;
+    ack_pub_->publish(ack);
+  }
+
+  std::vector<rosbag2_storage::TopicMetadata> topic_types_;
+  std::vector<std::shared_ptr<rosbag2_storage::SerializedBagMessage>> messages_;
+  rclcpp::Node::SharedPtr ack_node_;
+  rclcpp::Publisher<rosbag2_interfaces::msg::PlaybackAck>::SharedPtr ack_pub_;
+};
+
+TEST_F(PlayFlowControlTestFixture, publishes_next_message_only_after_acknowledgement) {
+  auto prepared_mock_reader = std::make_unique<MockSequentialReader>();
+  prepared_mock_reader->prepare(messages_, topic_types_);
+  auto reader = std::make_unique<rosbag2_cpp::Reader>(std::move(prepared_mock_reader));
+  auto player = std::make_shared<MockPlayer>(std::move(reader), storage_options_, play_options_);
+
+  std::atomic<size_t> published{0};
+  player->add_on_play_message_post_callback(
+    [&published](std::shared_ptr<rosbag2_storage::SerializedBagMessage>) {published++;});
+
+  rclcpp::executors::SingleThreadedExecutor exec;
+  exec.add_node(player);
+  auto spin_thread = std::thread([&exec]() {exec.spin();});
+
+  ASSERT_TRUE(wait_for(30s, [this]() {return ack_pub_->get_subscription_count() > 0;}));
+
+  auto start = std::chrono::steady_clock::now();
+  auto player_future = std::async(std::launch::async, [&player]() -> void {player->play();});
+
+  ASSERT_TRUE(wait_for(5s, [&published]() {return published == 1;}));
+  // Window is full, nothing else may be published until consumer acknowledges
+  std::this_thread::sleep_for(500ms);
+  EXPECT_EQ(published, 1u);
+
+  // Acknowledgements from unknown consumers are ignored
+  acknowledge("unknown", 1);
+  std::this_thread::sleep_for(200ms);
+  EXPECT_EQ(published, 1u);
+
+  acknowledge("consumer", 1);
+  ASSERT_TRUE(wait_for(5s, [&published]() {return published == 2;}));
+  acknowledge("consumer", 1);
+  ASSERT_TRUE(wait_for(5s, [&published]() {return published == 3;}));
+
+  player_future.get();
+  auto replay_time = std::chrono::steady_clock::now() - start;
+  // Recorded timing spans 6 seconds and must not be honored
+  EXPECT_THAT(replay_time, Lt(std::chrono::seconds(5)));
+
+  exec.cancel();
+  spin_thread.join();
+}
+
+TEST_F(PlayFlowControlTestFixture, window_allows_multiple_messages_in_flight) {
+  play_options_.flow_control_window = 2;
+  auto prepared_mock_reader = std::make_unique<MockSequentialReader>();
+  prepared_mock_reader->prepare(messages_, topic_types_);
+  auto reader = std::make_unique<rosbag2_cpp::Reader>(std::move(prepared_mock_reader));
+  auto player = std::make_shared<MockPlayer>(std::move(reader), storage_options_, play_options_);
+
+  std::atomic<size_t> published{0};
+  player->add_on_play_message_post_callback(
+    [&published](std::shared_ptr<rosbag2_storage::SerializedBagMessage>) {published++;});
+
+  rclcpp::executors::SingleThreadedExecutor exec;
+  exec.add_node(player);
+  auto spin_thread = std::thread([&exec]() {exec.spin();});
+
+  ASSERT_TRUE(wait_for(30s, [this]() {return ack_pub_->get_subscription_count() > 0;}));
+
+  auto player_future = std::async(std::launch::async, [&player]() -> void {player->play();});
+
+  ASSERT_TRUE(wait_for(5s, [&published]() {return published == 2;}));
+  std::this_thread::sleep_for(500ms);
+  EXPECT_EQ(published, 2u);
+
+  acknowledge("consumer", 2);
+  ASSERT_TRUE(wait_for(5s, [&published]() {return published == 3;}));
+
+  player_future.get();
+  exec.cancel();
+  spin_thread.join();
+}
@@ -14,6 +14,7 @@
 
 #include <gmock/gmock.h>
 
+#include <chrono>
 #include <string>
 #include <vector>
 
@@ -279,3 +280,16 @@ TEST_F(AdaptiveQoSTest, adapt_offer_mixed_non_compatibility_returns_first)
   auto adapted_offer = Rosbag2QoS::adapt_offer_to_recorded_offers(topic_name_, offers);
   EXPECT_EQ(adapted_offer, offers[0]);
 }
+
+TEST(TestQoS, history_depth_covers_budget_at_observed_rate)
+{
+  using rosbag2_transport::Rosbag2QoS;
+  using namespace std::chrono_literals;  // NOLINT
+  const size_t default_depth = rmw_qos_profile_default.depth;
+  // Slow and silent topics keep the default depth
+  EXPECT_EQ(Rosbag2QoS::history_depth_for_rate(0.0, 500ms, 10000), default_depth);
+  EXPECT_EQ(Rosbag2QoS::history_depth_for_rate(1.0, 500ms, 10000), default_depth);
+  EXPECT_EQ(Rosbag2QoS::history_depth_for_rate(1000.0, 500ms, 10000), 500u);
+  EXPECT_EQ(Rosbag2QoS::history_depth_for_rate(999.5, 100ms, 10000), 100u);
+  EXPECT_EQ(Rosbag2QoS::history_depth_for_rate(1e6, 1000ms, 10000), 10000u);
+}
@@ -15,7 +15,9 @@
 #include <gmock/gmock.h>
 
 #include <memory>
+#include <set>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -28,6 +30,7 @@
 #include "rosbag2_transport/recorder.hpp"
 
 #include "test_msgs/msg/arrays.hpp"
+#include "test_msgs/msg/basic_types.hpp"
 #include "test_msgs/message_fixtures.hpp"
 
 #include "rosbag2_transport/qos.hpp"
@@ -357,3 +360,49 @@ TEST_F(RecordIntegrationTestFixture, write_split_callback_is_called)
   EXPECT_EQ(closed_file, "BagFile0");
   EXPECT_EQ(opened_file, "BagFile1");
 }
+
+TEST_F(RecordIntegrationTestFixture, history_is_resized_without_missing_or_duplicate_messages)
+{
+  std::string topic = "/high_rate_topic";
+  rosbag2_transport::RecordOptions record_options =
+  {false, false, {topic}, "rmw_format", 100ms};
+  // At the publishing rate below, the default depth of 10 only covers 10 ms
+  record_options.subscription_history_budget = 500ms;
+  auto recorder = std::make_shared<rosbag2_transport::Recorder>(
+    std::move(writer_), storage_options_, record_options);
+
+  auto publisher_node = std::make_shared<rclcpp::Node>("high_rate_publisher");
+  // Only the history of the recorder's subscription should limit what is received
+  auto publisher = publisher_node->create_publisher<test_msgs::msg::BasicTypes>(topic, 1000);
+  recorder->record();
+  start_async_spin(recorder);
+  ASSERT_TRUE(
+    rosbag2_test_common::spin_and_wait_for(
+      std::chrono::seconds(5), publisher_node,
+      [&publisher]() {return publisher->get_subscription_count() > 0;}));
+  const auto first_subscription = recorder->subscriptions().at(topic);
+
+  // Long enough for the rate to be measured and the subscription to be replaced
+  const int64_t messages_to_publish = 3000;
+  test_msgs::msg::BasicTypes message;
+  for (int64_t i = 0; i < messages_to_publish; i++) {
+    message.int64_value = i;
+    publisher->publish(message);
+    std::this_thread::sleep_for(1ms);
+  }
+  std::this_thread::sleep_for(500ms);
+  stop_spinning();
+
+  EXPECT_NE(recorder->subscriptions().at(topic), first_subscription);
+  auto & writer = recorder->get_writer_handle();
+  MockSequentialWriter & mock_writer =
+    static_cast<MockSequentialWriter &>(writer.get_implementation_handle());
+  auto recorded_messages = filter_messages<test_msgs::msg::BasicTypes>(
+    mock_writer.get_messages(), topic);
+  std::set<int64_t> recorded_values;
+  for (const auto & recorded_message : recorded_messages) {
+    EXPECT_TRUE(recorded_values.insert(recorded_message->int64_value).second) <<
+      "message " << recorded_message->int64_value << " was recorded twice";
+  }
+  EXPECT_EQ(recorded_values.size(), static_cast<size_t>(messages_to_publish));
+}
@@ -17,7 +17,9 @@
 #include <chrono>
 #include <memory>
 #include <string>
+#include <thread>
 #include <utility>
+#include <vector>
 
 #include "test_msgs/msg/arrays.hpp"
 #include "test_msgs/msg/basic_types.hpp"
@@ -28,6 +30,7 @@
 
 #include "rosbag2_transport/recorder.hpp"
 
+#include "mock_recorder.hpp"
 #include "record_integration_fixture.hpp"
 
 using namespace std::chrono_literals;  // NOLINT
@@ -85,3 +88,92 @@ TEST_F(RecordIntegrationTestFixture, published_messages_from_multiple_topics_are
   EXPECT_THAT(array_messages[0]->bool_values, ElementsAre(true, false, true));
   EXPECT_THAT(array_messages[0]->float32_values, ElementsAre(40.0f, 2.0f, 0.0f));
 }
+
+TEST_F(
+  RecordIntegrationTestFixture,
+  messages_from_topics_in_separate_callback_groups_are_recorded_with_multithreaded_executor)
+{
+  auto string_message = get_messages_strings()[0];
+  string_message->string_value = "Hello World";
+  std::string string_topic = "/string_topic";
+  std::string other_string_topic = "/other_string_topic";
+  std::string grouped_string_topic = "/grouped_string_topic";
+
+  rosbag2_test_common::PublicationManager pub_manager;
+  pub_manager.setup_publisher(string_topic, string_message, 2);
+  pub_manager.setup_publisher(other_string_topic, string_message, 2);
+  pub_manager.setup_publisher(grouped_string_topic, string_message, 2);
+
+  rosbag2_transport::RecordOptions record_options = {true, false, {}, "rmw_format", 100ms};
+  record_options.callback_group_policy = "per_topic";
+  record_options.topic_callback_groups = {{grouped_string_topic, "group"}};
+  auto recorder = std::make_shared<rosbag2_transport::Recorder>(
+    std::move(writer_), storage_options_, record_options);
+  recorder->record();
+
+  future_ = std::async(
+    std::launch::async, [recorder]() -> void {
+      rclcpp::executors::MultiThreadedExecutor exec(rclcpp::ExecutorOptions(), 3);
+      exec.add_node(recorder);
+      exec.spin();
+    });
+
+  ASSERT_TRUE(pub_manager.wait_for_matched(string_topic.c_str()));
+  ASSERT_TRUE(pub_manager.wait_for_matched(other_string_topic.c_str()));
+  ASSERT_TRUE(pub_manager.wait_for_matched(grouped_string_topic.c_str()));
+
+  pub_manager.run_publishers();
+
+  auto & writer = recorder->get_writer_handle();
+  MockSequentialWriter & mock_writer =
+    static_cast<MockSequentialWriter &>(writer.get_implementation_handle());
+
+  size_t expected_messages = 6;
+  auto ret = rosbag2_test_common::wait_until_shutdown(
+    std::chrono::seconds(5),
+    [&mock_writer, &expected_messages]() {
+      return mock_writer.get_messages().size() >= expected_messages;
+    });
+  auto recorded_messages = mock_writer.get_messages();
+  EXPECT_TRUE(ret) << "failed to capture expected messages in time";
+  for (const auto & topic : {string_topic, other_string_topic, grouped_string_topic}) {
+    EXPECT_THAT(filter_messages<test_msgs::msg::Strings>(recorded_messages, topic), SizeIs(2));
+  }
+}
+
+TEST_F(RecordIntegrationTestFixture, idle_graph_triggers_no_discovery_passes)
+{
+  // Topics are queried again after 50 polling intervals without graph changes, i.e. after 1 s
+  const auto polling_interval = 20ms;
+  rosbag2_transport::RecordOptions record_options =
+  {true, false, {}, "rmw_format", polling_interval};
+  auto recorder = std::make_shared<MockRecorder>(writer_, storage_options_, record_options);
+  recorder->record();
+  start_async_spin(recorder);
+
+  // One query by record() and one by the first discovery pass
+  const auto timeout = std::chrono::steady_clock::now() + 5s;
+  while (recorder->topic_queries() < 2 && std::chrono::steady_clock::now() < timeout) {
+    std::this_thread::sleep_for(10ms);
+  }
+  ASSERT_GE(recorder->topic_queries(), 2u);
+  // Let the graph events of the subscriptions created by the first passes settle
+  std::this_thread::sleep_for(200ms);
+
+  // Polling would query 25 times. Allow a few passes for graph changes of other processes.
+  const auto queries_before_idle = recorder->topic_queries();
+  std::this_thread::sleep_for(polling_interval * 25);
+  EXPECT_LT(recorder->topic_queries() - queries_before_idle, 5u);
+
+  // A graph change is still picked up well before the idle graph interval
+  auto publisher_node = std::make_shared<rclcpp::Node>("late_publisher_node");
+  auto publisher = publisher_node->create_publisher<test_msgs::msg::Strings>("/late_topic", 10);
+  const auto subscribe_timeout = std::chrono::steady_clock::now() + 500ms;
+  while (recorder->subscriptions().count("/late_topic") == 0 &&
+    std::chrono::steady_clock::now() < subscribe_timeout)
+  {
+    std::this_thread::sleep_for(10ms);
+  }
+  EXPECT_EQ(recorder->subscriptions().count("/late_topic"), 1u);
+  stop_spinning();
+}
@@ -0,0 +1,171 @@
+// Copyright 2022 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "rclcpp/rclcpp.hpp"
+
+#include "rosbag2_interfaces/msg/recorder_statistics.hpp"
+
+#include "rosbag2_test_common/publication_manager.hpp"
+#include "rosbag2_test_common/wait_for.hpp"
+
+#include "rosbag2_transport/recorder.hpp"
+
+#include "test_msgs/message_fixtures.hpp"
+
+#include "record_integration_fixture.hpp"
+
+TEST_F(RecordIntegrationTestFixture, published_statistics_reflect_writer_drops)
+{
+  auto string_message = get_messages_strings()[1];
+  std::string string_topic = "/string_topic";
+
+  rosbag2_test_common::PublicationManager pub_manager;
+  pub_manager.setup_publisher(string_topic, string_message, 3);
+
+  auto & mock_writer =
+    static_cast<MockSequentialWriter &>(writer_->get_implementation_handle());
+  rosbag2_cpp::WriterStatistics writer_statistics;
+  writer_statistics.messages_dropped_cache_full[string_topic] = 2;
+  writer_statistics.messages_dropped_compression_queue[string_topic] = 1;
+  writer_statistics.messages_dropped_storage = 4;
+  mock_writer.set_statistics(writer_statistics);
+
+  rosbag2_transport::RecordOptions record_options =
+  {false, false, {string_topic}, "rmw_format", 100ms};
+  record_options.statistics_publish_period = 50ms;
+  auto recorder = std::make_shared<rosbag2_transport::Recorder>(
+    writer_, storage_options_, record_options);
+  recorder->record();
+
+  start_async_spin(recorder);
+
+  // Only spun by spin_and_wait_for on this thread
+  rosbag2_interfaces::msg::RecorderStatistics last_statistics;
+  auto listener = std::make_shared<rclcpp::Node>("statistics_listener");
+  auto subscription = listener->create_subscription<rosbag2_interfaces::msg::RecorderStatistics>(
+    "/rosbag2_recorder/statistics", 10,
+    [&last_statistics](const rosbag2_interfaces::msg::RecorderStatistics & statistics) {
+      last_statistics = statistics;
+    });
+
+  ASSERT_TRUE(pub_manager.wait_for_matched(string_topic.c_str()));
+  pub_manager.run_publishers();
+
+  // Statistics are published periodically, wait for one which counts all received messages
+  auto all_received = [&last_statistics, &string_topic]() {
+      for (const auto & topic : last_statistics.topics) {
+        if (topic.topic_name == string_topic && topic.messages_received == 3) {
+          return true;
+        }
+      }
+      return false;
+    };
+  ASSERT_TRUE(
+    rosbag2_test_common::spin_and_wait_for(std::chrono::seconds(5), listener, all_received));
+
+  EXPECT_EQ(last_statistics.messages_dropped_storage, 4u);
+  ASSERT_THAT(last_statistics.topics, SizeIs(1));
+  const auto & topic_statistics = last_statistics.topics[0];
+  EXPECT_EQ(topic_statistics.messages_dropped_cache_full, 2u);
+  EXPECT_EQ(topic_statistics.messages_dropped_compression_queue, 1u);
+  EXPECT_EQ(topic_statistics.messages_throttled, 0u);
+}
+
+TEST_F(RecordIntegrationTestFixture, throttle_only_counts_messages_passing_the_content_filter)
+{
+  std::string topic = "/filtered_topic";
+  rosbag2_transport::RecordOptions record_options =
+  {false, false, {topic}, "rmw_format", 100ms};
+  record_options.topic_content_filters[topic] = {"int64_value >= 0"};
+  rosbag2_transport::TopicThrottleOptions throttle_options;
+  throttle_options.keep_every_nth = 2;
+  record_options.topic_throttles[topic] = throttle_options;
+  record_options.statistics_publish_period = 50ms;
+  auto recorder = std::make_shared<rosbag2_transport::Recorder>(
+    writer_, storage_options_, record_options);
+  recorder->record();
+
+  start_async_spin(recorder);
+
+  auto publisher_node = std::make_shared<rclcpp::Node>("filtered_publisher");
+  auto publisher = publisher_node->create_publisher<test_msgs::msg::BasicTypes>(topic, 10);
+  ASSERT_TRUE(
+    rosbag2_test_common::spin_and_wait_for(
+      std::chrono::seconds(5), publisher_node,
+      [&publisher]() {return publisher->get_subscription_count() > 0;}));
+
+  // Every other message is rejected by the filter. If the throttle counted those, it would
+  // keep exactly the rejected ones.
+  const int64_t messages_to_publish = 12;
+  test_msgs::msg::BasicTypes message;
+  for (int64_t i = 0; i < messages_to_publish; i++) {
+    message.int64_value = i % 2 == 0 ? i : -i;
+    publisher->publish(message);
+    std::this_thread::sleep_for(10ms);
+  }
+
+  rosbag2_interfaces::msg::RecorderStatistics last_statistics;
+  size_t statistics_count = 0;
+  auto listener = std::make_shared<rclcpp::Node>("statistics_listener");
+  auto subscription = listener->create_subscription<rosbag2_interfaces::msg::RecorderStatistics>(
+    "/rosbag2_recorder/statistics", 10,
+    [&last_statistics, &statistics_count](
+      const rosbag2_interfaces::msg::RecorderStatistics & statistics) {
+      last_statistics = statistics;
+      statistics_count++;
+    });
+  auto all_received = [&last_statistics, &topic, messages_to_publish]() {
+      for (const auto & topic_statistics : last_statistics.topics) {
+        if (topic_statistics.topic_name == topic &&
+          topic_statistics.messages_received == static_cast<uint64_t>(messages_to_publish))
+        {
+          return true;
+        }
+      }
+      return false;
+    };
+  ASSERT_TRUE(
+    rosbag2_test_common::spin_and_wait_for(std::chrono::seconds(5), listener, all_received));
+  // Messages are counted as received before they are filtered or throttled, so the last one
+  // may not be accounted for yet
+  const auto statistics_count_when_all_received = statistics_count;
+  ASSERT_TRUE(
+    rosbag2_test_common::spin_and_wait_for(
+      std::chrono::seconds(5), listener,
+      [&statistics_count, statistics_count_when_all_received]() {
+        return statistics_count > statistics_count_when_all_received;
+      }));
+  stop_spinning();
+
+  ASSERT_THAT(last_statistics.topics, SizeIs(1));
+  EXPECT_EQ(last_statistics.topics[0].messages_filtered, 6u);
+  EXPECT_EQ(last_statistics.topics[0].messages_throttled, 3u);
+
+  auto & mock_writer =
+    static_cast<MockSequentialWriter &>(writer_->get_implementation_handle());
+  auto recorded_messages = filter_messages<test_msgs::msg::BasicTypes>(
+    mock_writer.get_messages(), topic);
+  std::vector<int64_t> recorded_values;
+  for (const auto & recorded_message : recorded_messages) {
+    recorded_values.push_back(recorded_message->int64_value);
+  }
+  EXPECT_THAT(recorded_values, ElementsAre(0, 4, 8));
+}
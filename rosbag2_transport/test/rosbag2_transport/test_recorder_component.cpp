@@ -0,0 +1,86 @@
+// Copyright 2022 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "rclcpp/rclcpp.hpp"
+#include "rclcpp_components/component_manager.hpp"
+
+#include "rosbag2_test_common/temporary_directory_fixture.hpp"
+#include "rosbag2_test_common/wait_for.hpp"
+
+#include "rosbag2_transport/recorder.hpp"
+
+#include "test_msgs/msg/basic_types.hpp"
+
+using namespace ::testing;  // NOLINT
+using namespace std::chrono_literals;  // NOLINT
+
+class RecorderComponentTest : public rosbag2_test_common::TemporaryDirectoryFixture
+{
+public:
+  static void SetUpTestCase()
+  {
+    rclcpp::init(0, nullptr);
+  }
+
+  static void TearDownTestCase()
+  {
+    rclcpp::shutdown();
+  }
+};
+
+TEST_F(RecorderComponentTest, recorder_loads_as_component_and_subscribes)
+{
+  auto executor = std::make_shared<rclcpp::executors::SingleThreadedExecutor>();
+  auto manager = std::make_shared<rclcpp_components::ComponentManager>(executor);
+  auto resources = manager->get_component_resources("rosbag2_transport");
+  auto recorder_resource = std::find_if(
+    resources.begin(), resources.end(),
+    [](const rclcpp_components::ComponentManager::ComponentResource & resource) {
+      return resource.first == "rosbag2_transport::Recorder";
+    });
+  ASSERT_NE(recorder_resource, resources.end());
+  auto factory = manager->create_component_factory(*recorder_resource);
+  ASSERT_THAT(factory, NotNull());
+
+  const std::string topic = "/component_topic";
+  auto publisher_node = std::make_shared<rclcpp::Node>("component_test_publisher");
+  auto publisher = publisher_node->create_publisher<test_msgs::msg::BasicTypes>(topic, 10);
+
+  // Without a terminal, keyboard controls would take over stdin of the component container
+  auto options = rclcpp::NodeOptions().parameter_overrides(
+  {
+    rclcpp::Parameter("storage.uri", temporary_dir_path_ + "/component_bag"),
+    rclcpp::Parameter("record.topics", std::vector<std::string>{topic}),
+    rclcpp::Parameter("record.disable_keyboard_controls", true),
+  });
+  auto wrapper = factory->create_node_instance(options);
+  auto recorder = std::static_pointer_cast<rosbag2_transport::Recorder>(
+    wrapper.get_node_instance());
+  ASSERT_THAT(recorder, NotNull());
+  EXPECT_FALSE(recorder->is_paused());
+
+  EXPECT_TRUE(
+    rosbag2_test_common::spin_and_wait_for(
+      5s, recorder, [&recorder, &topic]() {
+        return recorder->subscriptions().count(topic) == 1;
+      }));
+}
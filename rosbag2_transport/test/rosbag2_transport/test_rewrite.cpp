@@ -14,11 +14,13 @@
 
 #include <gmock/gmock.h>
 
+#include <cstring>
 #include <string>
 #include <vector>
 #include <utility>
 
 #include "rcpputils/filesystem_helper.hpp"
+#include "rosbag2_compression/sequential_compression_reader.hpp"
 #include "rosbag2_transport/bag_rewrite.hpp"
 #include "rosbag2_transport/reader_writer_factory.hpp"
 
@@ -131,6 +133,37 @@ TEST_F(TestRewrite, test_merge) {
   }
 }
 
+TEST_F(TestRewrite, test_merge_through_full_cache_does_not_drop) {
+  use_input_a();
+  use_input_b();
+
+  // The cache fills up with every message, so writing has to wait for the cache consumer
+  rosbag2_storage::StorageOptions output_storage;
+  output_storage.uri = (output_dir_ / "small_cache").string();
+  output_storage.storage_id = "sqlite3";
+  output_storage.max_cache_size = 1;
+  rosbag2_transport::RecordOptions output_record;
+  output_record.all = true;
+  output_bags_.push_back({output_storage, output_record});
+
+  rosbag2_transport::bag_rewrite(input_bags_, output_bags_);
+
+  auto reader = rosbag2_transport::ReaderWriterFactory::make_reader(output_storage);
+  reader->open(output_storage);
+  const auto metadata = reader->get_metadata();
+  EXPECT_EQ(metadata.message_count, 100u + 50u + 50u + 25u);
+
+  rcutils_time_point_value_t previous_time_stamp = 0;
+  size_t read_count = 0;
+  while (reader->has_next()) {
+    auto message = reader->read_next();
+    EXPECT_GE(message->time_stamp, previous_time_stamp);
+    previous_time_stamp = message->time_stamp;
+    read_count++;
+  }
+  EXPECT_EQ(read_count, metadata.message_count);
+}
+
 TEST_F(TestRewrite, test_filter_split) {
   use_input_a();
 
@@ -193,3 +226,57 @@ TEST_F(TestRewrite, test_compress) {
   EXPECT_TRUE(compressed_bagfile.exists());
   EXPECT_TRUE(compressed_bagfile.is_regular_file());
 }
+
+TEST_F(TestRewrite, test_message_compressed_passthrough) {
+  use_input_a();
+
+  rosbag2_transport::RecordOptions compressed_record;
+  compressed_record.all = true;
+  compressed_record.compression_mode = "message";
+  compressed_record.compression_format = "zstd";
+
+  rosbag2_storage::StorageOptions compressed_storage;
+  compressed_storage.uri = (output_dir_ / "message_compressed").string();
+  compressed_storage.storage_id = "sqlite3";
+  output_bags_.push_back({compressed_storage, compressed_record});
+  rosbag2_transport::bag_rewrite(input_bags_, output_bags_);
+
+  // Same compression settings, the compressed messages are copied as they are
+  rosbag2_storage::StorageOptions copied_storage;
+  copied_storage.uri = (output_dir_ / "message_compressed_copy").string();
+  copied_storage.storage_id = "sqlite3";
+  rosbag2_transport::bag_rewrite({compressed_storage}, {{copied_storage, compressed_record}});
+
+  // Read the compressed blobs of both bags as they are stored
+  auto compressed = rosbag2_transport::ReaderWriterFactory::make_reader(compressed_storage);
+  compressed->open(compressed_storage);
+  auto copy = rosbag2_transport::ReaderWriterFactory::make_reader(copied_storage);
+  copy->open(copied_storage);
+  EXPECT_EQ(copy->get_metadata().compression_mode, "MESSAGE");
+  EXPECT_EQ(copy->get_metadata().compression_format, "zstd");
+  for (auto reader : {compressed.get(), copy.get()}) {
+    auto compression_reader = dynamic_cast<rosbag2_compression::SequentialCompressionReader *>(
+      &reader->get_implementation_handle());
+    ASSERT_THAT(compression_reader, NotNull());
+    compression_reader->set_compressed_message_passthrough(true);
+  }
+
+  size_t message_count = 0;
+  while (compressed->has_next()) {
+    ASSERT_TRUE(copy->has_next());
+    auto compressed_message = compressed->read_next();
+    auto copied_message = copy->read_next();
+    EXPECT_EQ(copied_message->topic_name, compressed_message->topic_name);
+    EXPECT_EQ(copied_message->time_stamp, compressed_message->time_stamp);
+    ASSERT_EQ(
+      copied_message->serialized_data->buffer_length,
+      compressed_message->serialized_data->buffer_length);
+    EXPECT_EQ(
+      0, memcmp(
+        copied_message->serialized_data->buffer, compressed_message->serialized_data->buffer,
+        compressed_message->serialized_data->buffer_length));
+    message_count++;
+  }
+  EXPECT_FALSE(copy->has_next());
+  EXPECT_EQ(message_count, 100u + 50u);
+}
@@ -0,0 +1,122 @@
+// Copyright 2022 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "subscription_handover.hpp"
+
+using namespace ::testing;  // NOLINT
+using rosbag2_transport::SubscriptionHandover;
+
+namespace
+{
+std::shared_ptr<rclcpp::SerializedMessage> make_message(const std::string & content)
+{
+  auto message = std::make_shared<rclcpp::SerializedMessage>(content.size());
+  auto & buffer = message->get_rcl_serialized_message();
+  std::memcpy(buffer.buffer, content.data(), content.size());
+  buffer.buffer_length = content.size();
+  return message;
+}
+
+std::string content_of(const rclcpp::SerializedMessage & message)
+{
+  const auto & buffer = message.get_rcl_serialized_message();
+  return std::string(reinterpret_cast<const char *>(buffer.buffer), buffer.buffer_length);
+}
+}  // namespace
+
+class SubscriptionHandoverTest : public Test
+{
+public:
+  SubscriptionHandoverTest()
+  : handover_([this](std::shared_ptr<rclcpp::SerializedMessage> message) {
+        recorded_.push_back(content_of(*message));
+      })
+  {}
+
+  void receive(uint64_t generation, const std::vector<std::string> & contents)
+  {
+    for (const auto & content : contents) {
+      handover_.receive(generation, make_message(content));
+    }
+  }
+
+  std::vector<std::string> recorded_;
+  SubscriptionHandover handover_;
+};
+
+TEST_F(SubscriptionHandoverTest, records_messages_of_the_current_subscription_only) {
+  receive(0, {"a", "b"});
+  receive(1, {"c"});
+  EXPECT_THAT(recorded_, ElementsAre("a", "b"));
+}
+
+TEST_F(SubscriptionHandoverTest, takes_over_when_the_new_subscription_is_behind) {
+  const auto generation = handover_.begin(10);
+  // The new subscription matched after "1" was published
+  receive(0, {"1", "2", "3"});
+  receive(generation, {"2"});
+  EXPECT_FALSE(handover_.in_progress());
+  receive(generation, {"3", "4"});
+  receive(0, {"4", "5"});
+  receive(generation, {"5"});
+  EXPECT_THAT(recorded_, ElementsAre("1", "2", "3", "4", "5"));
+}
+
+TEST_F(SubscriptionHandoverTest, takes_over_when_the_new_subscription_is_ahead) {
+  const auto generation = handover_.begin(10);
+  receive(0, {"1"});
+  receive(generation, {"2", "3", "4"});
+  EXPECT_TRUE(handover_.in_progress());
+  receive(0, {"2"});
+  EXPECT_FALSE(handover_.in_progress());
+  receive(0, {"3", "4", "5"});
+  receive(generation, {"5"});
+  EXPECT_THAT(recorded_, ElementsAre("1", "2", "3", "4", "5"));
+}
+
+TEST_F(SubscriptionHandoverTest, complete_records_what_the_new_subscription_received) {
+  const auto generation = handover_.begin(10);
+  receive(0, {"1"});
+  receive(generation, {"2"});
+  handover_.complete();
+  EXPECT_FALSE(handover_.in_progress());
+  receive(0, {"2", "3"});
+  receive(generation, {"3"});
+  EXPECT_THAT(recorded_, ElementsAre("1", "2", "3"));
+}
+
+TEST_F(SubscriptionHandoverTest, abort_keeps_the_replaced_subscription_recording) {
+  const auto generation = handover_.begin(10);
+  receive(0, {"1"});
+  receive(generation, {"2"});
+  handover_.abort();
+  receive(0, {"2"});
+  receive(generation, {"3"});
+  EXPECT_THAT(recorded_, ElementsAre("1", "2"));
+}
+
+TEST_F(SubscriptionHandoverTest, stops_matching_after_the_capacity) {
+  const auto generation = handover_.begin(2);
+  receive(0, {"1", "2", "3"});
+  // "3" arrives more messages late than the capacity allows, so it is taken for a new message
+  receive(generation, {"2", "4", "5", "3"});
+  EXPECT_THAT(recorded_, ElementsAre("1", "2", "3", "4", "5", "3"));
+}
@@ -203,3 +203,20 @@ TEST_F(RegexFixture, regex_all_and_filter)
   auto filtered_topics = filter.filter_topics(topics_and_types_);
   EXPECT_THAT(filtered_topics, SizeIs(6));
 }
+
+TEST(TestTopicFilter, repeated_filtering_reevaluates_topics_with_changed_type) {
+  std::map<std::string, std::vector<std::string>> topics_and_types {
+    {"topic/a", {"test_msgs/BasicTypes"}},
+    {"topic/b", {"type_b"}}
+  };
+  rosbag2_transport::TopicFilter filter{rosbag2_transport::RecordOptions{}, nullptr};
+  for (int i = 0; i < 2; i++) {
+    auto filtered_topics = filter.filter_topics(topics_and_types);
+    ASSERT_THAT(filtered_topics, SizeIs(1));
+    EXPECT_EQ("topic/a", filtered_topics.begin()->first);
+  }
+
+  topics_and_types["topic/b"] = {"test_msgs/Strings"};
+  auto filtered_topics = filter.filter_topics(topics_and_types);
+  EXPECT_THAT(filtered_topics, SizeIs(2));
+}
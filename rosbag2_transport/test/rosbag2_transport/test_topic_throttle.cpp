@@ -0,0 +1,79 @@
+// Copyright 2022 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+
+#include <chrono>
+#include <cstdint>
+
+#include "topic_throttle.hpp"
+
+using namespace ::testing;  // NOLINT
+using namespace std::chrono_literals;  // NOLINT
+
+namespace
+{
+// Feed messages at the given rate for one second and count the recorded ones
+size_t count_taken(rosbag2_transport::TopicThrottle & throttle, double input_rate)
+{
+  size_t taken = 0;
+  auto period = static_cast<rcutils_time_point_value_t>(RCUTILS_S_TO_NS(1.0 / input_rate));
+  for (int64_t i = 0; i < static_cast<int64_t>(input_rate); i++) {
+    if (throttle.take(i * period)) {
+      taken++;
+    }
+  }
+  return taken;
+}
+}  // namespace
+
+TEST(TestTopicThrottle, default_options_take_all_messages) {
+  rosbag2_transport::TopicThrottle throttle{rosbag2_transport::TopicThrottleOptions{}};
+  EXPECT_EQ(60u, count_taken(throttle, 60.0));
+}
+
+TEST(TestTopicThrottle, keep_every_nth_takes_first_and_every_nth_message) {
+  rosbag2_transport::TopicThrottleOptions options;
+  options.keep_every_nth = 3;
+  rosbag2_transport::TopicThrottle throttle{options};
+  EXPECT_TRUE(throttle.take(0));
+  EXPECT_FALSE(throttle.take(1));
+  EXPECT_FALSE(throttle.take(2));
+  EXPECT_TRUE(throttle.take(3));
+}
+
+TEST(TestTopicThrottle, max_rate_limits_average_rate) {
+  rosbag2_transport::TopicThrottleOptions options;
+  options.max_rate = 5.0;
+  rosbag2_transport::TopicThrottle throttle{options};
+  EXPECT_EQ(5u, count_taken(throttle, 60.0));
+}
+
+TEST(TestTopicThrottle, max_rate_does_not_limit_slower_topics) {
+  rosbag2_transport::TopicThrottleOptions options;
+  options.max_rate = 5.0;
+  rosbag2_transport::TopicThrottle throttle{options};
+  EXPECT_EQ(2u, count_taken(throttle, 2.0));
+}
+
+TEST(TestTopicThrottle, min_interval_is_enforced_between_recorded_messages) {
+  rosbag2_transport::TopicThrottleOptions options;
+  options.min_interval = 100ms;
+  rosbag2_transport::TopicThrottle throttle{options};
+  EXPECT_TRUE(throttle.take(0));
+  EXPECT_FALSE(throttle.take(RCUTILS_MS_TO_NS(99)));
+  EXPECT_TRUE(throttle.take(RCUTILS_MS_TO_NS(150)));
+  EXPECT_FALSE(throttle.take(RCUTILS_MS_TO_NS(200)));
+  EXPECT_TRUE(throttle.take(RCUTILS_MS_TO_NS(250)));
+}